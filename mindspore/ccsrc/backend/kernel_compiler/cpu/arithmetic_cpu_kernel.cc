@@ -14,46 +14,13 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
-#include <thread>
+#include <atomic>
 #include <string>
+#include <type_traits>
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
-namespace {
-template <typename T>
-void Add(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] + (is_number ? *input2 : input2[i]);
-  }
-}
-
-template <typename T>
-void Sub(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] - (is_number ? *input2 : input2[i]);
-  }
-}
-
-template <typename T>
-void Mul(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = input1[i] * (is_number ? *input2 : input2[i]);
-  }
-}
-
-template <typename T>
-void Div(const T *input1, const T *input2, T *out, size_t start, size_t end, bool is_number) {
-  for (size_t i = start; i < end; i++) {
-    auto div_number = is_number ? *input2 : input2[i];
-    if (div_number == 0) {
-      MS_LOG(EXCEPTION) << "Cannot divided by 0!";
-    }
-    out[i] = input1[i] / div_number;
-  }
-}
-}  // namespace
-
 void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
@@ -63,24 +30,18 @@ void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     operate_type_ = SUB;
   } else if (kernel_name == prim::kPrimMul->name()) {
     operate_type_ = MUL;
-  } else if (kernel_name == "Div") {
+  } else if (kernel_name == "Div" || kernel_name == prim::kPrimRealDiv->name()) {
     operate_type_ = DIV;
+  } else if (kernel_name == "SquaredDifference") {
+    operate_type_ = SQUARED_DIFFERENCE;
+  } else {
+    MS_LOG(EXCEPTION) << "Not support " << kernel_name;
   }
 
   auto shape0 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
   auto shape1 = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
-  if (shape1.size() == 0) {
-    is_number_ = true;
-  } else {
-    is_number_ = false;
-    if (shape0.size() != shape1.size()) {
-      MS_LOG(EXCEPTION) << "Input0 and input1 must has the same shape";
-    }
-    for (size_t i = 0; i < shape0.size(); ++i) {
-      if (shape0[i] != shape1[i]) {
-        MS_LOG(EXCEPTION) << "Input0 and input1 must has the same shape";
-      }
-    }
+  if (!ElementwiseEngine::InitBroadcastPlan(shape0, shape1, &broadcast_plan_)) {
+    MS_LOG(EXCEPTION) << "Input0 and input1 of " << kernel_name << " can not broadcast";
   }
   dtype_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1)) {
@@ -95,10 +56,13 @@ bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
     LaunchKernel<int>(inputs, outputs);
   } else if (dtype_ == kNumberTypeFloat32) {
     LaunchKernel<float>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
   } else if (dtype_ == kNumberTypeInt64) {
     LaunchKernel<int64_t>(inputs, outputs);
   } else {
-    MS_LOG(EXCEPTION) << "Only support int32, float32, but actual data type is " << TypeIdLabel(dtype_);
+    MS_LOG(EXCEPTION) << "Only support int32, int64, float16, float32, but actual data type is "
+                      << TypeIdLabel(dtype_);
   }
   return true;
 }
@@ -108,29 +72,30 @@ void ArithmeticCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, co
   T *input1 = reinterpret_cast<T *>(inputs[0]->addr);
   T *input2 = reinterpret_cast<T *>(inputs[1]->addr);
   T *output = reinterpret_cast<T *>(outputs[0]->addr);
-  auto lens = inputs[0]->size / sizeof(T);
-  MS_LOG(INFO) << "lens=" << lens;
+  if (outputs[0]->size < broadcast_plan_.output_size * sizeof(T)) {
+    MS_LOG(EXCEPTION) << "Output size " << outputs[0]->size << " is less than " << broadcast_plan_.output_size;
+  }
+  MS_LOG(INFO) << "lens=" << broadcast_plan_.output_size;
 
-  const size_t thread_num = 24;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == ADD) {
-      threads.emplace_back(std::thread(Add<T>, input1, input2, output, start, end, is_number_));
-    } else if (operate_type_ == SUB) {
-      threads.emplace_back(std::thread(Sub<T>, input1, input2, output, start, end, is_number_));
-    } else if (operate_type_ == MUL) {
-      threads.emplace_back(std::thread(Mul<T>, input1, input2, output, start, end, is_number_));
-    } else if (operate_type_ == DIV) {
-      threads.emplace_back(std::thread(Div<T>, input1, input2, output, start, end, is_number_));
+  if (operate_type_ == ADD) {
+    ElementwiseEngine::Binary(broadcast_plan_, input1, input2, output, AddFunc());
+  } else if (operate_type_ == SUB) {
+    ElementwiseEngine::Binary(broadcast_plan_, input1, input2, output, SubFunc());
+  } else if (operate_type_ == MUL) {
+    ElementwiseEngine::Binary(broadcast_plan_, input1, input2, output, MulFunc());
+  } else if (operate_type_ == DIV) {
+    // float division by zero gives inf or nan, only integer division is checked
+    if constexpr (std::is_integral<T>::value) {
+      std::atomic<bool> divided_by_zero{false};
+      ElementwiseEngine::Binary(broadcast_plan_, input1, input2, output, CheckedIntDivFunc{&divided_by_zero});
+      if (divided_by_zero.load()) {
+        MS_LOG(EXCEPTION) << "Cannot divided by 0!";
+      }
+    } else {
+      ElementwiseEngine::Binary(broadcast_plan_, input1, input2, output, DivFunc());
     }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  } else if (operate_type_ == SQUARED_DIFFERENCE) {
+    ElementwiseEngine::Binary(broadcast_plan_, input1, input2, output, SquaredDifferenceFunc());
   }
 }
 }  // namespace kernel
@@ -14,29 +14,11 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/arithmetic_self_cpu_kernel.h"
-#include <cmath>
-#include <thread>
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
 namespace kernel {
-namespace {
-template <typename T>
-void Square(const T *in, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = in[i] * in[i];
-  }
-}
-
-template <typename T>
-void Sqrt(const T *in, T *out, size_t start, size_t end) {
-  for (size_t i = start; i < end; i++) {
-    out[i] = sqrtf(in[i]);
-  }
-}
-}  // namespace
-
 void ArithmeticSelfCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
@@ -53,10 +35,12 @@ bool ArithmeticSelfCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inpu
                                      const std::vector<kernel::AddressPtr> &outputs) {
   if (dtype_ == kNumberTypeFloat32) {
     LaunchKernel<float>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
   } else if (dtype_ == kNumberTypeInt32) {
-    LaunchKernel<float>(inputs, outputs);
+    LaunchKernel<int>(inputs, outputs);
   } else {
-    MS_LOG(EXCEPTION) << "Only support float32, int32, but actual data type is " << TypeIdLabel(dtype_);
+    MS_LOG(EXCEPTION) << "Only support float16, float32, int32, but actual data type is " << TypeIdLabel(dtype_);
   }
   return true;
 }
@@ -69,22 +53,10 @@ void ArithmeticSelfCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs
   auto lens = inputs[0]->size / sizeof(T);
   MS_LOG(INFO) << "lens=" << lens;
 
-  const size_t thread_num = 24;
-  std::vector<std::thread> threads;
-  threads.reserve(thread_num);
-  size_t start = 0;
-  size_t once_compute_size = (lens + thread_num - 1) / thread_num;
-  while (start < lens) {
-    size_t end = (start + once_compute_size) > lens ? lens : (start + once_compute_size);
-    if (operate_type_ == SQUARE) {
-      threads.emplace_back(std::thread(Square<T>, input, output, start, end));
-    } else if (operate_type_ == SQRT) {
-      threads.emplace_back(std::thread(Sqrt<T>, input, output, start, end));
-    }
-    start += once_compute_size;
-  }
-  for (size_t i = 0; i < threads.size(); ++i) {
-    threads[i].join();
+  if (operate_type_ == SQUARE) {
+    ElementwiseEngine::Unary(input, output, lens, SquareFunc());
+  } else if (operate_type_ == SQRT) {
+    ElementwiseEngine::Unary(input, output, lens, SqrtFunc());
   }
 }
 }  // namespace kernel
@@ -76,5 +76,9 @@ void CPUKernelUtils::GetElementNumEveryDim(const std::vector<size_t> &shape, std
   }
   std::reverse(element_num->begin(), element_num->end());
 }
+
+void CPUKernelUtils::ParallelFor(const common::ParallelTask &task, size_t count, size_t grain_size) {
+  common::ThreadPool::GetInstance().ParallelFor(count, task, grain_size);
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -24,6 +24,7 @@
 #include "backend/kernel_compiler/kernel.h"
 #include "ir/anf.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "common/thread_pool.h"
 
 using mindspore::kernel::Address;
 using mindspore::kernel::AddressPtr;
@@ -51,7 +52,9 @@ const char END[] = "end";
 const char SIZE[] = "size";
 const char USE_NESTEROV[] = "use_nesterov";
 const char GROUP[] = "group";
-enum OperateType { ADD = 0, SUB, MUL, DIV, SQUARE, SQRT };
+enum OperateType { ADD = 0, SUB, MUL, DIV, SQUARE, SQRT, SQUARED_DIFFERENCE };
+// Min number of elements of a parallel block for the cheap elementwise kernels, smaller tensors run in one thread.
+constexpr size_t kElementwiseGrainSize = 16384;
 
 class CPUKernel : public kernel::KernelMod {
  public:
@@ -82,6 +85,8 @@ class CPUKernelUtils {
   static size_t CalcOffset(const std::vector<size_t> &shape, size_t dim0, size_t dim1, size_t dim2, size_t dim3);
   static size_t GetElementNumOnAxis(const std::vector<size_t> &shape, int axis);
   static void GetElementNumEveryDim(const std::vector<size_t> &shape, std::vector<size_t> *element_num);
+  // Run task on the blocks of [0, count) in the process-wide cpu thread pool, see common::ThreadPool::ParallelFor.
+  static void ParallelFor(const common::ParallelTask &task, size_t count, size_t grain_size = 1);
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/elementwise_engine.h"
+
+namespace mindspore {
+namespace kernel {
+bool ElementwiseEngine::InitBroadcastPlan(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1,
+                                          BroadcastPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  *plan = BroadcastPlan();
+  size_t rank = std::max(shape0.size(), shape1.size());
+  // dims of the output not equal to 1, with whether each input has them
+  std::vector<size_t> dims;
+  std::vector<bool> has_dim0;
+  std::vector<bool> has_dim1;
+  for (size_t i = 0; i < rank; ++i) {
+    size_t dim0 = i + shape0.size() < rank ? 1 : shape0[i + shape0.size() - rank];
+    size_t dim1 = i + shape1.size() < rank ? 1 : shape1[i + shape1.size() - rank];
+    if (dim0 != dim1 && dim0 != 1 && dim1 != 1) {
+      MS_LOG(ERROR) << "Dim " << i << " of the shapes can not broadcast: " << dim0 << " vs " << dim1;
+      return false;
+    }
+    size_t dim = std::max(dim0, dim1);
+    plan->output_size *= dim;
+    if (dim == 1) {
+      continue;
+    }
+    bool has0 = dim0 != 1;
+    bool has1 = dim1 != 1;
+    if (!dims.empty() && has_dim0.back() == has0 && has_dim1.back() == has1) {
+      dims.back() *= dim;
+      continue;
+    }
+    dims.push_back(dim);
+    has_dim0.push_back(has0);
+    has_dim1.push_back(has1);
+  }
+  if (plan->output_size == 0 || dims.empty()) {
+    plan->inner_size = plan->output_size;
+    return true;
+  }
+
+  plan->inner_size = dims.back();
+  plan->inner_step0 = has_dim0.back() ? 1 : 0;
+  plan->inner_step1 = has_dim1.back() ? 1 : 0;
+  size_t stride0 = plan->inner_step0 == 1 ? plan->inner_size : 1;
+  size_t stride1 = plan->inner_step1 == 1 ? plan->inner_size : 1;
+  size_t outer_rank = dims.size() - 1;
+  plan->outer_shape.resize(outer_rank);
+  plan->outer_strides0.resize(outer_rank);
+  plan->outer_strides1.resize(outer_rank);
+  for (size_t i = outer_rank; i > 0; --i) {
+    plan->outer_shape[i - 1] = dims[i - 1];
+    plan->outer_strides0[i - 1] = has_dim0[i - 1] ? stride0 : 0;
+    plan->outer_strides1[i - 1] = has_dim1[i - 1] ? stride1 : 0;
+    stride0 *= has_dim0[i - 1] ? dims[i - 1] : 1;
+    stride1 *= has_dim1[i - 1] ? dims[i - 1] : 1;
+    plan->outer_count *= dims[i - 1];
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
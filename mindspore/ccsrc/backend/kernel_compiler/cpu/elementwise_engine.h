@@ -0,0 +1,286 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_ENGINE_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_ENGINE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "base/float16.h"
+
+namespace mindspore {
+namespace kernel {
+// Width of the simd registers of the isa the file is compiled for.
+#if defined(__AVX512F__)
+constexpr size_t kVectorBytes = 64;
+#elif defined(__AVX__)
+constexpr size_t kVectorBytes = 32;
+#else
+constexpr size_t kVectorBytes = 16;
+#endif
+// Elements of float16 converted to float32 at a time.
+constexpr size_t kHalfBlockSize = 256;
+
+// A vector of T as wide as the simd registers, the compiler lowers its arithmetic operators to simd instructions.
+template <typename T>
+struct SimdVector {
+  typedef T Vec __attribute__((vector_size(kVectorBytes)));
+  static constexpr size_t kLanes = kVectorBytes / sizeof(T);
+  static Vec Load(const T *addr) {
+    Vec vec;
+    (void)memcpy(&vec, addr, sizeof(Vec));
+    return vec;
+  }
+  static void Store(T *addr, const Vec &vec) { (void)memcpy(addr, &vec, sizeof(Vec)); }
+  static Vec Broadcast(T value) { return Vec{} + value; }
+};
+
+// Apply func to a scalar, or to each lane of a simd vector.
+template <typename V, typename F>
+V LaneWise(V value, const F &func) {
+  if constexpr (std::is_arithmetic<V>::value) {
+    return func(value);
+  } else {
+    for (size_t i = 0; i < sizeof(V) / sizeof(value[0]); ++i) {
+      value[i] = func(value[i]);
+    }
+    return value;
+  }
+}
+
+// The functors of the engine work on both scalars and simd vectors, a fused expression is a functor of several ops.
+struct AddFunc {
+  template <typename V>
+  V operator()(const V &x, const V &y) const {
+    return x + y;
+  }
+};
+
+struct SubFunc {
+  template <typename V>
+  V operator()(const V &x, const V &y) const {
+    return x - y;
+  }
+};
+
+struct MulFunc {
+  template <typename V>
+  V operator()(const V &x, const V &y) const {
+    return x * y;
+  }
+};
+
+struct DivFunc {
+  template <typename V>
+  V operator()(const V &x, const V &y) const {
+    return x / y;
+  }
+};
+
+// Integer division, which traps on a zero divisor. The zero is flagged and its lane gives 0, the caller raises after
+// the parallel loop.
+struct CheckedIntDivFunc {
+  std::atomic<bool> *divided_by_zero;
+
+  template <typename V>
+  V operator()(const V &x, const V &y) const {
+    if constexpr (std::is_arithmetic<V>::value) {
+      if (y == 0) {
+        divided_by_zero->store(true, std::memory_order_relaxed);
+        return 0;
+      }
+      return x / y;
+    } else {
+      V out = x;
+      for (size_t i = 0; i < sizeof(V) / sizeof(x[0]); ++i) {
+        out[i] = (*this)(x[i], y[i]);
+      }
+      return out;
+    }
+  }
+};
+
+struct SquaredDifferenceFunc {
+  template <typename V>
+  V operator()(const V &x, const V &y) const {
+    V diff = x - y;
+    return diff * diff;
+  }
+};
+
+struct SquareFunc {
+  template <typename V>
+  V operator()(const V &x) const {
+    return x * x;
+  }
+};
+
+struct SqrtFunc {
+  template <typename V>
+  V operator()(const V &x) const {
+    return LaneWise(x, [](auto lane) { return static_cast<decltype(lane)>(std::sqrt(lane)); });
+  }
+};
+
+// Broadcast of two inputs to the output, the dims of the same broadcast pattern are merged. The last merged dim is
+// computed by the simd loops, the others are walked by counters.
+struct BroadcastPlan {
+  std::vector<size_t> outer_shape;
+  std::vector<size_t> outer_strides0;
+  std::vector<size_t> outer_strides1;
+  size_t outer_count{1};
+  size_t inner_size{1};
+  // 1 if the input has the inner dim, 0 if it is broadcast along it
+  size_t inner_step0{1};
+  size_t inner_step1{1};
+  size_t output_size{1};
+};
+
+class ElementwiseEngine {
+ public:
+  // Plan the numpy style broadcast of shape0 with shape1, false if they can not broadcast.
+  static bool InitBroadcastPlan(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1,
+                                BroadcastPlan *plan);
+
+  // output[i] = op(input[i]) for i in [0, count).
+  template <typename T, typename Op>
+  static void Unary(const T *input, T *output, size_t count, const Op &op) {
+    CPUKernelUtils::ParallelFor(
+      [input, output, &op](size_t start, size_t end) { UnarySpan(input + start, output + start, end - start, op); },
+      count, kElementwiseGrainSize);
+  }
+
+  // output = op(input0, input1) broadcast as planned.
+  template <typename T, typename Op>
+  static void Binary(const BroadcastPlan &plan, const T *input0, const T *input1, T *output, const Op &op) {
+    if (plan.outer_count == 1) {
+      auto task = [&plan, input0, input1, output, &op](size_t start, size_t end) {
+        BinarySpan(input0 + start * plan.inner_step0, plan.inner_step0, input1 + start * plan.inner_step1,
+                   plan.inner_step1, output + start, end - start, op);
+      };
+      CPUKernelUtils::ParallelFor(task, plan.inner_size, kElementwiseGrainSize);
+      return;
+    }
+    auto task = [&plan, input0, input1, output, &op](size_t start, size_t end) {
+      size_t rank = plan.outer_shape.size();
+      std::vector<size_t> index(rank, 0);
+      size_t offset0 = 0;
+      size_t offset1 = 0;
+      for (size_t dim = rank, rest = start; dim > 0; --dim) {
+        index[dim - 1] = rest % plan.outer_shape[dim - 1];
+        rest /= plan.outer_shape[dim - 1];
+        offset0 += index[dim - 1] * plan.outer_strides0[dim - 1];
+        offset1 += index[dim - 1] * plan.outer_strides1[dim - 1];
+      }
+      for (size_t row = start; row < end; ++row) {
+        BinarySpan(input0 + offset0, plan.inner_step0, input1 + offset1, plan.inner_step1,
+                   output + row * plan.inner_size, plan.inner_size, op);
+        for (size_t dim = rank; dim > 0; --dim) {
+          offset0 += plan.outer_strides0[dim - 1];
+          offset1 += plan.outer_strides1[dim - 1];
+          if (++index[dim - 1] < plan.outer_shape[dim - 1]) {
+            break;
+          }
+          offset0 -= plan.outer_strides0[dim - 1] * plan.outer_shape[dim - 1];
+          offset1 -= plan.outer_strides1[dim - 1] * plan.outer_shape[dim - 1];
+          index[dim - 1] = 0;
+        }
+      }
+    };
+    CPUKernelUtils::ParallelFor(task, plan.outer_count, kElementwiseGrainSize / std::max<size_t>(plan.inner_size, 1));
+  }
+
+ private:
+  template <typename T, typename Op>
+  static void UnarySpan(const T *input, T *output, size_t count, const Op &op) {
+    if constexpr (std::is_same<T, float16>::value) {
+      float input_block[kHalfBlockSize];
+      float output_block[kHalfBlockSize];
+      for (size_t start = 0; start < count; start += kHalfBlockSize) {
+        size_t block_size = std::min(kHalfBlockSize, count - start);
+        for (size_t i = 0; i < block_size; ++i) {
+          input_block[i] = static_cast<float>(input[start + i]);
+        }
+        UnarySpan(input_block, output_block, block_size, op);
+        for (size_t i = 0; i < block_size; ++i) {
+          output[start + i] = float16(output_block[i]);
+        }
+      }
+    } else {
+      using Simd = SimdVector<T>;
+      size_t i = 0;
+      for (; i + Simd::kLanes <= count; i += Simd::kLanes) {
+        Simd::Store(output + i, op(Simd::Load(input + i)));
+      }
+      for (; i < count; ++i) {
+        output[i] = op(input[i]);
+      }
+    }
+  }
+
+  // step is 1 for an input of count elements, 0 for a single element broadcast to count.
+  template <typename T, typename Op>
+  static void BinarySpan(const T *input0, size_t step0, const T *input1, size_t step1, T *output, size_t count,
+                         const Op &op) {
+    if constexpr (std::is_same<T, float16>::value) {
+      float input0_block[kHalfBlockSize];
+      float input1_block[kHalfBlockSize];
+      float output_block[kHalfBlockSize];
+      for (size_t start = 0; start < count; start += kHalfBlockSize) {
+        size_t block_size = std::min(kHalfBlockSize, count - start);
+        for (size_t i = 0; i < (step0 == 0 ? 1 : block_size); ++i) {
+          input0_block[i] = static_cast<float>(input0[(start + i) * step0]);
+        }
+        for (size_t i = 0; i < (step1 == 0 ? 1 : block_size); ++i) {
+          input1_block[i] = static_cast<float>(input1[(start + i) * step1]);
+        }
+        BinarySpan(input0_block, step0, input1_block, step1, output_block, block_size, op);
+        for (size_t i = 0; i < block_size; ++i) {
+          output[start + i] = float16(output_block[i]);
+        }
+      }
+    } else {
+      using Simd = SimdVector<T>;
+      size_t i = 0;
+      if (step0 == 1 && step1 == 1) {
+        for (; i + Simd::kLanes <= count; i += Simd::kLanes) {
+          Simd::Store(output + i, op(Simd::Load(input0 + i), Simd::Load(input1 + i)));
+        }
+      } else if (step0 == 1) {
+        auto value1 = Simd::Broadcast(*input1);
+        for (; i + Simd::kLanes <= count; i += Simd::kLanes) {
+          Simd::Store(output + i, op(Simd::Load(input0 + i), value1));
+        }
+      } else if (step1 == 1) {
+        auto value0 = Simd::Broadcast(*input0);
+        for (; i + Simd::kLanes <= count; i += Simd::kLanes) {
+          Simd::Store(output + i, op(value0, Simd::Load(input1 + i)));
+        }
+      }
+      for (; i < count; ++i) {
+        output[i] = op(input0[i * step0], input1[i * step1]);
+      }
+    }
+  }
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_ENGINE_H_
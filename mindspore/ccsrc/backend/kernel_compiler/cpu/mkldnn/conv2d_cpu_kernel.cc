@@ -68,15 +68,42 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
-  dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+  bool blocked_input = IsBlockedInput(kernel_node);
+  bool blocked_output = IsBlockedOutput(kernel_node);
+  if (!blocked_input && !blocked_output) {
+    dnnl::convolution_forward::desc desc =
+      dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
+                                      weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
 
+    auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
+    AddArgument(DNNL_ARG_SRC, src_desc);
+    AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+    AddArgument(DNNL_ARG_DST, dst_desc);
+    return;
+  }
+  // let mkldnn choose the layouts it runs fastest in, reorder the inputs and outputs which are not in them
+  auto any_desc = [](const dnnl::memory::desc &mem_desc) {
+    return dnnl::memory::desc(mem_desc.dims(), dnnl::memory::data_type::f32, dnnl::memory::format_tag::any);
+  };
+  dnnl::convolution_forward::desc desc = dnnl::convolution_forward::desc(
+    dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, any_desc(src_desc), any_desc(weights_desc),
+    any_desc(dst_desc), strides, dilates, padding_l, padding_r);
   auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  AddReorderArgument(DNNL_ARG_SRC, prim_desc.src_desc(), blocked_input ? GetBlockedMemDesc(src_shape) : src_desc,
+                     true);
+  AddReorderArgument(DNNL_ARG_WEIGHTS, prim_desc.weights_desc(), weights_desc, true);
+  if (IsReadOnlyWeight(kernel_node)) {
+    KeepReorderedInput(DNNL_ARG_WEIGHTS);
+  }
+  if (blocked_output) {
+    dnnl::memory::desc blocked_dst_desc = GetBlockedMemDesc(dst_shape);
+    AddReorderArgument(DNNL_ARG_DST, prim_desc.dst_desc(), blocked_dst_desc, false);
+    blocked_output_size_ = blocked_dst_desc.get_size();
+  } else {
+    AddReorderArgument(DNNL_ARG_DST, prim_desc.dst_desc(), dst_desc, false);
+  }
 }
 
 bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -18,6 +18,7 @@
 #include <string>
 #include <algorithm>
 #include "utils/ms_utils.h"
+#include "utils/utils.h"
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
 
 namespace mindspore {
@@ -87,18 +88,103 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+void MKLCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  if (blocked_output_size_ > 0 && !output_size_list_.empty()) {
+    output_size_list_[0] = blocked_output_size_;
+  }
+}
+
+bool MKLCPUKernel::IsBlockedInput(const CNodePtr &kernel_node) const {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (!AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedInput, kernel_node) ||
+      !AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrMkldnnBlockedInput)) {
+    return false;
+  }
+  return MKLKernelEngine::Get().blocked_format_tag() != dnnl::memory::format_tag::undef;
+}
+
+bool MKLCPUKernel::IsBlockedOutput(const CNodePtr &kernel_node) const {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (!AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedOutput, kernel_node) ||
+      !AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrMkldnnBlockedOutput)) {
+    return false;
+  }
+  return MKLKernelEngine::Get().blocked_format_tag() != dnnl::memory::format_tag::undef;
+}
+
+bool MKLCPUKernel::IsReadOnlyWeight(const CNodePtr &kernel_node) const {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  return AnfAlgo::HasNodeAttr(kAttrMkldnnReadOnlyWeight, kernel_node) &&
+         AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrMkldnnReadOnlyWeight);
+}
+
+dnnl::memory::desc MKLCPUKernel::GetBlockedMemDesc(const std::vector<size_t> &shape) const {
+  if (shape.size() != 4) {
+    MS_LOG(EXCEPTION) << "blocked layout only support 4d, but got " << shape.size() << "d";
+  }
+  dnnl::memory::dims dims;
+  dims.insert(dims.end(), shape.begin(), shape.end());
+  return dnnl::memory::desc(dims, dnnl::memory::data_type::f32, MKLKernelEngine::Get().blocked_format_tag());
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
 
+void MKLCPUKernel::AddReorderArgument(int arg_key, const dnnl::memory::desc &prim_desc,
+                                      const dnnl::memory::desc &io_desc, bool is_input) {
+  if (prim_desc == io_desc) {
+    AddArgument(arg_key, io_desc);
+    return;
+  }
+  AddArgument(arg_key, prim_desc, true);
+  auto &engine = MKLKernelEngine::Get();
+  auto reorder = is_input ? engine.GetReorder(io_desc, prim_desc) : engine.GetReorder(prim_desc, io_desc);
+  reorder_arguments_[arg_key] = {engine.CreateMemory(io_desc), reorder, is_input};
+}
+
+void MKLCPUKernel::KeepReorderedInput(int arg_key) {
+  auto reorder_iter = reorder_arguments_.find(arg_key);
+  if (reorder_iter != reorder_arguments_.end() && reorder_iter->second.is_input) {
+    reorder_iter->second.keep = true;
+  }
+}
+
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  auto reorder_iter = reorder_arguments_.find(arg_key);
+  if (reorder_iter != reorder_arguments_.end()) {
+    reorder_iter->second.io_mem.set_data_handle(ptr);
+    return;
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
   }
 }
 
-void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+void MKLCPUKernel::ExecutePrimitive() {
+  auto &engine = MKLKernelEngine::Get();
+  for (auto &[arg_key, reorder_arg] : reorder_arguments_) {
+    if (!reorder_arg.is_input) {
+      continue;
+    }
+    void *handle = reorder_arg.io_mem.get_data_handle();
+    uint64_t version = engine.weights_version();
+    if (reorder_arg.keep && handle == reorder_arg.kept_handle && version == reorder_arg.kept_version) {
+      continue;
+    }
+    engine.Execute(reorder_arg.reorder, {{DNNL_ARG_FROM, reorder_arg.io_mem}, {DNNL_ARG_TO, arguments_[arg_key]}});
+    reorder_arg.kept_handle = handle;
+    reorder_arg.kept_version = version;
+  }
+  engine.Execute(primitive_, arguments_);
+  for (auto &[arg_key, reorder_arg] : reorder_arguments_) {
+    if (!reorder_arg.is_input) {
+      engine.Execute(reorder_arg.reorder, {{DNNL_ARG_FROM, arguments_[arg_key]}, {DNNL_ARG_TO, reorder_arg.io_mem}});
+    }
+  }
+}
 
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
@@ -32,6 +32,7 @@ class MKLCPUKernel : public CPUKernel {
   ~MKLCPUKernel() override = default;
 
  protected:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
   void GetPadding(const CNodePtr &kernel_node, const std::string &pad_mode, const std::vector<size_t> &src_shape,
                   const std::vector<size_t> &kernel_size, int stride, std::vector<int> *padding_l,
                   std::vector<int> *padding_r);
@@ -39,8 +40,34 @@ class MKLCPUKernel : public CPUKernel {
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // Whether the input 0 or the output 0 of the kernel is kept in the mkldnn blocked layout, see
+  // opt::MkldnnLayoutPropagation.
+  bool IsBlockedInput(const CNodePtr &kernel_node) const;
+  bool IsBlockedOutput(const CNodePtr &kernel_node) const;
+  dnnl::memory::desc GetBlockedMemDesc(const std::vector<size_t> &shape) const;
+  // Whether the weight input of the kernel is read by no other kernel of the graph, see opt::MkldnnLayoutPropagation.
+  bool IsReadOnlyWeight(const CNodePtr &kernel_node) const;
+  // Adds an argument the primitive reads or writes in prim_desc while the kernel input or output is in io_desc, the
+  // argument is reordered from the input or to the output around the primitive if the layouts differ.
+  void AddReorderArgument(int arg_key, const dnnl::memory::desc &prim_desc, const dnnl::memory::desc &io_desc,
+                          bool is_input);
+  // Keeps the reordered input between launches while the input address and the weights version of MKLKernelEngine
+  // are unchanged, for the weights no kernel writes.
+  void KeepReorderedInput(int arg_key);
   void ExecutePrimitive();
   std::unordered_map<int, dnnl::memory> arguments_;
+  // The kernel inputs and outputs of the reordered arguments.
+  struct ReorderArgument {
+    dnnl::memory io_mem;
+    std::shared_ptr<dnnl::primitive> reorder;
+    bool is_input;
+    bool keep{false};
+    void *kept_handle{nullptr};
+    uint64_t kept_version{0};
+  };
+  std::unordered_map<int, ReorderArgument> reorder_arguments_;
+  // Size of the output 0 in the blocked layout, 0 if the output is in the default layout.
+  size_t blocked_output_size_{0};
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
   inline dnnl::memory::desc formatted_md(const dnnl::memory::dims &dimensions, dnnl::memory::format_tag layout) {
     return dnnl::memory::desc{{dimensions}, dnnl::memory::data_type::f32, layout};
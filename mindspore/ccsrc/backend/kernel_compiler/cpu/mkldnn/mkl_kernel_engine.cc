@@ -22,8 +22,10 @@ namespace kernel {
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  // graphs of different sessions run on several executor threads at once, a stream must not be shared by them
+  thread_local dnnl::stream stream(engine_);
+  primitive->execute(stream, arguments);
+  (void)stream.wait();
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -34,7 +36,62 @@ dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, b
   }
 }
 void MKLKernelEngine::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
-  dnnl::reorder(*src_mem, *dst_mem).execute(stream_, *src_mem, *dst_mem);
+  MS_EXCEPTION_IF_NULL(src_mem);
+  MS_EXCEPTION_IF_NULL(dst_mem);
+  auto reorder = GetReorder(src_mem->get_desc(), dst_mem->get_desc());
+  Execute(reorder, {{DNNL_ARG_FROM, *src_mem}, {DNNL_ARG_TO, *dst_mem}});
+}
+
+std::shared_ptr<dnnl::primitive> MKLKernelEngine::GetReorder(const dnnl::memory::desc &src_desc,
+                                                              const dnnl::memory::desc &dst_desc) {
+  std::lock_guard<std::mutex> lock(reorder_mutex_);
+  for (auto &[cached_src_desc, cached_dst_desc, reorder] : reorders_) {
+    if (cached_src_desc == src_desc && cached_dst_desc == dst_desc) {
+      return reorder;
+    }
+  }
+  auto prim_desc = dnnl::reorder::primitive_desc(engine_, src_desc, engine_, dst_desc);
+  std::shared_ptr<dnnl::primitive> reorder = std::make_shared<dnnl::reorder>(prim_desc);
+  reorders_.emplace_back(src_desc, dst_desc, reorder);
+  return reorder;
+}
+
+void MKLKernelEngine::OnRunGraph(const void *graph, bool same_weights) {
+  std::lock_guard<std::mutex> lock(run_graph_mutex_);
+  if (graph != last_graph_ || !same_weights) {
+    last_graph_ = graph;
+    weights_version_++;
+  }
+}
+
+dnnl::memory::format_tag MKLKernelEngine::blocked_format_tag() {
+  std::call_once(blocked_format_flag_, [this]() {
+    blocked_format_tag_ = QueryBlockedFormatTag();
+    MS_LOG(INFO) << "Blocked mkldnn format tag " << static_cast<int>(blocked_format_tag_);
+  });
+  return blocked_format_tag_;
+}
+
+dnnl::memory::format_tag MKLKernelEngine::QueryBlockedFormatTag() const {
+  // let mkldnn choose the layouts of a typical convolution
+  const dnnl::memory::dim batch = 1;
+  const dnnl::memory::dim channel = 64;
+  const dnnl::memory::dim size = 28;
+  const dnnl::memory::dim kernel_size = 3;
+  auto any_desc = [](const dnnl::memory::dims &dims) {
+    return dnnl::memory::desc(dims, dnnl::memory::data_type::f32, dnnl::memory::format_tag::any);
+  };
+  dnnl::memory::dims data_dims{batch, channel, size, size};
+  auto desc = dnnl::convolution_forward::desc(
+    dnnl::prop_kind::forward_inference, dnnl::algorithm::convolution_direct, any_desc(data_dims),
+    any_desc({channel, channel, kernel_size, kernel_size}), any_desc(data_dims), {1, 1}, {1, 1}, {1, 1});
+  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, engine_);
+  for (auto tag : {dnnl::memory::format_tag::nChw16c, dnnl::memory::format_tag::nChw8c}) {
+    if (prim_desc.src_desc() == dnnl::memory::desc(data_dims, dnnl::memory::data_type::f32, tag)) {
+      return tag;
+    }
+  }
+  return dnnl::memory::format_tag::undef;
 }
 }  // namespace kernel
 }  // namespace mindspore
@@ -22,6 +22,9 @@
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <tuple>
 #include "dnnl.hpp"
 #include "utils/ms_utils.h"
 
@@ -42,12 +45,28 @@ class MKLKernelEngine {
   void Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                const std::unordered_map<int, dnnl::memory> &arguments);
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
+  // The reorder primitives are shared by all the kernels reordering between the same layouts.
+  std::shared_ptr<dnnl::primitive> GetReorder(const dnnl::memory::desc &src_desc, const dnnl::memory::desc &dst_desc);
+  // The channel blocked layout, nChw8c or nChw16c, the convolutions of the cpu run fastest in, undef if they prefer
+  // the plain layout.
+  dnnl::memory::format_tag blocked_format_tag();
+  // The weights a kernel reordered are still valid while the version is unchanged. The version changes once another
+  // graph runs, or the same graph runs with other weight tensors, as the weights may be written or rebound then.
+  void OnRunGraph(const void *graph, bool same_weights);
+  uint64_t weights_version() const { return weights_version_; }
 
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0) {}
   ~MKLKernelEngine() = default;
+  dnnl::memory::format_tag QueryBlockedFormatTag() const;
   dnnl::engine engine_;
-  dnnl::stream stream_;
+  std::mutex reorder_mutex_;
+  std::vector<std::tuple<dnnl::memory::desc, dnnl::memory::desc, std::shared_ptr<dnnl::primitive>>> reorders_;
+  std::once_flag blocked_format_flag_;
+  dnnl::memory::format_tag blocked_format_tag_{dnnl::memory::format_tag::undef};
+  std::mutex run_graph_mutex_;
+  const void *last_graph_{nullptr};
+  std::atomic<uint64_t> weights_version_{0};
 };
 }  // namespace kernel
 }  // namespace mindspore
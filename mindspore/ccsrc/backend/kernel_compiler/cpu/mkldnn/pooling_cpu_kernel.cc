@@ -26,8 +26,12 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  // pooling runs in the layout of its input, the output is reordered if it is expected in another layout
+  bool blocked_input = IsBlockedInput(kernel_node);
+  bool blocked_output = IsBlockedOutput(kernel_node);
+  dnnl::memory::desc src_desc = blocked_input ? GetBlockedMemDesc(src_shape) : GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc dst_desc = blocked_input ? GetBlockedMemDesc(dst_shape) : GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc io_dst_desc = blocked_output ? GetBlockedMemDesc(dst_shape) : GetDefaultMemDesc(dst_shape);
   std::vector<int> origin_kernel_sizes = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, KSIZE);
   std::vector<int> strides = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDES);
   if (origin_kernel_sizes.size() != 4 || strides.size() != 4) {
@@ -51,7 +55,10 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::pooling_forward>(prim_desc);
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  AddReorderArgument(DNNL_ARG_DST, dst_desc, io_dst_desc, false);
+  if (blocked_output) {
+    blocked_output_size_ = io_dst_desc.get_size();
+  }
   AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
 }
 
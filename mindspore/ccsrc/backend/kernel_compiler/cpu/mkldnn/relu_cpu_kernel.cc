@@ -27,7 +27,9 @@ void ReluCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (src_shape.size() != 4 && src_shape.size() != 2) {
     MS_LOG(EXCEPTION) << "relu kernel dims invalid " << src_shape.size();
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  // relu runs in the layout of its input, keeps the output in the default layout unless it is blocked too
+  bool blocked_input = IsBlockedInput(kernel_node);
+  dnnl::memory::desc src_desc = blocked_input ? GetBlockedMemDesc(src_shape) : GetDefaultMemDesc(src_shape);
 
   dnnl::eltwise_forward::desc desc =
     dnnl::eltwise_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::eltwise_relu, src_desc, 0.0);
@@ -41,7 +43,13 @@ void ReluCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   primitive_ = std::make_shared<dnnl::eltwise_forward>(prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, src_desc);
+  if (IsBlockedOutput(kernel_node)) {
+    dnnl::memory::desc blocked_dst_desc = GetBlockedMemDesc(src_shape);
+    AddReorderArgument(DNNL_ARG_DST, src_desc, blocked_dst_desc, false);
+    blocked_output_size_ = blocked_dst_desc.get_size();
+  } else {
+    AddReorderArgument(DNNL_ARG_DST, src_desc, GetDefaultMemDesc(src_shape), false);
+  }
 }
 
 bool ReluCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/optimizer/cpu/mkldnn_layout_propagation.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "base/core_ops.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kBlockedDims = 4;
+constexpr size_t kSummaryInputIndex = 2;
+constexpr size_t kConvWeightInputIndex = 2;
+
+bool IsSummaryNode(const AnfNodePtr &node) {
+  return IsPrimitiveCNode(node, prim::kPrimScalarSummary) || IsPrimitiveCNode(node, prim::kPrimTensorSummary) ||
+         IsPrimitiveCNode(node, prim::kPrimImageSummary) || IsPrimitiveCNode(node, prim::kPrimHistogramSummary);
+}
+
+bool IsBlockedLayoutKernel(const AnfNodePtr &node) {
+  if (!IsPrimitiveCNode(node, prim::kPrimConv2D) && !IsPrimitiveCNode(node, prim::kPrimRelu) &&
+      !IsPrimitiveCNode(node, prim::kPrimMaxPool)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  if (AnfAlgo::GetOutputTensorNum(cnode) != 1 || AnfAlgo::GetInputTensorNum(cnode) < 1) {
+    return false;
+  }
+  return AnfAlgo::GetOutputDeviceShape(cnode, 0).size() == kBlockedDims &&
+         AnfAlgo::GetInputDeviceShape(cnode, 0).size() == kBlockedDims &&
+         AnfAlgo::GetOutputDeviceDataType(cnode, 0) == kNumberTypeFloat32 &&
+         AnfAlgo::GetInputDeviceDataType(cnode, 0) == kNumberTypeFloat32;
+}
+}  // namespace
+
+bool MkldnnLayoutPropagation::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  std::vector<AnfNodePtr> node_list = TopoSort(graph->get_return());
+  std::unordered_map<AnfNodePtr, size_t> use_count;
+  // Summary nodes read the device memory of the kernel behind their input, which must stay in the default layout.
+  std::unordered_set<AnfNodePtr> summary_read;
+  for (auto &node : node_list) {
+    if (node == nullptr || !node->isa<CNode>()) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    for (auto &input : cnode->inputs()) {
+      use_count[input]++;
+    }
+    if (IsSummaryNode(cnode) && cnode->inputs().size() > kSummaryInputIndex) {
+      (void)summary_read.insert(AnfAlgo::VisitKernelWithReturnType(cnode->input(kSummaryInputIndex), 0, true).first);
+    }
+  }
+  auto kernel_graph = graph->cast<KernelGraphPtr>();
+  bool changed = false;
+  for (auto &node : node_list) {
+    if (node == nullptr || !IsBlockedLayoutKernel(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    // A weight only the convolution reads is written by no kernel of the graph, its reorder is kept between launches.
+    if (IsPrimitiveCNode(cnode, prim::kPrimConv2D) && cnode->inputs().size() > kConvWeightInputIndex) {
+      auto weight = cnode->input(kConvWeightInputIndex)->cast<ParameterPtr>();
+      if (weight != nullptr && AnfAlgo::IsParameterWeight(weight) && use_count[weight] == 1) {
+        AnfAlgo::SetNodeAttr(kAttrMkldnnReadOnlyWeight, MakeValue(true), cnode);
+        changed = true;
+      }
+    }
+    auto producer = cnode->input(1);
+    if (!IsBlockedLayoutKernel(producer) || use_count[producer] != 1 || summary_read.count(producer) != 0) {
+      continue;
+    }
+    // Internal outputs are handed to the next graph as they are, so they keep the default layout as well.
+    if (kernel_graph != nullptr && kernel_graph->IsInternalOutput(producer, 0)) {
+      continue;
+    }
+    AnfAlgo::SetNodeAttr(kAttrMkldnnBlockedOutput, MakeValue(true), producer);
+    AnfAlgo::SetNodeAttr(kAttrMkldnnBlockedInput, MakeValue(true), cnode);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
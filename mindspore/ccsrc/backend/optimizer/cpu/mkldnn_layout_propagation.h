@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MKLDNN_LAYOUT_PROPAGATION_H_
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MKLDNN_LAYOUT_PROPAGATION_H_
+#include "backend/optimizer/common/pass.h"
+#include "ir/func_graph.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Keeps the tensors passed between the mkldnn convolution, relu and pooling kernels in the mkldnn channel blocked
+// layout, so they are not reordered to the default layout and back between the kernels. A tensor is kept blocked only
+// if it is the first input of its single user, the other tensors stay in the default layout. The convolutions whose
+// weight is read by no other kernel are marked to keep the weight reordered to the blocked layout between launches.
+class MkldnnLayoutPropagation : public Pass {
+ public:
+  MkldnnLayoutPropagation() : Pass("mkldnn_layout_propagation") {}
+  ~MkldnnLayoutPropagation() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_MKLDNN_LAYOUT_PROPAGATION_H_
@@ -17,6 +17,7 @@
 #include "backend/session/cpu_session.h"
 #include <algorithm>
 #include <sstream>
+#include <utility>
 #include "ir/anf.h"
 #include "utils/ms_utils.h"
 #include "backend/session/anf_runtime_algorithm.h"
@@ -26,12 +27,17 @@
 #include "backend/optimizer/common/optimizer.h"
 #include "backend/optimizer/common/pass_manager.h"
 #include "backend/optimizer/pass/replace_node_by_proxy.h"
+#include "backend/optimizer/cpu/mkldnn_layout_propagation.h"
+#include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#include "utils/convert_utils.h"
 #if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
 #include "frontend/parallel/ps/util.h"
 #endif
 
 namespace mindspore {
 namespace session {
+CPUSession::~CPUSession() { MS_LOG(INFO) << run_op_graph_cache_.Statistics(); }
+
 ParameterPtr CPUSession::CreateNewParameterFromParameter(const AnfNodePtr &anf, KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(anf);
   MS_EXCEPTION_IF_NULL(graph);
@@ -61,6 +67,14 @@ void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
   kernel_graph->SetExecOrderByDefault();
 }
 
+void CPUSession::PropagateLayout(const std::shared_ptr<KernelGraph> &kernel_graph) {
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>("cpu_layout_pm");
+  pm->AddPass(std::make_shared<opt::MkldnnLayoutPropagation>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+}
+
 GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) {
   auto graph_id = graph_sum_;
   auto graph = ConstructKernelGraph(lst, outputs);
@@ -73,6 +87,8 @@ GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
     Optimize(graph);
   }
 #endif
+  MS_LOG(INFO) << "Propagate layout";
+  PropagateLayout(graph);
   MS_LOG(INFO) << "Build kernel";
   BuildKernel(graph.get());
   MS_LOG(INFO) << "Assign kernel address";
@@ -110,6 +126,7 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
     runtime_.IncreaseSummaryRefCount(summary_outputs);
   }
 
+  UpdateWeightsVersion(kernel_graph.get(), inputs);
   bool ret = runtime_.Run(kernel_graph.get(), false);
   if (!ret) {
     MS_LOG(EXCEPTION) << "Run graph failed";
@@ -123,6 +140,74 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
   MS_LOG(INFO) << "Run graph end";
 }
 
+void CPUSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+                         const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask) {
+  // Check if the graph cache exists.
+  if (run_op_graph_cache_.Get(graph_info) != nullptr) {
+    return;
+  }
+  // Prepare the graph
+  auto kernel_graph = ConstructSingleOpGraph(op_run_info, input_tensors, tensors_mask);
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  SetKernelInfo(kernel_graph.get());
+  BuildKernel(kernel_graph.get());
+  runtime_.AssignKernelAddress(kernel_graph.get());
+  run_op_graph_cache_.Put(graph_info, kernel_graph);
+  MS_LOG(DEBUG) << "Build op " << op_run_info.op_name << ", " << run_op_graph_cache_.Statistics();
+}
+
+void CPUSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+                       const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  auto kernel_graph = run_op_graph_cache_.Find(graph_info);
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  // the graph is bound to the input tensors of this run only, they keep their own device addresses
+  std::vector<DeviceSyncPtr> input_addresses;
+  for (auto &input_tensor : input_tensors) {
+    MS_EXCEPTION_IF_NULL(input_tensor);
+    input_addresses.push_back(input_tensor->device_address());
+  }
+  VectorRef op_outputs;
+  runtime_.BindInputOutput(kernel_graph.get(), input_tensors, &op_outputs);
+  // a single op may write any weight
+  kernel::MKLKernelEngine::Get().OnRunGraph(kernel_graph.get(), false);
+  bool ret = runtime_.Run(kernel_graph.get(), false);
+  runtime_.ReleaseRunOpMemory(kernel_graph.get(), op_outputs);
+  for (size_t i = 0; i < input_tensors.size(); ++i) {
+    input_tensors[i]->set_device_address(input_addresses[i]);
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Run op " << op_run_info.op_name << " failed";
+  }
+  // Fetch outputs
+  if (op_run_info.value != nullptr) {
+    std::vector<tensor::TensorPtr> pre_output_tensors;
+    TensorValueToTensor(op_run_info.value, &pre_output_tensors);
+    for (auto &pre_output : pre_output_tensors) {
+      MS_EXCEPTION_IF_NULL(pre_output);
+      tensor::TensorPtr tensor = std::make_shared<tensor::Tensor>(*pre_output);
+      tensor->set_sync_status(kNoNeedSync);
+      outputs->emplace_back(tensor);
+    }
+  } else {
+    *outputs = op_outputs;
+  }
+}
+
+void CPUSession::UpdateWeightsVersion(const KernelGraph *kernel_graph, const std::vector<tensor::TensorPtr> &inputs) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  std::vector<tensor::TensorPtr> weights;
+  auto &input_nodes = kernel_graph->inputs();
+  for (size_t i = 0; i < input_nodes.size() && i < inputs.size(); ++i) {
+    auto param = input_nodes[i]->cast<ParameterPtr>();
+    if (param != nullptr && AnfAlgo::IsParameterWeight(param)) {
+      weights.push_back(inputs[i]);
+    }
+  }
+  kernel::MKLKernelEngine::Get().OnRunGraph(kernel_graph, weights == last_run_weights_);
+  last_run_weights_ = std::move(weights);
+}
+
 void CPUSession::SetKernelInfo(const KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   auto &kernel_nodes = kernel_graph->execution_order();
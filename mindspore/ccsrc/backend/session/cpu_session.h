@@ -23,27 +23,39 @@
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/cpu/cpu_kernel_runtime.h"
 #include "backend/session/session_factory.h"
+#include "backend/session/single_op_graph_cache.h"
 namespace mindspore {
 namespace session {
 class CPUSession : public SessionBasic {
  public:
-  CPUSession() = default;
-  ~CPUSession() override = default;
+  CPUSession() : run_op_graph_cache_(SingleOpGraphCache::GetCapacityFromEnv()) {}
+  ~CPUSession() override;
   void Init(uint32_t device_id) override { InitDevice(kCPUDevice, device_id); }
   GraphId CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) override;
   void RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) override;
 
   void CreateOutputTensors(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *,
                            std::map<tensor::TensorPtr, session::KernelWithIndex> *tensor_to_node) override;
+  void BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+               const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask) override;
+  void RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info,
+             const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs) override;
 
  protected:
   ParameterPtr CreateNewParameterFromParameter(const AnfNodePtr &anf, KernelGraph *graph) override;
   void Optimize(const std::shared_ptr<KernelGraph> &kernel_graph);
+  // Keeps the tensors between the mkldnn kernels in the blocked layout, see opt::MkldnnLayoutPropagation.
+  void PropagateLayout(const std::shared_ptr<KernelGraph> &kernel_graph);
 
  private:
   void SetKernelInfo(const KernelGraph *kernel_graph);
   void BuildKernel(const KernelGraph *kernel_graph);
+  // Tells the mkldnn kernels whether the weights they reordered in the last run are still valid.
+  void UpdateWeightsVersion(const KernelGraph *kernel_graph, const std::vector<tensor::TensorPtr> &inputs);
   device::cpu::CPUKernelRuntime runtime_;
+  SingleOpGraphCache run_op_graph_cache_;
+  // The weight tensors of the last run graph, held so a new weight tensor can not take their memory.
+  std::vector<tensor::TensorPtr> last_run_weights_;
 };
 MS_REG_SESSION(kCPUDevice, CPUSession);
 }  // namespace session
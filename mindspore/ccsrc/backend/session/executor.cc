@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 #include "backend/session/executor.h"
+#include <algorithm>
+#include <cstdlib>
 #include "runtime/device/kernel_runtime_manager.h"
 #include "backend/session/executor_manager.h"
 #include "utils/comm_manager.h"
 #include "utils/scoped_long_running.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 namespace session {
@@ -48,7 +51,56 @@ void UpdateOutputTensors(const VectorRef *outputs,
     }
   }
 }
+
+void CollectOutputTensors(const VectorRef *outputs, std::set<tensor::TensorPtr> *tensors) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  MS_EXCEPTION_IF_NULL(tensors);
+  for (auto item : *outputs) {
+    if (utils::isa<VectorRefPtr>(item)) {
+      auto vector_ref = utils::cast<VectorRef>(item);
+      CollectOutputTensors(&vector_ref, tensors);
+    } else if (utils::isa<tensor::TensorPtr>(item)) {
+      (void)tensors->insert(utils::cast<tensor::TensorPtr>(item));
+    }
+  }
+}
+
+// Wake up the waiters of the outputs of a failed graph, the failure is reported by the next call to the executor.
+void ReleaseOutputTensors(const VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  for (auto item : *outputs) {
+    if (utils::isa<VectorRefPtr>(item)) {
+      auto vector_ref = utils::cast<VectorRef>(item);
+      ReleaseOutputTensors(&vector_ref);
+    } else if (utils::isa<tensor::TensorPtr>(item)) {
+      auto tensor = utils::cast<tensor::TensorPtr>(item);
+      MS_EXCEPTION_IF_NULL(tensor);
+      tensor->SetNeedWait(false);
+    }
+  }
+}
+
+size_t GetThreadNum(const std::string &device_name) {
+  std::string thread_num_env = common::GetEnv(kEnvExecutorThreadNum);
+  if (thread_num_env.empty()) {
+    return 1;
+  }
+  // the kernel runtimes of the other devices are bound to the thread which initializes them
+  if (device_name != kCPUDevice) {
+    MS_LOG(WARNING) << "Env " << kEnvExecutorThreadNum << " only takes effect on the CPU device, the executor of "
+                    << device_name << " uses 1 thread.";
+    return 1;
+  }
+  char *end = nullptr;
+  auto thread_num = std::strtol(thread_num_env.c_str(), &end, 10);
+  if (*end != '\0' || thread_num <= 0) {
+    MS_LOG(WARNING) << "Env " << kEnvExecutorThreadNum << " is invalid: " << thread_num_env << ", use 1 instead.";
+    return 1;
+  }
+  return static_cast<size_t>(thread_num);
+}
 }  // namespace
+
 void CompileNodesTask::Run() {
   MS_EXCEPTION_IF_NULL(session_);
   graph_id_ = session_->CompileGraph(nodes_, output_nodes_);
@@ -66,7 +118,15 @@ void BuildGraphTask::Run() {
 
 void RunGraphTask::Run() {
   MS_EXCEPTION_IF_NULL(session_);
-  session_->RunGraph(graph_id_, input_tensors_, &outputs_);
+  try {
+    session_->RunGraph(graph_id_, input_tensors_, &outputs_);
+  } catch (const std::exception &e) {
+    // the graphs waiting for the outputs fail too, the outputs are released once the failure is recorded
+    std::set<tensor::TensorPtr> failed_tensors;
+    CollectOutputTensors(&outputs_, &failed_tensors);
+    ExecutorManager::Instance().OnRunGraphFailed(std::move(failed_tensors), std::current_exception());
+    throw;
+  }
   UpdateOutputTensors(&outputs_, tensor_to_node_);
   ExecutorManager::Instance().OnRunGraphFinished();
 }
@@ -88,20 +148,33 @@ void DestroyCommGroupTask::Run() { result_ = CommManager::GetInstance().DestroyG
 Executor::Executor(const std::string &device_name, uint32_t device_id) {
   device_name_ = device_name;
   device_id_ = device_id;
-  worker_ = std::make_shared<std::thread>(&Executor::WorkerLoop, this);
+  size_t thread_num = GetThreadNum(device_name);
+  MS_LOG(INFO) << "Executor of " << device_name << " starts " << thread_num << " worker threads.";
+  for (size_t i = 0; i < thread_num; ++i) {
+    workers_.emplace_back(std::make_shared<std::thread>(&Executor::WorkerLoop, this));
+  }
 }
 
-void Executor::CheckException() {
-  if (exception_ptr_ != nullptr) {
-    auto exception_ptr = exception_ptr_;
-    exception_ptr_ = nullptr;
+void Executor::CheckException(const SessionPtr &session) {
+  std::exception_ptr exception_ptr = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    auto iter = exception_ptrs_.find(session);
+    if (iter != exception_ptrs_.end()) {
+      exception_ptr = iter->second;
+      (void)exception_ptrs_.erase(iter);
+    }
+  }
+  if (exception_ptr != nullptr) {
     std::rethrow_exception(exception_ptr);
   }
 }
 
 void Executor::WorkerJoin() {
   StopWorker();
-  worker_->join();
+  for (auto &worker : workers_) {
+    worker->join();
+  }
 }
 
 void Executor::WorkerLoop() {
@@ -109,22 +182,82 @@ void Executor::WorkerLoop() {
     std::shared_ptr<Task> task;
     {
       std::unique_lock<std::mutex> lock(task_mutex_);
-      task_cond_var_.wait(lock, [this] { return !ready_tasks_.empty(); });
-      task = ready_tasks_.front();
-      ready_tasks_.pop();
+      task_cond_var_.wait(lock, [this, &task] {
+        task = stopped_ ? nullptr : PopRunnableTask();
+        return stopped_ || task != nullptr;
+      });
+    }
+    if (task == nullptr) {
+      return;
     }
     if (task->type_ == kExit) {
       OnWorkerExit();
+      {
+        std::unique_lock<std::mutex> lock(task_mutex_);
+        stopped_ = true;
+      }
+      task_cond_var_.notify_all();
+      task->promise_.set_value();
       return;
     }
     try {
       task->Run();
+      task->promise_.set_value();
     } catch (const std::exception &e) {
-      exception_ptr_ = std::current_exception();
+      {
+        std::unique_lock<std::mutex> lock(task_mutex_);
+        auto exception_ptr = std::current_exception();
+        (void)exception_ptrs_.emplace(task->session_, exception_ptr);
+        task->promise_.set_exception(exception_ptr);
+      }
+      if (task->type_ == kRunGraph) {
+        ReleaseOutputTensors(&std::static_pointer_cast<RunGraphTask>(task)->outputs_);
+      }
+    }
+    {
+      std::unique_lock<std::mutex> lock(task_mutex_);
+      running_task_num_--;
+      sync_task_running_ = false;
+      (void)running_sessions_.erase(task->session_.get());
     }
     task = nullptr;
-    sync_cond_var_.notify_all();
+    task_cond_var_.notify_all();
+  }
+}
+
+// Called with task_mutex_ held. The tasks of a session run in the order they are queued, as the kernel runtime of a
+// session is not thread safe.
+std::shared_ptr<Task> Executor::PopRunnableTask() {
+  if (sync_task_running_) {
+    return nullptr;
   }
+  auto blocked_sessions = running_sessions_;
+  for (auto iter = ready_tasks_.begin(); iter != ready_tasks_.end(); ++iter) {
+    auto task = *iter;
+    MS_EXCEPTION_IF_NULL(task);
+    if (task->sync_run_) {
+      if (iter != ready_tasks_.begin() || running_task_num_ > 0) {
+        return nullptr;
+      }
+      sync_task_running_ = true;
+    } else if (!blocked_sessions.insert(task->session_.get()).second) {
+      continue;
+    }
+    (void)ready_tasks_.erase(iter);
+    running_task_num_++;
+    (void)running_sessions_.insert(task->session_.get());
+    return task;
+  }
+  return nullptr;
+}
+
+void Executor::SyncRunTask(const std::shared_ptr<Task> &task) {
+  {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    ready_tasks_.push_back(task);
+  }
+  task_cond_var_.notify_all();
+  task->future_.wait();
 }
 
 std::vector<std::shared_ptr<RunGraphTask>> Executor::GetNewReadyTasks() {
@@ -146,13 +279,53 @@ void Executor::OnRunGraphFinished() {
   auto new_ready_tasks = GetNewReadyTasks();
   std::unique_lock<std::mutex> lock(task_mutex_);
   for (auto &task : new_ready_tasks) {
-    ready_tasks_.push(task);
+    ready_tasks_.push_back(task);
   }
   if (new_ready_tasks.size() > 0) {
     task_cond_var_.notify_all();
   }
 }
 
+bool Executor::FailDependentTasks(std::set<tensor::TensorPtr> *failed_tensors, const std::exception_ptr &exception) {
+  MS_EXCEPTION_IF_NULL(failed_tensors);
+  std::vector<std::shared_ptr<RunGraphTask>> failed_tasks;
+  {
+    std::unique_lock<std::mutex> lock(pending_task_mutex_);
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto iter = pending_tasks_.begin(); iter != pending_tasks_.end();) {
+        auto task = *iter;
+        auto &inputs = task->input_tensors_;
+        if (std::none_of(inputs.begin(), inputs.end(),
+                         [failed_tensors](const tensor::TensorPtr &input) { return failed_tensors->count(input) > 0; })) {
+          iter++;
+          continue;
+        }
+        CollectOutputTensors(&task->outputs_, failed_tensors);
+        failed_tasks.emplace_back(task);
+        pending_tasks_.erase(iter++);
+        changed = true;
+      }
+    }
+  }
+  if (failed_tasks.empty()) {
+    return false;
+  }
+  {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    for (auto &task : failed_tasks) {
+      (void)exception_ptrs_.emplace(task->session_, exception);
+    }
+  }
+  for (auto &task : failed_tasks) {
+    MS_LOG(ERROR) << "Run graph " << task->graph_id_ << " failed as a graph it depends on failed.";
+    ReleaseOutputTensors(&task->outputs_);
+    task->promise_.set_exception(exception);
+  }
+  return true;
+}
+
 bool Executor::IsAllInputsReady(const std::vector<tensor::TensorPtr> &inputs) {
   for (auto &input : inputs) {
     MS_EXCEPTION_IF_NULL(input);
@@ -165,47 +338,38 @@ bool Executor::IsAllInputsReady(const std::vector<tensor::TensorPtr> &inputs) {
 
 GraphId Executor::CompileGraphAsync(const SessionPtr &session, const AnfNodePtrList &lst,
                                     const AnfNodePtrList &outputs) {
-  CheckException();
-  std::unique_lock<std::mutex> lock(task_mutex_);
+  CheckException(session);
   auto task = std::make_shared<CompileNodesTask>();
   task->session_ = session;
   task->nodes_ = lst;
   task->output_nodes_ = outputs;
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
-  sync_cond_var_.wait(lock);
-  CheckException();
+  SyncRunTask(task);
+  CheckException(session);
   return task->graph_id_;
 }
 
 GraphId Executor::CompileGraphAsync(const SessionPtr &session, NotNull<FuncGraphPtr> func_graph) {
-  CheckException();
-  std::unique_lock<std::mutex> lock(task_mutex_);
+  CheckException(session);
   auto task = std::make_shared<CompileGraphTask>();
   task->session_ = session;
   task->func_graph_ = func_graph;
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
-  sync_cond_var_.wait(lock);
-  CheckException();
+  SyncRunTask(task);
+  CheckException(session);
   return task->graph_id_;
 }
 
 void Executor::BuildGraphAsync(const SessionPtr &session, GraphId graphId) {
-  CheckException();
-  std::unique_lock<std::mutex> lock(task_mutex_);
+  CheckException(session);
   auto task = std::make_shared<BuildGraphTask>();
   task->session_ = session;
   task->graph_id_ = graphId;
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
-  sync_cond_var_.wait(lock);
-  CheckException();
+  SyncRunTask(task);
+  CheckException(session);
 }
 
-void Executor::RunGraphAsync(const SessionPtr &session, const GraphId &graph_id,
-                             const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) {
-  CheckException();
+std::shared_future<void> Executor::RunGraphAsync(const SessionPtr &session, const GraphId &graph_id,
+                                                 const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) {
+  CheckException(session);
   auto task = std::make_shared<RunGraphTask>();
   task->session_ = session;
   task->graph_id_ = graph_id;
@@ -216,76 +380,79 @@ void Executor::RunGraphAsync(const SessionPtr &session, const GraphId &graph_id,
   task->outputs_ = *outputs;
 
   bool ready = IsAllInputsReady(inputs);
+  if (!ready || workers_.size() > 1) {
+    // the graph runs in parallel with the frontend, the outputs are waited for when they are read
+    for (auto &item : task->tensor_to_node_) {
+      MS_EXCEPTION_IF_NULL(item.first);
+      item.first->SetNeedWait(true);
+    }
+  }
   if (!ready) {
     std::unique_lock<std::mutex> lock(pending_task_mutex_);
     pending_tasks_.push_back(task);
-    return;
+    return task->future_;
+  }
+  if (workers_.size() > 1) {
+    {
+      std::unique_lock<std::mutex> lock(task_mutex_);
+      ready_tasks_.push_back(task);
+    }
+    task_cond_var_.notify_all();
+    return task->future_;
   }
-  std::unique_lock<std::mutex> lock(task_mutex_);
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
   mindspore::ScopedLongRunning long_running;
-  sync_cond_var_.wait(lock);
-  CheckException();
+  SyncRunTask(task);
+  CheckException(session);
+  return task->future_;
 }
 
 void Executor::BuildOpAsync(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
                             const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask) {
-  CheckException();
-  std::unique_lock<std::mutex> lock(task_mutex_);
+  CheckException(session);
   auto task = std::make_shared<BuildOpTask>();
   task->session_ = session;
   task->op_run_info_ = op_run_info;
   task->graph_info_ = graph_info;
   task->input_tensors_ = input_tensors;
   task->tensors_mask_ = tensors_mask;
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
-  sync_cond_var_.wait(lock);
-  CheckException();
+  SyncRunTask(task);
+  CheckException(session);
 }
 
 void Executor::RunOpAsync(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
                           const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs) {
-  CheckException();
-  std::unique_lock<std::mutex> lock(task_mutex_);
+  CheckException(session);
   auto task = std::make_shared<RunOpTask>();
   task->session_ = session;
   task->op_run_info_ = op_run_info;
   task->graph_info_ = graph_info;
   task->input_tensors_ = input_tensors;
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
-  sync_cond_var_.wait(lock);
-  CheckException();
+  SyncRunTask(task);
+  CheckException(session);
   *outputs = task->outputs_;
 }
 
 bool Executor::CreateCommGroup(const std::string &group_name, std::vector<uint32_t> ranks) {
-  std::unique_lock<std::mutex> lock(task_mutex_);
   auto task = std::make_shared<CreateCommGroupTask>();
   task->group_name_ = group_name;
   task->ranks_ = ranks;
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
-  sync_cond_var_.wait(lock);
+  SyncRunTask(task);
   return task->result_;
 }
 
 bool Executor::DestroyCommGroup(const std::string &group_name) {
-  std::unique_lock<std::mutex> lock(task_mutex_);
   auto task = std::make_shared<DestroyCommGroupTask>();
   task->group_name_ = group_name;
-  ready_tasks_.push(task);
-  task_cond_var_.notify_all();
-  sync_cond_var_.wait(lock);
+  SyncRunTask(task);
   return task->result_;
 }
 
 void Executor::StopWorker() {
-  std::unique_lock<std::mutex> lock(task_mutex_);
   auto task = std::make_shared<ExitTask>();
-  ready_tasks_.push(task);
+  {
+    std::unique_lock<std::mutex> lock(task_mutex_);
+    ready_tasks_.push_back(task);
+  }
   task_cond_var_.notify_all();
 }
 
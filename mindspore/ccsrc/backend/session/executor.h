@@ -21,12 +21,13 @@
 #include <utility>
 #include <memory>
 #include <list>
-#include <queue>
 #include <map>
+#include <set>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <exception>
+#include <future>
 #include "backend/session/session_basic.h"
 #include "ir/anf.h"
 #include "ir/tensor.h"
@@ -36,6 +37,9 @@
 
 namespace mindspore {
 namespace session {
+// Number of the worker threads of the executor of the CPU device, 1 by default.
+constexpr char kEnvExecutorThreadNum[] = "MS_EXECUTOR_THREAD_NUM";
+
 enum TaskType {
   kUnKnown,
   kExit,
@@ -55,6 +59,11 @@ class Task {
   virtual ~Task() = default;
   SessionPtr session_{nullptr};
   TaskType type_{kUnKnown};
+  // A sync task runs alone once the tasks queued before it are done, the others run in parallel with the tasks of the
+  // other sessions.
+  bool sync_run_{true};
+  std::promise<void> promise_;
+  std::shared_future<void> future_{promise_.get_future()};
   virtual void Run() {}
 };
 
@@ -87,7 +96,10 @@ class BuildGraphTask : public Task {
 
 class RunGraphTask : public Task {
  public:
-  RunGraphTask() { type_ = kRunGraph; }
+  RunGraphTask() {
+    type_ = kRunGraph;
+    sync_run_ = false;
+  }
   ~RunGraphTask() override = default;
   void Run() override;
   std::vector<tensor::TensorPtr> input_tensors_;
@@ -109,7 +121,10 @@ class BuildOpTask : public Task {
 
 class RunOpTask : public Task {
  public:
-  RunOpTask() { type_ = kRunOp; }
+  RunOpTask() {
+    type_ = kRunOp;
+    sync_run_ = false;
+  }
   ~RunOpTask() override = default;
   void Run() override;
   OpRunInfo *op_run_info_{nullptr};
@@ -152,13 +167,16 @@ class Executor {
   GraphId CompileGraphAsync(const SessionPtr &session, const AnfNodePtrList &lst, const AnfNodePtrList &outputs);
   GraphId CompileGraphAsync(const SessionPtr &session, NotNull<FuncGraphPtr> func_graph);
   void BuildGraphAsync(const SessionPtr &session, GraphId graphId);
-  void RunGraphAsync(const SessionPtr &session, const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs,
-                     VectorRef *outputs);
+  std::shared_future<void> RunGraphAsync(const SessionPtr &session, const GraphId &graph_id,
+                                         const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs);
   void BuildOpAsync(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
                     const std::vector<tensor::TensorPtr> &input_tensors, const std::vector<int> &tensors_mask);
   void RunOpAsync(const SessionPtr &session, OpRunInfo *op_run_info, const GraphInfo &graph_info,
                   const std::vector<tensor::TensorPtr> &input_tensors, VectorRef *outputs);
   void OnRunGraphFinished();
+  // Fail the pending graphs which read any of failed_tensors, directly or through the outputs of another failed graph.
+  // The outputs of the failed graphs are added to failed_tensors. Returns false if no graph fails.
+  bool FailDependentTasks(std::set<tensor::TensorPtr> *failed_tensors, const std::exception_ptr &exception);
   bool CreateCommGroup(const std::string &group_name, std::vector<uint32_t> ranks);
   bool DestroyCommGroup(const std::string &group_name);
 
@@ -167,7 +185,9 @@ class Executor {
                            const std::map<tensor::TensorPtr, session::KernelWithIndex> &tensor_to_node);
   std::vector<std::shared_ptr<RunGraphTask>> GetNewReadyTasks();
   bool IsAllInputsReady(const std::vector<tensor::TensorPtr> &inputs);
-  void CheckException();
+  std::shared_ptr<Task> PopRunnableTask();
+  void SyncRunTask(const std::shared_ptr<Task> &task);
+  void CheckException(const SessionPtr &session);
   void StopWorker();
   void OnWorkerExit();
 
@@ -176,11 +196,17 @@ class Executor {
   std::mutex task_mutex_;
   std::mutex pending_task_mutex_;
   std::condition_variable task_cond_var_;
-  std::condition_variable sync_cond_var_;
-  std::queue<std::shared_ptr<Task>> ready_tasks_;
+  std::list<std::shared_ptr<Task>> ready_tasks_;
   std::list<std::shared_ptr<RunGraphTask>> pending_tasks_;
-  std::shared_ptr<std::thread> worker_;
-  std::exception_ptr exception_ptr_{nullptr};
+  std::set<SessionBasic *> running_sessions_;
+  size_t running_task_num_{0};
+  bool sync_task_running_{false};
+  bool stopped_{false};
+  std::vector<std::shared_ptr<std::thread>> workers_;
+  // the exception of the failed task of a session, rethrown to the next caller of the same session. Owner-based keys
+  // so that a new session allocated at the address of a released one does not see its exception.
+  std::map<std::weak_ptr<SessionBasic>, std::exception_ptr, std::owner_less<std::weak_ptr<SessionBasic>>>
+    exception_ptrs_;
 };
 }  // namespace session
 }  // namespace mindspore
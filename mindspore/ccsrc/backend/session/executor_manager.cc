@@ -37,6 +37,20 @@ void ExecutorManager::OnRunGraphFinished() {
   }
 }
 
+void ExecutorManager::OnRunGraphFailed(std::set<tensor::TensorPtr> failed_tensors, const std::exception_ptr &exception) {
+  // a graph failing in one executor may fail graphs of the executors visited before it
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto &item : executors_) {
+      auto &executor = item.second;
+      if (executor != nullptr && executor->FailDependentTasks(&failed_tensors, exception)) {
+        changed = true;
+      }
+    }
+  }
+}
+
 void ExecutorManager::JoinExecutorWorkers() {
   for (auto &item : executors_) {
     auto &executor = item.second;
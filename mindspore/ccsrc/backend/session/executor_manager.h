@@ -31,6 +31,7 @@ class ExecutorManager {
   }
   std::shared_ptr<Executor> GetExecutor(const std::string &device_name, int device_id);
   void OnRunGraphFinished();
+  void OnRunGraphFailed(std::set<tensor::TensorPtr> failed_tensors, const std::exception_ptr &exception);
   void Clear();
 
  private:
@@ -1372,10 +1372,10 @@ void SessionBasic::RunOpAsync(OpRunInfo *op_run_info, const GraphInfo &graph_inf
   executor_->RunOpAsync(shared_from_this(), op_run_info, graph_info, input_tensors, outputs);
 }
 
-void SessionBasic::RunGraphAsync(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs,
-                                 VectorRef *outputs) {
+std::shared_future<void> SessionBasic::RunGraphAsync(const GraphId &graph_id,
+                                                     const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) {
   MS_EXCEPTION_IF_NULL(executor_);
-  executor_->RunGraphAsync(shared_from_this(), graph_id, inputs, outputs);
+  return executor_->RunGraphAsync(shared_from_this(), graph_id, inputs, outputs);
 }
 
 #if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
@@ -22,6 +22,7 @@
 #include <utility>
 #include <memory>
 #include <map>
+#include <future>
 
 #include "backend/session/session_context.h"
 #include "backend/session/kernel_graph.h"
@@ -91,7 +92,9 @@ class SessionBasic : public std::enable_shared_from_this<SessionBasic> {
   GraphId CompileGraphAsync(const AnfNodePtrList &lst, const AnfNodePtrList &outputs);
   GraphId CompileGraphAsync(NotNull<FuncGraphPtr> func_graph);
   void BuildGraphAsync(GraphId graphId);
-  void RunGraphAsync(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs);
+  // the returned future is ready once the graph has run, the outputs also wait for it when they are read
+  std::shared_future<void> RunGraphAsync(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs,
+                                         VectorRef *outputs);
   void BuildOpAsync(OpRunInfo *, const GraphInfo &, const std::vector<tensor::TensorPtr> &input_tensors,
                     const std::vector<int> &tensors_mask);
   void RunOpAsync(OpRunInfo *, const GraphInfo &, const std::vector<tensor::TensorPtr> &input_tensors,
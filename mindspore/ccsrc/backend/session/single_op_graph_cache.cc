@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/session/single_op_graph_cache.h"
+#include <cstdlib>
+#include <sstream>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace session {
+size_t SingleOpGraphCache::GetCapacityFromEnv() {
+  std::string capacity_env = common::GetEnv(kEnvSingleOpGraphCacheSize);
+  if (capacity_env.empty()) {
+    return kDefaultSingleOpGraphCacheSize;
+  }
+  char *end = nullptr;
+  auto capacity = std::strtol(capacity_env.c_str(), &end, 10);
+  if (*end != '\0' || capacity <= 0) {
+    MS_LOG(WARNING) << "Env " << kEnvSingleOpGraphCacheSize << " is invalid: " << capacity_env << ", use "
+                    << kDefaultSingleOpGraphCacheSize << " instead.";
+    return kDefaultSingleOpGraphCacheSize;
+  }
+  return static_cast<size_t>(capacity);
+}
+
+KernelGraphPtr SingleOpGraphCache::Get(const GraphInfo &graph_info) {
+  auto iter = graph_iters_.find(graph_info);
+  if (iter == graph_iters_.end()) {
+    misses_++;
+    return nullptr;
+  }
+  hits_++;
+  graphs_.splice(graphs_.begin(), graphs_, iter->second);
+  return iter->second->second;
+}
+
+KernelGraphPtr SingleOpGraphCache::Find(const GraphInfo &graph_info) const {
+  auto iter = graph_iters_.find(graph_info);
+  return iter == graph_iters_.end() ? nullptr : iter->second->second;
+}
+
+void SingleOpGraphCache::Put(const GraphInfo &graph_info, const KernelGraphPtr &graph) {
+  auto iter = graph_iters_.find(graph_info);
+  if (iter != graph_iters_.end()) {
+    iter->second->second = graph;
+    graphs_.splice(graphs_.begin(), graphs_, iter->second);
+    return;
+  }
+  if (graphs_.size() >= capacity_ && !graphs_.empty()) {
+    MS_LOG(DEBUG) << "Evict single op graph " << graphs_.back().first;
+    (void)graph_iters_.erase(graphs_.back().first);
+    graphs_.pop_back();
+    evictions_++;
+  }
+  graphs_.emplace_front(graph_info, graph);
+  graph_iters_[graph_info] = graphs_.begin();
+}
+
+std::string SingleOpGraphCache::Statistics() const {
+  std::ostringstream buffer;
+  buffer << "single op graph cache: " << graphs_.size() << " graphs cached, " << hits_ << " hits, " << misses_
+         << " misses, " << evictions_ << " evictions";
+  return buffer.str();
+}
+}  // namespace session
+}  // namespace mindspore
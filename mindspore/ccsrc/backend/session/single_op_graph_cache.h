@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H
+#define MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "backend/session/kernel_graph.h"
+#include "backend/session/session_basic.h"
+
+namespace mindspore {
+namespace session {
+// Max number of the compiled single op graphs a session keeps in pynative mode.
+constexpr char kEnvSingleOpGraphCacheSize[] = "MS_SINGLE_OP_GRAPH_CACHE_SIZE";
+constexpr size_t kDefaultSingleOpGraphCacheSize = 1024;
+
+// The compiled single op graphs of pynative mode, keyed by the graph info of the op: the shapes and types of its
+// inputs, its primitive and attrs. The kernels built for a graph, with their mkldnn primitives, live as long as it is
+// cached. The least recently used graph is evicted once the cache is full.
+class SingleOpGraphCache {
+ public:
+  explicit SingleOpGraphCache(size_t capacity) : capacity_(capacity) {}
+  ~SingleOpGraphCache() = default;
+
+  static size_t GetCapacityFromEnv();
+
+  // Looks up a graph to build, the lookup is counted in the statistics and marks the graph as the most recently used.
+  KernelGraphPtr Get(const GraphInfo &graph_info);
+  // Looks up a graph which has been built.
+  KernelGraphPtr Find(const GraphInfo &graph_info) const;
+  void Put(const GraphInfo &graph_info, const KernelGraphPtr &graph);
+
+  size_t size() const { return graphs_.size(); }
+  size_t hits() const { return hits_; }
+  size_t misses() const { return misses_; }
+  size_t evictions() const { return evictions_; }
+  std::string Statistics() const;
+
+ private:
+  using GraphList = std::list<std::pair<GraphInfo, KernelGraphPtr>>;
+  size_t capacity_;
+  // the most recently used graph first
+  GraphList graphs_;
+  std::unordered_map<GraphInfo, GraphList::iterator> graph_iters_;
+  size_t hits_{0};
+  size_t misses_{0};
+  size_t evictions_{0};
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_BACKEND_SESSION_SINGLE_OP_GRAPH_CACHE_H
@@ -0,0 +1,244 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/thread_pool.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace common {
+namespace {
+thread_local bool t_in_worker = false;
+
+size_t GetEnvThreadNum() {
+  const char *env = std::getenv(kEnvCpuThreadNum);
+  if (env == nullptr) {
+    return 0;
+  }
+  char *end = nullptr;
+  auto thread_num = std::strtol(env, &end, 10);
+  if (end == env || *end != '\0' || thread_num <= 0) {
+    MS_LOG(WARNING) << "Env " << kEnvCpuThreadNum << " is invalid: " << env << ", use the core number instead.";
+    return 0;
+  }
+  return static_cast<size_t>(thread_num);
+}
+}  // namespace
+
+struct ThreadPool::Job {
+  const ParallelTask *task{nullptr};
+  std::atomic<size_t> pending{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::exception_ptr error;
+};
+
+ThreadPool &ThreadPool::GetInstance() {
+  static ThreadPool instance;
+  return instance;
+}
+
+ThreadPool::ThreadPool() {
+  std::vector<int> bind_cores;
+  const char *core_list = std::getenv(kEnvCpuBindCore);
+  if (core_list != nullptr) {
+    bind_cores = ParseCoreList(core_list);
+  }
+  Start(GetEnvThreadNum(), bind_cores);
+}
+
+ThreadPool::~ThreadPool() { Stop(); }
+
+void ThreadPool::Reset(size_t thread_num, const std::vector<int> &bind_cores) {
+  Stop();
+  Start(thread_num, bind_cores);
+}
+
+void ThreadPool::Start(size_t thread_num, const std::vector<int> &bind_cores) {
+  if (thread_num == 0) {
+    thread_num = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  workers_.reserve(thread_num - 1);
+  for (size_t i = 0; i + 1 < thread_num; ++i) {
+    int core = bind_cores.empty() ? -1 : bind_cores[i % bind_cores.size()];
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i, core);
+  }
+  MS_LOG(INFO) << "Cpu thread pool started, thread num: " << thread_num << ", bind core num: " << bind_cores.size();
+}
+
+void ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  stop_ = false;
+}
+
+void ThreadPool::WorkerLoop(size_t worker_id, int core) {
+  t_in_worker = true;
+#ifdef __linux__
+  if (core >= 0 && core < CPU_SETSIZE) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0) {
+      MS_LOG(WARNING) << "Bind cpu thread pool worker " << worker_id << " to core " << core << " failed.";
+    }
+  }
+#endif
+  while (true) {
+    Block block;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !blocks_.empty(); });
+      if (blocks_.empty()) {
+        return;
+      }
+      block = std::move(blocks_.front());
+      blocks_.pop_front();
+    }
+    RunBlock(block);
+  }
+}
+
+void ThreadPool::RunBlock(const Block &block) {
+  auto &job = block.job;
+  try {
+    (*job->task)(block.start, block.end);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    if (job->error == nullptr) {
+      job->error = std::current_exception();
+    }
+  }
+  if (job->pending.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    job->cv.notify_all();
+  }
+}
+
+void ThreadPool::ParallelFor(size_t count, const ParallelTask &task, size_t grain_size) {
+  if (count == 0) {
+    return;
+  }
+  grain_size = std::max<size_t>(grain_size, 1);
+  size_t block_num = std::min(GetThreadNum(), count / grain_size);
+  if (block_num <= 1 || t_in_worker) {
+    task(0, count);
+    return;
+  }
+  size_t block_size = (count + block_num - 1) / block_num;
+  block_num = (count + block_size - 1) / block_size;
+
+  auto job = std::make_shared<Job>();
+  job->task = &task;
+  job->pending = block_num - 1;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t start = block_size; start < count; start += block_size) {
+      blocks_.push_back({job, start, std::min(start + block_size, count)});
+    }
+  }
+  if (block_num - 1 < workers_.size()) {
+    for (size_t i = 0; i + 1 < block_num; ++i) {
+      cv_.notify_one();
+    }
+  } else {
+    cv_.notify_all();
+  }
+
+  // the caller runs the first block, then helps the workers with the queued ones
+  std::exception_ptr error;
+  try {
+    task(0, block_size);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  while (job->pending > 0) {
+    Block block;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (blocks_.empty()) {
+        break;
+      }
+      block = std::move(blocks_.front());
+      blocks_.pop_front();
+    }
+    RunBlock(block);
+  }
+  {
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->cv.wait(lock, [&job] { return job->pending == 0; });
+    if (error == nullptr) {
+      error = job->error;
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::vector<int> ThreadPool::ParseCoreList(const char *core_list) {
+  std::vector<int> cores;
+  std::string list(core_list);
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t next = list.find(',', pos);
+    if (next == std::string::npos) {
+      next = list.size();
+    }
+    std::string item = list.substr(pos, next - pos);
+    pos = next + 1;
+    if (item.empty()) {
+      continue;
+    }
+    try {
+      size_t dash = item.find('-');
+      int first = std::stoi(item.substr(0, dash));
+      int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+      if (first < 0 || last < first) {
+        throw std::invalid_argument(item);
+      }
+      for (int core = first; core <= last; ++core) {
+        cores.push_back(core);
+      }
+    } catch (const std::exception &) {
+      MS_LOG(WARNING) << "Env " << kEnvCpuBindCore << " is invalid: " << core_list << ", the workers are not bound.";
+      return {};
+    }
+  }
+  return cores;
+}
+}  // namespace common
+}  // namespace mindspore
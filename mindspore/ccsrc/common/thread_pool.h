@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace common {
+// Runs the elements in [start, end) of a parallel loop.
+using ParallelTask = std::function<void(size_t start, size_t end)>;
+
+// Env variables read when the pool is first used.
+// MS_CPU_THREAD_NUM: number of threads running a parallel loop, the caller included, defaults to the core number.
+// MS_CPU_BIND_CORE: comma separated cores or core ranges, e.g. "0-3,8", the workers are bound to them round-robin.
+constexpr char kEnvCpuThreadNum[] = "MS_CPU_THREAD_NUM";
+constexpr char kEnvCpuBindCore[] = "MS_CPU_BIND_CORE";
+
+// A process-wide pool of threads shared by the cpu kernels, so a kernel launch does not create threads and the
+// kernels running at the same time do not oversubscribe the cores.
+class ThreadPool {
+ public:
+  static ThreadPool &GetInstance();
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Split [0, count) into at most GetThreadNum() blocks of at least grain_size elements and run task on each block.
+  // The caller runs the first block and returns when all the blocks are done. The loop runs inline in the caller
+  // when there is a single block or when it is called from a worker, the first exception thrown by a block is
+  // rethrown to the caller.
+  void ParallelFor(size_t count, const ParallelTask &task, size_t grain_size = 1);
+  // Number of threads running a parallel loop, the caller included.
+  size_t GetThreadNum() const { return workers_.size() + 1; }
+  // Restart the workers, must not be called while a parallel loop is running.
+  // @param thread_num - number of threads running a parallel loop, the caller included, 0 for the core number.
+  // @param bind_cores - cores the workers are bound to round-robin, empty for no binding.
+  void Reset(size_t thread_num, const std::vector<int> &bind_cores);
+
+ private:
+  struct Job;
+  struct Block {
+    std::shared_ptr<Job> job;
+    size_t start;
+    size_t end;
+  };
+
+  ThreadPool();
+  void Start(size_t thread_num, const std::vector<int> &bind_cores);
+  void Stop();
+  void WorkerLoop(size_t worker_id, int core);
+  static void RunBlock(const Block &block);
+  static std::vector<int> ParseCoreList(const char *core_list);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Block> blocks_;
+  bool stop_{false};
+};
+}  // namespace common
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_COMMON_THREAD_POOL_H_
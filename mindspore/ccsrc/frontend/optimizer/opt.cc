@@ -25,6 +25,7 @@
 #include "ir/manager.h"
 #include "frontend/optimizer/optimizer.h"
 #include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
 
 namespace mindspore {
 /* namespace to support opt */
@@ -32,7 +33,7 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, std::vector<PrimitivePtr>{prim});
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +60,7 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, prims);
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -103,11 +104,50 @@ static bool isTraversable(const AnfNodePtr &node) {
   return false;
 }
 
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  is_sweep_ = common::GetEnv(kEnvSubstitutionSweep) == "1";
+  for (size_t i = 0; i < list_.size(); i++) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->prims_.empty()) {
+      any_candidates_.push_back(i);
+      for (auto &candidates : prim_candidates_) {
+        candidates.second.push_back(i);
+      }
+      continue;
+    }
+    for (auto &prim : list_[i]->prims_) {
+      MS_EXCEPTION_IF_NULL(prim);
+      auto &candidates = prim_candidates_[prim->name()];
+      if (candidates.empty()) {
+        // a new primitive, the substitutions before it matching any node are candidates too
+        candidates = any_candidates_;
+      }
+      if (candidates.empty() || candidates.back() != i) {
+        candidates.push_back(i);
+      }
+    }
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::Candidates(const AnfNodePtr &node) const {
+  auto prim = GetCNodePrimitive(node);
+  if (prim == nullptr) {
+    return any_candidates_;
+  }
+  auto iter = prim_candidates_.find(prim->name());
+  if (iter == prim_candidates_.end()) {
+    return any_candidates_;
+  }
+  return iter->second;
+}
+
 bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
                                       const SubstitutionPtr &transform) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
+  size_t visited = 0;
   FuncGraphManagerPtr manager = optimizer->manager();
   auto seen = NewSeenGeneration();
   // 1024 is for the initial capacity of deque
@@ -126,6 +166,7 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
       continue;
     }
     node->seen_ = seen;
+    visited++;
 
     // select nodes that this transform can be applied.
     bool is_match = transform->predicate_(node);
@@ -173,12 +214,108 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
     }
   }
 
+  visited_nodes_ += visited;
 #ifdef ENABLE_PROFILE
   MsProfile::StatTime("opt.transform." + optimizer->name(), GetTime() - start);
+  MsProfile::StatCount("visit." + optimizer->name() + "." + optimizer->CurPass_.name, visited);
 #endif
   return changes;
 }
 
+AnfNodePtr SubstitutionList::ApplySubstitutionsOnNode(const OptimizerPtr &optimizer, const AnfNodePtr &node,
+                                                      std::vector<bool> *changes, size_t *applied) const {
+  for (auto i : Candidates(node)) {
+    auto &substitution = list_[i];
+    if (!substitution->predicate_(node)) {
+      continue;
+    }
+    auto ret = (*substitution)(optimizer, node);
+    if (ret != nullptr && ret != node) {
+      (*changes)[i] = true;
+      *applied = i;
+      return ret;
+    }
+  }
+  return nullptr;
+}
+
+bool SubstitutionList::ApplySubstitutions(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
+                                          std::vector<bool> *changes) const {
+#ifdef ENABLE_PROFILE
+  double start = GetTime();
+#endif
+  size_t visited = 0;
+  FuncGraphManagerPtr manager = optimizer->manager();
+  auto seen = NewSeenGeneration();
+  // 1024 is for the initial capacity of deque
+  std::deque<AnfNodePtr> todo(1024);
+  todo.clear();
+  todo.push_back(root_node);
+  bool changed = false;
+
+  auto &all_nodes = manager->all_nodes();
+  while (!todo.empty()) {
+    AnfNodePtr node = todo.front();
+    todo.pop_front();
+
+    if (node == nullptr || node->seen_ == seen || !isTraversable(node) || !all_nodes.contains(node)) {
+      continue;
+    }
+    node->seen_ = seen;
+    visited++;
+
+    size_t applied = 0;
+    auto ret = ApplySubstitutionsOnNode(optimizer, node, changes, &applied);
+    if (ret != nullptr) {
+      changed = true;
+#ifdef ENABLE_PROFILE
+      double t = GetTime();
+#endif
+      (void)manager->Replace(node, ret);
+#ifdef ENABLE_PROFILE
+      MsProfile::StatTime("replace." + list_[applied]->name_, GetTime() - t);
+#endif
+      // match the new node again before going on, and the users of it which may match now
+      if (ret->seen_ == seen) {
+        ret->seen_--;
+      }
+      todo.push_front(ret);
+      auto &node_users = manager->node_users();
+      auto users = node_users.find(ret);
+      if (users == node_users.end()) {
+        continue;
+      }
+      for (auto &use : users->second) {
+        auto use_node = use.first;
+        if (use_node == nullptr) {
+          continue;
+        }
+        todo.push_back(use_node);
+        if (use_node->seen_ == seen) {
+          use_node->seen_--;
+        }
+      }
+      continue;
+    }
+
+    if (IsValueNode<FuncGraph>(node)) {
+      todo.push_back(GetValueNode<FuncGraphPtr>(node)->output());
+    }
+
+    if (node->isa<CNode>()) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(todo));
+    }
+  }
+
+  visited_nodes_ += visited;
+#ifdef ENABLE_PROFILE
+  MsProfile::StatTime("opt.transform." + optimizer->name(), GetTime() - start);
+  MsProfile::StatCount("visit." + optimizer->name() + "." + optimizer->CurPass_.name, visited);
+#endif
+  return changed;
+}
+
 bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
   MS_EXCEPTION_IF_NULL(optimizer);
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -196,9 +333,24 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
 
   bool loop = false;
   bool changes = false;
+  visited_nodes_ = 0;
 
   do {
     loop = false;
+    // A list applied once keeps one traversal per substitution, in one sweep a substitution would also match the
+    // nodes made by the ones after it in the list and the result of the pass would change.
+    if (is_sweep_ && !is_once_) {
+      std::vector<bool> change(list_.size(), false);
+      loop = ApplySubstitutions(optimizer, func_graph->output(), &change);
+      changes = changes || loop;
+      if (optimizer->is_on_debug_) {
+        for (size_t i = 0; i < list_.size(); i++) {
+          status[list_[i]->name_ + std::to_string(i)].push_back(change[i]);
+          space = std::max(list_[i]->name_.size(), space);
+        }
+      }
+      continue;
+    }
     for (size_t i = 0; i < list_.size(); i++) {
       auto change = ApplyTransform(optimizer, func_graph->output(), list_[i]);
       changes = changes || change;
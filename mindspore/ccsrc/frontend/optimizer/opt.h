@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -35,6 +36,10 @@ namespace opt {
 // CHECK_RENORM: check if the new node is un-typed to decide if the next Renormalize will be executted
 enum RenormAction : int { FORCE_RENORM = 0, CHECK_RENORM };
 
+// Set to 1 to apply all the substitutions of a list in one graph traversal, instead of one after another in a graph
+// traversal each. The lists applied once always use a traversal per substitution.
+constexpr char kEnvSubstitutionSweep[] = "MS_OPT_SUBSTITUTION_SWEEP";
+
 class Substitution {
  public:
   OptimizerCallerPtr transform_;
@@ -42,9 +47,11 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // the primitives of the cnodes the predicate may match, empty if it may match any node
+  std::vector<PrimitivePtr> prims_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
-               const RenormAction &renorm_action)
-      : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
+               const RenormAction &renorm_action, const std::vector<PrimitivePtr> &prims = {})
+      : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action), prims_(prims) {}
   ~Substitution() = default;
   AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node);
 };
@@ -61,17 +68,31 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
+  // the nodes visited by the last call, to compare the traversals
+  size_t visited_nodes() const { return visited_nodes_; }
 
  private:
   bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  // Applies all the substitutions in one traversal of the graph, a replaced node is matched again and its users are
+  // traversed again. changes records which substitutions changed the graph.
+  bool ApplySubstitutions(const OptimizerPtr &optimizer, const AnfNodePtr &root_node, std::vector<bool> *changes) const;
+  // Returns the node replacing node, and the index in list_ of the substitution which made it in applied.
+  AnfNodePtr ApplySubstitutionsOnNode(const OptimizerPtr &optimizer, const AnfNodePtr &node, std::vector<bool> *changes,
+                                      size_t *applied) const;
+  const std::vector<size_t> &Candidates(const AnfNodePtr &node) const;
   std::vector<SubstitutionPtr> list_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
+  bool is_sweep_{false};
+  // the indexes in list_ of the substitutions which may match the cnodes of a primitive, keyed by primitive name
+  std::unordered_map<std::string, std::vector<size_t>> prim_candidates_;
+  // the indexes in list_ of the substitutions which may match any node
+  std::vector<size_t> any_candidates_;
+  mutable size_t visited_nodes_{0};
 };
 }  // namespace opt
 }  // namespace mindspore
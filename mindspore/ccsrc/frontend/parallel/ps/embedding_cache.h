@@ -0,0 +1,248 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_EMBEDDING_CACHE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_EMBEDDING_CACHE_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// Rows of each embedding table cached by a worker, 0 disables the cache.
+constexpr char kEnvEmbeddingCacheSize[] = "MS_EMBEDDING_CACHE_SIZE";
+// "lru" or "lfu".
+constexpr char kEnvEmbeddingCachePolicy[] = "MS_EMBEDDING_CACHE_POLICY";
+// Pushes of a table a cached row may lag behind.
+constexpr char kEnvEmbeddingCacheStaleness[] = "MS_EMBEDDING_CACHE_STALENESS";
+
+enum class EmbeddingCachePolicy { kLRU, kLFU };
+
+struct EmbeddingCacheConfig {
+  size_t capacity{0};
+  EmbeddingCachePolicy policy{EmbeddingCachePolicy::kLRU};
+  size_t max_staleness{0};
+};
+
+struct EmbeddingCacheStats {
+  size_t lookups{0};
+  size_t hits{0};
+  size_t misses{0};
+  double lookup_us{0};
+  double fetch_us{0};
+  double hit_rate() const { return hits + misses == 0 ? 0 : static_cast<double>(hits) / (hits + misses); }
+};
+
+// Worker local cache of embedding rows pulled from the servers. A row fetched after the n-th push of its table is
+// served until the (n + max_staleness)-th push, pushing the id itself drops it at once: other workers' updates of a
+// row show up at most max_staleness steps late, the worker's own updates never do.
+template <typename T>
+class EmbeddingCache {
+ public:
+  // Pull the rows of ids, which are distinct, into rows one after another.
+  using FetchFunc = std::function<void(const std::vector<int> &ids, T *rows)>;
+
+  explicit EmbeddingCache(const EmbeddingCacheConfig &config) : config_(config) {}
+  ~EmbeddingCache() = default;
+
+  static bool GetConfigFromEnv(EmbeddingCacheConfig *config);
+
+  // Fill output with the rows of ids, the ids missed are fetched once each and cached.
+  void Lookup(uint64_t table, const int *ids, size_t id_num, size_t row_size, T *output, const FetchFunc &fetch);
+  // A push of the table with the gradients of ids, nullptr ids if the whole table is updated.
+  void OnPush(uint64_t table, const int *ids, size_t id_num);
+  EmbeddingCacheStats stats();
+
+ private:
+  // Eviction order of a row, the least frequency first for lfu, then the least recent use.
+  using Order = std::tuple<size_t, size_t, int>;
+  struct Row {
+    std::vector<T> data;
+    size_t version{0};
+    size_t frequency{0};
+    size_t last_use{0};
+  };
+  struct Table {
+    size_t version{0};
+    std::unordered_map<int, Row> rows;
+    std::set<Order> order;
+  };
+
+  Order GetOrder(int id, const Row &row) const {
+    return Order(config_.policy == EmbeddingCachePolicy::kLFU ? row.frequency : 0, row.last_use, id);
+  }
+  void Touch(Table *table, int id, Row *row);
+  void Erase(Table *table, int id);
+
+  EmbeddingCacheConfig config_;
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Table> tables_;
+  size_t tick_{0};
+  EmbeddingCacheStats stats_;
+};
+
+template <typename T>
+bool EmbeddingCache<T>::GetConfigFromEnv(EmbeddingCacheConfig *config) {
+  MS_EXCEPTION_IF_NULL(config);
+  auto parse = [](const char *env, size_t *value) {
+    std::string env_value = common::GetEnv(env);
+    if (env_value.empty()) {
+      return;
+    }
+    char *end = nullptr;
+    auto number = std::strtol(env_value.c_str(), &end, 10);
+    if (*end != '\0' || number < 0) {
+      MS_LOG(WARNING) << "Env " << env << " is invalid: " << env_value << ", ignore it.";
+      return;
+    }
+    *value = static_cast<size_t>(number);
+  };
+  parse(kEnvEmbeddingCacheSize, &config->capacity);
+  parse(kEnvEmbeddingCacheStaleness, &config->max_staleness);
+  std::string policy = common::GetEnv(kEnvEmbeddingCachePolicy);
+  if (policy == "lfu") {
+    config->policy = EmbeddingCachePolicy::kLFU;
+  } else if (!policy.empty() && policy != "lru") {
+    MS_LOG(WARNING) << "Env " << kEnvEmbeddingCachePolicy << " is invalid: " << policy << ", use lru instead.";
+  }
+  return config->capacity > 0;
+}
+
+template <typename T>
+void EmbeddingCache<T>::Lookup(uint64_t table_key, const int *ids, size_t id_num, size_t row_size, T *output,
+                               const FetchFunc &fetch) {
+  auto start = std::chrono::steady_clock::now();
+  // positions in output of each id missed
+  std::unordered_map<int, std::vector<size_t>> missed_positions;
+  std::vector<int> missed_ids;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.lookups++;
+    auto &table = tables_[table_key];
+    for (size_t i = 0; i < id_num; ++i) {
+      auto iter = table.rows.find(ids[i]);
+      if (iter != table.rows.end() &&
+          (iter->second.data.size() != row_size || table.version - iter->second.version > config_.max_staleness)) {
+        Erase(&table, ids[i]);
+        iter = table.rows.end();
+      }
+      if (iter == table.rows.end()) {
+        auto &positions = missed_positions[ids[i]];
+        if (positions.empty()) {
+          missed_ids.push_back(ids[i]);
+        }
+        positions.push_back(i);
+        stats_.misses++;
+        continue;
+      }
+      Touch(&table, ids[i], &iter->second);
+      std::copy(iter->second.data.begin(), iter->second.data.end(), output + i * row_size);
+      stats_.hits++;
+    }
+  }
+  if (!missed_ids.empty()) {
+    std::vector<T> fetched(missed_ids.size() * row_size);
+    size_t version;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      version = tables_[table_key].version;
+    }
+    auto fetch_start = std::chrono::steady_clock::now();
+    fetch(missed_ids, fetched.data());
+    auto fetch_end = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.fetch_us += std::chrono::duration<double, std::micro>(fetch_end - fetch_start).count();
+    auto &table = tables_[table_key];
+    for (size_t j = 0; j < missed_ids.size(); ++j) {
+      const T *row_data = fetched.data() + j * row_size;
+      for (auto position : missed_positions[missed_ids[j]]) {
+        std::copy(row_data, row_data + row_size, output + position * row_size);
+      }
+      // a push during the fetch may have updated the row on the servers already
+      if (version != table.version || config_.capacity == 0) {
+        continue;
+      }
+      Erase(&table, missed_ids[j]);
+      if (table.rows.size() >= config_.capacity) {
+        Erase(&table, std::get<2>(*table.order.begin()));
+      }
+      Row &row = table.rows[missed_ids[j]];
+      row.data.assign(row_data, row_data + row_size);
+      row.version = version;
+      Touch(&table, missed_ids[j], &row);
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.lookup_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+void EmbeddingCache<T>::OnPush(uint64_t table_key, const int *ids, size_t id_num) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &table = tables_[table_key];
+  table.version++;
+  if (ids == nullptr) {
+    table.rows.clear();
+    table.order.clear();
+    return;
+  }
+  for (size_t i = 0; i < id_num; ++i) {
+    Erase(&table, ids[i]);
+  }
+}
+
+template <typename T>
+EmbeddingCacheStats EmbeddingCache<T>::stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+template <typename T>
+void EmbeddingCache<T>::Touch(Table *table, int id, Row *row) {
+  if (row->last_use != 0) {
+    (void)table->order.erase(GetOrder(id, *row));
+  }
+  row->frequency++;
+  row->last_use = ++tick_;
+  (void)table->order.insert(GetOrder(id, *row));
+}
+
+template <typename T>
+void EmbeddingCache<T>::Erase(Table *table, int id) {
+  auto iter = table->rows.find(id);
+  if (iter == table->rows.end()) {
+    return;
+  }
+  (void)table->order.erase(GetOrder(id, iter->second));
+  (void)table->rows.erase(iter);
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_EMBEDDING_CACHE_H_
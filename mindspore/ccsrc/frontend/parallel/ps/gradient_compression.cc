@@ -0,0 +1,203 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/ps/gradient_compression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+namespace {
+constexpr size_t kHeaderSize = 2;
+constexpr float kDefaultTopKRatio = 0.01;
+constexpr float kInt8Max = 127;
+
+float IntToWord(int32_t value) {
+  float word;
+  (void)memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+int32_t WordToInt(float word) {
+  int32_t value;
+  (void)memcpy(&value, &word, sizeof(value));
+  return value;
+}
+
+size_t WordsOf(size_t bytes) { return (bytes + sizeof(float) - 1) / sizeof(float); }
+}  // namespace
+
+CompressionType GradientCompressor::GetTypeFromEnv(float *topk_ratio) {
+  MS_EXCEPTION_IF_NULL(topk_ratio);
+  *topk_ratio = kDefaultTopKRatio;
+  std::string ratio = common::GetEnv(kEnvGradientTopKRatio);
+  if (!ratio.empty()) {
+    char *end = nullptr;
+    float value = std::strtof(ratio.c_str(), &end);
+    if (*end != '\0' || value <= 0 || value > 1) {
+      MS_LOG(WARNING) << "Env " << kEnvGradientTopKRatio << " is invalid: " << ratio << ", use " << kDefaultTopKRatio
+                      << " instead.";
+    } else {
+      *topk_ratio = value;
+    }
+  }
+  std::string type = common::GetEnv(kEnvGradientCompression);
+  if (type == "topk") {
+    return kCompressionTopK;
+  } else if (type == "fp16") {
+    return kCompressionFp16;
+  } else if (type == "int8") {
+    return kCompressionInt8;
+  } else if (!type.empty()) {
+    MS_LOG(WARNING) << "Env " << kEnvGradientCompression << " is invalid: " << type << ", gradients are not compressed.";
+  }
+  return kCompressionNone;
+}
+
+void GradientCompressor::Encode(uint64_t key, const float *grad, size_t size, std::vector<float> *encoded) {
+  MS_EXCEPTION_IF_NULL(grad);
+  MS_EXCEPTION_IF_NULL(encoded);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &residual = residuals_[key];
+  residual.resize(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    residual[i] += grad[i];
+  }
+  Encode(residual.data(), size, encoded);
+  std::vector<float> decoded;
+  if (!Decode(encoded->data(), encoded->size(), &decoded)) {
+    MS_LOG(EXCEPTION) << "Decode the gradient of key " << key << " failed.";
+  }
+  for (size_t i = 0; i < size; ++i) {
+    residual[i] -= decoded[i];
+  }
+}
+
+void GradientCompressor::Encode(const float *grad, size_t size, std::vector<float> *encoded) const {
+  MS_EXCEPTION_IF_NULL(encoded);
+  encoded->assign({IntToWord(type_), IntToWord(static_cast<int32_t>(size))});
+  if (type_ == kCompressionTopK) {
+    size_t k = std::min(size, std::max<size_t>(1, static_cast<size_t>(std::ceil(size * topk_ratio_))));
+    std::vector<int32_t> indices(size);
+    std::iota(indices.begin(), indices.end(), 0);
+    if (k > 0) {
+      std::nth_element(indices.begin(), indices.begin() + k - 1, indices.end(),
+                       [grad](int32_t x, int32_t y) { return std::fabs(grad[x]) > std::fabs(grad[y]); });
+    }
+    indices.resize(k);
+    std::sort(indices.begin(), indices.end());
+    encoded->push_back(IntToWord(static_cast<int32_t>(k)));
+    for (auto index : indices) {
+      encoded->push_back(IntToWord(index));
+    }
+    for (auto index : indices) {
+      encoded->push_back(grad[index]);
+    }
+  } else if (type_ == kCompressionFp16) {
+    std::vector<float16> halves(grad, grad + size);
+    encoded->resize(kHeaderSize + WordsOf(size * sizeof(float16)), 0);
+    if (size > 0) {
+      (void)memcpy(encoded->data() + kHeaderSize, halves.data(), size * sizeof(float16));
+    }
+  } else if (type_ == kCompressionInt8) {
+    float max_abs = 0;
+    for (size_t i = 0; i < size; ++i) {
+      max_abs = std::max(max_abs, std::fabs(grad[i]));
+    }
+    float scale = max_abs / kInt8Max;
+    std::vector<int8_t> quantized(size, 0);
+    if (scale > 0) {
+      for (size_t i = 0; i < size; ++i) {
+        quantized[i] = static_cast<int8_t>(std::lround(grad[i] / scale));
+      }
+    }
+    encoded->push_back(scale);
+    encoded->resize(kHeaderSize + 1 + WordsOf(size), 0);
+    if (size > 0) {
+      (void)memcpy(encoded->data() + kHeaderSize + 1, quantized.data(), size);
+    }
+  } else {
+    encoded->insert(encoded->end(), grad, grad + size);
+  }
+}
+
+bool GradientCompressor::Decode(const float *encoded, size_t encoded_size, std::vector<float> *grad) {
+  MS_EXCEPTION_IF_NULL(encoded);
+  MS_EXCEPTION_IF_NULL(grad);
+  if (encoded_size < kHeaderSize || WordToInt(encoded[1]) < 0) {
+    return false;
+  }
+  auto type = WordToInt(encoded[0]);
+  size_t size = static_cast<size_t>(WordToInt(encoded[1]));
+  const float *payload = encoded + kHeaderSize;
+  size_t payload_size = encoded_size - kHeaderSize;
+  grad->assign(size, 0);
+  if (type == kCompressionTopK) {
+    if (payload_size < 1 || WordToInt(payload[0]) < 0) {
+      return false;
+    }
+    size_t k = static_cast<size_t>(WordToInt(payload[0]));
+    if (payload_size != 1 + 2 * k) {
+      return false;
+    }
+    for (size_t i = 0; i < k; ++i) {
+      auto index = WordToInt(payload[1 + i]);
+      if (index < 0 || static_cast<size_t>(index) >= size) {
+        return false;
+      }
+      (*grad)[index] = payload[1 + k + i];
+    }
+  } else if (type == kCompressionFp16) {
+    if (payload_size != WordsOf(size * sizeof(float16))) {
+      return false;
+    }
+    std::vector<float16> halves(size);
+    if (size > 0) {
+      (void)memcpy(static_cast<void *>(halves.data()), payload, size * sizeof(float16));
+    }
+    std::transform(halves.begin(), halves.end(), grad->begin(), [](float16 half) { return half_to_float(half); });
+  } else if (type == kCompressionInt8) {
+    if (payload_size != 1 + WordsOf(size)) {
+      return false;
+    }
+    float scale = payload[0];
+    std::vector<int8_t> quantized(size);
+    if (size > 0) {
+      (void)memcpy(quantized.data(), payload + 1, size);
+    }
+    std::transform(quantized.begin(), quantized.end(), grad->begin(),
+                   [scale](int8_t value) { return value * scale; });
+  } else if (type == kCompressionNone) {
+    if (payload_size != size) {
+      return false;
+    }
+    std::copy(payload, payload + size, grad->begin());
+  } else {
+    return false;
+  }
+  return true;
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_GRADIENT_COMPRESSION_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_GRADIENT_COMPRESSION_H_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// "topk", "fp16" or "int8", the dense gradients pushed by the workers are sent compressed.
+constexpr char kEnvGradientCompression[] = "MS_GRADIENT_COMPRESSION";
+// Fraction of the gradient elements sent by topk, 0.01 by default.
+constexpr char kEnvGradientTopKRatio[] = "MS_GRADIENT_TOPK_RATIO";
+
+enum CompressionType : int { kCompressionNone = 0, kCompressionTopK = 1, kCompressionFp16 = 2, kCompressionInt8 = 3 };
+
+// Compress gradients into float words, the value type of the push messages. An encoded gradient starts with a header
+// of its type and element number, so the servers decode it without other context:
+//   topk: header, k, k indices, k values
+//   fp16: header, the halves packed two in a word
+//   int8: header, scale, the quantized values packed four in a word
+// The error of the encoding is fed back: it is kept per key and added to the next gradient of the key, so no part of
+// a gradient is lost, it is only delayed.
+class GradientCompressor {
+ public:
+  GradientCompressor(CompressionType type, float topk_ratio) : type_(type), topk_ratio_(topk_ratio) {}
+  ~GradientCompressor() = default;
+
+  // kCompressionNone if compression is not enabled by the env.
+  static CompressionType GetTypeFromEnv(float *topk_ratio);
+
+  CompressionType type() const { return type_; }
+  // Encode grad with the error left by the last encoding of key, and keep the error of this one.
+  void Encode(uint64_t key, const float *grad, size_t size, std::vector<float> *encoded);
+  // Encode grad without error feedback.
+  void Encode(const float *grad, size_t size, std::vector<float> *encoded) const;
+  // False if encoded is not an encoded gradient.
+  static bool Decode(const float *encoded, size_t encoded_size, std::vector<float> *grad);
+
+ private:
+  CompressionType type_;
+  float topk_ratio_;
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<float>> residuals_;
+};
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_GRADIENT_COMPRESSION_H_
@@ -24,14 +24,18 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <thread>
 #include <cmath>
 #include <random>
+#include <cstdlib>
 #include <utility>
 #include <list>
 #include <map>
 #include <functional>
+#include <numeric>
+#include <algorithm>
 #include "ir/func_graph.h"
 #include "backend/session/session_basic.h"
 #include "backend/session/anf_runtime_algorithm.h"
@@ -41,6 +45,9 @@
 #include "frontend/parallel/ps/optimizer_info_builder.h"
 #include "frontend/parallel/ps/util.h"
 #include "frontend/parallel/ps/ps_context.h"
+#include "frontend/parallel/ps/request_dispatcher.h"
+#include "frontend/parallel/ps/gradient_compression.h"
+#include "frontend/parallel/ps/push_pull_controller.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
 #include "utils/ms_context.h"
 #include "backend/kernel_compiler/kernel.h"
@@ -72,12 +79,12 @@ class ParameterServer {
       : pserver_num_(0),
         worker_num_(0),
         rank_id_(0),
-        grad_accum_count_(0),
         ps_(new ::ps::KVServer<T>(0)),
         handler_(nullptr),
+        dispatcher_(nullptr),
+        push_pull_controller_(nullptr),
         func_graph_(nullptr),
         sess_(nullptr),
-        running_(true),
         thread_(nullptr) {}
   ~ParameterServer() = default;
   ParameterServer(const ParameterServer &) = delete;
@@ -98,10 +105,15 @@ class ParameterServer {
                                    ::ps::KVPairs<T> *res);
     void HandleInitInputsShape(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleInitEmbeddings(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    void HandleInitCompression(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleCheckReadyForPush(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleCheckReadyForPull(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
     void HandleEmbeddingLookup(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    void HandlePushCompressedGrad(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
+                                  ::ps::KVPairs<T> *res);
     void HandleFinalize(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res);
+    void HandleRequest(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data, ::ps::KVServer<T> *server);
+    static size_t WorkerRank(const ::ps::KVMeta &req_meta);
 
     ParameterServer *ps_;
     typedef void (ServerHandler::*RequestHandler)(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
@@ -123,27 +135,31 @@ class ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
-  void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
+  void UpdateWeight(const Key &key);
+  void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths, size_t worker);
+  CompressionType AcceptedCompression(const Key &key, CompressionType type);
+  void DecompressGrad(const Key &key, const Values &values, const Lengths &lengths, Values *grad_values,
+                      Lengths *grad_lengths);
+  int GradIndex(const std::string &optim_name) const;
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res);
-  bool ReadyForUpdateWeights();
-  bool ReadyForPush(const Key &key);
+  bool ReadyForPush(const Key &key, size_t worker);
   bool ReadyForPull(const Key &key);
-  void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
-  std::mutex &mutex();
+  std::shared_mutex &keys_mutex();
+  std::mutex &key_mutex(const Key &key);
   void GetEmbeddingTableParamPtr();
   void SyncEmbeddingTables();
 
   size_t pserver_num_;
   size_t worker_num_;
   size_t rank_id_;
-  size_t grad_accum_count_;
   std::unique_ptr<::ps::KVServer<T>> ps_;
   std::unique_ptr<ServerHandler> handler_;
+  std::unique_ptr<RequestDispatcher> dispatcher_;
+  std::unique_ptr<PushPullController> push_pull_controller_;
   FuncGraphPtr func_graph_;
   std::shared_ptr<session::SessionBasic> sess_;
-  bool running_;
 
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> optimizers_;
   std::unordered_map<Key, InputsShapePtr> optim_inputs_shape_;
@@ -155,12 +171,7 @@ class ParameterServer {
   std::unordered_map<Key, WeightPtr> weights_;
   std::unordered_map<Key, bool> is_embedding_;
   std::unordered_map<Key, WeightPtr> grads_;
-  std::unordered_map<Key, size_t> grads_accum_counter_;
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
-  std::unordered_map<Key, uint64_t> tokens_;
-
-  std::mutex mutex_;
-  std::condition_variable apply_grads_cv_;
 
   std::unique_ptr<std::thread> thread_;
   std::map<Key, ParameterPtr> embedding_tables_;
@@ -172,9 +183,17 @@ class FuncGraph;
 template <typename T>
 void ParameterServer<T>::ServerHandler::operator()(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
                                                    ::ps::KVServer<T> *server) {
+  Key key = req_data.keys.empty() ? 0 : req_data.keys[0];
+  ps_->dispatcher_->Dispatch(key, [this, req_meta, req_data, server]() { HandleRequest(req_meta, req_data, server); });
+}
+
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandleRequest(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
+                                                      ::ps::KVServer<T> *server) {
   ::ps::KVPairs<T> res;
-  if (handlers_.count(req_meta.cmd) > 0) {
-    auto &handler_ptr = handlers_[req_meta.cmd];
+  auto iter = handlers_.find(req_meta.cmd);
+  if (iter != handlers_.end()) {
+    auto handler_ptr = iter->second;
     (this->*handler_ptr)(req_meta, req_data, &res);
   } else if (req_meta.push) {
     HandlePushReq(req_meta, req_data, &res);
@@ -184,22 +203,29 @@ void ParameterServer<T>::ServerHandler::operator()(const ::ps::KVMeta &req_meta,
   server->Response(req_meta, res);
 }
 
+template <typename T>
+size_t ParameterServer<T>::ServerHandler::WorkerRank(const ::ps::KVMeta &req_meta) {
+  return IntToSize(::ps::Postoffice::Get()->IDtoRank(req_meta.sender));
+}
+
 template <typename T>
 void ParameterServer<T>::ServerHandler::Init() {
   handlers_[kInitWeightsCmd] = &ServerHandler::HandleInitWeights;
   handlers_[kInitWeightToOptimIdCmd] = &ServerHandler::HandleInitWeightToOptimId;
   handlers_[kInitOptimInputsShapeCmd] = &ServerHandler::HandleInitInputsShape;
   handlers_[kInitEmbeddingsCmd] = &ServerHandler::HandleInitEmbeddings;
+  handlers_[kInitCompressionCmd] = &ServerHandler::HandleInitCompression;
   handlers_[kCheckReadyForPushCmd] = &ServerHandler::HandleCheckReadyForPush;
   handlers_[kCheckReadyForPullCmd] = &ServerHandler::HandleCheckReadyForPull;
   handlers_[kEmbeddingLookupCmd] = &ServerHandler::HandleEmbeddingLookup;
+  handlers_[kPushCompressedGradCmd] = &ServerHandler::HandlePushCompressedGrad;
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
 }
 
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandlePushReq(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
                                                       ::ps::KVPairs<T> *res) {
-  ps_->AccumGrad(req_data.keys, req_data.vals, req_data.lens);
+  ps_->AccumGrad(req_data.keys, req_data.vals, req_data.lens, WorkerRank(req_meta));
 }
 
 template <typename T>
@@ -213,7 +239,7 @@ void ParameterServer<T>::ServerHandler::HandlePullReq(const ::ps::KVMeta &req_me
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitWeights(const ::ps::KVMeta &req_meta,
                                                           const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->keys_mutex());
   size_t key_num = req_data.keys.size();
   T *data_ptr = req_data.vals.data();
   size_t pos = 0;
@@ -237,7 +263,7 @@ template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitWeightToOptimId(const ::ps::KVMeta &req_meta,
                                                                   const ::ps::KVPairs<T> &req_data,
                                                                   ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->keys_mutex());
   size_t key_num = req_data.keys.size();
   for (size_t i = 0; i < key_num; i++) {
     Key key = req_data.keys[i];
@@ -254,7 +280,7 @@ void ParameterServer<T>::ServerHandler::HandleInitWeightToOptimId(const ::ps::KV
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitInputsShape(const ::ps::KVMeta &req_meta,
                                                               const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->keys_mutex());
   const Key &key = req_data.keys[0];
   if (init_optim_info_[key]) {
     return;
@@ -267,7 +293,7 @@ void ParameterServer<T>::ServerHandler::HandleInitInputsShape(const ::ps::KVMeta
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleInitEmbeddings(const ::ps::KVMeta &req_meta,
                                                              const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->keys_mutex());
   const Key &key = req_data.keys[0];
   MS_LOG(INFO) << "Initializing embedding table for key:" << key;
   std::shared_ptr<std::vector<std::shared_ptr<std::vector<size_t>>>> shapes =
@@ -293,12 +319,21 @@ void ParameterServer<T>::ServerHandler::HandleInitEmbeddings(const ::ps::KVMeta
   ps_->InitEmbeddingTable(key, shapes);
 }
 
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandleInitCompression(const ::ps::KVMeta &req_meta,
+                                                              const ::ps::KVPairs<T> &req_data, ::ps::KVPairs<T> *res) {
+  const Key &key = req_data.keys[0];
+  auto type = static_cast<CompressionType>(static_cast<int>(req_data.vals[0]));
+  res->keys.push_back(key);
+  res->vals.push_back(ps_->AcceptedCompression(key, type));
+}
+
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleCheckReadyForPush(const ::ps::KVMeta &req_meta,
                                                                 const ::ps::KVPairs<T> &req_data,
                                                                 ::ps::KVPairs<T> *res) {
   const Key &key = req_data.keys[0];
-  bool ready = ps_->ReadyForPush(key);
+  bool ready = ps_->ReadyForPush(key, WorkerRank(req_meta));
   res->keys.push_back(key);
   res->vals.push_back(ready);
 }
@@ -323,6 +358,16 @@ void ParameterServer<T>::ServerHandler::HandleEmbeddingLookup(const ::ps::KVMeta
   ps_->DoEmbeddingLookup(key, req_data.keys.segment(1, req_data.keys.size()), res);
 }
 
+template <typename T>
+void ParameterServer<T>::ServerHandler::HandlePushCompressedGrad(const ::ps::KVMeta &req_meta,
+                                                                 const ::ps::KVPairs<T> &req_data,
+                                                                 ::ps::KVPairs<T> *res) {
+  Values values;
+  Lengths lengths;
+  ps_->DecompressGrad(req_data.keys[0], req_data.vals, req_data.lens, &values, &lengths);
+  ps_->AccumGrad(req_data.keys, values, lengths, WorkerRank(req_meta));
+}
+
 template <typename T>
 void ParameterServer<T>::ServerHandler::HandleFinalize(const ::ps::KVMeta &req_meta, const ::ps::KVPairs<T> &req_data,
                                                        ::ps::KVPairs<T> *res) {
@@ -337,6 +382,26 @@ bool ParameterServer<T>::Init(const FuncGraphPtr &func_graph) {
   rank_id_ = ::ps::MyRank();
   handler_.reset(new ServerHandler(this));
   handler_->Init();
+  size_t thread_num = 0;
+  std::string thread_num_env = common::GetEnv(kEnvPServerThreadNum);
+  if (!thread_num_env.empty()) {
+    char *end = nullptr;
+    auto env_value = std::strtol(thread_num_env.c_str(), &end, 10);
+    if (*end != '\0' || env_value <= 0) {
+      MS_LOG(WARNING) << "Env " << kEnvPServerThreadNum << " is invalid: " << thread_num_env
+                      << ", use the core number instead.";
+    } else {
+      thread_num = static_cast<size_t>(env_value);
+    }
+  }
+  dispatcher_.reset(new RequestDispatcher(thread_num));
+  size_t staleness = 0;
+  UpdateMode update_mode = StalenessController::GetModeFromEnv(&staleness);
+  push_pull_controller_.reset(new PushPullController(worker_num_, update_mode, staleness));
+  if (update_mode != UpdateMode::kSync) {
+    MS_LOG(INFO) << "PServer updates weights " << (update_mode == UpdateMode::kAsync ? "asynchronously" : "in ssp mode")
+                 << ", staleness: " << staleness;
+  }
 
   InitOptimInfoBuilders();
   ps_->set_request_handle(*handler_);
@@ -437,8 +502,9 @@ void ParameterServer<T>::InitWeight(const Key &key, const WeightPtr &weight) {
   if ((weights_.count(key) == 0) || (is_embedding_[key] && weights_.count(key) != 0)) {
     MS_LOG(INFO) << "Initializing weight for key " << key << ", server rank " << rank_id_;
     weights_[key] = weight;
-    tokens_[key] = 0;
+    push_pull_controller_->AddWeight(key, false);
     is_embedding_[key] = false;
+    (void)optim_infos_.emplace(key, nullptr);
   }
 }
 
@@ -446,7 +512,7 @@ template <typename T>
 void ParameterServer<T>::InitGrad(const Key &key, const GradPtr &grad) {
   if (grads_.count(key) == 0) {
     grads_[key] = grad;
-    grads_accum_counter_[key] = 0;
+    push_pull_controller_->AddGrad(key);
   }
 }
 
@@ -470,10 +536,11 @@ void ParameterServer<T>::InitEmbeddingTable(
       embedding_data[i] = random(engine);
     }
     weights_[key] = embedding;
-    tokens_[key] = 0;
+    push_pull_controller_->AddWeight(key, true);
     is_embedding_[key] = true;
+    (void)optim_infos_.emplace(key, nullptr);
 
-    grads_accum_counter_[key] = 0;
+    push_pull_controller_->AddGrad(key);
   }
 }
 
@@ -484,120 +551,188 @@ bool ParameterServer<T>::HasWeight(const Key &key) {
 
 template <typename T>
 void ParameterServer<T>::Finalize() {
-  running_ = false;
-  apply_grads_cv_.notify_one();
+  push_pull_controller_->Stop();
   SyncEmbeddingTables();
 }
 
 template <typename T>
 void ParameterServer<T>::UpdateWeights() {
-  while (true) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
-    if (!running_) {
-      break;
-    }
+  push_pull_controller_->UpdateLoop([this](uint64_t key) { UpdateWeight(key); });
+}
 
-    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
-      Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
+// Run the optimizer of key on the gradients accumulated, with keys_mutex shared and the key mutex held.
+template <typename T>
+void ParameterServer<T>::UpdateWeight(const Key &key) {
+  std::shared_ptr<PServerKernel> optimizer = nullptr;
+  auto optimizer_iter = optimizers_.find(key);
+  if (weight_key_to_optims_.count(key) > 0 && optimizer_iter != optimizers_.end()) {
+    optimizer = optimizer_iter->second;
+  }
+  MS_EXCEPTION_IF_NULL(optimizer);
 
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
-      }
-      MS_EXCEPTION_IF_NULL(optimizer);
-
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-        std::vector<std::vector<size_t>> shapes = {};
-        std::vector<size_t> indices_shape = {};
-        indices_shape.emplace_back(optim_info->indice_size());
-        shapes.push_back(indices_shape);
-
-        if (original_optim_inputs_shape_.count(key) != 0) {
-          for (auto input_shapes : *(original_optim_inputs_shape_[key])) {
-            shapes.push_back(*input_shapes);
-          }
-        }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, rank_id_);
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
-      }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
-      }
+  auto optim_info_iter = optim_infos_.find(key);
+  std::shared_ptr<OptimizerInfo> optim_info = optim_info_iter == optim_infos_.end() ? nullptr : optim_info_iter->second;
+  if (optim_info == nullptr) {
+    return;
+  }
+  const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+  const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+  const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+
+  std::vector<std::vector<size_t>> shapes = {};
+  std::vector<size_t> indices_shape = {};
+  indices_shape.emplace_back(optim_info->indice_size());
+  shapes.push_back(indices_shape);
+
+  auto original_shape_iter = original_optim_inputs_shape_.find(key);
+  if (original_shape_iter != original_optim_inputs_shape_.end()) {
+    for (auto input_shapes : *(original_shape_iter->second)) {
+      shapes.push_back(*input_shapes);
     }
-    ResetGradAccumCount();
   }
+  optimizer->ReInit(shapes);
+  optim_info->ComputeMean(shapes, worker_num_, pserver_num_, rank_id_);
+  optimizer->Execute(inputs, workspaces, outputs);
+  optim_info->Reset();
 }
 
 template <typename T>
-void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
+void ParameterServer<T>::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths, size_t worker) {
   const Key &key = keys[0];
   bool no_sparse_grad = values.size() == 1 && values[0] == -100;
-  if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
+  auto accumulate = [this, &keys, &values, &lengths, &key, no_sparse_grad]() {
+    if (no_sparse_grad) {
+      return;
+    }
+    std::shared_ptr<OptimizerInfo> &optim_info = optim_infos_.at(key);
 
     // Create or update the optimizer info
     if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+      auto optim_iter = weight_key_to_optims_.find(key);
+      auto kernel_iter = optimizers_.find(key);
+      if (optim_iter == weight_key_to_optims_.end() || kernel_iter == optimizers_.end() ||
+          kernel_iter->second == nullptr) {
+        MS_LOG(EXCEPTION) << "no optimizer found for key " << key;
       }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim =
-        builder->Build(pserver_kernel, weights_[key], keys, values, lengths, optim_inputs_shape_[key], worker_num_);
+      auto builder_iter = optim_info_builders_.find(optim_iter->second);
+      if (builder_iter == optim_info_builders_.end()) {
+        MS_LOG(EXCEPTION) << "no optimizer info builder found for key " << key << " optim name "
+                          << optim_iter->second;
+      }
+      auto shape_iter = optim_inputs_shape_.find(key);
+      InputsShapePtr inputs_shape = shape_iter == optim_inputs_shape_.end() ? nullptr : shape_iter->second;
+      OptimizerInfo *optim = builder_iter->second->Build(kernel_iter->second, weights_.at(key), keys, values, lengths,
+                                                         inputs_shape, worker_num_);
       optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
     } else {
       optim_info->Update(values, lengths);
       optim_info->Accumulate(values, lengths);
     }
-  }
+  };
+  // The gradient of a single worker is applied at once in the ssp and async modes. It is still divided by the worker
+  // number, so a learning rate means the same as in sync mode.
+  auto update = [this, &key, no_sparse_grad]() {
+    if (!no_sparse_grad) {
+      UpdateWeight(key);
+    }
+  };
+  push_pull_controller_->Push(key, worker, accumulate, update);
+}
 
-  grads_accum_counter_[key] += 1;
-  if (grads_accum_counter_[key] == worker_num_) {
-    grad_accum_count_++;
+template <typename T>
+CompressionType ParameterServer<T>::AcceptedCompression(const Key &key, CompressionType type) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex());
+  auto iter = weight_key_to_optims_.find(key);
+  if (iter == weight_key_to_optims_.end() || GradIndex(iter->second) < 0) {
+    return kCompressionNone;
+  }
+  // the error of top-k is fed back per key, which only fits dense gradients
+  bool accepted = type == kCompressionFp16 || type == kCompressionInt8 ||
+                  (type == kCompressionTopK && iter->second == kApplyMomentum);
+  MS_LOG(INFO) << "Gradient compression " << type << " of key " << key << " optim name " << iter->second
+               << (accepted ? " is accepted." : " is not supported.");
+  return accepted ? type : kCompressionNone;
+}
+
+template <typename T>
+void ParameterServer<T>::DecompressGrad(const Key &key, const Values &values, const Lengths &lengths,
+                                        Values *grad_values, Lengths *grad_lengths) {
+  int grad_index = -1;
+  {
+    std::shared_lock<std::shared_mutex> keys_lock(keys_mutex());
+    auto iter = weight_key_to_optims_.find(key);
+    if (iter != weight_key_to_optims_.end()) {
+      grad_index = GradIndex(iter->second);
+    }
   }
-  if (ReadyForUpdateWeights()) {
-    apply_grads_cv_.notify_one();
+  if (grad_index < 0) {
+    MS_LOG(EXCEPTION) << "The gradients of key " << key << " are not compressed.";
   }
+  grad_lengths->CopyFrom(lengths);
+  // the servers holding none of the indices of a sparse gradient receive no gradient
+  if (lengths.size() <= IntToSize(grad_index)) {
+    grad_values->CopyFrom(values);
+    return;
+  }
+  size_t grad_offset = IntToSize(std::accumulate(lengths.begin(), lengths.begin() + grad_index, 0));
+  size_t grad_size = IntToSize(lengths[grad_index]);
+  std::vector<float> grad;
+  if (grad_offset + grad_size > values.size() ||
+      !GradientCompressor::Decode(values.data() + grad_offset, grad_size, &grad)) {
+    MS_LOG(EXCEPTION) << "The compressed gradient of key " << key << " is invalid.";
+  }
+  grad_values->resize(values.size() - grad_size + grad.size());
+  auto iter = std::copy(values.begin(), values.begin() + grad_offset, grad_values->begin());
+  iter = std::copy(grad.begin(), grad.end(), iter);
+  (void)std::copy(values.begin() + grad_offset + grad_size, values.end(), iter);
+  (*grad_lengths)[grad_index] = SizeToInt(grad.size());
+}
+
+// The position of the gradient among the values pushed for the optimizer, -1 for the optimizers whose gradients are
+// not compressed.
+template <typename T>
+int ParameterServer<T>::GradIndex(const std::string &optim_name) const {
+  if (optim_name == kApplyMomentum) {
+    return 1;
+  } else if (optim_name == kSparseAdam || optim_name == kSparseLazyAdam) {
+    return 6;
+  } else if (optim_name == kSparseFtrl) {
+    return 0;
+  }
+  return -1;
 }
 
 template <typename T>
 WeightPtr ParameterServer<T>::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
-    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
-  }
-  WeightPtr weight_ptr = weights_[key];
-  WeightPtr copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
-  copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
-  tokens_[key] -= 1;
+  WeightPtr copy_weight_ptr = nullptr;
+  push_pull_controller_->Pull(key, [this, &key, &copy_weight_ptr]() {
+    auto iter = weights_.find(key);
+    if (iter == weights_.end()) {
+      MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+    }
+    WeightPtr weight_ptr = iter->second;
+    copy_weight_ptr = std::make_shared<::ps::SArray<T>>(weight_ptr->size(), 0);
+    copy_weight_ptr->CopyFrom(weight_ptr->data(), weight_ptr->size());
+  });
   return copy_weight_ptr;
 }
 
 template <typename T>
 void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, ::ps::KVPairs<T> *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex());
+  auto weight_iter = weights_.find(key);
+  if (weight_iter == weights_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
+  auto lookup_iter = embedding_lookup_ops_.find(key);
+  if (lookup_iter == embedding_lookup_ops_.end()) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  WeightPtr table_ptr = weight_iter->second;
+  std::shared_ptr<PServerKernel> table_lookup_op = lookup_iter->second;
 
   // Update shapes of lookup operator
   std::vector<std::vector<size_t>> shapes = {};
@@ -637,40 +772,23 @@ void ParameterServer<T>::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids,
 }
 
 template <typename T>
-inline bool ParameterServer<T>::ReadyForUpdateWeights() {
-  return grads_accum_counter_.size() > 0 && grad_accum_count_ == grads_accum_counter_.size();
-}
-
-template <typename T>
-inline bool ParameterServer<T>::ReadyForPush(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.empty()) {
-    MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
-                         "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
-  }
-  return grad_accum_count_ < weights_.size() && tokens_[key] <= 0;
+inline bool ParameterServer<T>::ReadyForPush(const Key &key, size_t worker) {
+  return push_pull_controller_->ReadyForPush(key, worker);
 }
 
 template <typename T>
 inline bool ParameterServer<T>::ReadyForPull(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (tokens_.count(key) == 0 || weights_[key] == 0) {
-    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
-  }
-  return tokens_[key] > 0;
+  return push_pull_controller_->ReadyForPull(key);
 }
 
 template <typename T>
-inline void ParameterServer<T>::ResetGradAccumCount() {
-  grad_accum_count_ = 0;
-  for (auto iter = grads_accum_counter_.begin(); iter != grads_accum_counter_.end(); iter++) {
-    grads_accum_counter_[iter->first] = 0;
-  }
+inline std::shared_mutex &ParameterServer<T>::keys_mutex() {
+  return push_pull_controller_->keys_mutex();
 }
 
 template <typename T>
-inline std::mutex &ParameterServer<T>::mutex() {
-  return mutex_;
+inline std::mutex &ParameterServer<T>::key_mutex(const Key &key) {
+  return push_pull_controller_->key_mutex(key);
 }
 
 template <typename T>
@@ -692,11 +810,13 @@ void ParameterServer<T>::GetEmbeddingTableParamPtr() {
 
 template <typename T>
 void ParameterServer<T>::SyncEmbeddingTables() {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex());
   for (auto embedding_table : embedding_tables_) {
     Key key = embedding_table.first;
     if (embedding_lookup_ops_.count(key) == 0) {
       MS_LOG(EXCEPTION) << "Can't find look up PS kernel for key " << key;
     }
+    std::lock_guard<std::mutex> key_lock(key_mutex(key));
     auto lookup = embedding_lookup_ops_[key];
     const std::vector<size_t> &input_shapes = lookup->input_sizes();
     std::vector<int> new_tensor_shape(input_shapes.begin(), input_shapes.end());
@@ -734,7 +854,10 @@ void ParameterServer<T>::Run(const FuncGraphPtr &func_graph) {
   PSContext::instance()->SetPSRankId(rank_id_);
   thread_->join();
   MS_LOG(INFO) << "PServer finished updating models, starts finalizing...";
+  // The update thread exits at the finalize command of the first worker. The dispatcher keeps running until the
+  // finalize barrier is passed, so the finalize commands of the other workers are still answered.
   ::ps::Finalize(0, true);
+  dispatcher_->Stop();
   MS_LOG(INFO) << "PServer finalized successfully.";
 }
 }  // namespace ps
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/ps/push_pull_controller.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+PushPullController::PushPullController(size_t worker_num, UpdateMode mode, size_t staleness)
+    : worker_num_(worker_num),
+      mode_(mode),
+      staleness_controller_(nullptr),
+      grad_accum_count_(0),
+      update_pending_(false),
+      running_(true),
+      key_mutexes_(kKeyMutexNum) {
+  if (mode != UpdateMode::kSync) {
+    staleness_controller_ = std::make_unique<StalenessController>(mode, staleness, worker_num);
+  }
+}
+
+void PushPullController::AddWeight(uint64_t key, bool embedding) {
+  tokens_[key] = 0;
+  is_embedding_[key] = embedding;
+}
+
+void PushPullController::AddGrad(uint64_t key) { grads_accum_counter_[key] = 0; }
+
+bool PushPullController::ReadyForPush(uint64_t key, size_t worker) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex_);
+  if (tokens_.empty()) {
+    MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
+                         "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
+  }
+  if (staleness_controller_ != nullptr) {
+    return staleness_controller_->ReadyForPush(key, worker);
+  }
+  {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    if (grad_accum_count_ >= tokens_.size()) {
+      return false;
+    }
+  }
+  auto iter = tokens_.find(key);
+  if (iter == tokens_.end()) {
+    return true;
+  }
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  return iter->second <= 0;
+}
+
+bool PushPullController::ReadyForPull(uint64_t key) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex_);
+  auto iter = tokens_.find(key);
+  if (iter == tokens_.end()) {
+    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+  }
+  // the latest weights are pulled whenever a worker likes in the ssp and async modes
+  if (staleness_controller_ != nullptr) {
+    return true;
+  }
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  return iter->second > 0;
+}
+
+void PushPullController::Push(uint64_t key, size_t worker, const UpdateFunc &accumulate, const UpdateFunc &update) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex_);
+  auto counter_iter = grads_accum_counter_.find(key);
+  if (counter_iter == grads_accum_counter_.end()) {
+    MS_LOG(EXCEPTION) << "Invalid gradient key " << key;
+  }
+  bool key_ready = false;
+  {
+    std::lock_guard<std::mutex> key_lock(key_mutex(key));
+    accumulate();
+    if (staleness_controller_ != nullptr) {
+      update();
+      staleness_controller_->OnPush(key, worker);
+      return;
+    }
+    key_ready = ++counter_iter->second == worker_num_;
+  }
+
+  if (key_ready) {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    grad_accum_count_++;
+    if (ReadyForUpdateWeights()) {
+      update_pending_ = true;
+      apply_grads_cv_.notify_one();
+    }
+  }
+}
+
+void PushPullController::Pull(uint64_t key, const UpdateFunc &read) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex_);
+  auto iter = tokens_.find(key);
+  if (iter == tokens_.end()) {
+    MS_LOG(EXCEPTION) << "Invalid weight key " << key;
+  }
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  read();
+  if (staleness_controller_ == nullptr) {
+    iter->second -= 1;
+  }
+}
+
+void PushPullController::UpdateLoop(const KeyUpdateFunc &update) {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(update_mutex_);
+      apply_grads_cv_.wait(lock, [this] { return update_pending_ || !running_; });
+      if (!running_) {
+        break;
+      }
+    }
+
+    std::shared_lock<std::shared_mutex> keys_lock(keys_mutex_);
+    for (auto &token : tokens_) {
+      uint64_t key = token.first;
+      std::lock_guard<std::mutex> key_lock(key_mutex(key));
+      update(key);
+      if (!is_embedding_.at(key)) {
+        token.second = worker_num_;
+      }
+      // Reset with the key still locked, a push of the key may follow as soon as it is released.
+      auto counter_iter = grads_accum_counter_.find(key);
+      if (counter_iter != grads_accum_counter_.end()) {
+        counter_iter->second = 0;
+      }
+    }
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    grad_accum_count_ = 0;
+    update_pending_ = false;
+  }
+}
+
+void PushPullController::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    running_ = false;
+  }
+  apply_grads_cv_.notify_one();
+}
+
+uint64_t PushPullController::tokens(uint64_t key) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex_);
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  auto iter = tokens_.find(key);
+  return iter == tokens_.end() ? 0 : iter->second;
+}
+
+size_t PushPullController::grads_accum_counter(uint64_t key) {
+  std::shared_lock<std::shared_mutex> keys_lock(keys_mutex_);
+  std::lock_guard<std::mutex> key_lock(key_mutex(key));
+  auto iter = grads_accum_counter_.find(key);
+  return iter == grads_accum_counter_.end() ? 0 : iter->second;
+}
+
+size_t PushPullController::clock(uint64_t key, size_t worker) {
+  return staleness_controller_ == nullptr ? 0 : staleness_controller_->clock(key, worker);
+}
+
+bool PushPullController::ReadyForUpdateWeights() const {
+  return grads_accum_counter_.size() > 0 && grad_accum_count_ == grads_accum_counter_.size();
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_PUSH_PULL_CONTROLLER_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_PUSH_PULL_CONTROLLER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include "frontend/parallel/ps/staleness_controller.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// Guards the keys of a server and decides when the workers may push and pull each of them.
+//
+// Requests of different keys are handled in parallel. keys_mutex is held exclusively while keys are added and shared
+// while the entries of existing keys are used, the entry of a key is guarded by its striped key mutex. update_mutex_
+// guards grad_accum_count_ and the handoff to the weight update thread.
+//
+// In sync mode a key may be pulled once per worker after each update, and pushed again once it has been pulled by
+// every worker. The weights are updated by UpdateLoop when every worker has pushed every key. In the ssp and async
+// modes the weight is updated at each push and the pushes are paced by a StalenessController.
+class PushPullController {
+ public:
+  using UpdateFunc = std::function<void()>;
+  using KeyUpdateFunc = std::function<void(uint64_t)>;
+
+  PushPullController(size_t worker_num, UpdateMode mode, size_t staleness);
+  ~PushPullController() = default;
+  PushPullController(const PushPullController &) = delete;
+  PushPullController &operator=(const PushPullController &) = delete;
+
+  std::shared_mutex &keys_mutex() { return keys_mutex_; }
+  std::mutex &key_mutex(uint64_t key) { return key_mutexes_[key % kKeyMutexNum]; }
+  UpdateMode mode() const { return mode_; }
+
+  // Called with keys_mutex held exclusively.
+  void AddWeight(uint64_t key, bool embedding);
+  void AddGrad(uint64_t key);
+
+  bool ReadyForPush(uint64_t key, size_t worker);
+  bool ReadyForPull(uint64_t key);
+  // Runs accumulate with keys_mutex shared and the key mutex held. In the ssp and async modes update follows at once.
+  void Push(uint64_t key, size_t worker, const UpdateFunc &accumulate, const UpdateFunc &update);
+  // Runs read with keys_mutex shared and the key mutex held, and takes a token of the key in sync mode.
+  void Pull(uint64_t key, const UpdateFunc &read);
+  // Runs update on each key with the key mutex held every time all the keys are pushed in sync mode, until Stop.
+  void UpdateLoop(const KeyUpdateFunc &update);
+  void Stop();
+
+  // The state of a key, for the tests.
+  uint64_t tokens(uint64_t key);
+  size_t grads_accum_counter(uint64_t key);
+  size_t clock(uint64_t key, size_t worker);
+
+ private:
+  // Called with keys_mutex shared and update_mutex_ locked.
+  bool ReadyForUpdateWeights() const;
+
+  static constexpr size_t kKeyMutexNum = 64;
+  size_t worker_num_;
+  UpdateMode mode_;
+  // Only created in the ssp and async modes.
+  std::unique_ptr<StalenessController> staleness_controller_;
+
+  std::unordered_map<uint64_t, uint64_t> tokens_;
+  std::unordered_map<uint64_t, bool> is_embedding_;
+  std::unordered_map<uint64_t, size_t> grads_accum_counter_;
+  size_t grad_accum_count_;
+  bool update_pending_;
+  bool running_;
+
+  std::shared_mutex keys_mutex_;
+  std::vector<std::mutex> key_mutexes_;
+  std::mutex update_mutex_;
+  std::condition_variable apply_grads_cv_;
+};
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_PUSH_PULL_CONTROLLER_H_
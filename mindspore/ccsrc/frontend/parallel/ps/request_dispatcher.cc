@@ -0,0 +1,84 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/ps/request_dispatcher.h"
+#include <algorithm>
+#include <utility>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+RequestDispatcher::RequestDispatcher(size_t thread_num) {
+  if (thread_num == 0) {
+    thread_num = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  for (size_t i = 0; i < thread_num; ++i) {
+    auto shard = std::make_unique<Shard>();
+    shard->thread = std::thread(&RequestDispatcher::ShardLoop, shard.get());
+    shards_.push_back(std::move(shard));
+  }
+  MS_LOG(INFO) << "Parameter server request dispatcher started, thread num: " << thread_num;
+}
+
+RequestDispatcher::~RequestDispatcher() { Stop(); }
+
+void RequestDispatcher::Dispatch(uint64_t key, Request &&request) {
+  auto &shard = shards_[key % shards_.size()];
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    if (shard->stop) {
+      MS_LOG(WARNING) << "The request dispatcher is stopped, drop the request of key " << key;
+      return;
+    }
+    shard->requests.push_back(std::move(request));
+  }
+  shard->cv.notify_one();
+}
+
+void RequestDispatcher::Stop() {
+  for (auto &shard : shards_) {
+    {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->stop = true;
+    }
+    shard->cv.notify_one();
+  }
+  for (auto &shard : shards_) {
+    if (shard->thread.joinable()) {
+      shard->thread.join();
+    }
+  }
+}
+
+void RequestDispatcher::ShardLoop(Shard *shard) {
+  while (true) {
+    Request request;
+    {
+      std::unique_lock<std::mutex> lock(shard->mutex);
+      shard->cv.wait(lock, [shard] { return shard->stop || !shard->requests.empty(); });
+      if (shard->requests.empty()) {
+        return;
+      }
+      request = std::move(shard->requests.front());
+      shard->requests.pop_front();
+    }
+    request();
+  }
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
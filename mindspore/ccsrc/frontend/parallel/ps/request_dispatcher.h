@@ -0,0 +1,64 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_REQUEST_DISPATCHER_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_REQUEST_DISPATCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// Runs the requests of the server on a fixed set of threads. The requests of a key always run on the same thread in
+// the order they are dispatched, so requests of different keys run in parallel while those of one key never race.
+class RequestDispatcher {
+ public:
+  using Request = std::function<void()>;
+
+  // thread_num 0 means the number of cores.
+  explicit RequestDispatcher(size_t thread_num);
+  ~RequestDispatcher();
+  RequestDispatcher(const RequestDispatcher &) = delete;
+  RequestDispatcher &operator=(const RequestDispatcher &) = delete;
+
+  void Dispatch(uint64_t key, Request &&request);
+  // Run the requests already dispatched, then join the threads. Requests dispatched afterwards are dropped.
+  void Stop();
+  size_t thread_num() const { return shards_.size(); }
+
+ private:
+  struct Shard {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Request> requests;
+    bool stop{false};
+    std::thread thread;
+  };
+  static void ShardLoop(Shard *shard);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_REQUEST_DISPATCHER_H_
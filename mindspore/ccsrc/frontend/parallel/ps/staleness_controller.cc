@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/ps/staleness_controller.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+UpdateMode StalenessController::GetModeFromEnv(size_t *staleness) {
+  MS_EXCEPTION_IF_NULL(staleness);
+  *staleness = 0;
+  std::string staleness_env = common::GetEnv(kEnvPSStaleness);
+  if (!staleness_env.empty()) {
+    char *end = nullptr;
+    auto value = std::strtol(staleness_env.c_str(), &end, 10);
+    if (*end != '\0' || value < 0) {
+      MS_LOG(WARNING) << "Env " << kEnvPSStaleness << " is invalid: " << staleness_env << ", use 0 instead.";
+    } else {
+      *staleness = static_cast<size_t>(value);
+    }
+  }
+  std::string mode = common::GetEnv(kEnvPSUpdateMode);
+  if (mode == "ssp") {
+    return UpdateMode::kSSP;
+  } else if (mode == "async") {
+    return UpdateMode::kAsync;
+  } else if (!mode.empty() && mode != "sync") {
+    MS_LOG(WARNING) << "Env " << kEnvPSUpdateMode << " is invalid: " << mode << ", use sync instead.";
+  }
+  return UpdateMode::kSync;
+}
+
+bool StalenessController::ReadyForPush(uint64_t key, size_t worker) {
+  if (mode_ == UpdateMode::kAsync) {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &key_clocks = clocks(key);
+  if (worker >= worker_num_) {
+    MS_LOG(EXCEPTION) << "Invalid worker rank " << worker << ", worker number " << worker_num_;
+  }
+  size_t min_clock = *std::min_element(key_clocks.begin(), key_clocks.end());
+  return key_clocks[worker] - min_clock <= staleness_;
+}
+
+void StalenessController::OnPush(uint64_t key, size_t worker) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &key_clocks = clocks(key);
+  if (worker >= worker_num_) {
+    MS_LOG(EXCEPTION) << "Invalid worker rank " << worker << ", worker number " << worker_num_;
+  }
+  key_clocks[worker]++;
+}
+
+size_t StalenessController::clock(uint64_t key, size_t worker) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &key_clocks = clocks(key);
+  return worker < worker_num_ ? key_clocks[worker] : 0;
+}
+
+std::vector<size_t> &StalenessController::clocks(uint64_t key) {
+  auto &key_clocks = clocks_[key];
+  if (key_clocks.empty()) {
+    key_clocks.resize(worker_num_, 0);
+  }
+  return key_clocks;
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_STALENESS_CONTROLLER_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_STALENESS_CONTROLLER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+// "sync", "ssp" or "async", sync by default.
+constexpr char kEnvPSUpdateMode[] = "MS_PS_UPDATE_MODE";
+// Pushes of a key a worker may be ahead of the slowest worker in ssp mode.
+constexpr char kEnvPSStaleness[] = "MS_PS_STALENESS";
+
+// sync: the gradients of all the workers are averaged, then the weights are updated once per step.
+// ssp: the gradient of each worker is applied as it arrives, a worker may run at most staleness steps ahead of the
+//      slowest one (stale synchronous parallel).
+// async: the gradient of each worker is applied as it arrives, the workers never wait for each other.
+enum class UpdateMode { kSync, kSSP, kAsync };
+
+// Decides when a worker may push the next gradient of a key in the ssp and async modes, from the number of pushes of
+// the key each worker has done, its clock.
+class StalenessController {
+ public:
+  StalenessController(UpdateMode mode, size_t staleness, size_t worker_num)
+      : mode_(mode), staleness_(staleness), worker_num_(worker_num) {}
+  ~StalenessController() = default;
+
+  static UpdateMode GetModeFromEnv(size_t *staleness);
+
+  UpdateMode mode() const { return mode_; }
+  bool ReadyForPush(uint64_t key, size_t worker);
+  void OnPush(uint64_t key, size_t worker);
+  size_t clock(uint64_t key, size_t worker);
+
+ private:
+  std::vector<size_t> &clocks(uint64_t key);
+
+  UpdateMode mode_;
+  size_t staleness_;
+  size_t worker_num_;
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<size_t>> clocks_;
+};
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_PS_STALENESS_CONTROLLER_H_
@@ -30,6 +30,7 @@
 #include "frontend/parallel/ps/util.h"
 #include "frontend/parallel/ps/common.h"
 #include "frontend/parallel/ps/worker_proxy.h"
+#include "frontend/parallel/ps/staleness_controller.h"
 #include "utils/shape_utils.h"
 
 namespace mindspore {
@@ -59,7 +60,7 @@ class Worker {
   void Finalize();
 
  private:
-  Worker() : kv_worker_(nullptr), running_(false), key_cnt_(0) {}
+  Worker() : kv_worker_(nullptr), running_(false), key_cnt_(0), update_mode_(UpdateMode::kSync) {}
   ~Worker() = default;
   Worker(const Worker &) = delete;
   Worker &operator=(const Worker &) = delete;
@@ -75,6 +76,7 @@ class Worker {
   std::shared_ptr<WorkerProxy<T>> kv_worker_;
   bool running_;
   size_t key_cnt_;
+  UpdateMode update_mode_;
   std::map<std::string, size_t> param_to_key_;
   std::map<size_t, bool> init_keys_;
   std::map<size_t, int> key_to_optimId_;
@@ -95,6 +97,8 @@ void Worker<T>::Run() {
     MS_LOG(EXCEPTION) << "The role is not worker.";
   }
   kv_worker_ = std::make_shared<WorkerProxy<T>>(0, 0, 1, 2);
+  size_t staleness = 0;
+  update_mode_ = StalenessController::GetModeFromEnv(&staleness);
   running_ = true;
 }
 
@@ -124,6 +128,10 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
   } else if (optim_id == 3) {
     grad_index = 0;
     indice_index = 1;
+
+    // Dense momentum gradient
+  } else if (optim_id == 0) {
+    grad_index = 1;
   }
 
   size_t total_size = std::accumulate(sizes.begin(), sizes.end(), 0, std::plus<int>());
@@ -139,10 +147,13 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
     offset += sizes[i] * sizeof(T);
   }
 
-  while (!kv_worker_->IsReadyForPush(keys[0])) {
+  // the servers take the gradients at any time in async mode
+  while (update_mode_ != UpdateMode::kAsync && !kv_worker_->IsReadyForPush(keys[0])) {
     continue;
   }
-  if (!is_sparse) {
+  if (!is_sparse && grad_index >= 0) {
+    kv_worker_->PushDenseData(::ps::SArray<::ps::Key>(keys), total_buffer, ::ps::SArray<int>(sizes), grad_index);
+  } else if (!is_sparse) {
     kv_worker_->PushData(::ps::SArray<::ps::Key>(keys), total_buffer, ::ps::SArray<int>(sizes));
   } else {
     std::vector<int> &var_shape = key_to_optim_shapes_[key][0];
@@ -156,7 +167,8 @@ void Worker<T>::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> add
 template <typename T>
 void Worker<T>::Pull(const size_t key, void *dev_addr, const size_t size) {
   ::ps::SArray<T> variables(size / sizeof(T), 0);
-  while (!kv_worker_->IsReadyForPull(key)) {
+  // the latest weights are pulled without waiting for the update of the step unless in sync mode
+  while (update_mode_ == UpdateMode::kSync && !kv_worker_->IsReadyForPull(key)) {
     continue;
   }
   kv_worker_->PullData({key}, &variables);
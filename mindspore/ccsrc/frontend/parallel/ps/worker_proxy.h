@@ -25,11 +25,14 @@
 #include <algorithm>
 #include <utility>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "ps/ps.h"
 #include "frontend/parallel/ps/util.h"
 #include "backend/kernel_compiler/common_utils.h"
 #include "frontend/parallel/ps/ps_context.h"
+#include "frontend/parallel/ps/embedding_cache.h"
+#include "frontend/parallel/ps/gradient_compression.h"
 
 namespace mindspore {
 namespace parallel {
@@ -61,6 +64,18 @@ class WorkerProxy : public ::ps::KVWorker<T> {
     broadcast_slicer_ = std::bind(&WorkerProxy<T>::BroadcastSlicer, this, _1, _2, _3, _4, _5);
     round_robin_slicer_ = std::bind(&WorkerProxy<T>::RoundRobinSlicer, this, _1, _2, _3, _4, _5);
     worker_init_embedding_slicer_ = std::bind(&WorkerProxy<T>::WorkerInitEmbeddingSlicer, this, _1, _2, _3, _4, _5);
+    EmbeddingCacheConfig cache_config;
+    if (EmbeddingCache<T>::GetConfigFromEnv(&cache_config)) {
+      embedding_cache_ = std::make_unique<EmbeddingCache<T>>(cache_config);
+      MS_LOG(INFO) << "Embedding cache enabled, rows of each table: " << cache_config.capacity
+                   << ", max staleness: " << cache_config.max_staleness;
+    }
+    float topk_ratio = 0;
+    CompressionType compression_type = GradientCompressor::GetTypeFromEnv(&topk_ratio);
+    if (compression_type != kCompressionNone) {
+      compressor_ = std::make_unique<GradientCompressor>(compression_type, topk_ratio);
+      MS_LOG(INFO) << "Gradient compression enabled, type: " << compression_type << ", top-k ratio: " << topk_ratio;
+    }
   }
   ~WorkerProxy() override = default;
 
@@ -77,11 +92,16 @@ class WorkerProxy : public ::ps::KVWorker<T> {
                 int cmd = 0, int priority = 0);
   void PushSparseData(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &vals, const ::ps::SArray<int> &lens,
                       size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size);
+  // Push a dense gradient, compressed if the servers accepted the compression of the key.
+  void PushDenseData(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &vals, const ::ps::SArray<int> &lens,
+                     size_t grad_index);
   void PullData(const ::ps::SArray<::ps::Key> &keys, ::ps::SArray<T> *vals, ::ps::SArray<int> *lens = nullptr,
                 int cmd = 0, int priority = 0);
   void Finalize();
 
  private:
+  void LookupFromServers(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                         ::ps::SArray<T> *outs, int cmd, const Callback &cb, int priority);
   template <typename C>
   int AddLookupCB(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids, C *vals, int cmd,
                   const Callback &cb);
@@ -103,6 +123,12 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   void Send(::ps::Customer *customer, int timestamp, bool push, bool pull, int cmd, const ::ps::KVPairs<T> &kvs,
             const Slicer &slicer, std::map<int, int> attrs = {});
   void AddKeyByHashMod(const ::ps::Key &key);
+  CompressionType GetCompression(const ::ps::Key &key);
+  void CompressGradient(const ::ps::Key &key, size_t grad_index, bool feedback, ::ps::SArray<T> *vals,
+                        ::ps::SArray<int> *lens);
+  void ReduceSparseData(const ::ps::SArray<T> &vals, const ::ps::SArray<int> &lens, size_t grad_index,
+                        size_t indice_index, size_t first_dim_size, size_t outer_dim_size,
+                        ::ps::SArray<T> *reduced_vals, ::ps::SArray<int> *reduced_lens);
 
   void PrepareSparseGradient(const size_t begin, const size_t end, const std::unordered_set<int> &distinct_ids,
                              const std::vector<std::pair<int, T *>> &indice_to_grad, const int *all_indice,
@@ -127,6 +153,11 @@ class WorkerProxy : public ::ps::KVWorker<T> {
   std::unordered_map<int, int> expected_result_count_;
   std::unordered_map<::ps::Key, int> key_to_server_id_;
   std::unordered_map<::ps::Key, size_t> embedding_row_cnt_;
+  std::unique_ptr<EmbeddingCache<T>> embedding_cache_;
+  std::unique_ptr<GradientCompressor> compressor_;
+  // The compression of each key negotiated with the servers.
+  std::unordered_map<::ps::Key, CompressionType> compressions_;
+  std::mutex compression_mutex_;
 };
 
 template <typename T>
@@ -164,10 +195,116 @@ void WorkerProxy<T>::AddKeyToServerId(const ::ps::Key &key) {
   AddKeyByHashMod(key);
 }
 
+template <typename T>
+CompressionType WorkerProxy<T>::GetCompression(const ::ps::Key &key) {
+  if (compressor_ == nullptr) {
+    return kCompressionNone;
+  }
+  std::lock_guard<std::mutex> lock(compression_mutex_);
+  auto iter = compressions_.find(key);
+  if (iter != compressions_.end()) {
+    return iter->second;
+  }
+  // every server holding the key has to accept the compression
+  ::ps::SArray<T> accepted;
+  int ts = AddGeneralRspCB({key}, &accepted, nullptr, kInitCompressionCmd, nullptr);
+  ::ps::KVPairs<T> kvs;
+  kvs.keys = {key};
+  kvs.vals = {static_cast<T>(compressor_->type())};
+  kvs.lens = {1};
+  if (embedding_table_ranges_.count(key)) {
+    Send(general_customer_.get(), ts, false, true, kInitCompressionCmd, kvs, broadcast_slicer_);
+  } else {
+    Send(general_customer_.get(), ts, false, true, kInitCompressionCmd, kvs, round_robin_slicer_);
+  }
+  if (expected_result_count_[ts] < server_num_) {
+    general_customer_->AddResponse(ts, server_num_ - expected_result_count_[ts]);
+  }
+  general_customer_->WaitRequest(ts);
+  CompressionType type = compressor_->type();
+  if (accepted.empty() || std::any_of(accepted.begin(), accepted.end(), [type](T val) { return val != type; })) {
+    type = kCompressionNone;
+  }
+  MS_LOG(INFO) << "The gradient compression of key " << key << " is " << type;
+  compressions_[key] = type;
+  return type;
+}
+
+template <typename T>
+void WorkerProxy<T>::CompressGradient(const ::ps::Key &key, size_t grad_index, bool feedback, ::ps::SArray<T> *vals,
+                                      ::ps::SArray<int> *lens) {
+  int grad_offset = std::accumulate(lens->begin(), lens->begin() + grad_index, 0);
+  int grad_size = (*lens)[grad_index];
+  std::vector<float> encoded;
+  if (feedback) {
+    compressor_->Encode(key, vals->data() + grad_offset, grad_size, &encoded);
+  } else {
+    // the rows of a sparse gradient change every step, its error is not fed back
+    compressor_->Encode(vals->data() + grad_offset, grad_size, &encoded);
+  }
+  ::ps::SArray<T> compressed(vals->size() - grad_size + encoded.size());
+  auto iter = std::copy(vals->begin(), vals->begin() + grad_offset, compressed.begin());
+  iter = std::copy(encoded.begin(), encoded.end(), iter);
+  (void)std::copy(vals->begin() + grad_offset + grad_size, vals->end(), iter);
+  *vals = compressed;
+  (*lens)[grad_index] = SizeToInt(encoded.size());
+}
+
+template <typename T>
+void WorkerProxy<T>::ReduceSparseData(const ::ps::SArray<T> &vals, const ::ps::SArray<int> &lens, size_t grad_index,
+                                      size_t indice_index, size_t first_dim_size, size_t outer_dim_size,
+                                      ::ps::SArray<T> *reduced_vals, ::ps::SArray<int> *reduced_lens) {
+  int grad_offset = std::accumulate(lens.begin(), lens.begin() + grad_index, 0);
+  int indice_offset = std::accumulate(lens.begin(), lens.begin() + indice_index, 0);
+  size_t indices_size = IntToSize(lens[indice_index]);
+  if (indices_size == 0) {
+    reduced_vals->CopyFrom(vals);
+    reduced_lens->CopyFrom(lens);
+    return;
+  }
+  size_t segment_size = IntToSize(lens[grad_index]) / indices_size;
+  std::vector<T> src_grad(vals.begin() + grad_offset, vals.begin() + grad_offset + lens[grad_index]);
+  const int *indice_data = reinterpret_cast<const int *>(vals.data()) + indice_offset;
+  std::vector<int> src_indices(indice_data, indice_data + indices_size);
+
+  std::vector<T> new_grad(src_grad.size());
+  std::vector<int> new_indices(indices_size);
+  mindspore::kernel::SparseGradient<int> unique_sparse_grad({new_grad.data(), new_indices.data(), indices_size});
+  Util::ReduceSparseGradient(src_grad.data(), src_indices.data(), indices_size, segment_size, first_dim_size,
+                             outer_dim_size, &unique_sparse_grad);
+
+  reduced_lens->CopyFrom(lens);
+  (*reduced_lens)[grad_index] = unique_sparse_grad.indices_size_ * segment_size;
+  (*reduced_lens)[indice_index] = unique_sparse_grad.indices_size_;
+  size_t total_size = std::accumulate(reduced_lens->begin(), reduced_lens->end(), 0, std::plus<int>());
+  ::ps::SArray<T> reduced_data(total_size, 0);
+  BuildSparseValue(*reduced_lens, grad_index, indice_index, vals.data(), unique_sparse_grad.value_,
+                   unique_sparse_grad.indices_, &reduced_data);
+  *reduced_vals = reduced_data;
+}
+
 template <typename T>
 void WorkerProxy<T>::EmbeddingLookup(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
                                      const ::ps::SArray<int> &lens, ::ps::SArray<T> *outs, int cmd, const Callback &cb,
                                      int priority) {
+  if (embedding_cache_ == nullptr || cmd != kEmbeddingLookupCmd || lookup_ids.empty()) {
+    LookupFromServers(keys, lookup_ids, outs, cmd, cb, priority);
+    return;
+  }
+  size_t row_size = outs->size() / lookup_ids.size();
+  auto fetch = [this, &keys, cmd, priority, row_size](const std::vector<int> &ids, T *rows) {
+    ::ps::SArray<T> fetched(rows, ids.size() * row_size);
+    LookupFromServers(keys, ::ps::SArray<int>(ids), &fetched, cmd, nullptr, priority);
+  };
+  embedding_cache_->Lookup(keys[0], lookup_ids.data(), lookup_ids.size(), row_size, outs->data(), fetch);
+  if (cb) {
+    cb();
+  }
+}
+
+template <typename T>
+void WorkerProxy<T>::LookupFromServers(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<int> &lookup_ids,
+                                       ::ps::SArray<T> *outs, int cmd, const Callback &cb, int priority) {
   int ts = AddLookupCB(keys, lookup_ids, outs, cmd, cb);
   ::ps::KVPairs<T> kvs;
   kvs.keys = keys;
@@ -238,28 +375,60 @@ void WorkerProxy<T>::PushData(const ::ps::SArray<::ps::Key> &keys, const ::ps::S
     general_customer_->AddResponse(ts, server_num_ - expected_result_count_[ts]);
   }
   general_customer_->WaitRequest(ts);
+  if (embedding_cache_ != nullptr && embedding_table_ranges_.count(keys[0])) {
+    embedding_cache_->OnPush(keys[0], nullptr, 0);
+  }
 }
 
 template <typename T>
 void WorkerProxy<T>::PushSparseData(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &vals,
                                     const ::ps::SArray<int> &lens, size_t grad_index, size_t indice_index,
                                     size_t first_dim_size, size_t outer_dim_size) {
-  int ts = AddGeneralRspCB(keys, nullptr, nullptr, 0, nullptr);
+  bool compress = GetCompression(keys[0]) != kCompressionNone;
+  const int cmd = compress ? kPushCompressedGradCmd : 0;
+  int ts = AddGeneralRspCB(keys, nullptr, nullptr, cmd, nullptr);
   ::ps::KVPairs<T> kvs;
   kvs.keys = keys;
   kvs.vals = vals;
   kvs.lens = lens;
-  const int cmd = 0;
   if (embedding_table_ranges_.count(keys[0])) {
     std::map<int, int> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
+    if (compress) {
+      attrs[4] = 1;
+    }
     Send(general_customer_.get(), ts, true, false, cmd, kvs, sparse_slicer_, attrs);
   } else {
+    // the sparse slicer merges the duplicate indices of embedding tables, merge them here for the other keys
+    ReduceSparseData(vals, lens, grad_index, indice_index, first_dim_size, outer_dim_size, &kvs.vals, &kvs.lens);
+    if (compress) {
+      CompressGradient(keys[0], grad_index, false, &kvs.vals, &kvs.lens);
+    }
     Send(general_customer_.get(), ts, true, false, cmd, kvs, round_robin_slicer_);
   }
   if (expected_result_count_[ts] < server_num_) {
     general_customer_->AddResponse(ts, server_num_ - expected_result_count_[ts]);
   }
   general_customer_->WaitRequest(ts);
+  if (embedding_cache_ != nullptr && embedding_table_ranges_.count(keys[0])) {
+    // the indices of the sparse gradient are stored as ints among the values
+    int indice_offset = std::accumulate(lens.begin(), lens.begin() + indice_index, 0);
+    embedding_cache_->OnPush(keys[0], reinterpret_cast<const int *>(vals.data()) + indice_offset, lens[indice_index]);
+  }
+}
+
+template <typename T>
+void WorkerProxy<T>::PushDenseData(const ::ps::SArray<::ps::Key> &keys, const ::ps::SArray<T> &vals,
+                                   const ::ps::SArray<int> &lens, size_t grad_index) {
+  if (GetCompression(keys[0]) == kCompressionNone) {
+    PushData(keys, vals, lens);
+    return;
+  }
+  ::ps::SArray<T> compressed_vals;
+  ::ps::SArray<int> compressed_lens;
+  compressed_vals.CopyFrom(vals);
+  compressed_lens.CopyFrom(lens);
+  CompressGradient(keys[0], grad_index, true, &compressed_vals, &compressed_lens);
+  PushData(keys, compressed_vals, compressed_lens, kPushCompressedGradCmd);
 }
 
 template <typename T>
@@ -282,6 +451,14 @@ void WorkerProxy<T>::PullData(const ::ps::SArray<::ps::Key> &keys, ::ps::SArray<
 
 template <typename T>
 void WorkerProxy<T>::Finalize() {
+  if (embedding_cache_ != nullptr) {
+    auto stats = embedding_cache_->stats();
+    MS_LOG(INFO) << "Embedding cache hit rate: " << stats.hit_rate() << ", hits: " << stats.hits
+                 << ", misses: " << stats.misses << ", average lookup latency: "
+                 << (stats.lookups == 0 ? 0 : stats.lookup_us / stats.lookups)
+                 << "us, of which fetching from servers: " << (stats.lookups == 0 ? 0 : stats.fetch_us / stats.lookups)
+                 << "us";
+  }
   int ts = obj_->NewRequest(::ps::kServerGroup);
   ::ps::KVPairs<T> kvs;
   kvs.keys.push_back(0);
@@ -503,6 +680,9 @@ void WorkerProxy<T>::SparseSlicer(int timestamp, const ::ps::KVPairs<T> &send, c
 
       kvs.lens = reduced_lens;
       kvs.vals = reduced_data;
+      if (attrs.count(4) > 0) {
+        CompressGradient(key, grad_index, false, &kvs.vals, &kvs.lens);
+      }
     }
 
     if (indices_size <= 0) {
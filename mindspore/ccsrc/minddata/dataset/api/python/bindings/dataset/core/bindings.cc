@@ -47,6 +47,10 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
                     .def("get_callback_timeout", &ConfigManager::callback_timeout)
                     .def("set_callback_timeout", &ConfigManager::set_callback_timeout)
+                    .def("get_coalesce_max_rows", &ConfigManager::coalesce_max_rows)
+                    .def("set_coalesce_max_rows", &ConfigManager::set_coalesce_max_rows)
+                    .def("get_mindrecord_prefetch_window", &ConfigManager::mindrecord_prefetch_window)
+                    .def("set_mindrecord_prefetch_window", &ConfigManager::set_mindrecord_prefetch_window)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
@@ -32,6 +32,8 @@ ConfigManager::ConfigManager()
       seed_(kCfgDefaultSeed),
       monitor_sampling_interval_(kCfgMonitorSamplingInterval),
       callback_timout_(kCfgCallbackTimeout),
+      coalesce_max_rows_(kCfgCoalesceMaxRows),
+      mindrecord_prefetch_window_(kCfgMindRecordPrefetchWindow),
       cache_host_(kCfgDefaultCacheHost),
       cache_port_(kCfgDefaultCachePort) {
   auto env_cache_host = std::getenv("MS_CACHE_HOST");
@@ -69,6 +71,8 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
   set_seed(j.value("seed", seed_));
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
+  set_coalesce_max_rows(j.value("coalesceMaxRows", coalesce_max_rows_));
+  set_mindrecord_prefetch_window(j.value("mindrecordPrefetchWindow", mindrecord_prefetch_window_));
   set_cache_host(j.value("cacheHost", cache_host_));
   set_cache_port(j.value("cachePort", cache_port_));
   return Status::OK();
@@ -120,6 +124,10 @@ void ConfigManager::set_monitor_sampling_interval(uint32_t interval) { monitor_s
 
 void ConfigManager::set_callback_timeout(uint32_t timeout) { callback_timout_ = timeout; }
 
+void ConfigManager::set_coalesce_max_rows(int32_t max_rows) { coalesce_max_rows_ = max_rows; }
+
+void ConfigManager::set_mindrecord_prefetch_window(int32_t window) { mindrecord_prefetch_window_ = window; }
+
 void ConfigManager::set_cache_host(std::string cache_host) { cache_host_ = cache_host; }
 
 void ConfigManager::set_cache_port(int32_t cache_port) { cache_port_ = cache_port; }
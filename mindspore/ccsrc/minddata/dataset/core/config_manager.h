@@ -143,6 +143,22 @@ class ConfigManager {
   // @return The timeout DSWaitedCallback would wait for before raising an error
   int32_t callback_timeout() const { return callback_timout_; }
 
+  // setter function
+  // @param max_rows - Max rows of a buffer coalesced by the output connectors, 0 to disable coalescing
+  void set_coalesce_max_rows(int32_t max_rows);
+
+  // getter function
+  // @return Max rows of a buffer coalesced by the output connectors
+  int32_t coalesce_max_rows() const { return coalesce_max_rows_; }
+
+  // setter function
+  // @param window - Max rows MindRecordOp reads ahead of its workers, 0 to disable the read-ahead
+  void set_mindrecord_prefetch_window(int32_t window);
+
+  // getter function
+  // @return Max rows MindRecordOp reads ahead of its workers
+  int32_t mindrecord_prefetch_window() const { return mindrecord_prefetch_window_; }
+
  private:
   int32_t rows_per_buffer_;
   int32_t num_parallel_workers_;
@@ -151,6 +167,8 @@ class ConfigManager {
   uint32_t seed_;
   uint32_t monitor_sampling_interval_;
   uint32_t callback_timout_;
+  int32_t coalesce_max_rows_;
+  int32_t mindrecord_prefetch_window_;
   std::string cache_host_;
   int32_t cache_port_;
 
@@ -62,9 +62,10 @@ Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape),
 Tensor::Tensor(Tensor &&other) noexcept
     : shape_(other.shape()),
       type_(other.type()),
-      data_(other.GetMutableBuffer()),
+      data_(other.data_),
       data_end_(other.data_end_),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_allocator_(std::move(other.data_allocator_)),
+      data_owner_(std::move(other.data_owner_)) {
   other.Invalidate();
 }
 
@@ -72,9 +73,10 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
   if (&other != this) {
     shape_ = other.shape();
     type_ = other.type();
-    data_ = other.GetMutableBuffer();
+    data_ = other.data_;
     data_end_ = other.data_end_;
     data_allocator_ = std::move(other.data_allocator_);
+    data_owner_ = std::move(other.data_owner_);
     other.Invalidate();
   }
   return *this;
@@ -132,6 +134,21 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateFromMemoryView(const TensorShape &shape, const DataType &type, const uchar *src,
+                                    std::shared_ptr<void> owner, TensorPtr *out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(src != nullptr, "Pointer to source data is null.");
+  CHECK_FAIL_RETURN_UNEXPECTED(owner != nullptr, "Owner of source data is null.");
+  CHECK_FAIL_RETURN_UNEXPECTED(shape.known(), "Invalid shape.");
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "Only numeric tensor can view memory.");
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  // the view is never written through, mutable accessors copy it first
+  (*out)->data_ = const_cast<uchar *>(src);
+  (*out)->data_end_ = (*out)->data_ + (*out)->SizeInBytes();
+  (*out)->data_owner_ = std::move(owner);
+  return Status::OK();
+}
+
 #ifdef ENABLE_PYTHON
 Status Tensor::CreateFromNpString(py::array arr, std::shared_ptr<Tensor> *out) {
   std::vector<dsize_t> shape;
@@ -335,7 +352,12 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
 // Name: Destructor
 // Description: Destructor
 Tensor::~Tensor() {
-  if (data_ != nullptr) {
+  if (data_owner_ != nullptr) {
+    // data_ is not ours, just release the owner
+    data_ = nullptr;
+    data_end_ = nullptr;
+    data_owner_ = nullptr;
+  } else if (data_ != nullptr) {
     if (data_allocator_ != nullptr) {
       data_allocator_->deallocate(data_);
       data_ = nullptr;
@@ -451,6 +473,39 @@ Status Tensor::AllocateBuffer(const dsize_t &length) {
   return Status::OK();
 }
 
+Status Tensor::DetachView() {
+  if (data_owner_ == nullptr) {
+    return Status::OK();
+  }
+  unsigned char *view = data_;
+  unsigned char *view_end = data_end_;
+  dsize_t length = view_end - view;
+  data_ = nullptr;
+  data_end_ = nullptr;
+  Status rc = AllocateBuffer(length);
+  if (rc.IsError()) {
+    data_ = view;
+    data_end_ = view_end;
+    return rc;
+  }
+  if (length > 0 && memcpy_s(data_, length, view, length) != 0) {
+    data_allocator_->deallocate(data_);
+    data_ = view;
+    data_end_ = view_end;
+    RETURN_STATUS_UNEXPECTED("Failed to copy the viewed data of tensor.");
+  }
+  // the owner keeps the view valid until it is copied
+  data_owner_ = nullptr;
+  return Status::OK();
+}
+
+void Tensor::DetachViewOrLog() {
+  Status rc = DetachView();
+  if (rc.IsError()) {
+    MS_LOG(ERROR) << "Tensor view is read only and could not be copied: " << rc.ToString();
+  }
+}
+
 Status Tensor::Reshape(const TensorShape &shape) {
   if (shape.NumOfElements() == shape_.NumOfElements()) {
     shape_ = shape;
@@ -467,6 +522,7 @@ void Tensor::Invalidate() {
   data_ = nullptr;
   data_end_ = nullptr;
   data_allocator_ = nullptr;
+  data_owner_ = nullptr;
 }
 
 template <typename T>
@@ -560,7 +616,7 @@ Status Tensor::InsertTensor(const std::vector<dsize_t> &ind, const std::shared_p
   } else {
     if (start_addr_of_ind != nullptr) {
       int ret_code =
-        memcpy_s(start_addr_of_ind, tensor->SizeInBytes(), tensor->GetMutableBuffer(), tensor->SizeInBytes());
+        memcpy_s(start_addr_of_ind, tensor->SizeInBytes(), tensor->GetBuffer(), tensor->SizeInBytes());
       if (ret_code == 0) {
         return Status::OK();
       } else {
@@ -603,6 +659,8 @@ Status Tensor::GetBufferInfo(Tensor *t, py::buffer_info *out) {
   if (format_desc.empty()) {
     RETURN_STATUS_UNEXPECTED("Cannot convert DE type tp pybind format");
   }
+  // python may write into the buffer
+  RETURN_IF_NOT_OK(t->DetachView());
   *out = py::buffer_info(t->GetMutableBuffer(),   /* Pointer to buffer */
                          t->type().SizeInBytes(), /* Size of one scalar */
                          format_desc,             /* Python struct-style format descriptor */
@@ -857,7 +915,9 @@ Status Tensor::CopyLastDimAt(const std::shared_ptr<Tensor> &src, const std::vect
   RETURN_IF_NOT_OK(shape_.ToFlatIndex(index, &dst_flat_ind));
 
   const unsigned char *src_addr = src->GetBuffer() + src_flat_ind * type_size;
-  unsigned char *dst_addr = GetMutableBuffer() + dst_flat_ind * type_size;
+  unsigned char *dst_addr = GetMutableBuffer();
+  CHECK_FAIL_RETURN_UNEXPECTED(dst_addr != nullptr, "Failed to copy the viewed data of tensor.");
+  dst_addr += dst_flat_ind * type_size;
   CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst_addr, len, src_addr, len) == 0, "memcpy error");
   return Status::OK();
 }
@@ -16,8 +16,11 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "minddata/dataset/util/task_manager.h"
@@ -50,6 +53,11 @@ namespace dataset {
 //        - The caller thread of pop() is not equal to the _expectConsumer. This is to enforce
 //          the ordering.
 //
+// Lock free mode:
+//   Each internal queue has exactly one producer, and consumers take it in turns to pop, so only one consumer
+//   touches the queues at a time. In lock free mode the internal queues are SpscQueue rings and the turn is passed
+//   through the atomic expect_consumer_, so neither Push nor Pop takes a lock unless it has to wait.
+//
 // Future improvement:
 //   1. Fault tolerant: Right now, if one of the worker dies, the Connector will not work
 //      properly.
@@ -71,8 +79,9 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+  // @param lock_free Use lock free rings for the internal queues, see the lock free mode at the top of this file.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : num_producers_(n_producers), num_consumers_(n_consumers), lock_free_(lock_free) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -84,7 +93,13 @@ class Connector {
 
     // Initialize the queues_ to have num_producers_ number of queues.
     // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    if (lock_free_) {
+      for (int32_t i = 0; i < num_producers_; ++i) {
+        ring_queues_.push_back(std::make_unique<SpscQueue<T>>(queue_capacity));
+      }
+    } else {
+      queues_.Init(num_producers_, queue_capacity);
+    }
   }
 
   // Destructor of Connector
@@ -98,6 +113,15 @@ class Connector {
                      T *result) noexcept {
     {
       MS_ASSERT(worker_id < num_consumers_);
+      if (lock_free_) {
+        RETURN_IF_NOT_OK(WaitTurn([this, worker_id]() { return expect_consumer_ == worker_id; }));
+        RETURN_IF_NOT_OK(PopFromQueue(pop_from_, result));
+        pop_from_ = (pop_from_ + 1) % num_producers_;
+        out_buffers_count_++;
+        expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
+        NotifyTurn();
+        return Status::OK();
+      }
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
       RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
@@ -116,6 +140,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A const lvalue element to be passed/added/pushed.
   Status Push(int32_t worker_id, const T &el) noexcept {
+    if (lock_free_) {
+      MS_ASSERT(worker_id < static_cast<int32_t>(ring_queues_.size()));
+      return (ring_queues_[worker_id]->Add(el));
+    }
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(el));
@@ -129,6 +157,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el An element to be passed/added/pushed.
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
+    if (lock_free_) {
+      MS_ASSERT(worker_id < static_cast<int32_t>(ring_queues_.size()));
+      return (ring_queues_[worker_id]->Add(std::forward<T>(el)));
+    }
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(std::forward<T>(el)));
@@ -140,6 +172,9 @@ class Connector {
     for (int i = 0; i < queues_.size(); ++i) {
       queues_[i]->ResetQue();
     }
+    for (auto &queue : ring_queues_) {
+      queue->ResetQue();
+    }
     expect_consumer_ = 0;
     pop_from_ = 0;
     out_buffers_count_ = 0;
@@ -163,6 +198,9 @@ class Connector {
     for (int32_t i = 0; i < queues_.size(); ++i) {
       size += queues_[i]->size();
     }
+    for (auto &queue : ring_queues_) {
+      size += queue->size();
+    }
     return size;
   }
 
@@ -171,6 +209,9 @@ class Connector {
     for (int32_t i = 0; i < queues_.size(); ++i) {
       capacity += queues_[i]->capacity();
     }
+    for (auto &queue : ring_queues_) {
+      capacity += queue->capacity();
+    }
     return capacity;
   }
 
@@ -179,6 +220,12 @@ class Connector {
   // @return
   Status Register(TaskGroup *vg) {
     Status rc = queues_.Register(vg);
+    for (auto &queue : ring_queues_) {
+      if (rc.IsError()) {
+        break;
+      }
+      rc = queue->Register(vg);
+    }
     if (rc.IsOk()) {
       rc = cv_.Register(vg->GetIntrpService());
     }
@@ -186,13 +233,55 @@ class Connector {
   }
 
  protected:
+  // Number of elements waiting in one internal queue. It may be stale, but it never overstates what the only
+  // consumer allowed to pop from the queue can get without blocking.
+  size_t QueueSize(int32_t index) const {
+    if (lock_free_) {
+      return ring_queues_[index]->size();
+    }
+    return queues_[index]->size();
+  }
+
+  Status PopFromQueue(int32_t index, T *result) {
+    if (lock_free_) {
+      return ring_queues_[index]->PopFront(result);
+    }
+    return queues_[index]->PopFront(result);
+  }
+
+  // Lock free mode: wait until pred() holds. Spin first, then sleep on cv_ if the turn is still not ours.
+  Status WaitTurn(const std::function<bool()> &pred) {
+    for (int32_t i = 0; i < SpscQueue<T>::kSpinCount; ++i) {
+      if (pred()) {
+        return Status::OK();
+      }
+      std::this_thread::yield();
+    }
+    ++turn_waiters_;
+    std::unique_lock<std::mutex> lk(m_);
+    Status rc = cv_.Wait(&lk, pred);
+    --turn_waiters_;
+    return rc;
+  }
+
+  // Lock free mode: called after passing the turn, only takes the lock if some consumer sleeps.
+  void NotifyTurn() {
+    if (turn_waiters_ > 0) {
+      std::unique_lock<std::mutex> lk(m_);
+      cv_.NotifyAll();
+    }
+  }
+
   std::string my_name_;
 
   // A list of Queues that are thread safe.
   QueueList<T> queues_;
 
+  // The lock free rings used instead of queues_ in lock free mode.
+  std::vector<std::unique_ptr<SpscQueue<T>>> ring_queues_;
+
   // The consumer that we allow to get the next data from pop()
-  int32_t expect_consumer_;
+  std::atomic<int32_t> expect_consumer_;
 
   // The index to the queues_ where the next data should be popped.
   int32_t pop_from_;
@@ -200,6 +289,11 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  bool lock_free_;
+
+  // Number of consumers sleeping on cv_ for their turn in lock free mode.
+  std::atomic<int32_t> turn_waiters_{0};
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
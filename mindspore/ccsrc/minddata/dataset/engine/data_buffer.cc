@@ -77,6 +77,21 @@ Status DataBuffer::PopRow(TensorRow *ptr) {
   return Status::OK();
 }
 
+Status DataBuffer::AppendRows(DataBuffer *other) {
+  if (other == nullptr || other->tensor_table_ == nullptr) {
+    return Status::OK();
+  }
+  if (tensor_table_ == nullptr) {
+    tensor_table_ = std::move(other->tensor_table_);
+    return Status::OK();
+  }
+  for (auto &row : *(other->tensor_table_)) {
+    tensor_table_->push_back(std::move(row));
+  }
+  other->tensor_table_->clear();
+  return Status::OK();
+}
+
 Status DataBuffer::SliceOff(int64_t number_of_rows) {
   while (number_of_rows > 0) {
     tensor_table_->pop_back();
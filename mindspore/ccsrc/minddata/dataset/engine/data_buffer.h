@@ -94,6 +94,9 @@ class DataBuffer {
 
   Status SliceOff(int64_t number_of_rows);
 
+  // Move all rows of another buffer to the end of this buffer, leaving the other one empty.
+  Status AppendRows(DataBuffer *other);
+
   // Replacing mTensorTable, the unique_ptr assignment will release the old TensorTable.
   void set_tensor_table(std::unique_ptr<TensorQTable> new_table) { tensor_table_ = std::move(new_table); }
 
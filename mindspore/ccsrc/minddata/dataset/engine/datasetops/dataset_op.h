@@ -237,6 +237,9 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// \brief Setter function, set the number of total repeats for the operator
   void set_total_repeats(int32_t total_repeats) { op_total_repeats_ = total_repeats; }
 
+  /// \brief Setter function, use lock free internal queues for the output connector created by CreateConnector()
+  void set_lock_free_connector(bool lock_free) { lock_free_connector_ = lock_free; }
+
   /// \brief Setter function, set the number of repeats per epoch for the operator
   void set_num_repeats_per_epoch(int32_t num_repeats_per_epoch) { op_num_repeats_per_epoch_ = num_repeats_per_epoch; }
 
@@ -283,6 +286,18 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return out_connector_ == nullptr ? int64_t(-1) : static_cast<int64_t>(out_connector_->out_buffers_count());
   }
 
+  /// \brief Counting number of rows sent out by a connector
+  int64_t ConnectorOutRowCount() const {
+    return out_connector_ == nullptr ? int64_t(-1) : out_connector_->out_rows_count();
+  }
+
+  /// \brief Setter function, set the max rows of a buffer coalesced by the output connector
+  void SetConnectorCoalesceRows(int32_t rows) {
+    if (out_connector_ != nullptr) {
+      out_connector_->SetCoalesceRows(rows);
+    }
+  }
+
   /// \brief Getter function
   /// \return connector size of current op
   int32_t ConnectorCapacity() const {
@@ -401,6 +416,7 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   int32_t op_current_repeats_;                                   // Current number of repeats the operator has handled
   int32_t op_current_epochs_;                                    // Current number of epochs the operator has handled
   std::unique_ptr<DbConnector> out_connector_;                   // Output Connector
+  bool lock_free_connector_;                                     // Output Connector uses lock free queues
   std::unordered_map<std::string, int32_t> column_name_id_map_;  // Mapping between col index and col name
   std::mutex column_name_map_mutex_;                             // For protecting shared access to the column map
   CallbackManager callback_manager_;                             // Manages callbacks associated with a DatasetOp
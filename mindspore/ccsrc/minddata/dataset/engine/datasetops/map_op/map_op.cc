@@ -40,6 +40,7 @@ MapOp::Builder::Builder() {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_num_workers_ = cfg->num_parallel_workers();
   build_op_connector_size_ = cfg->op_connector_size();
+  build_lock_free_connector_ = false;
 }
 
 // Check if the required parameters are set by the builder.
@@ -57,6 +58,7 @@ Status MapOp::Builder::Build(std::shared_ptr<MapOp> *ptr) {
   *ptr = std::make_shared<MapOp>(std::move(build_in_col_names_), std::move(build_out_col_names_),
                                  std::move(build_tensor_funcs_), build_num_workers_, build_op_connector_size_);
   (*ptr)->callback_manager_.AddCallbacks(std::move(builder_callbacks_));
+  (*ptr)->set_lock_free_connector(build_lock_free_connector_);
   return Status::OK();
 }
 
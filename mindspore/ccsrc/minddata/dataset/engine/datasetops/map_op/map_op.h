@@ -112,6 +112,13 @@ class MapOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method, the output connector uses lock free queues when set.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetLockFreeConnector(bool lock_free) {
+      build_lock_free_connector_ = lock_free;
+      return *this;
+    }
+
     // Setter method.
     // @return Builder setter method returns reference to the builder.
     Builder &AddCallbacks(const std::vector<std::shared_ptr<DSCallback>> &callbacks) {
@@ -131,6 +138,7 @@ class MapOp : public ParallelOp {
     std::vector<std::shared_ptr<TensorOp>> build_tensor_funcs_;
     int32_t build_num_workers_;
     int32_t build_op_connector_size_;
+    bool build_lock_free_connector_;
 
     // Check if the required parameters are set by the builder.
     // @return Status The error code return
@@ -139,6 +139,7 @@ Status MindRecordOp::Init() {
                                 num_padded_);
 
   CHECK_FAIL_RETURN_UNEXPECTED(rc == MSRStatus::SUCCESS, "MindRecordOp init failed, " + ErrnoToMessage(rc));
+  shard_reader_->SetPrefetchWindow(GlobalContext::config_manager()->mindrecord_prefetch_window());
 
   data_schema_ = std::make_unique<DataSchema>();
 
@@ -266,7 +267,7 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
     int32_t row_id = buffer_id * rows_per_buffer_ + i;
-    auto rc = shard_reader_->GetNextById(row_id, worker_id);
+    auto rc = shard_reader_->GetNextSliceById(row_id, worker_id);
     auto task_type = rc.first;
     auto tupled_buffer = rc.second;
     if (task_type == mindrecord::TaskType::kPaddedTask) {
@@ -277,8 +278,8 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
     if (tupled_buffer.empty()) break;
     if (task_type == mindrecord::TaskType::kCommonTask) {
       for (const auto &tupled_row : tupled_buffer) {
-        std::vector<uint8_t> columns_blob = std::get<0>(tupled_row);
-        mindrecord::json columns_json = std::get<1>(tupled_row);
+        const mindrecord::BlobSlice &columns_blob = std::get<0>(tupled_row);
+        const mindrecord::json &columns_json = std::get<1>(tupled_row);
         TensorRow tensor_row;
         RETURN_IF_NOT_OK(LoadTensorRow(&tensor_row, columns_blob, columns_json, task_type));
         tensor_table->push_back(std::move(tensor_row));
@@ -291,7 +292,7 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
-Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const mindrecord::BlobSlice &columns_blob,
                                    const mindrecord::json &columns_json, const mindrecord::TaskType task_type) {
   for (uint32_t i_col = 0; i_col < columns_to_load_.size(); i_col++) {
     auto column_name = columns_to_load_[i_col];
@@ -332,9 +333,9 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
         data = reinterpret_cast<const unsigned char *>(data_ptr.get());
       }
     } else {
-      auto has_column =
-        shard_column->GetColumnValueByName(column_name, columns_blob, columns_json, &data, &data_ptr, &n_bytes,
-                                           &column_data_type, &column_data_type_size, &column_shape);
+      auto has_column = shard_column->GetColumnValueByName(column_name, columns_blob.data, columns_blob.size,
+                                                           columns_json, &data, &data_ptr, &n_bytes, &column_data_type,
+                                                           &column_data_type_size, &column_shape);
       if (has_column == MSRStatus::FAILED) {
         RETURN_STATUS_UNEXPECTED("Invalid data, failed to retrieve data from mindrecord reader.");
       }
@@ -350,14 +351,26 @@ Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const std::vector<uint
     if (type == DataType::DE_STRING) {
       std::string s{data, data + n_bytes};
       RETURN_IF_NOT_OK(Tensor::CreateScalar(s, &tensor));
-    } else if (column.hasShape()) {
-      auto new_shape = TensorShape(column.shape());
-      RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
     } else {
-      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
-      auto new_shape = TensorShape(shapeDetails);
-      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      TensorShape new_shape = TensorShape::CreateUnknownRankShape();
+      if (column.hasShape()) {
+        new_shape = TensorShape(column.shape());
+        RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(num_elements), &new_shape));
+      } else {
+        std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_elements)};
+        new_shape = TensorShape(shapeDetails);
+      }
+      // Data still in the mapped shard file is viewed rather than copied, unless it is not aligned to its type.
+      // The mapping is read only, the tensor copies the view before an op writes to it in place.
+      bool in_mapping = columns_blob.mapping != nullptr && data >= columns_blob.data &&
+                        data + n_bytes <= columns_blob.data + columns_blob.size;
+      if (in_mapping && reinterpret_cast<uintptr_t>(data) % type.SizeInBytes() == 0 &&
+          new_shape.NumOfElements() > 0 &&
+          static_cast<uint64_t>(new_shape.NumOfElements() * type.SizeInBytes()) <= n_bytes) {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemoryView(new_shape, type, data, columns_blob.mapping, &tensor));
+      } else {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemory(new_shape, type, data, &tensor));
+      }
     }
     tensor_row->push_back(std::move(tensor));
   }
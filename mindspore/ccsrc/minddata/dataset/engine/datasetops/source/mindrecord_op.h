@@ -201,6 +201,10 @@ class MindRecordOp : public ParallelOp {
 
   bool load_dataset() const { return load_dataset_; }
 
+  // Getter method
+  // @return Counters of the read-ahead of the shard reader
+  mindrecord::ShardPrefetcher::Stats prefetch_stats() const { return shard_reader_->GetPrefetchStats(); }
+
   Status Init();
 
   // Base-class override for NodePass visitor acceptor.
@@ -218,9 +222,10 @@ class MindRecordOp : public ParallelOp {
 
   // Parses a single cell and puts the data into a tensor
   // @param tensor_row - the tensor row to put the parsed data in
-  // @param columns_blob - the blob data received from the reader
+  // @param columns_blob - the blob data received from the reader, numeric columns view it without copy if it is a slice
+  //     of a mapped shard file
   // @param columns_json - the data for fields received from the reader
-  Status LoadTensorRow(TensorRow *tensor_row, const std::vector<uint8_t> &columns_blob,
+  Status LoadTensorRow(TensorRow *tensor_row, const mindrecord::BlobSlice &columns_blob,
                        const mindrecord::json &columns_json, const mindrecord::TaskType task_type);
 
   // Private function for computing the assignment of the column name map.
@@ -26,6 +26,9 @@ namespace mindspore {
 namespace dataset {
 // DbConnector is a derived class from Connector with added logic to handle EOE and EOF.
 // The Connector class itself is responsible to ensure deterministic order on every run.
+// With coalescing enabled, a pop also takes the data buffers already waiting in the next queues (in the same round
+// robin order) and merges their rows into the popped buffer. It never waits for more rows, so coalescing reduces the
+// number of buffers handed over without adding latency.
 class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
  public:
   // Constructor of DbConnector
@@ -34,8 +37,12 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
-  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+  // @param lock_free Use lock free internal queues, see Connector.h.
+  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity, lock_free),
+        end_of_file_(false),
+        coalesce_rows_(0),
+        out_rows_count_(0) {}
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -48,6 +55,22 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
     return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
   }
 
+  // Set the max number of rows a popped buffer is coalesced to. 0 or 1 disables coalescing.
+  // It can be changed at any time, e.g. by a tuner running next to the pipeline.
+  void SetCoalesceRows(int32_t rows) { coalesce_rows_ = rows; }
+
+  int32_t coalesce_rows() const { return coalesce_rows_; }
+
+  // Number of rows in the data buffers popped so far.
+  int64_t out_rows_count() const { return out_rows_count_; }
+
+  // Resets the connector, see Connector::Reset().
+  void Reset() {
+    pending_.reset();
+    out_rows_count_ = 0;
+    Connector<std::unique_ptr<DataBuffer>>::Reset();
+  }
+
   // Get a unique_ptr<DataBuffer> from the DbConnector.
   // @note After the first EOF Buffer is encountered, subsequent pop()s will return EOF Buffer.
   // This will provide/propagate the EOF to all consumer threads of this Connector.
@@ -60,6 +83,8 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
     if (result == nullptr) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "[ERROR] nullptr detected when getting data from db connector");
+    } else if (lock_free_) {
+      return LockFreePopWithRetry(worker_id, result, retry_if_eoe);
     } else {
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return (expect_consumer_ == worker_id) || end_of_file_; }));
@@ -67,16 +92,11 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       if (end_of_file_) {
         *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
       } else {
-        RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
-        if (*result == nullptr) {
-          return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
-                        "[ERROR] nullptr detected when getting data from db connector");
-        }
+        RETURN_IF_NOT_OK(PopBuffer(result));
         // Setting the internal flag once the first EOF is encountered.
         if ((*result)->eof()) {
           end_of_file_ = true;
         }
-        pop_from_ = (pop_from_ + 1) % num_producers_;
       }
       // Do not increment expect_consumer_ when result is eoe and retry_if_eoe is set.
       if (!((*result)->eoe() && retry_if_eoe)) {
@@ -89,8 +109,75 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   }
 
  private:
+  // Same as PopWithRetry() but synchronized by the turn only. Once EOF is seen the turn is not passed around anymore.
+  Status LockFreePopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe) noexcept {
+    RETURN_IF_NOT_OK(WaitTurn([this, worker_id]() { return (expect_consumer_ == worker_id) || end_of_file_; }));
+    if (end_of_file_) {
+      *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
+      out_buffers_count_++;
+      return Status::OK();
+    }
+    RETURN_IF_NOT_OK(PopBuffer(result));
+    out_buffers_count_++;
+    if ((*result)->eof()) {
+      end_of_file_ = true;
+    } else if (!((*result)->eoe() && retry_if_eoe)) {
+      expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
+    }
+    NotifyTurn();
+    return Status::OK();
+  }
+
+  static bool IsDataBuffer(const DataBuffer &buffer) {
+    return !buffer.eoe() && !buffer.eof() && !buffer.wait() && !buffer.quit();
+  }
+
+  // Pop the next buffer in round robin order, coalescing the data buffers already waiting in the following queues
+  // into it. A control buffer met while coalescing is kept in pending_ and returned by the next pop.
+  // Must be called by the consumer holding the turn.
+  Status PopBuffer(std::unique_ptr<DataBuffer> *result) {
+    if (pending_ != nullptr) {
+      *result = std::move(pending_);
+    } else {
+      RETURN_IF_NOT_OK(PopFromQueue(pop_from_, result));
+      pop_from_ = (pop_from_ + 1) % num_producers_;
+    }
+    if (*result == nullptr) {
+      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                    "[ERROR] nullptr detected when getting data from db connector");
+    }
+    if (!IsDataBuffer(**result)) {
+      return Status::OK();
+    }
+    int32_t max_rows = coalesce_rows_;
+    while ((*result)->NumRows() < max_rows && QueueSize(pop_from_) > 0) {
+      std::unique_ptr<DataBuffer> next;
+      RETURN_IF_NOT_OK(PopFromQueue(pop_from_, &next));
+      pop_from_ = (pop_from_ + 1) % num_producers_;
+      if (next == nullptr) {
+        return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                      "[ERROR] nullptr detected when getting data from db connector");
+      }
+      if (!IsDataBuffer(*next)) {
+        pending_ = std::move(next);
+        break;
+      }
+      RETURN_IF_NOT_OK((*result)->AppendRows(next.get()));
+    }
+    out_rows_count_ += (*result)->NumRows();
+    return Status::OK();
+  }
+
   // A flag to indicate the end of stream has been encountered.
-  bool end_of_file_;
+  std::atomic<bool> end_of_file_;
+
+  // Max rows of a coalesced buffer, coalescing is disabled if it is less than 2.
+  std::atomic<int32_t> coalesce_rows_;
+
+  // A control buffer popped while coalescing, to be returned by the next pop.
+  std::unique_ptr<DataBuffer> pending_;
+
+  std::atomic<int64_t> out_rows_count_;
 };
 }  // namespace dataset
 }  // namespace mindspore
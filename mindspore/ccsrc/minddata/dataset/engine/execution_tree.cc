@@ -16,6 +16,8 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include <iostream>
 #include <string>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -29,6 +31,7 @@
 #include "mindspore/ccsrc/minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/engine/perf/buffer_coalescing.h"
 
 namespace mindspore {
 namespace dataset {
@@ -39,6 +42,7 @@ ExecutionTree::ExecutionTree() : id_count_(0) {
   prepare_flags_ = kDePrepNone;
   profiling_manager_ = std::make_unique<ProfilingManager>(this);
   optimize_ = common::GetEnv("OPTIMIZE") == "true" ? true : false;
+  coalesce_max_rows_ = GlobalContext::config_manager()->coalesce_max_rows();
 }
 
 // Destructor
@@ -141,6 +145,12 @@ Status ExecutionTree::Launch() {
     RETURN_IF_NOT_OK(profiling_manager_->LaunchMonitor());
   }
 
+  // The coalescing tuner samples the connectors of the ops, which exist once the tree is prepared
+  if (coalesce_max_rows_ > 1) {
+    buffer_coalescing_ = std::make_unique<BufferCoalescing>(this, coalesce_max_rows_);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("Buffer coalescing tuner", std::ref(*buffer_coalescing_)));
+  }
+
   MS_LOG(DEBUG) << "Printing the tree before launch tasks:\n" << ss.str();
   for (auto itr = this->begin(); itr != this->end(); ++itr) {
     // An inlined operator is one that has an output connector size of 0, and it does not
@@ -30,6 +30,7 @@ namespace dataset {
 // Forward declares
 class TaskGroup;
 class DatasetOp;
+class BufferCoalescing;
 
 class ExecutionTree {
  public:
@@ -249,6 +250,19 @@ class ExecutionTree {
   // Optional optimizations status
   bool OptimizationEnabled() const { return optimize_; }
 
+  // Set the max rows of a buffer coalesced by the output connectors if tree has not been launched yet.
+  // When greater than 1, a tuner task adapts the coalescing of each connector to its observed throughput.
+  Status SetCoalesceMaxRows(int32_t max_rows) {
+    if (tree_state_ == kDeTStateExecuting || tree_state_ == kDeTStateFinished) {
+      RETURN_STATUS_UNEXPECTED("Tree has already been launched, buffer coalescing can not be changed.");
+    }
+    coalesce_max_rows_ = max_rows;
+    return Status::OK();
+  }
+
+  // Getter for the max rows of a buffer coalesced by the output connectors, 0 if coalescing is disabled
+  int32_t coalesce_max_rows() const { return coalesce_max_rows_; }
+
   // Getter function to get the total number of epochs to be run on this tree.
   // @return total number of epochs
   int32_t num_epochs() { return num_epochs_; }
@@ -270,6 +284,8 @@ class ExecutionTree {
   int32_t num_epochs_;                                   // Total number of epochs to run for this tree
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
   bool optimize_;                                        // Flag to enable optional optimizations
+  int32_t coalesce_max_rows_;                            // Max rows of a buffer coalesced by the connectors
+  std::unique_ptr<BufferCoalescing> buffer_coalescing_;  // Tuner of the buffer coalescing
 };
 
 inline bool operator==(const ExecutionTree::Iterator &lhs, const ExecutionTree::Iterator &rhs) { return lhs == rhs; }
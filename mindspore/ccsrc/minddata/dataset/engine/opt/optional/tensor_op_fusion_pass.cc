@@ -15,37 +15,77 @@
  */
 
 #include <memory>
+#include <vector>
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
 
 namespace mindspore {
 namespace dataset {
 
 Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
-  // Most primitive pattern: DecodeOp immediately followed by RandomCropAndResizeOp
-  // Abstract into a more general member function that can find any pattern, expressed
-  // by regular expressions, for instance.
-  // Add a list of optimisation policies. For now, just this lambda
-  auto FindPattern = [](auto &tfuncs) {
-    auto it =
-      std::find_if(tfuncs.begin(), tfuncs.end(), [](const auto &tf) -> bool { return tf->Name() == kDecodeOp; });
+  // Pattern matched from every DecodeOp:
+  //   Decode [RandomCropAndResize | Resize] [RandomHorizontalFlip] [Normalize [HwcToChw]]
+  // A chain up to Normalize is replaced by one FusedImageOp. Without Normalize, only DecodeOp immediately followed by
+  // RandomCropAndResizeOp is fused, into RandomCropDecodeResizeOp.
+  auto &tfuncs = node->TFuncs();
+  for (auto it = tfuncs.begin(); it != tfuncs.end(); ++it) {
+    if ((*it)->Name() != kDecodeOp) {
+      continue;
+    }
     auto next = it + 1;
-    if (it != tfuncs.end() && next != tfuncs.end() && (*next)->Name() == kRandomCropAndResizeOp) {
-      return it;
-    } else {
-      return tfuncs.end();
+    RandomCropAndResizeOp *crop_resize = nullptr;
+    std::shared_ptr<TensorOp> resize;
+    if (next != tfuncs.end() && (*next)->Name() == kRandomCropAndResizeOp) {
+      crop_resize = static_cast<RandomCropAndResizeOp *>(next->get());
+      ++next;
+    } else if (next != tfuncs.end() && (*next)->Name() == kResizeOp) {
+      resize = *next;
+      ++next;
+    }
+    RandomHorizontalFlipOp *flip = nullptr;
+    if (next != tfuncs.end() && (*next)->Name() == kRandomHorizontalFlipOp) {
+      flip = static_cast<RandomHorizontalFlipOp *>(next->get());
+      ++next;
+    }
+    NormalizeOp *normalize = nullptr;
+    bool hwc_to_chw = false;
+    if (next != tfuncs.end() && (*next)->Name() == kNormalizeOp) {
+      normalize = static_cast<NormalizeOp *>(next->get());
+      ++next;
+      if (next != tfuncs.end() && (*next)->Name() == kHwcToChwOp) {
+        hwc_to_chw = true;
+        ++next;
+      }
     }
-  };
 
-  auto &tfuncs = node->TFuncs();
-  auto it = FindPattern(tfuncs);
-  if (it != tfuncs.end()) {
-    auto next = it + 1;
-    auto op = static_cast<RandomCropAndResizeOp *>(next->get());
-    *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
-    tfuncs.erase(next);
+    // the fused kernel works on 3 channel RGB images only
+    if (normalize == nullptr || !static_cast<DecodeOp *>(it->get())->is_rgb_format()) {
+      if (crop_resize != nullptr) {
+        *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*crop_resize));
+        it = tfuncs.erase(it + 1) - 1;
+      }
+      continue;
+    }
+    std::shared_ptr<TensorOp> decode = *it;
+    if (crop_resize != nullptr) {
+      decode = std::make_shared<RandomCropDecodeResizeOp>(*crop_resize);
+    }
+    std::vector<float> mean(normalize->mean()->Size());
+    std::vector<float> std(normalize->std()->Size());
+    for (dsize_t i = 0; i < static_cast<dsize_t>(mean.size()); ++i) {
+      RETURN_IF_NOT_OK(normalize->mean()->GetItemAt<float>(&mean[i], {i}));
+    }
+    for (dsize_t i = 0; i < static_cast<dsize_t>(std.size()); ++i) {
+      RETURN_IF_NOT_OK(normalize->std()->GetItemAt<float>(&std[i], {i}));
+    }
+    float flip_probability = flip != nullptr ? flip->probability() : 0;
+    *it = std::make_shared<FusedImageOp>(decode, resize, flip_probability, mean, std, hwc_to_chw);
+    it = tfuncs.erase(it + 1, next) - 1;
   }
   if (modified != nullptr) {
     *modified = true;
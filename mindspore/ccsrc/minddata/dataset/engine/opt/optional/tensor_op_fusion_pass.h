@@ -24,7 +24,10 @@ namespace dataset {
 
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
 /// \brief And optional optimization pass identifying and fusing
-///     tensor ops within MapOp
+///     tensor ops within MapOp. A Decode, crop/resize, flip, Normalize and
+///     HwcToChw chain becomes a single FusedImageOp, and a Decode followed
+///     by RandomCropAndResize becomes RandomCropDecodeResizeOp
+
 class TensorOpFusionPass : public NodePass {
   /// \brief Identifies and fuses tensor ops within MapOp
   /// \param[in] node The node being visited
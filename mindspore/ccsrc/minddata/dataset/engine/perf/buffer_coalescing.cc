@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/buffer_coalescing.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/execution_tree.h"
+
+namespace mindspore {
+namespace dataset {
+// Only the latest two samples are needed to get the throughput
+constexpr int64_t kCoalescingSamples = 2;
+
+BufferCoalescing::BufferCoalescing(ExecutionTree *tree, int32_t max_rows) : tree_(tree), max_rows_(max_rows) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  sampling_interval_ = cfg->monitor_sampling_interval();
+  throughput_ = std::make_unique<ConnectorThroughput>(tree_, kCoalescingSamples);
+  prev_buffers_.resize(throughput_->InitNodes(), 0);
+  prev_rows_.resize(prev_buffers_.size(), 0);
+}
+
+Status BufferCoalescing::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+  while (!this_thread::is_interrupted() && !(tree_->isFinished())) {
+    RETURN_IF_NOT_OK(Tune());
+    std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
+  }
+  return Status::OK();
+}
+
+Status BufferCoalescing::Tune() {
+  RETURN_IF_NOT_OK(throughput_->Sample());
+  std::vector<double> throughput = throughput_->LatestThroughput();
+  size_t col = 0;
+  for (auto &node : *tree_) {
+    if (col >= throughput.size()) {
+      break;
+    }
+    int64_t buffers = node.ConnectorOutBufferCount();
+    int64_t rows = node.ConnectorOutRowCount();
+    // Inlined ops have no connector, and the connector of DeviceQueueOp is not used.
+    if (buffers >= 0 && rows >= 0 && !node.inlined() && node.Name() != "DeviceQueueOp") {
+      // Buffers are counted by the connector throughput, turn them into rows with the rows per buffer
+      // of the last interval. The row rate does not change with the coalescing limit.
+      double rows_per_buffer = 1.0;
+      if (buffers > prev_buffers_[col] && rows > prev_rows_[col]) {
+        rows_per_buffer = static_cast<double>(rows - prev_rows_[col]) / (buffers - prev_buffers_[col]);
+      }
+      double row_rate = throughput[col] * rows_per_buffer;
+      auto limit = static_cast<int32_t>(std::min<double>(row_rate * kTargetLatencyMs, max_rows_));
+      node.SetConnectorCoalesceRows(std::max(limit, 1));
+      prev_buffers_[col] = buffers;
+      prev_rows_[col] = rows;
+    }
+    col++;
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BUFFER_COALESCING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BUFFER_COALESCING_H_
+
+#include <memory>
+#include <vector>
+#include "minddata/dataset/engine/perf/connector_throughput.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class ExecutionTree;
+
+// BufferCoalescing tunes how many rows the output connector of each op may coalesce into one buffer.
+// Every sampling interval it samples the connector throughput and sets the limit to the number of rows
+// the connector moves in kTargetLatencyMs, capped by max_rows. A slow connector thus keeps handing over
+// small buffers, while a busy one merges its queued buffers and saves the per-buffer overhead.
+class BufferCoalescing {
+ public:
+  // Time worth of rows a coalesced buffer may hold
+  static constexpr double kTargetLatencyMs = 1.0;
+
+  // @param tree - The execution tree to tune, no ownership
+  // @param max_rows - The max rows of a coalesced buffer
+  BufferCoalescing(ExecutionTree *tree, int32_t max_rows);
+
+  ~BufferCoalescing() = default;
+
+  // Functor for the tuner main loop.
+  // This function will be the entry point of mindspore::Dataset::Task
+  Status operator()();
+
+  // Sample the connectors once and update the coalescing limit of every op.
+  Status Tune();
+
+ private:
+  ExecutionTree *tree_;
+  int32_t max_rows_;
+  int64_t sampling_interval_;
+  std::unique_ptr<ConnectorThroughput> throughput_;
+  std::vector<int64_t> prev_buffers_;
+  std::vector<int64_t> prev_rows_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_BUFFER_COALESCING_H_
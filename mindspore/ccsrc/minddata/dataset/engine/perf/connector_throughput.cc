@@ -128,6 +128,13 @@ Status ConnectorThroughput::SaveToFile() {
   return Status::OK();
 }
 
+std::vector<double> ConnectorThroughput::LatestThroughput() {
+  if (throughput_.size() == 0) {
+    return {};
+  }
+  return throughput_.Row(throughput_.size() - 1);
+}
+
 Status ConnectorThroughput::Init(const std::string &dir_path, const std::string &device_id) {
   file_path_ = (Path(dir_path) / Path("pipeline_profiling_" + device_id + ".json")).toString();
   return Status::OK();
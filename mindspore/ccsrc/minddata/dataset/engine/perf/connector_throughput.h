@@ -87,6 +87,10 @@ class ConnectorThroughput : public Sampling {
 
   json ParseOpInfo(const DatasetOp &node, const std::vector<double> &thr);
 
+  // Throughput (buffers per ms) of every node in the last sample, in the order of the tree iterator.
+  // Empty if nothing has been sampled yet.
+  std::vector<double> LatestThroughput();
+
  private:
   ExecutionTree *tree_ = nullptr;  // ExecutionTree pointer
   int64_t max_rows_;
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/mindrecord_prefetch_sampling.h"
+#include <fstream>
+#include <string>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/source/mindrecord_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/path.h"
+
+namespace mindspore {
+namespace dataset {
+void MindRecordPrefetchSampling::InitOps() {
+  for (auto &node : *tree_) {
+    auto op = dynamic_cast<MindRecordOp *>(&node);
+    if (op != nullptr) {
+      ops_.push_back(op);
+    }
+  }
+  ops_ready_ = true;
+}
+
+// Sample action
+Status MindRecordPrefetchSampling::Sample() {
+  if (!ops_ready_) {
+    InitOps();
+  }
+  if (ops_.empty()) {
+    return Status::OK();
+  }
+  PrefetchSample cur_row;
+  for (auto op : ops_) {
+    cur_row.push_back(op->prefetch_stats());
+  }
+  // Push new row of sample
+  sample_table_.push_back(cur_row);
+  return Status::OK();
+}
+
+// Save profiling data to file
+Status MindRecordPrefetchSampling::SaveToFile() {
+  if (ops_.empty()) {
+    return Status::OK();
+  }
+  json output;
+  output["sampling_interval"] = GlobalContext::config_manager()->monitor_sampling_interval();
+  for (size_t idx = 0; idx < ops_.size(); ++idx) {
+    std::vector<int64_t> prefetched_rows;
+    std::vector<int64_t> read_requests;
+    std::vector<int64_t> read_bytes;
+    std::vector<int64_t> hit_rows;
+    std::vector<int64_t> miss_rows;
+    std::string backend;
+    for (const auto &sample : sample_table_) {
+      const auto &stats = sample[idx];
+      prefetched_rows.push_back(stats.prefetched_rows);
+      read_requests.push_back(stats.read_requests);
+      read_bytes.push_back(stats.read_bytes);
+      hit_rows.push_back(stats.hit_rows);
+      miss_rows.push_back(stats.miss_rows);
+      if (!stats.backend.empty()) {
+        backend = stats.backend;
+      }
+    }
+    json json_node;
+    json_node["op_id"] = ops_[idx]->id();
+    json_node["op_type"] = ops_[idx]->Name();
+    json_node["backend"] = backend;
+    json_node["window"] = GlobalContext::config_manager()->mindrecord_prefetch_window();
+    json_node["metrics"] = {{"prefetched_rows", prefetched_rows},
+                            {"read_requests", read_requests},
+                            {"read_bytes", read_bytes},
+                            {"hit_rows", hit_rows},
+                            {"miss_rows", miss_rows}};
+    output["op_info"].push_back(json_node);
+  }
+
+  // Discard the content of the file when opening.
+  std::ofstream os(file_path_, std::ios::trunc);
+  os << output;
+  return Status::OK();
+}
+
+Status MindRecordPrefetchSampling::Init(const std::string &dir_path, const std::string &device_id) {
+  file_path_ = (Path(dir_path) / Path("mindrecord_prefetch_" + device_id + ".json")).toString();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_MINDRECORD_PREFETCH_SAMPLING_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_MINDRECORD_PREFETCH_SAMPLING_H_
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/engine/perf/profiling.h"
+#include "minddata/mindrecord/include/shard_prefetcher.h"
+
+using json = nlohmann::json;
+
+namespace mindspore {
+namespace dataset {
+class ExecutionTree;
+class MindRecordOp;
+
+// MindRecord prefetch sampling samples the read-ahead counters of each MindRecordOp in the pipeline.
+// The counters are cumulative, one column of samples per op.
+class MindRecordPrefetchSampling : public Sampling {
+  using PrefetchSample = std::vector<mindrecord::ShardPrefetcher::Stats>;
+  using PrefetchSampleTable = std::vector<PrefetchSample>;
+
+ public:
+  explicit MindRecordPrefetchSampling(ExecutionTree *tree) : tree_(tree) {}
+
+  ~MindRecordPrefetchSampling() override = default;
+
+  // Driver function for prefetch sampling.
+  // This function samples the read-ahead counters of every MindRecordOp within the ExecutionTree
+  Status Sample() override;
+
+  std::string Name() const override { return kMindRecordPrefetchSamplingName; }
+
+  // Save sampling data to file
+  // @return Status - The error code return
+  Status SaveToFile() override;
+
+  Status Init(const std::string &dir_path, const std::string &device_id) override;
+
+ private:
+  // Collect the MindRecordOps of the tree on the first sample
+  void InitOps();
+
+  ExecutionTree *tree_ = nullptr;     // ExecutionTree pointer
+  std::vector<MindRecordOp *> ops_;   // MindRecordOps in the tree, no ownership
+  bool ops_ready_ = false;            // if ops_ is collected
+  PrefetchSampleTable sample_table_;  // Dataset structure to store all samples of prefetch sampling
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_MINDRECORD_PREFETCH_SAMPLING_H_
@@ -24,6 +24,9 @@
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/connector_throughput.h"
 #include "minddata/dataset/engine/perf/dataset_iterator_tracing.h"
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/perf/mindrecord_prefetch_sampling.h"
+#endif
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -84,6 +87,12 @@ Status ProfilingManager::Initialize() {
   std::shared_ptr<Sampling> connector_thr_sampling = std::make_shared<ConnectorThroughput>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(connector_thr_sampling));
 
+#ifndef ENABLE_ANDROID
+  // mindrecord_prefetch node only writes its file if the tree has a MindRecordOp
+  std::shared_ptr<Sampling> mindrecord_prefetch_sampling = std::make_shared<MindRecordPrefetchSampling>(tree_);
+  RETURN_IF_NOT_OK(RegisterSamplingNode(mindrecord_prefetch_sampling));
+#endif
+
   return Status::OK();
 }
 
@@ -110,6 +110,18 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor viewing read only memory owned by someone else. No data is copied, and the owner is kept
+  /// alive as long as the tensor. The view is copied into a buffer of the tensor before it is first written through
+  /// any mutable accessor.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor
+  /// \param[in] src pointer to the source data, of the size determined from the shape and type
+  /// \param[in] owner owner of the source data
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromMemoryView(const TensorShape &shape, const DataType &type, const uchar *src,
+                                     std::shared_ptr<void> owner, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -228,6 +240,7 @@ class Tensor {
   /// \param[in] value of type `T`
   template <typename T>
   Status SetItemAt(const std::vector<dsize_t> &index, const T &value) {
+    RETURN_IF_NOT_OK(DetachView());
     T *ptr = nullptr;
     RETURN_IF_NOT_OK(GetItemPtr<T>(&ptr, index));
     *ptr = value;
@@ -238,6 +251,7 @@ class Tensor {
   /// \param[in] index
   /// \param[in] value of type std::string
   Status SetItemAt(const std::vector<dsize_t> &index, const std::string &value) {
+    RETURN_IF_NOT_OK(DetachView());
     RETURN_UNEXPECTED_IF_NULL(data_);
     uchar *ptr = nullptr;
     offset_t length = 0;
@@ -265,6 +279,7 @@ class Tensor {
   template <typename T>
   Status Fill(const T &value) {
     CHECK_FAIL_RETURN_UNEXPECTED(type_ != DataType::DE_STRING, "Cannot use fill on tensor of strings.");
+    RETURN_IF_NOT_OK(DetachView());
     int64_t cellSize = type_.SizeInBytes();
     if ((data_ != nullptr) && type_.IsCompatible<T>()) {
       for (dsize_t i = 0; i < Size(); i++) {
@@ -287,6 +302,10 @@ class Tensor {
   /// \return bool - true if tensor is empty
   bool HasData() const { return data_ != nullptr; }
 
+  /// Check if tensor views memory it does not own, see CreateFromMemoryView
+  /// \return bool - true if the data is not copied yet
+  bool IsView() const { return data_owner_ != nullptr; }
+
   /// Reshape the tensor. The given shape should have the same number of elements in the Tensor
   /// \param shape
   virtual Status Reshape(const TensorShape &shape);
@@ -581,6 +600,7 @@ class Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> begin() {
+    DetachViewOrLog();
     return TensorIterator<T>(data_);
   }
 
@@ -589,6 +609,7 @@ class Tensor {
   /// \return TensorIterator
   template <typename T>
   TensorIterator<T> end() {
+    DetachViewOrLog();
     return TensorIterator<T>(data_end_);
   }
 
@@ -605,9 +626,16 @@ class Tensor {
   Status AllocateBuffer(const dsize_t &length);
 
   /// Get the starting memory address for the data of the tensor.  This potentially
-  /// drives an allocation if the data is null.
-  /// \return unsigned char*
-  unsigned char *GetMutableBuffer() { return data_; }
+  /// drives an allocation if the data is null, or a copy if the tensor is a view.
+  /// \return unsigned char*, nullptr if a view could not be copied
+  unsigned char *GetMutableBuffer() { return DetachView().IsOk() ? data_ : nullptr; }
+
+  /// Copy the viewed memory into a buffer owned by the tensor, so it can be written. Does nothing if not a view.
+  /// \return Status code
+  Status DetachView();
+
+  /// DetachView for the accessors that can not return a status
+  void DetachViewOrLog();
 
   /// A function that prints Tensor recursively, first called by print
   /// \param[in] out
@@ -657,6 +685,8 @@ class Tensor {
   CharAllocPtr data_allocator_;
   /// pointer to the end of the physical data
   unsigned char *data_end_ = nullptr;
+  /// owner of data_ if the tensor is a view of memory it does not allocate
+  std::shared_ptr<void> data_owner_;
 
  private:
 #ifdef ENABLE_ANDROID
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+#include <utility>
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/util/random.h"
+
+namespace mindspore {
+namespace dataset {
+FusedImageOp::FusedImageOp(std::shared_ptr<TensorOp> decode, std::shared_ptr<TensorOp> resize, float flip_probability,
+                           std::vector<float> mean, std::vector<float> std, bool hwc_to_chw)
+    : decode_(std::move(decode)),
+      resize_(std::move(resize)),
+      random_flip_(flip_probability > 0),
+      distribution_(flip_probability),
+      mean_(std::move(mean)),
+      std_(std::move(std)),
+      hwc_to_chw_(hwc_to_chw) {
+  rnd_.seed(GetSeed());
+}
+
+Status FusedImageOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  std::shared_ptr<Tensor> image;
+  RETURN_IF_NOT_OK(decode_->Compute(input, &image));
+  if (resize_ != nullptr) {
+    std::shared_ptr<Tensor> resized;
+    RETURN_IF_NOT_OK(resize_->Compute(image, &resized));
+    image = std::move(resized);
+  }
+  bool flip = random_flip_ && distribution_(rnd_);
+  return FlipNormalizeTranspose(image, output, mean_, std_, flip, hwc_to_chw_);
+}
+
+void FusedImageOp::Print(std::ostream &out) const {
+  out << Name() << ": " << decode_->Name();
+  if (resize_ != nullptr) {
+    out << " " << resize_->Name();
+  }
+  if (random_flip_) {
+    out << " " << kRandomHorizontalFlipOp;
+  }
+  out << " " << kNormalizeOp;
+  if (hwc_to_chw_) {
+    out << " " << kHwcToChwOp;
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// FusedImageOp replaces a chain of Decode, [RandomCropAndResize | Resize], [RandomHorizontalFlip], Normalize and
+// [HwcToChw] found by the TensorOpFusionPass.
+// The decode stage decodes only the crop window of a JPEG image (RandomCropDecodeResizeOp), and the flip,
+// normalization and transpose are done in one pass from the uint8 image into the float output, so that none of the
+// intermediate images is materialized.
+class FusedImageOp : public TensorOp {
+ public:
+  // @param decode - The decode stage, DecodeOp or RandomCropDecodeResizeOp
+  // @param resize - An optional resize stage run after decoding, nullptr if none
+  // @param flip_probability - The probability of the horizontal flip, 0 if there is no flip
+  // @param mean - The mean of each channel in RGB order
+  // @param std - The std of each channel in RGB order
+  // @param hwc_to_chw - Whether to output the image in CHW format
+  FusedImageOp(std::shared_ptr<TensorOp> decode, std::shared_ptr<TensorOp> resize, float flip_probability,
+               std::vector<float> mean, std::vector<float> std, bool hwc_to_chw);
+
+  ~FusedImageOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  std::string Name() const override { return kFusedImageOp; }
+
+ private:
+  std::shared_ptr<TensorOp> decode_;
+  std::shared_ptr<TensorOp> resize_;
+  bool random_flip_;
+  std::mt19937 rnd_;
+  std::bernoulli_distribution distribution_;
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  bool hwc_to_chw_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_IMAGE_OP_H_
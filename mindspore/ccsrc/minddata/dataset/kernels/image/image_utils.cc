@@ -611,6 +611,81 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   }
 }
 
+namespace {
+// The loops below have no branch and a unit stride on the output, so that they get vectorized by the compiler.
+template <bool kFlip>
+void NormalizeRowToPlanes(const uint8_t *src, int width, const float *scale, const float *shift, float *dst_r,
+                          float *dst_g, float *dst_b) {
+  for (int x = 0; x < width; x++) {
+    const uint8_t *pixel = src + (kFlip ? width - 1 - x : x) * 3;
+    dst_r[x] = pixel[0] * scale[0] + shift[0];
+    dst_g[x] = pixel[1] * scale[1] + shift[1];
+    dst_b[x] = pixel[2] * scale[2] + shift[2];
+  }
+}
+
+template <bool kFlip>
+void NormalizeRowInterleaved(const uint8_t *src, int width, const float *scale, const float *shift, float *dst) {
+  for (int x = 0; x < width; x++) {
+    const uint8_t *pixel = src + (kFlip ? width - 1 - x : x) * 3;
+    dst[x * 3] = pixel[0] * scale[0] + shift[0];
+    dst[x * 3 + 1] = pixel[1] * scale[1] + shift[1];
+    dst[x * 3 + 2] = pixel[2] * scale[2] + shift[2];
+  }
+}
+}  // namespace
+
+Status FlipNormalizeTranspose(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                              const std::vector<float> &mean, const std::vector<float> &std, bool flip,
+                              bool hwc_to_chw) {
+  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
+  if (!input_cv->mat().data || input_cv->Rank() != 3 || input_cv->shape()[2] != 3 ||
+      input_cv->type() != DataType::DE_UINT8) {
+    RETURN_STATUS_UNEXPECTED("Input image is not a <H,W,3> uint8 image.");
+  }
+  if (mean.size() != 3 || std.size() != 3) {
+    std::string err_msg = "Mean and std should be of size 3.";
+    return Status(StatusCode::kShapeMisMatch, err_msg);
+  }
+  int height = input_cv->shape()[0];
+  int width = input_cv->shape()[1];
+  float scale[3];
+  float shift[3];
+  for (int c = 0; c < 3; c++) {
+    if (std[c] == 0) {
+      RETURN_STATUS_UNEXPECTED("Std of each channel should not be zero.");
+    }
+    scale[c] = 1.0f / std[c];
+    shift[c] = -mean[c] / std[c];
+  }
+  TensorShape out_shape = hwc_to_chw ? TensorShape({3, height, width}) : TensorShape({height, width, 3});
+  std::shared_ptr<Tensor> output_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, DataType(DataType::DE_FLOAT32), &output_tensor));
+  auto dst = reinterpret_cast<float *>(output_tensor->GetMutableBuffer());
+  const cv::Mat &in_image = input_cv->mat();
+  size_t plane = static_cast<size_t>(height) * width;
+  for (int y = 0; y < height; y++) {
+    const uint8_t *src = in_image.ptr<uint8_t>(y);
+    if (hwc_to_chw) {
+      float *dst_r = dst + static_cast<size_t>(y) * width;
+      if (flip) {
+        NormalizeRowToPlanes<true>(src, width, scale, shift, dst_r, dst_r + plane, dst_r + 2 * plane);
+      } else {
+        NormalizeRowToPlanes<false>(src, width, scale, shift, dst_r, dst_r + plane, dst_r + 2 * plane);
+      }
+    } else {
+      float *dst_row = dst + static_cast<size_t>(y) * width * 3;
+      if (flip) {
+        NormalizeRowInterleaved<true>(src, width, scale, shift, dst_row);
+      } else {
+        NormalizeRowInterleaved<false>(src, width, scale, shift, dst_row);
+      }
+    }
+  }
+  *output = output_tensor;
+  return Status::OK();
+}
+
 Status AdjustBrightness(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float &alpha) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
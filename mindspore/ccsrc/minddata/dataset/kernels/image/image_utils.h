@@ -182,6 +182,17 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                  const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
 
+/// \brief Returns flipped, normalized and transposed image in one pass over the pixels
+/// \param input: Tensor of shape <H,W,3> and type DE_UINT8 in RGB order.
+/// \param mean: mean of each channel in RGB order, of size 3
+/// \param std: std of each channel in RGB order, of size 3
+/// \param flip: whether to flip the image horizontally
+/// \param hwc_to_chw: whether to output the channels as planes
+/// \param output: Normalized image Tensor of type DE_FLOAT32 and shape <3,H,W> if hwc_to_chw else <H,W,3>
+Status FlipNormalizeTranspose(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                              const std::vector<float> &mean, const std::vector<float> &std, bool flip,
+                              bool hwc_to_chw);
+
 /// \brief Returns image with adjusted brightness.
 /// \param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param alpha: Alpha value to adjust brightness by. Should be a positive number.
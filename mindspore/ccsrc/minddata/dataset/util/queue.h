@@ -17,9 +17,11 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -169,6 +171,144 @@ class Queue {
   CondVar full_cv_;
 };
 
+// A bounded queue for exactly one producer thread and one consumer thread at a time, based on a ring of fixed size.
+// Add and PopFront take no lock unless the queue is full or empty respectively. In that case the caller spins for a
+// short while before it sleeps on a condition variable, and the other side only takes the mutex if someone sleeps.
+template <typename T>
+class SpscQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+
+  // Number of yields before a blocked caller goes to sleep.
+  static constexpr int32_t kSpinCount = 128;
+
+  explicit SpscQueue(int sz)
+      : sz_(sz), arr_(Services::GetAllocator<T>()), head_(0), tail_(0), my_name_(Services::GetUniqueID()) {
+    Status rc = arr_.allocate(sz);
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << "Fail to create a queue.";
+      std::terminate();
+    } else {
+      MS_LOG(DEBUG) << "Create SPSC Q with uuid " << my_name_ << " of size " << sz_ << ".";
+    }
+  }
+
+  virtual ~SpscQueue() { ResetQue(); }
+
+  size_t size() const { return tail_ - head_; }
+
+  size_t capacity() const { return sz_; }
+
+  bool empty() const { return head_ == tail_; }
+
+  void Reset() { ResetQue(); }
+
+  // Producer
+  Status Add(const_reference ele) noexcept {
+    return Produce([&ele](pointer p) { *p = ele; });
+  }
+
+  Status Add(T &&ele) noexcept {
+    return Produce([&ele](pointer p) { *p = std::forward<T>(ele); });
+  }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    return Produce([&args...](pointer p) { *p = T(std::forward<Ts>(args)...); });
+  }
+
+  // Consumer
+  Status PopFront(pointer p) {
+    Status rc = WaitFor(&empty_cv_, &empty_waiters_, [this]() -> bool { return head_ != tail_; });
+    if (rc.IsError()) {
+      full_cv_.Interrupt();
+      return rc;
+    }
+    auto head = head_.load(std::memory_order_relaxed);
+    *p = std::move(*(arr_[head % sz_]));
+    head_ = head + 1;
+    WakeUp(&full_cv_, &full_waiters_);
+    return rc;
+  }
+
+  // Not thread safe, neither side may be running.
+  void ResetQue() noexcept {
+    std::unique_lock<std::mutex> _lock(mux_);
+    for (auto i = head_.load(); i < tail_; ++i) {
+      auto k = i % sz_;
+      auto val = std::move(*(arr_[k]));
+      MS_LOG(DEBUG) << "Address of val: " << &val;
+    }
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+    head_ = 0;
+    tail_ = 0;
+  }
+
+  Status Register(TaskGroup *vg) {
+    Status rc1 = empty_cv_.Register(vg->GetIntrpService());
+    Status rc2 = full_cv_.Register(vg->GetIntrpService());
+    if (rc1.IsOk()) {
+      return rc2;
+    } else {
+      return rc1;
+    }
+  }
+
+ private:
+  template <typename F>
+  Status Produce(F &&assign) noexcept {
+    Status rc = WaitFor(&full_cv_, &full_waiters_, [this]() -> bool { return tail_ - head_ < sz_; });
+    if (rc.IsError()) {
+      empty_cv_.Interrupt();
+      return rc;
+    }
+    auto tail = tail_.load(std::memory_order_relaxed);
+    assign(arr_[tail % sz_]);
+    tail_ = tail + 1;
+    WakeUp(&empty_cv_, &empty_waiters_);
+    return rc;
+  }
+
+  // The waiter count is raised before the predicate is checked under the mutex, and the other side publishes its
+  // index before it reads the count, so a wake up can not be missed.
+  Status WaitFor(CondVar *cv, std::atomic<int32_t> *waiters, const std::function<bool()> &pred) {
+    for (int32_t i = 0; i < kSpinCount; ++i) {
+      if (pred()) {
+        return Status::OK();
+      }
+      std::this_thread::yield();
+    }
+    ++(*waiters);
+    std::unique_lock<std::mutex> _lock(mux_);
+    Status rc = cv->Wait(&_lock, pred);
+    --(*waiters);
+    return rc;
+  }
+
+  void WakeUp(CondVar *cv, std::atomic<int32_t> *waiters) {
+    if (*waiters > 0) {
+      std::unique_lock<std::mutex> _lock(mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  size_t sz_;
+  MemGuard<T, Allocator<T>> arr_;
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+  std::string my_name_;
+  std::mutex mux_;
+  std::atomic<int32_t> empty_waiters_{0};
+  std::atomic<int32_t> full_waiters_{0};
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+
 // A container of queues with [] operator accessors.  Basically this is a wrapper over of a vector of queues
 // to help abstract/simplify code that is maintaining multiple queues.
 template <typename T>
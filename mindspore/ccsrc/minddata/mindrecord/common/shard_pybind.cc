@@ -99,6 +99,7 @@ void BindShardReader(const py::module *m) {
 void BindShardIndexGenerator(const py::module *m) {
   (void)py::class_<ShardIndexGenerator>(*m, "ShardIndexGenerator", py::module_local())
     .def(py::init<const std::string &, bool>())
+    .def(py::init<const std::string &, bool, bool>())
     .def("build", &ShardIndexGenerator::Build)
     .def("write_to_db", &ShardIndexGenerator::WriteToDatabase);
 }
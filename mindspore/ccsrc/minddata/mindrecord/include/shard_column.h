@@ -72,6 +72,13 @@ class ShardColumn {
                                  ColumnDataType *column_data_type, uint64_t *column_data_type_size,
                                  std::vector<int64_t> *column_shape);
 
+  /// \brief get column value by column name, blob given by address and size, e.g. a slice of a mapped file
+  MSRStatus GetColumnValueByName(const std::string &column_name, const unsigned char *columns_blob,
+                                 uint64_t blob_size, const json &columns_json, const unsigned char **data,
+                                 std::unique_ptr<unsigned char[]> *data_ptr, uint64_t *const n_bytes,
+                                 ColumnDataType *column_data_type, uint64_t *column_data_type_size,
+                                 std::vector<int64_t> *column_shape);
+
   /// \brief compress blob
   std::vector<uint8_t> CompressBlob(const std::vector<uint8_t> &blob, int64_t *compression_size);
 
@@ -95,6 +102,11 @@ class ShardColumn {
                               const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
                               uint64_t *const n_bytes);
 
+  /// \brief get column value from blob given by address and size
+  MSRStatus GetColumnFromBlob(const std::string &column_name, const unsigned char *columns_blob, uint64_t blob_size,
+                              const unsigned char **data, std::unique_ptr<unsigned char[]> *data_ptr,
+                              uint64_t *const n_bytes);
+
   /// \brief get column type
   std::pair<MSRStatus, ColumnCategory> GetColumnTypeByName(const std::string &column_name,
                                                            ColumnDataType *column_data_type,
@@ -118,7 +130,7 @@ class ShardColumn {
   MSRStatus GetInt(std::unique_ptr<unsigned char[]> *data_ptr, const json &json_column_value);
 
   /// \brief get column offset address and size from blob
-  MSRStatus GetColumnAddressInBlock(const uint64_t &column_id, const std::vector<uint8_t> &columns_blob,
+  MSRStatus GetColumnAddressInBlock(const uint64_t &column_id, const unsigned char *columns_blob, uint64_t blob_size,
                                     uint64_t *num_bytes, uint64_t *shift_idx);
 
   /// \brief check if column name is available
@@ -130,15 +142,14 @@ class ShardColumn {
   /// \brief uncompress integer array column
   template <typename T>
   static MSRStatus UncompressInt(const uint64_t &column_id, std::unique_ptr<unsigned char[]> *const data_ptr,
-                                 const std::vector<uint8_t> &columns_blob, uint64_t *num_bytes, uint64_t shift_idx);
+                                 const unsigned char *columns_blob, uint64_t *num_bytes, uint64_t shift_idx);
 
   /// \brief convert big-endian bytes to unsigned int
   /// \param bytes_array bytes array
   /// \param pos shift address in bytes array
   /// \param i_type integer type
   /// \return unsigned int
-  static uint64_t BytesBigToUInt64(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
-                                   const IntegerType &i_type);
+  static uint64_t BytesBigToUInt64(const unsigned char *bytes_array, const uint64_t &pos, const IntegerType &i_type);
 
   /// \brief convert unsigned int to big-endian bytes
   /// \param value integer value
@@ -158,7 +169,7 @@ class ShardColumn {
   /// \param src_i_type source integer typ0e
   /// \param dst_i_type (output), destination integer type
   /// \return integer
-  static int64_t BytesLittleToMinIntType(const std::vector<uint8_t> &bytes_array, const uint64_t &pos,
+  static int64_t BytesLittleToMinIntType(const unsigned char *bytes_array, const uint64_t &pos,
                                          const IntegerType &src_i_type, IntegerType *dst_i_type = nullptr);
 
  private:
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+
+namespace mindspore {
+namespace mindrecord {
+const char kIndexFileSuffix[] = ".idx";
+
+/// \brief compact binary index of one shard, read by mapping the file instead of querying the sqlite index.
+///        All numbers are 64 bits in host byte order, and every section starts at a multiple of 8 bytes:
+///          magic, number of rows, number of fields, size and header checksum of the shard, shard name
+///          name and type of every field
+///          the index columns in IndexColumn order, then the field columns, all of them sorted by row id.
+///          Integer and float fields are arrays of int64 and double, text fields are an array of number of rows + 1
+///          offsets followed by the bytes.
+class ShardIndexFile {
+ public:
+  enum FieldType : uint64_t { kFieldInteger = 0, kFieldFloat = 1, kFieldText = 2 };
+
+  enum IndexColumn {
+    kRowGroupId = 0,
+    kPageIdRaw,
+    kPageOffsetRaw,
+    kPageOffsetRawEnd,
+    kPageIdBlob,
+    kPageOffsetBlob,
+    kPageOffsetBlobEnd,
+    kNumIndexColumn
+  };
+
+  /// \brief the shard an index file is written for, the index file is not used with a shard rewritten since
+  struct ShardDigest {
+    uint64_t shard_size = 0;
+    uint64_t header_checksum = 0;
+  };
+
+  /// \brief one row to write, field values are formatted as for the sqlite index
+  struct Row {
+    int64_t row_id = 0;
+    int64_t index[kNumIndexColumn] = {0};
+    std::vector<std::string> fields;
+  };
+
+  ShardIndexFile() = default;
+
+  ~ShardIndexFile() = default;
+
+  /// \brief write the index of a shard
+  /// \param[in] file_path path of the index file
+  /// \param[in] shard_name file name of the shard
+  /// \param[in] digest digest of the shard
+  /// \param[in] fields name and sql type of the index fields
+  /// \param[in] rows rows of the shard, sorted by row id in place
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus Write(const std::string &file_path, const std::string &shard_name, const ShardDigest &digest,
+                         const std::vector<std::pair<std::string, std::string>> &fields, std::vector<Row> *rows);
+
+  /// \brief get the size of a shard and the checksum of its header
+  /// \param[in] shard_path path of the shard
+  /// \param[out] digest digest of the shard
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus GetShardDigest(const std::string &shard_path, ShardDigest *digest);
+
+  /// \brief map and check an index file
+  /// \param[in] file_path path of the index file
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus Load(const std::string &file_path);
+
+  /// \brief getter
+  const std::string &GetShardName() const { return shard_name_; }
+
+  /// \brief getter
+  uint64_t GetNumRows() const { return num_rows_; }
+
+  /// \brief whether the index file is written for a shard of this digest
+  bool MatchShard(const ShardDigest &digest) const {
+    return digest_.shard_size == digest.shard_size && digest_.header_checksum == digest.header_checksum;
+  }
+
+  /// \brief get an index column, of number of rows values
+  const int64_t *GetIndexColumn(IndexColumn column) const { return index_columns_[column]; }
+
+  /// \brief get the id of a field by its name in the sqlite index, -1 if not found
+  int GetFieldId(const std::string &field_name) const;
+
+  /// \brief getter
+  FieldType GetFieldType(int field_id) const { return field_types_[field_id]; }
+
+  /// \brief get the value of an integer field
+  int64_t GetInteger(int field_id, uint64_t row) const {
+    return reinterpret_cast<const int64_t *>(field_data_[field_id])[row];
+  }
+
+  /// \brief get the value of a float field
+  double GetFloat(int field_id, uint64_t row) const {
+    return reinterpret_cast<const double *>(field_data_[field_id])[row];
+  }
+
+  /// \brief get the value of a text field
+  std::string GetText(int field_id, uint64_t row) const;
+
+ private:
+  std::shared_ptr<ShardMappedFile> file_;
+  std::string shard_name_;
+  uint64_t num_rows_ = 0;
+  ShardDigest digest_;
+  std::vector<std::string> field_names_;
+  std::vector<FieldType> field_types_;
+  const int64_t *index_columns_[kNumIndexColumn] = {nullptr};
+  std::vector<const uint8_t *> field_data_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_INDEX_FILE_H_
@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/shard_header.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "./sqlite3.h"
 
 namespace mindspore {
@@ -34,7 +35,11 @@ using INDEX_FIELDS = std::pair<MSRStatus, std::vector<std::tuple<std::string, st
 using ROW_DATA = std::pair<MSRStatus, std::vector<std::vector<std::tuple<std::string, std::string, std::string>>>>;
 class ShardIndexGenerator {
  public:
-  explicit ShardIndexGenerator(const std::string &file_path, bool append = false);
+  /// \brief constructor
+  /// \param[in] file_path one of the mindrecord files
+  /// \param[in] append whether the index of an existing dataset is regenerated
+  /// \param[in] compact_index also write the compact binary index file of every shard besides the sqlite index
+  explicit ShardIndexGenerator(const std::string &file_path, bool append = false, bool compact_index = false);
 
   MSRStatus Build();
 
@@ -105,10 +110,16 @@ class ShardIndexGenerator {
   void AddIndexFieldByRawData(const std::vector<json> &schema_detail,
                               std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
 
+  MSRStatus GenerateIndexFileFields();
+
+  void AppendIndexFileRows(const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+                           std::vector<ShardIndexFile::Row> *rows);
+
   void DatabaseWriter();  // worker thread
 
   std::string file_path_;
   bool append_;
+  bool compact_index_;
   ShardHeader shard_header_;
   uint64_t page_size_;
   uint64_t header_size_;
@@ -116,6 +127,8 @@ class ShardIndexGenerator {
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+  // name and sql type of the index fields in the compact index file
+  std::vector<std::pair<std::string, std::string>> index_file_fields_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
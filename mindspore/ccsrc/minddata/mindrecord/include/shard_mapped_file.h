@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <string>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief a whole shard file mapped into memory. The mapping is read only and lives as long as the reader or any slice
+///        of it, consumers must copy a blob before modifying it.
+class ShardMappedFile {
+ public:
+  ShardMappedFile() = default;
+
+  ~ShardMappedFile();
+
+  ShardMappedFile(const ShardMappedFile &) = delete;
+
+  ShardMappedFile &operator=(const ShardMappedFile &) = delete;
+
+  /// \brief map the file
+  /// \param[in] file_path path of the shard file
+  /// \return MSRStatus FAILED if the file can not be mapped, readers fall back to file streams then
+  MSRStatus Open(const std::string &file_path);
+
+  /// \brief getter
+  const uint8_t *GetData() const { return data_; }
+
+  /// \brief getter
+  uint64_t GetSize() const { return size_; }
+
+  /// \brief advise the access pattern of the whole mapping
+  /// \param[in] sequential true for aggressive readahead, false to disable readahead for random access
+  void AdviseSequential(bool sequential) const;
+
+  /// \brief ask to read a range of the file ahead
+  /// \param[in] offset offset of the range in the file
+  /// \param[in] length length of the range
+  void AdviseWillNeed(uint64_t offset, uint64_t length) const;
+
+ private:
+  uint8_t *data_ = nullptr;
+  uint64_t size_ = 0;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_MAPPED_FILE_H_
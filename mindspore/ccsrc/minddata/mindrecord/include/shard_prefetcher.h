@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PREFETCHER_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PREFETCHER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+const int64_t kMaxPrefetchWindow = 4096;  // rows read ahead, the slots of the window are allocated at once
+
+/// \brief asks the kernel to read the blobs of the rows ahead of the readers in task order, so the reads of the
+///        readers hit the page cache. Nothing is copied to the user space. The rows are taken in batches, the blobs
+///        of one batch next to each other in a shard are merged into one request, and the requests of a batch are
+///        submitted together as IORING_OP_FADVISE through io_uring where the kernel supports it, or issued with
+///        posix_fadvise by a pool of threads otherwise.
+class ShardPrefetcher {
+ public:
+  /// \brief blob of a row in the shard files
+  struct Range {
+    int shard_id = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  /// \brief get the blob of the row at a task position, false if the row has no blob
+  using RangeFunc = std::function<bool(int64_t, Range *)>;
+
+  /// \brief counters since the prefetcher was created
+  struct Stats {
+    std::string backend;          // "io_uring", "thread_pool" or empty if not started
+    int64_t window = 0;           // max rows prefetched ahead of the readers
+    int64_t prefetched_rows = 0;  // rows read ahead
+    int64_t read_requests = 0;    // read-ahead requests submitted after merging
+    int64_t read_bytes = 0;       // bytes asked to read ahead
+    int64_t hit_rows = 0;         // rows read ahead before the readers asked for them
+    int64_t miss_rows = 0;        // rows the readers asked for before they were read ahead
+  };
+
+  /// \brief constructor
+  /// \param[in] window max rows read ahead of the readers, at most kMaxPrefetchWindow
+  explicit ShardPrefetcher(int64_t window);
+
+  ~ShardPrefetcher();
+
+  ShardPrefetcher(const ShardPrefetcher &) = delete;
+
+  ShardPrefetcher &operator=(const ShardPrefetcher &) = delete;
+
+  /// \brief start reading ahead from task position 0
+  /// \param[in] file_paths paths of the shard files
+  /// \param[in] num_tasks number of task positions
+  /// \param[in] range_func gets the blob of a task position, called by the prefetch threads
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus Start(const std::vector<std::string> &file_paths, int64_t num_tasks, const RangeFunc &range_func);
+
+  /// \brief stop the prefetch threads and close the files, the counters are kept
+  void Stop();
+
+  /// \brief tell that the readers reached a task position, called before reading its row
+  /// \param[in] task_id task position
+  void Advance(int64_t task_id);
+
+  /// \brief getter
+  Stats GetStats() const;
+
+ private:
+  class IoRing;
+
+  void PrefetchThread(int thread_id);
+
+  bool TakeTasks(int64_t *begin, int64_t *end);
+
+  // return false if the ring failed, the ranges are advised with posix_fadvise then
+  bool AdviseRanges(IoRing *ring, std::vector<Range> *ranges);
+
+  int64_t window_;
+  int64_t num_tasks_ = 0;
+  RangeFunc range_func_;
+  std::vector<int> fds_;
+  std::vector<std::thread> threads_;
+  std::vector<std::unique_ptr<IoRing>> rings_;
+  std::atomic<bool> use_io_uring_{false};
+  std::atomic<bool> started_{false};
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  int64_t next_task_ = 0;                         // next task position to read ahead
+  int64_t reached_task_ = -1;                     // farthest task position the readers reached
+  std::unique_ptr<std::atomic<int64_t>[]> done_;  // task position read ahead in each slot of the window, fixed size
+
+  std::atomic<int64_t> prefetched_rows_{0};
+  std::atomic<int64_t> read_requests_{0};
+  std::atomic<int64_t> read_bytes_{0};
+  std::atomic<int64_t> hit_rows_{0};
+  std::atomic<int64_t> miss_rows_{0};
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PREFETCHER_H_
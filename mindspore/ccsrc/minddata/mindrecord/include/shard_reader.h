@@ -47,9 +47,12 @@
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_mapped_file.h"
 #include "minddata/mindrecord/include/shard_operator.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
+#include "minddata/mindrecord/include/shard_prefetcher.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "minddata/mindrecord/include/shard_shuffle.h"
@@ -65,6 +68,15 @@ using TASK_RETURN_CONTENT =
   std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 
+/// \brief blob of one row, a slice of the mapped shard file when the file is mapped, or read into buffer otherwise
+struct BlobSlice {
+  const uint8_t *data = nullptr;
+  uint64_t size = 0;
+  std::shared_ptr<ShardMappedFile> mapping;  // keeps the mapping alive as long as the slice is used
+  std::vector<uint8_t> buffer;
+};
+using TASK_SLICE_CONTENT = std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<BlobSlice, json>>>>;
+
 class ShardReader {
  public:
   ShardReader();
@@ -183,6 +195,11 @@ class ShardReader {
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
                                                                                        const int32_t &consumer_id);
 
+  /// \brief return a row by id without copying the blob when the shard file is mapped
+  /// \return a batch of blob slices and image data
+  std::pair<TaskType, std::vector<std::tuple<BlobSlice, json>>> GetNextSliceById(const int64_t &task_id,
+                                                                                const int32_t &consumer_id);
+
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<std::vector<uint8_t>>, pybind11::object>> GetNextPy();
@@ -208,11 +225,32 @@ class ShardReader {
   /// \brief get the size of blob data
   MSRStatus GetTotalBlobSize(int64_t *total_blob_size);
 
+  /// \brief read the blobs of up to window rows ahead of the readers in task order, 0 to disable, set before Launch
+  /// \param[in] window max rows read ahead, at most kMaxPrefetchWindow
+  void SetPrefetchWindow(int64_t window);
+
+  /// \brief get the counters of the read-ahead, empty backend if it is not running
+  /// \return the counters
+  ShardPrefetcher::Stats GetPrefetchStats() const;
+
  protected:
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
 
+  /// \brief open the sqlite index of every shard if not opened yet, it is skipped at init when compact index
+  ///        files are loaded and opened on the first query needing sql
+  MSRStatus OpenDatabases();
+
  private:
+  /// \brief load the compact index file of every shard, all or none of them are kept. An index file is only kept if
+  ///        the size and header of its shard are the ones it was written for, and it has the rows of the shard
+  ///        in the header.
+  MSRStatus LoadIndexFiles(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary);
+
+  /// \brief read the label of a row from its raw page
+  MSRStatus ReadRawLabel(const std::shared_ptr<std::fstream> &fs, int raw_page_id, uint64_t label_start,
+                         uint64_t label_end, const std::vector<std::string> &columns, json *label);
+
   /// \brief wrap up labels to json format
   MSRStatus ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
@@ -226,6 +264,11 @@ class ShardReader {
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                std::vector<std::vector<json>> &column_values);
 
+  /// \brief read all rows in one shard from its compact index file
+  MSRStatus ReadAllRowsInIndexFile(int shard_id, const std::vector<std::string> &columns,
+                                   std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                   std::vector<std::vector<json>> &column_values);
+
   /// \brief initialize reader
   MSRStatus Init(const std::vector<std::string> &file_paths, bool load_dataset);
 
@@ -273,9 +316,21 @@ class ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
+  /// \brief map the shard files, file streams are used if any of them can not be mapped
+  void MapFiles();
+
+  /// \brief advise sequential readahead of the mapped files if the tasks visit rows in file order
+  void AdviseAccessPattern();
+
+  /// \brief start reading ahead of the tasks if the prefetch window is set
+  void StartPrefetch();
+
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
+  /// \brief read one row by one task, the blob points into the mapped file if mapped
+  TASK_SLICE_CONTENT ConsumerOneTaskSlice(int task_id, uint32_t consumer_id);
+
   /// \brief get labels from binary file
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
     int shard_id, const std::vector<std::string> &columns, const std::vector<std::vector<std::string>> &label_offsets);
@@ -300,9 +355,12 @@ class ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::mutex database_locker_;                                                   // locker of opening databases
+  std::vector<std::shared_ptr<ShardIndexFile>> index_files_;                     // compact index list, may be empty
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardMappedFile>> mapped_files_;                   // mapped files, empty if not mapped
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -313,11 +371,15 @@ class ShardReader {
   std::mutex shard_locker_;                                // locker of shard
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;        // if all columns are stored in index-table
+  bool interrupt_ = false;          // reader interrupted
+  bool sequential_access_ = false;  // if tasks visit rows in file order
 
   int num_padded_;  // number of padding samples
 
+  int64_t prefetch_window_ = 0;                  // rows read ahead of the readers, 0 if disabled
+  std::unique_ptr<ShardPrefetcher> prefetcher_;  // read-ahead of the blobs, null if disabled
+
   // Delivery/Iterator mode begin
   const std::string kThreadName = "THRD_ITER_";  // prefix of thread name
   std::vector<std::thread> thread_set_;          // thread list
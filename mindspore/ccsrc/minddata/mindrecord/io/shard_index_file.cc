@@ -0,0 +1,309 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_index_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const char kIndexFileMagic[] = "MRIDX002";
+constexpr uint64_t kIndexFileMagicLen = 8;
+constexpr uint64_t kIndexFileAlign = 8;
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t AlignIndexFile(uint64_t size) { return (size + kIndexFileAlign - 1) / kIndexFileAlign * kIndexFileAlign; }
+
+class IndexFileWriter {
+ public:
+  explicit IndexFileWriter(std::ofstream *out) : out_(out) {}
+
+  void WriteBytes(const void *data, uint64_t size) {
+    out_->write(static_cast<const char *>(data), size);
+    pos_ += size;
+  }
+
+  void WriteUInt64(uint64_t value) { WriteBytes(&value, sizeof(value)); }
+
+  void WriteString(const std::string &str) {
+    WriteUInt64(str.size());
+    WriteBytes(str.data(), str.size());
+    Pad();
+  }
+
+  void Pad() {
+    static const char zeros[kIndexFileAlign] = {0};
+    WriteBytes(zeros, AlignIndexFile(pos_) - pos_);
+  }
+
+ private:
+  std::ofstream *out_;
+  uint64_t pos_ = 0;
+};
+
+class IndexFileReader {
+ public:
+  IndexFileReader(const uint8_t *data, uint64_t size) : data_(data), size_(size) {}
+
+  // returns nullptr if the file is too short
+  const uint8_t *Take(uint64_t size) {
+    if (size > size_ - pos_) {
+      return nullptr;
+    }
+    auto ret = data_ + pos_;
+    pos_ = std::min(size_, AlignIndexFile(pos_ + size));
+    return ret;
+  }
+
+  bool ReadUInt64(uint64_t *value) {
+    auto ptr = Take(sizeof(uint64_t));
+    if (ptr == nullptr) {
+      return false;
+    }
+    memcpy(value, ptr, sizeof(uint64_t));
+    return true;
+  }
+
+  bool ReadString(std::string *str) {
+    uint64_t len = 0;
+    if (!ReadUInt64(&len)) {
+      return false;
+    }
+    auto ptr = Take(len);
+    if (ptr == nullptr) {
+      return false;
+    }
+    str->assign(reinterpret_cast<const char *>(ptr), len);
+    return true;
+  }
+
+ private:
+  const uint8_t *data_;
+  uint64_t size_;
+  uint64_t pos_ = 0;
+};
+
+ShardIndexFile::FieldType GetFieldTypeBySql(const std::string &sql_type) {
+  if (sql_type == "INTEGER") {
+    return ShardIndexFile::kFieldInteger;
+  }
+  if (sql_type == "NUMERIC") {
+    return ShardIndexFile::kFieldFloat;
+  }
+  return ShardIndexFile::kFieldText;
+}
+}  // namespace
+
+MSRStatus ShardIndexFile::Write(const std::string &file_path, const std::string &shard_name,
+                                const ShardDigest &digest,
+                                const std::vector<std::pair<std::string, std::string>> &fields,
+                                std::vector<Row> *rows) {
+  std::sort(rows->begin(), rows->end(), [](const Row &lhs, const Row &rhs) { return lhs.row_id < rhs.row_id; });
+  for (const auto &row : *rows) {
+    if (row.fields.size() != fields.size()) {
+      MS_LOG(ERROR) << "Row " << row.row_id << " has " << row.fields.size() << " index fields, expect "
+                    << fields.size();
+      return FAILED;
+    }
+  }
+
+  std::ofstream out(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Failed to open index file: " << file_path;
+    return FAILED;
+  }
+  IndexFileWriter writer(&out);
+  writer.WriteBytes(kIndexFileMagic, kIndexFileMagicLen);
+  writer.WriteUInt64(rows->size());
+  writer.WriteUInt64(fields.size());
+  writer.WriteUInt64(digest.shard_size);
+  writer.WriteUInt64(digest.header_checksum);
+  writer.WriteString(shard_name);
+  for (const auto &field : fields) {
+    writer.WriteString(field.first);
+    writer.WriteUInt64(GetFieldTypeBySql(field.second));
+  }
+
+  for (int column = 0; column < kNumIndexColumn; ++column) {
+    for (const auto &row : *rows) {
+      writer.WriteBytes(&row.index[column], sizeof(int64_t));
+    }
+  }
+  try {
+    for (size_t i = 0; i < fields.size(); ++i) {
+      auto type = GetFieldTypeBySql(fields[i].second);
+      if (type == kFieldInteger) {
+        for (const auto &row : *rows) {
+          int64_t value = row.fields[i].empty() ? 0 : std::stoll(row.fields[i]);
+          writer.WriteBytes(&value, sizeof(value));
+        }
+      } else if (type == kFieldFloat) {
+        for (const auto &row : *rows) {
+          double value = row.fields[i].empty() ? 0 : std::stod(row.fields[i]);
+          writer.WriteBytes(&value, sizeof(value));
+        }
+      } else {
+        uint64_t offset = 0;
+        writer.WriteUInt64(offset);
+        for (const auto &row : *rows) {
+          offset += row.fields[i].size();
+          writer.WriteUInt64(offset);
+        }
+        for (const auto &row : *rows) {
+          writer.WriteBytes(row.fields[i].data(), row.fields[i].size());
+        }
+        writer.Pad();
+      }
+    }
+  } catch (std::exception &e) {
+    MS_LOG(ERROR) << "Failed to convert index field of " << file_path << ": " << e.what();
+    out.close();
+    return FAILED;
+  }
+  out.close();
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Failed to write index file: " << file_path;
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardIndexFile::GetShardDigest(const std::string &shard_path, ShardDigest *digest) {
+  std::ifstream in(shard_path, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in.good()) {
+    MS_LOG(ERROR) << "Failed to open shard: " << shard_path;
+    return FAILED;
+  }
+  uint64_t shard_size = static_cast<uint64_t>(in.tellg());
+  // the header of a shard is its size followed by the json, and lists the pages of the shard
+  uint64_t header_size = 0;
+  in.seekg(0, std::ios::beg);
+  if (!in.read(reinterpret_cast<char *>(&header_size), kInt64Len).good() || header_size > kMaxHeaderSize ||
+      header_size > shard_size - kInt64Len) {
+    MS_LOG(ERROR) << "Invalid header of shard: " << shard_path;
+    return FAILED;
+  }
+  std::string header(header_size, '\0');
+  if (!in.read(&header[0], header_size).good()) {
+    MS_LOG(ERROR) << "Failed to read header of shard: " << shard_path;
+    return FAILED;
+  }
+  // FNV-1a
+  uint64_t checksum = kFnvOffsetBasis;
+  for (unsigned char c : header) {
+    checksum = (checksum ^ c) * kFnvPrime;
+  }
+  digest->shard_size = shard_size;
+  digest->header_checksum = checksum;
+  return SUCCESS;
+}
+
+MSRStatus ShardIndexFile::Load(const std::string &file_path) {
+  auto file = std::make_shared<ShardMappedFile>();
+  if (file->Open(file_path) != SUCCESS) {
+    return FAILED;
+  }
+  IndexFileReader reader(file->GetData(), file->GetSize());
+  auto magic = reader.Take(kIndexFileMagicLen);
+  if (magic == nullptr || memcmp(magic, kIndexFileMagic, kIndexFileMagicLen) != 0) {
+    MS_LOG(ERROR) << "Invalid index file: " << file_path;
+    return FAILED;
+  }
+  uint64_t num_rows = 0;
+  uint64_t num_fields = 0;
+  ShardDigest digest;
+  std::string shard_name;
+  if (!reader.ReadUInt64(&num_rows) || !reader.ReadUInt64(&num_fields) || !reader.ReadUInt64(&digest.shard_size) ||
+      !reader.ReadUInt64(&digest.header_checksum) || !reader.ReadString(&shard_name) || num_rows > file->GetSize() ||
+      num_fields > file->GetSize()) {
+    MS_LOG(ERROR) << "Invalid header of index file: " << file_path;
+    return FAILED;
+  }
+
+  std::vector<std::string> field_names(num_fields);
+  std::vector<FieldType> field_types(num_fields);
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    uint64_t type = 0;
+    if (!reader.ReadString(&field_names[i]) || !reader.ReadUInt64(&type) || type > kFieldText) {
+      MS_LOG(ERROR) << "Invalid field of index file: " << file_path;
+      return FAILED;
+    }
+    field_types[i] = static_cast<FieldType>(type);
+  }
+
+  const int64_t *index_columns[kNumIndexColumn] = {nullptr};
+  for (int column = 0; column < kNumIndexColumn; ++column) {
+    index_columns[column] = reinterpret_cast<const int64_t *>(reader.Take(num_rows * sizeof(int64_t)));
+    if (index_columns[column] == nullptr) {
+      MS_LOG(ERROR) << "Index file is truncated: " << file_path;
+      return FAILED;
+    }
+  }
+  std::vector<const uint8_t *> field_data(num_fields, nullptr);
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    if (field_types[i] != kFieldText) {
+      field_data[i] = reader.Take(num_rows * sizeof(int64_t));
+    } else {
+      auto offsets = reader.Take((num_rows + 1) * sizeof(uint64_t));
+      if (offsets != nullptr) {
+        auto text_offsets = reinterpret_cast<const uint64_t *>(offsets);
+        uint64_t text_size = text_offsets[num_rows];
+        field_data[i] = reader.Take(text_size) != nullptr ? offsets : nullptr;
+        // GetText reads between the offsets of a row, they must be sorted inside the text
+        for (uint64_t row = 0; field_data[i] != nullptr && row < num_rows; ++row) {
+          if (text_offsets[row] > text_offsets[row + 1]) {
+            MS_LOG(ERROR) << "Invalid text offsets of field " << field_names[i] << " in index file: " << file_path;
+            return FAILED;
+          }
+        }
+      }
+    }
+    if (field_data[i] == nullptr) {
+      MS_LOG(ERROR) << "Index file is truncated: " << file_path;
+      return FAILED;
+    }
+  }
+
+  file->AdviseSequential(true);
+  file_ = file;
+  shard_name_ = shard_name;
+  num_rows_ = num_rows;
+  digest_ = digest;
+  field_names_ = std::move(field_names);
+  field_types_ = std::move(field_types);
+  std::copy(index_columns, index_columns + kNumIndexColumn, index_columns_);
+  field_data_ = std::move(field_data);
+  return SUCCESS;
+}
+
+int ShardIndexFile::GetFieldId(const std::string &field_name) const {
+  auto it = std::find(field_names_.begin(), field_names_.end(), field_name);
+  return it == field_names_.end() ? -1 : static_cast<int>(it - field_names_.begin());
+}
+
+std::string ShardIndexFile::GetText(int field_id, uint64_t row) const {
+  auto offsets = reinterpret_cast<const uint64_t *>(field_data_[field_id]);
+  auto text = reinterpret_cast<const char *>(offsets + num_rows_ + 1);
+  return std::string(text + offsets[row], offsets[row + 1] - offsets[row]);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
 #include <thread>
 
 #include "minddata/mindrecord/include/shard_index_generator.h"
@@ -26,9 +27,10 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
-ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append)
+ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool append, bool compact_index)
     : file_path_(file_path),
       append_(append),
+      compact_index_(compact_index),
       page_size_(0),
       header_size_(0),
       schema_count_(0),
@@ -530,6 +532,7 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
     MS_LOG(ERROR) << "File could not opened";
     return FAILED;
   }
+  std::vector<ShardIndexFile::Row> index_rows;
   (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
   for (int raw_page_id : raw_page_ids) {
     auto sql = GenerateRawSQL(fields_);
@@ -547,6 +550,9 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
       return FAILED;
     }
     MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
+    if (compact_index_) {
+      AppendIndexFileRows(data.second, &index_rows);
+    }
   }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
   in.close();
@@ -557,9 +563,76 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
     return FAILED;
   }
   db.second = nullptr;
+
+  if (compact_index_) {
+    auto shard_name = GetFileName(shard_address).second;
+    ShardIndexFile::ShardDigest digest;
+    if (ShardIndexFile::GetShardDigest(shard_address, &digest) != SUCCESS ||
+        ShardIndexFile::Write(shard_address + kIndexFileSuffix, shard_name, digest, index_file_fields_, &index_rows) !=
+          SUCCESS) {
+      MS_LOG(ERROR) << "Write index file failed, shard: " << shard_address;
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Write " << index_rows.size() << " rows to index file.";
+  } else {
+    // an index file left by an earlier build would be out of date now
+    (void)std::remove(common::SafeCStr(shard_address + kIndexFileSuffix));
+  }
   return SUCCESS;
 }
 
+MSRStatus ShardIndexGenerator::GenerateIndexFileFields() {
+  index_file_fields_.clear();
+  for (const auto &field : fields_) {
+    auto result = shard_header_.GetSchemaByID(field.first);
+    if (result.second != SUCCESS) {
+      return FAILED;
+    }
+    std::string type = ConvertJsonToSQL(TakeFieldType(field.second, result.first->GetSchema()["schema"]));
+    auto ret = GenerateFieldName(field);
+    if (ret.first != SUCCESS) {
+      return FAILED;
+    }
+    index_file_fields_.emplace_back(ret.second, type);
+  }
+  return SUCCESS;
+}
+
+void ShardIndexGenerator::AppendIndexFileRows(
+  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+  std::vector<ShardIndexFile::Row> *rows) {
+  static const std::map<std::string, int> kIndexColumns = {
+    {":ROW_GROUP_ID", ShardIndexFile::kRowGroupId},         {":PAGE_ID_RAW", ShardIndexFile::kPageIdRaw},
+    {":PAGE_OFFSET_RAW", ShardIndexFile::kPageOffsetRaw},   {":PAGE_OFFSET_RAW_END", ShardIndexFile::kPageOffsetRawEnd},
+    {":PAGE_ID_BLOB", ShardIndexFile::kPageIdBlob},         {":PAGE_OFFSET_BLOB", ShardIndexFile::kPageOffsetBlob},
+    {":PAGE_OFFSET_BLOB_END", ShardIndexFile::kPageOffsetBlobEnd}};
+  std::map<std::string, size_t> field_ids;
+  for (size_t i = 0; i < index_file_fields_.size(); ++i) {
+    field_ids[":" + index_file_fields_[i].first] = i;
+  }
+  for (const auto &row_data : data) {
+    ShardIndexFile::Row row;
+    row.fields.resize(index_file_fields_.size());
+    for (const auto &field : row_data) {
+      const auto &place_holder = std::get<0>(field);
+      if (place_holder == ":ROW_ID") {
+        row.row_id = std::stoll(std::get<2>(field));
+        continue;
+      }
+      auto column = kIndexColumns.find(place_holder);
+      if (column != kIndexColumns.end()) {
+        row.index[column->second] = std::stoll(std::get<2>(field));
+        continue;
+      }
+      auto field_id = field_ids.find(place_holder);
+      if (field_id != field_ids.end()) {
+        row.fields[field_id->second] = std::get<2>(field);
+      }
+    }
+    rows->push_back(std::move(row));
+  }
+}
+
 MSRStatus ShardIndexGenerator::WriteToDatabase() {
   fields_ = shard_header_.GetFields();
   page_size_ = shard_header_.GetPageSize();
@@ -569,6 +642,10 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
     MS_LOG(ERROR) << "num shards: " << shard_header_.GetShardCount() << " exceeds max count:" << kMaxSchemaCount;
     return FAILED;
   }
+  if (compact_index_ && GenerateIndexFileFields() != SUCCESS) {
+    MS_LOG(ERROR) << "Generate fields of index file failed.";
+    return FAILED;
+  }
   task_ = 0;  // set two atomic vars to initial value
   write_success_ = true;
 
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_mapped_file.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::DEBUG;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+ShardMappedFile::~ShardMappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr) {
+    (void)munmap(data_, size_);
+    data_ = nullptr;
+  }
+#endif
+}
+
+MSRStatus ShardMappedFile::Open(const std::string &file_path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(common::SafeCStr(file_path), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(INFO) << "Failed to open file to map, file: " << file_path;
+    return FAILED;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(INFO) << "Failed to get size of file to map, file: " << file_path;
+    (void)close(fd);
+    return FAILED;
+  }
+  size_ = static_cast<uint64_t>(file_stat.st_size);
+  void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after the descriptor is closed
+  (void)close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(INFO) << "Failed to map file, file: " << file_path << ", size: " << size_;
+    size_ = 0;
+    return FAILED;
+  }
+  data_ = static_cast<uint8_t *>(addr);
+  return SUCCESS;
+#else
+  return FAILED;
+#endif
+}
+
+void ShardMappedFile::AdviseSequential(bool sequential) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ != nullptr && madvise(data_, size_, sequential ? MADV_SEQUENTIAL : MADV_RANDOM) != 0) {
+    MS_LOG(DEBUG) << "Failed to advise access pattern of mapped file.";
+  }
+#endif
+}
+
+void ShardMappedFile::AdviseWillNeed(uint64_t offset, uint64_t length) const {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (data_ == nullptr || offset >= size_) {
+    return;
+  }
+  // madvise works on whole pages of memory
+  uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t begin = offset / page * page;
+  uint64_t end = std::min(offset + length, size_);
+  if (madvise(data_ + begin, end - begin, MADV_WILLNEED) != 0) {
+    MS_LOG(DEBUG) << "Failed to advise readahead of mapped file.";
+  }
+#endif
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,421 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_prefetcher.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <linux/version.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+// IORING_OP_FADVISE is in the headers since linux 5.6
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+#define ENABLE_SHARD_IO_URING
+#endif
+#endif
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// rows taken by a prefetch thread at a time
+constexpr int64_t kPrefetchBatchRows = 32;
+// blobs closer than this are read ahead as one range
+constexpr uint64_t kMergeGap = 64 << 10;
+// longer ranges are split into requests of this size
+constexpr uint64_t kMaxAdviseSize = 4 << 20;
+// io_uring keeps the requests of a batch in flight at once, so fewer threads are needed than with blocking calls
+constexpr int kIoUringThreads = 2;
+constexpr unsigned kIoUringEntries = 64;
+constexpr int kThreadPoolSize = 4;
+
+// Ask the kernel to read a range into the page cache, nothing is copied to the user space
+void AdviseWillNeed(int fd, const ShardPrefetcher::Range &range) {
+#ifdef POSIX_FADV_WILLNEED
+  // failed advice is left to the readers, which read the rows anyway
+  (void)posix_fadvise(fd, static_cast<off_t>(range.offset), static_cast<off_t>(range.size), POSIX_FADV_WILLNEED);
+#endif
+}
+}  // namespace
+
+#ifdef ENABLE_SHARD_IO_URING
+// A minimal io_uring submitting IORING_OP_FADVISE requests, through the raw system calls
+class ShardPrefetcher::IoRing {
+ public:
+  IoRing() = default;
+
+  ~IoRing() {
+    if (sqes_ != nullptr) {
+      (void)munmap(sqes_, entries_ * sizeof(struct io_uring_sqe));
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+      (void)munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_ != nullptr) {
+      (void)munmap(sq_ptr_, sq_size_);
+    }
+    if (fd_ >= 0) {
+      (void)close(fd_);
+    }
+  }
+
+  bool Init(unsigned entries) {
+    struct io_uring_params params;
+    (void)memset(&params, 0, sizeof(params));
+    fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd_ < 0) {
+      return false;
+    }
+    entries_ = params.sq_entries;
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_size_ = std::max(sq_size_, cq_size_);
+    }
+    sq_ptr_ = MapRing(sq_size_, IORING_OFF_SQ_RING);
+    if (sq_ptr_ == nullptr) {
+      return false;
+    }
+    cq_ptr_ = single_mmap ? sq_ptr_ : MapRing(cq_size_, IORING_OFF_CQ_RING);
+    if (cq_ptr_ == nullptr) {
+      return false;
+    }
+    sqes_ = static_cast<struct io_uring_sqe *>(MapRing(entries_ * sizeof(struct io_uring_sqe), IORING_OFF_SQES));
+    if (sqes_ == nullptr) {
+      return false;
+    }
+    auto sq = static_cast<uint8_t *>(sq_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    auto cq = static_cast<uint8_t *>(cq_ptr_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  // Advise the kernel to read the ranges ahead, at most entries at a time, and wait for all the requests submitted.
+  // Return false if the ring can not be used any more, no request of this call is left in the rings then.
+  bool Advise(const std::vector<int> &fds, const std::vector<Range> &ranges) {
+    for (size_t begin = 0; begin < ranges.size(); begin += entries_) {
+      unsigned count = static_cast<unsigned>(std::min<size_t>(ranges.size() - begin, entries_));
+      unsigned tail = *sq_tail_;
+      for (unsigned i = 0; i < count; ++i) {
+        const auto &range = ranges[begin + i];
+        unsigned index = tail & sq_mask_;
+        struct io_uring_sqe *sqe = &sqes_[index];
+        (void)memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_FADVISE;
+        sqe->fd = fds[range.shard_id];
+        sqe->off = range.offset;
+        sqe->len = static_cast<uint32_t>(range.size);
+        sqe->fadvise_advice = POSIX_FADV_WILLNEED;
+        sq_array_[index] = index;
+        tail++;
+      }
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+      bool failed = false;
+      unsigned submitted = 0;
+      while (submitted < count) {
+        auto ret = syscall(__NR_io_uring_enter, fd_, count - submitted, 0, 0, nullptr, 0);
+        if (ret < 0 && errno == EINTR) {
+          continue;
+        }
+        if (ret <= 0) {
+          MS_LOG(WARNING) << "Failed to submit prefetch requests, errno: " << errno;
+          failed = true;
+          break;
+        }
+        submitted += static_cast<unsigned>(ret);
+      }
+      if (failed) {
+        // take back the requests the kernel did not consume, it only reads the ring in io_uring_enter
+        __atomic_store_n(sq_tail_, __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+      }
+      bool unsupported = false;
+      unsigned completed = Reap(&unsupported);
+      while (completed < submitted) {
+        auto ret = syscall(__NR_io_uring_enter, fd_, 0, submitted - completed, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (ret < 0 && errno != EINTR) {
+          MS_LOG(WARNING) << "Failed to wait for prefetch requests, errno: " << errno;
+          return false;
+        }
+        completed += Reap(&unsupported);
+      }
+      if (failed || unsupported) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  void *MapRing(size_t size, off_t offset) {
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  // Consume the completions, unsupported is set if the kernel does not know IORING_OP_FADVISE
+  unsigned Reap(bool *unsupported) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (unsigned i = head; i != tail; ++i) {
+      // other failures are left to the readers, which read the rows anyway
+      if (cqes_[i & cq_mask_].res == -EINVAL) {
+        *unsupported = true;
+      }
+    }
+    __atomic_store_n(cq_head_, tail, __ATOMIC_RELEASE);
+    return tail - head;
+  }
+
+  int fd_ = -1;
+  unsigned entries_ = 0;
+  void *sq_ptr_ = nullptr;
+  void *cq_ptr_ = nullptr;
+  size_t sq_size_ = 0;
+  size_t cq_size_ = 0;
+  struct io_uring_sqe *sqes_ = nullptr;
+  unsigned *sq_head_ = nullptr;
+  unsigned *sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned *sq_array_ = nullptr;
+  unsigned *cq_head_ = nullptr;
+  unsigned *cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  struct io_uring_cqe *cqes_ = nullptr;
+};
+#else
+class ShardPrefetcher::IoRing {
+ public:
+  bool Init(unsigned) { return false; }
+
+  bool Advise(const std::vector<int> &, const std::vector<Range> &) { return false; }
+};
+#endif
+
+ShardPrefetcher::ShardPrefetcher(int64_t window) : window_(std::min(window, kMaxPrefetchWindow)) {
+  if (window_ > 0) {
+    done_ = std::make_unique<std::atomic<int64_t>[]>(window_);
+    for (int64_t i = 0; i < window_; ++i) {
+      done_[i].store(-1);
+    }
+  }
+}
+
+ShardPrefetcher::~ShardPrefetcher() { Stop(); }
+
+MSRStatus ShardPrefetcher::Start(const std::vector<std::string> &file_paths, int64_t num_tasks,
+                                 const RangeFunc &range_func) {
+  Stop();
+  if (window_ <= 0 || num_tasks <= 0) {
+    return FAILED;
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (const auto &file : file_paths) {
+    int fd = open(common::SafeCStr(file), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(WARNING) << "Failed to open file to prefetch, file: " << file;
+      Stop();
+      return FAILED;
+    }
+    fds_.push_back(fd);
+  }
+  num_tasks_ = num_tasks;
+  range_func_ = range_func;
+  stop_ = false;
+  next_task_ = 0;
+  reached_task_ = -1;
+  // the readers may still look at the slots, so they are reset instead of reallocated
+  for (int64_t i = 0; i < window_; ++i) {
+    done_[i].store(-1);
+  }
+
+  bool use_io_uring = true;
+  for (int i = 0; i < kIoUringThreads && use_io_uring; ++i) {
+    auto ring = std::make_unique<IoRing>();
+    use_io_uring = ring->Init(kIoUringEntries);
+    rings_.push_back(std::move(ring));
+  }
+  if (!use_io_uring) {
+    rings_.clear();
+  }
+  use_io_uring_ = use_io_uring;
+  started_ = true;
+  int num_threads = use_io_uring ? kIoUringThreads : kThreadPoolSize;
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ShardPrefetcher::PrefetchThread, this, i);
+  }
+  MS_LOG(INFO) << "Prefetch " << window_ << " rows ahead by " << (use_io_uring ? "io_uring" : "thread pool") << ".";
+  return SUCCESS;
+#else
+  return FAILED;
+#endif
+}
+
+void ShardPrefetcher::Stop() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  threads_.clear();
+  rings_.clear();
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto fd : fds_) {
+    (void)close(fd);
+  }
+#endif
+  fds_.clear();
+}
+
+void ShardPrefetcher::Advance(int64_t task_id) {
+  if (done_ == nullptr || task_id < 0) {
+    return;
+  }
+  if (done_[task_id % window_].load(std::memory_order_acquire) == task_id) {
+    hit_rows_++;
+  } else {
+    miss_rows_++;
+  }
+  bool moved = false;
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    if (task_id > reached_task_) {
+      reached_task_ = task_id;
+      moved = true;
+    }
+  }
+  if (moved) {
+    cv_.notify_all();
+  }
+}
+
+ShardPrefetcher::Stats ShardPrefetcher::GetStats() const {
+  Stats stats;
+  if (started_) {
+    stats.backend = use_io_uring_ ? "io_uring" : "thread_pool";
+  }
+  stats.window = window_;
+  stats.prefetched_rows = prefetched_rows_;
+  stats.read_requests = read_requests_;
+  stats.read_bytes = read_bytes_;
+  stats.hit_rows = hit_rows_;
+  stats.miss_rows = miss_rows_;
+  return stats;
+}
+
+bool ShardPrefetcher::TakeTasks(int64_t *begin, int64_t *end) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  cv_.wait(lck, [this] { return stop_ || next_task_ < std::min(num_tasks_, reached_task_ + 1 + window_); });
+  if (stop_) {
+    return false;
+  }
+  // rows the readers already passed are not worth reading any more
+  next_task_ = std::max(next_task_, reached_task_ + 1);
+  *begin = next_task_;
+  *end = std::min({*begin + kPrefetchBatchRows, reached_task_ + 1 + window_, num_tasks_});
+  next_task_ = *end;
+  return true;
+}
+
+void ShardPrefetcher::PrefetchThread(int thread_id) {
+  std::vector<Range> ranges;
+  IoRing *ring = use_io_uring_ ? rings_[thread_id].get() : nullptr;
+  int64_t begin = 0;
+  int64_t end = 0;
+  while (TakeTasks(&begin, &end)) {
+    ranges.clear();
+    for (int64_t task_id = begin; task_id < end; ++task_id) {
+      Range range;
+      if (range_func_(task_id, &range) && range.size > 0 && range.shard_id >= 0 &&
+          range.shard_id < static_cast<int>(fds_.size())) {
+        ranges.push_back(range);
+      }
+    }
+    if (!AdviseRanges(ring, &ranges)) {
+      MS_LOG(WARNING) << "Prefetch with io_uring failed, fall back to posix_fadvise.";
+      ring = nullptr;
+    }
+    for (int64_t task_id = begin; task_id < end; ++task_id) {
+      done_[task_id % window_].store(task_id, std::memory_order_release);
+    }
+    prefetched_rows_ += end - begin;
+  }
+}
+
+bool ShardPrefetcher::AdviseRanges(IoRing *ring, std::vector<Range> *ranges) {
+  if (ranges->empty()) {
+    return true;
+  }
+  std::sort(ranges->begin(), ranges->end(), [](const Range &lhs, const Range &rhs) {
+    return lhs.shard_id != rhs.shard_id ? lhs.shard_id < rhs.shard_id : lhs.offset < rhs.offset;
+  });
+  // merge the blobs close to each other, then split the merged ranges into requests of a bounded size
+  std::vector<Range> merged;
+  for (const auto &range : *ranges) {
+    if (!merged.empty() && merged.back().shard_id == range.shard_id &&
+        range.offset <= merged.back().offset + merged.back().size + kMergeGap) {
+      auto end = std::max(merged.back().offset + merged.back().size, range.offset + range.size);
+      merged.back().size = end - merged.back().offset;
+    } else {
+      merged.push_back(range);
+    }
+  }
+  std::vector<Range> requests;
+  for (const auto &range : merged) {
+    for (uint64_t offset = 0; offset < range.size; offset += kMaxAdviseSize) {
+      Range request = range;
+      request.offset = range.offset + offset;
+      request.size = std::min(kMaxAdviseSize, range.size - offset);
+      requests.push_back(request);
+    }
+  }
+
+  bool advised = ring != nullptr && ring->Advise(fds_, requests);
+  if (!advised) {
+    // the ring may have failed part way, advising a range twice is harmless
+    for (const auto &request : requests) {
+      AdviseWillNeed(fds_[request.shard_id], request);
+    }
+  }
+  read_requests_ += static_cast<int64_t>(requests.size());
+  for (const auto &request : requests) {
+    read_bytes_ += static_cast<int64_t>(request.size);
+  }
+  return ring == nullptr || advised;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -98,6 +98,44 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
       MS_LOG(ERROR) << "Mindrecord files meta information is different.";
       return FAILED;
     }
+  }
+  ShardHeader sh = ShardHeader();
+  if (sh.BuildDataset(file_paths_, load_dataset) == FAILED) {
+    return FAILED;
+  }
+  shard_header_ = std::make_shared<ShardHeader>(sh);
+  header_size_ = shard_header_->GetHeaderSize();
+  page_size_ = shard_header_->GetPageSize();
+  // version < 3.0
+  if (first_meta_data["version"] < kVersion) {
+    shard_column_ = std::make_shared<ShardColumn>(shard_header_, false);
+  } else {
+    shard_column_ = std::make_shared<ShardColumn>(shard_header_, true);
+  }
+  num_rows_ = 0;
+  auto row_group_summary = ReadRowGroupSummary();
+  for (const auto &rg : row_group_summary) {
+    num_rows_ += std::get<3>(rg);
+  }
+  // sqlite is only needed at launch when some shard has no compact index
+  if (LoadIndexFiles(row_group_summary) != SUCCESS && OpenDatabases() != SUCCESS) {
+    return FAILED;
+  }
+  auto disk_size = page_size_ * row_group_summary.size();
+  auto compression_size = shard_header_->GetCompressionSize();
+  total_blob_size_ = disk_size + compression_size;
+  MS_LOG(INFO) << "Blob data size, on disk: " << disk_size << " , addtional uncompression: " << compression_size
+               << " , Total: " << total_blob_size_;
+
+  MS_LOG(INFO) << "Get meta from mindrecord file & index file successfully.";
+
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::OpenDatabases() {
+  std::lock_guard<std::mutex> lck(database_locker_);
+  for (size_t i = database_paths_.size(); i < file_paths_.size(); ++i) {
+    const auto &file = file_paths_[i];
     sqlite3 *db = nullptr;
     // sqlite3_open create a database if not found, use sqlite3_open_v2 instead of it
     int rc = sqlite3_open_v2(common::SafeCStr(file + ".db"), &db, SQLITE_OPEN_READONLY, nullptr);
@@ -130,32 +168,35 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
     }
     database_paths_.push_back(db);
   }
-  ShardHeader sh = ShardHeader();
-  if (sh.BuildDataset(file_paths_, load_dataset) == FAILED) {
-    return FAILED;
-  }
-  shard_header_ = std::make_shared<ShardHeader>(sh);
-  header_size_ = shard_header_->GetHeaderSize();
-  page_size_ = shard_header_->GetPageSize();
-  // version < 3.0
-  if (first_meta_data["version"] < kVersion) {
-    shard_column_ = std::make_shared<ShardColumn>(shard_header_, false);
-  } else {
-    shard_column_ = std::make_shared<ShardColumn>(shard_header_, true);
-  }
-  num_rows_ = 0;
-  auto row_group_summary = ReadRowGroupSummary();
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::LoadIndexFiles(const std::vector<std::tuple<int, int, int, uint64_t>> &row_group_summary) {
+  std::vector<uint64_t> shard_rows(file_paths_.size(), 0);
   for (const auto &rg : row_group_summary) {
-    num_rows_ += std::get<3>(rg);
+    auto shard_id = static_cast<size_t>(std::get<0>(rg));
+    if (shard_id < shard_rows.size()) {
+      shard_rows[shard_id] += std::get<3>(rg);
+    }
   }
-  auto disk_size = page_size_ * row_group_summary.size();
-  auto compression_size = shard_header_->GetCompressionSize();
-  total_blob_size_ = disk_size + compression_size;
-  MS_LOG(INFO) << "Blob data size, on disk: " << disk_size << " , addtional uncompression: " << compression_size
-               << " , Total: " << total_blob_size_;
-
-  MS_LOG(INFO) << "Get meta from mindrecord file & index file successfully.";
-
+  std::vector<std::shared_ptr<ShardIndexFile>> index_files;
+  for (size_t i = 0; i < file_paths_.size(); ++i) {
+    const auto &file = file_paths_[i];
+    auto index_file = std::make_shared<ShardIndexFile>();
+    if (index_file->Load(file + kIndexFileSuffix) != SUCCESS) {
+      return FAILED;
+    }
+    ShardIndexFile::ShardDigest digest;
+    if (index_file->GetShardName() != GetFileName(file).second ||
+        ShardIndexFile::GetShardDigest(file, &digest) != SUCCESS || !index_file->MatchShard(digest) ||
+        index_file->GetNumRows() != shard_rows[i]) {
+      MS_LOG(WARNING) << "Index file can not match file " << file << ", use the db file instead.";
+      return FAILED;
+    }
+    index_files.push_back(index_file);
+  }
+  index_files_ = std::move(index_files);
+  MS_LOG(INFO) << "Load " << index_files_.size() << " compact index files successfully.";
   return SUCCESS;
 }
 
@@ -208,10 +249,46 @@ MSRStatus ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Open shard file successfully.";
   }
+  MapFiles();
 
   return SUCCESS;
 }
 
+void ShardReader::MapFiles() {
+  mapped_files_.clear();
+  for (const auto &file : file_paths_) {
+    auto mapping = std::make_shared<ShardMappedFile>();
+    if (mapping->Open(file) != SUCCESS) {
+      MS_LOG(INFO) << "Shard file could not be mapped, read it by file stream.";
+      mapped_files_.clear();
+      return;
+    }
+    mapped_files_.push_back(mapping);
+  }
+}
+
+void ShardReader::AdviseAccessPattern() {
+  // rows of one shard are visited in file order if both the row group and the offset in row group never go back
+  std::vector<std::pair<int, uint64_t>> last_row(file_paths_.size(), std::make_pair(-1, 0));
+  sequential_access_ = true;
+  for (auto id : tasks_.permutation_) {
+    auto &task = tasks_.GetTaskByID(id);
+    if (std::get<0>(task) == TaskType::kPaddedTask) {
+      continue;
+    }
+    auto shard_id = std::get<0>(std::get<1>(task));
+    auto row = std::make_pair(std::get<1>(std::get<1>(task)), std::get<2>(task)[0]);
+    if (row < last_row[shard_id]) {
+      sequential_access_ = false;
+      break;
+    }
+    last_row[shard_id] = row;
+  }
+  for (const auto &mapping : mapped_files_) {
+    mapping->AdviseSequential(sequential_access_);
+  }
+}
+
 void ShardReader::FileStreamsOperator() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
@@ -225,6 +302,8 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  // tensors viewing a mapped file keep it alive
+  mapped_files_.clear();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       auto ret = sqlite3_close(database_paths_[i]);
@@ -252,6 +331,9 @@ void ShardReader::Close() {
     }
   }
 
+  if (prefetcher_ != nullptr) {
+    prefetcher_->Stop();
+  }
   FileStreamsOperator();
 }
 
@@ -297,6 +379,82 @@ MSRStatus ShardReader::GetTotalBlobSize(int64_t *total_blob_size) {
   return SUCCESS;
 }
 
+void ShardReader::SetPrefetchWindow(int64_t window) {
+  if (window > kMaxPrefetchWindow) {
+    MS_LOG(WARNING) << "The prefetch window " << window << " is larger than " << kMaxPrefetchWindow
+                    << ", use " << kMaxPrefetchWindow << " instead.";
+    window = kMaxPrefetchWindow;
+  }
+  prefetch_window_ = window;
+}
+
+ShardPrefetcher::Stats ShardReader::GetPrefetchStats() const {
+  if (prefetcher_ == nullptr) {
+    return ShardPrefetcher::Stats();
+  }
+  return prefetcher_->GetStats();
+}
+
+void ShardReader::StartPrefetch() {
+  if (prefetch_window_ <= 0 || tasks_.Size() == 0) {
+    return;
+  }
+  if (prefetcher_ == nullptr) {
+    // the slots of the window are allocated at once, no more of them than rows
+    prefetcher_ = std::make_unique<ShardPrefetcher>(std::min(prefetch_window_, static_cast<int64_t>(tasks_.Size())));
+  }
+  auto range_func = [this](int64_t task_id, ShardPrefetcher::Range *range) {
+    auto &task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+    if (std::get<0>(task) == TaskType::kPaddedTask) {
+      return false;
+    }
+    auto shard_id = std::get<0>(std::get<1>(task));
+    auto group_id = std::get<1>(std::get<1>(task));
+    const auto &addr = std::get<2>(task);
+    const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+    if (SUCCESS != ret.first) {
+      return false;
+    }
+    range->shard_id = shard_id;
+    range->offset = header_size_ + page_size_ * (ret.second->GetPageID()) + addr[0];
+    range->size = addr[1] - addr[0];
+    return true;
+  };
+  if (prefetcher_->Start(file_paths_, static_cast<int64_t>(tasks_.Size()), range_func) != SUCCESS) {
+    MS_LOG(WARNING) << "Failed to start the read-ahead of the blobs, rows are read on demand.";
+  }
+}
+
+MSRStatus ShardReader::ReadRawLabel(const std::shared_ptr<std::fstream> &fs, int raw_page_id, uint64_t label_start,
+                                    uint64_t label_end, const std::vector<std::string> &columns, json *label) {
+  auto len = label_end - label_start;
+  auto label_raw = std::vector<uint8_t>(len);
+  auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    MS_LOG(ERROR) << "File seekg failed";
+    fs->close();
+    return FAILED;
+  }
+
+  auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    MS_LOG(ERROR) << "File read failed";
+    fs->close();
+    return FAILED;
+  }
+  json label_json = json::from_msgpack(label_raw);
+  if (!columns.empty()) {
+    for (auto &col : columns) {
+      if (label_json.find(col) != label_json.end()) {
+        (*label)[col] = label_json[col];
+      }
+    }
+  } else {
+    *label = label_json;
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels,
                                           std::shared_ptr<std::fstream> fs,
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
@@ -312,31 +470,9 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
       int raw_page_id = std::stoi(labels[i][3]);
       uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
       uint64_t label_end = std::stoull(labels[i][5]);
-      auto len = label_end - label_start;
-      auto label_raw = std::vector<uint8_t>(len);
-      auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
-      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-        MS_LOG(ERROR) << "File seekg failed";
-        fs->close();
-        return FAILED;
-      }
-
-      auto &io_read = fs->read(reinterpret_cast<char *>(&label_raw[0]), len);
-      if (!io_read.good() || io_read.fail() || io_read.bad()) {
-        MS_LOG(ERROR) << "File read failed";
-        fs->close();
-        return FAILED;
-      }
-      json label_json = json::from_msgpack(label_raw);
       json tmp;
-      if (!columns.empty()) {
-        for (auto &col : columns) {
-          if (label_json.find(col) != label_json.end()) {
-            tmp[col] = label_json[col];
-          }
-        }
-      } else {
-        tmp = label_json;
+      if (ReadRawLabel(fs, raw_page_id, label_start, label_end, columns, &tmp) != SUCCESS) {
+        return FAILED;
       }
       column_values[shard_id].emplace_back(tmp);
     } else {
@@ -394,6 +530,89 @@ MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql,
   return ConvertLabelToJson(labels, fs, offsets, shard_id, columns, column_values);
 }
 
+MSRStatus ShardReader::ReadAllRowsInIndexFile(int shard_id, const std::vector<std::string> &columns,
+                                              std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                              std::vector<std::vector<json>> &column_values) {
+  const auto &index_file = index_files_[shard_id];
+  auto num_rows = index_file->GetNumRows();
+  auto group_ids = index_file->GetIndexColumn(ShardIndexFile::kRowGroupId);
+  auto blob_starts = index_file->GetIndexColumn(ShardIndexFile::kPageOffsetBlob);
+  auto blob_ends = index_file->GetIndexColumn(ShardIndexFile::kPageOffsetBlobEnd);
+
+  std::vector<int> field_ids;
+  std::vector<std::string> column_types;
+  std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+  if (all_in_index_) {
+    auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+    for (const auto &column : columns) {
+      // runs on one thread per shard, so the column map is not touched by operator[]
+      auto schema_id = column_schema_id_.find(column);
+      int field_id = -1;
+      if (schema_id != column_schema_id_.end()) {
+        auto ret = ShardIndexGenerator::GenerateFieldName(std::make_pair(schema_id->second, column));
+        field_id = ret.first == SUCCESS ? index_file->GetFieldId(ret.second) : -1;
+      }
+      if (field_id < 0) {
+        MS_LOG(ERROR) << "Column " << column << " is not found in index file of shard " << shard_id;
+        return FAILED;
+      }
+      field_ids.push_back(field_id);
+      column_types.push_back(schema[column]["type"]);
+    }
+  } else {
+    fs->open(common::SafeCStr(file_paths_[shard_id]), std::ios::in | std::ios::binary);
+    if (!fs->good()) {
+      MS_LOG(ERROR) << "File could not opened";
+      return FAILED;
+    }
+  }
+
+  offsets[shard_id].reserve(num_rows);
+  column_values[shard_id].reserve(num_rows);
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    offsets[shard_id].emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id),
+                                                         static_cast<uint64_t>(group_ids[i]),
+                                                         static_cast<uint64_t>(blob_starts[i]) + kInt64Len,
+                                                         static_cast<uint64_t>(blob_ends[i])});
+    json construct_json;
+    if (!all_in_index_) {
+      int raw_page_id = static_cast<int>(index_file->GetIndexColumn(ShardIndexFile::kPageIdRaw)[i]);
+      uint64_t label_start = index_file->GetIndexColumn(ShardIndexFile::kPageOffsetRaw)[i] + kInt64Len;
+      uint64_t label_end = index_file->GetIndexColumn(ShardIndexFile::kPageOffsetRawEnd)[i];
+      if (ReadRawLabel(fs, raw_page_id, label_start, label_end, columns, &construct_json) != SUCCESS) {
+        return FAILED;
+      }
+      column_values[shard_id].emplace_back(construct_json);
+      continue;
+    }
+    for (size_t j = 0; j < columns.size(); ++j) {
+      // convert the value to base type by schema, as for the sqlite index
+      auto field_id = field_ids[j];
+      auto field_type = index_file->GetFieldType(field_id);
+      if (field_type == ShardIndexFile::kFieldInteger) {
+        auto value = index_file->GetInteger(field_id, i);
+        if (column_types[j] == "int32") {
+          construct_json[columns[j]] = static_cast<int32_t>(value);
+        } else {
+          construct_json[columns[j]] = value;
+        }
+      } else if (field_type == ShardIndexFile::kFieldFloat) {
+        auto value = index_file->GetFloat(field_id, i);
+        if (column_types[j] == "float32") {
+          construct_json[columns[j]] = static_cast<float>(value);
+        } else {
+          construct_json[columns[j]] = value;
+        }
+      } else {
+        construct_json[columns[j]] = index_file->GetText(field_id, i);
+      }
+    }
+    column_values[shard_id].emplace_back(construct_json);
+  }
+  MS_LOG(INFO) << "Get " << num_rows << " records from shard " << shard_id << " index file.";
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set<std::string> &categories) {
   std::map<std::string, uint64_t> index_columns;
   for (auto &field : GetShardHeader()->GetFields()) {
@@ -407,6 +626,9 @@ MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set
   if (SUCCESS != ret.first) {
     return FAILED;
   }
+  if (OpenDatabases() != SUCCESS) {
+    return FAILED;
+  }
   std::string sql = "SELECT DISTINCT " + ret.second + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
@@ -445,6 +667,17 @@ ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
   std::vector<std::vector<std::vector<uint64_t>>> offsets(shard_count_, std::vector<std::vector<uint64_t>>{});
   std::vector<std::vector<json>> column_values(shard_count_, std::vector<json>{});
+  if (!index_files_.empty()) {
+    std::vector<std::thread> thread_read_index = std::vector<std::thread>(shard_count_);
+    for (int x = 0; x < shard_count_; x++) {
+      thread_read_index[x] = std::thread(&ShardReader::ReadAllRowsInIndexFile, this, x, columns, std::ref(offsets),
+                                         std::ref(column_values));
+    }
+    for (int x = 0; x < shard_count_; x++) {
+      thread_read_index[x].join();
+    }
+    return std::make_tuple(SUCCESS, std::move(offsets), std::move(column_values));
+  }
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -529,6 +762,9 @@ int ShardReader::SelectCallback(void *p_data, int num_fields, char **p_fields, c
 
 std::vector<std::vector<uint64_t>> ShardReader::GetImageOffset(int page_id, int shard_id,
                                                                const std::pair<std::string, std::string> &criteria) {
+  if (OpenDatabases() != SUCCESS) {
+    return std::vector<std::vector<uint64_t>>();
+  }
   auto db = database_paths_[shard_id];
 
   std::string sql =
@@ -678,6 +914,9 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromPage(
   int page_id, int shard_id, const std::vector<std::string> &columns,
   const std::pair<std::string, std::string> &criteria) {
   // get page info from sqlite
+  if (OpenDatabases() != SUCCESS) {
+    return {FAILED, {}};
+  }
   auto db = database_paths_[shard_id];
   std::string sql = "SELECT PAGE_ID_RAW, PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END FROM INDEXES WHERE PAGE_ID_BLOB = " +
                     std::to_string(page_id);
@@ -709,6 +948,9 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int
                                                                const std::vector<std::string> &columns,
                                                                const std::pair<std::string, std::string> &criteria) {
   if (all_in_index_) {
+    if (OpenDatabases() != SUCCESS) {
+      return {FAILED, {}};
+    }
     auto db = database_paths_[shard_id];
     std::string fields;
     for (unsigned int i = 0; i < columns.size(); ++i) {
@@ -952,6 +1194,7 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
     interrupt_ = true;
     return FAILED;
   }
+  StartPrefetch();
   if (isSimpleReader) return SUCCESS;
   // Start provider consumer threads
   thread_set_ = std::vector<std::thread>(n_consumer_);
@@ -1096,14 +1339,33 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
   if (tasks_.permutation_.empty()) tasks_.MakePerm();
   num_rows_ = tasks_.Size();
   MS_LOG(INFO) << "Total rows is " << num_rows_;
+  AdviseAccessPattern();
   return SUCCESS;
 }
 
 TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+  auto ret = ConsumerOneTaskSlice(task_id, consumer_id);
+  std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
+  for (auto &row : ret.second.second) {
+    auto &blob = std::get<0>(row);
+    if (blob.mapping != nullptr) {
+      batch.emplace_back(std::vector<uint8_t>(blob.data, blob.data + blob.size), std::move(std::get<1>(row)));
+    } else {
+      batch.emplace_back(std::move(blob.buffer), std::move(std::get<1>(row)));
+    }
+  }
+  return std::make_pair(ret.first, std::make_pair(ret.second.first, std::move(batch)));
+}
+
+TASK_SLICE_CONTENT ShardReader::ConsumerOneTaskSlice(int task_id, uint32_t consumer_id) {
   // All tasks are done
   if (task_id >= static_cast<int>(tasks_.Size())) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BlobSlice, json>>()));
+  }
+
+  // Let the read-ahead move on before this row is read
+  if (prefetcher_ != nullptr) {
+    prefetcher_->Advance(task_id);
   }
 
   // Pick up task from task list
@@ -1112,8 +1374,7 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   // check task type
   auto task_type = std::get<0>(task);
   if (task_type == TaskType::kPaddedTask) {
-    return std::make_pair(SUCCESS,
-                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return std::make_pair(SUCCESS, std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<BlobSlice, json>>()));
   }
 
   auto shard_id = std::get<0>(std::get<1>(task));
@@ -1121,35 +1382,49 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   auto addr = std::get<2>(task);
   const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
   if (SUCCESS != ret.first) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BlobSlice, json>>()));
   }
   const std::shared_ptr<Page> &page = ret.second;
 
   // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
+  BlobSlice blob;
+  blob.size = addr[1] - addr[0];
   auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
-  }
+  if (!mapped_files_.empty()) {
+    const auto &mapping = mapped_files_[shard_id];
+    if (file_offset + blob.size > mapping->GetSize()) {
+      MS_LOG(ERROR) << "Blob is out of the mapped file, offset: " << file_offset << ", size: " << blob.size;
+      return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BlobSlice, json>>()));
+    }
+    // read the whole page ahead when its first row is visited, the following rows come from the other consumers
+    if (sequential_access_ && addr[0] == 0) {
+      mapping->AdviseWillNeed(file_offset, page_size_);
+    }
+    blob.data = mapping->GetData() + file_offset;
+    blob.mapping = mapping;
+  } else {
+    blob.buffer.resize(blob.size);
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BlobSlice, json>>()));
+    }
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    auto &io_read =
+      file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&blob.buffer[0]), blob.size);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BlobSlice, json>>()));
+    }
+    blob.data = blob.buffer.data();
   }
 
   // Deliver batch data to output map
-  std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
-  batch.emplace_back(std::move(images), std::move(std::get<3>(task)));
+  std::vector<std::tuple<BlobSlice, json>> batch;
+  batch.emplace_back(std::move(blob), std::move(std::get<3>(task)));
 
   return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
 }
@@ -1227,6 +1502,18 @@ std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardRe
   return std::move(ret.second);
 }
 
+std::pair<TaskType, std::vector<std::tuple<BlobSlice, json>>> ShardReader::GetNextSliceById(
+  const int64_t &task_id, const int32_t &consumer_id) {
+  if (interrupt_) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BlobSlice, json>>());
+  }
+  auto ret = ConsumerOneTaskSlice(task_id, consumer_id);
+  if (SUCCESS != ret.first) {
+    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<BlobSlice, json>>());
+  }
+  return std::move(ret.second);
+}
+
 std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> ShardReader::UnCompressBlob(
   const std::vector<uint8_t> &raw_blob_data) {
   auto loaded_columns = selected_columns_.size() == 0 ? shard_column_->GetColumnName() : selected_columns_;
@@ -1274,6 +1561,10 @@ void ShardReader::Reset() {
 }
 
 void ShardReader::ShuffleTask() {
+  // the read-ahead follows the task order, so it restarts from the first task of the new order
+  if (prefetcher_ != nullptr) {
+    prefetcher_->Stop();
+  }
   // exist shuffle and distributed sampler in ops, skip shuffle
   bool has_sharding = false;
   for (const auto &op : operators_) {
@@ -1293,6 +1584,8 @@ void ShardReader::ShuffleTask() {
     }
   }
   if (tasks_.permutation_.empty()) tasks_.MakePerm();
+  AdviseAccessPattern();
+  StartPrefetch();
 }
 
 }  // namespace mindrecord
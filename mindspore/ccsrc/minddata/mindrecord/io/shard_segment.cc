@@ -34,6 +34,9 @@ std::pair<MSRStatus, vector<std::string>> ShardSegment::GetCategoryFields() {
   // Skip if already populated
   if (!candidate_category_fields_.empty()) return {SUCCESS, candidate_category_fields_};
 
+  if (OpenDatabases() != SUCCESS) {
+    return {FAILED, vector<std::string>{}};
+  }
   std::string sql = "PRAGMA table_info(INDEXES);";
   std::vector<std::vector<std::string>> field_names;
 
@@ -99,6 +102,9 @@ std::pair<MSRStatus, std::vector<std::tuple<int, std::string, int>>> ShardSegmen
 
   std::string sql = "SELECT " + current_category_field_ + ", COUNT(" + current_category_field_ +
                     ") AS `value_occurrence` FROM indexes GROUP BY " + current_category_field_ + ";";
+  if (OpenDatabases() != SUCCESS) {
+    return {FAILED, std::vector<std::tuple<int, std::string, int>>()};
+  }
 
   for (auto &db : database_paths_) {
     std::vector<std::vector<std::string>> field_count;
@@ -0,0 +1,565 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "debug/dump_proto.h"
+#include "frontend/operator/composite/composite.h"
+#include "frontend/operator/composite/map.h"
+#include "frontend/optimizer/opt.h"
+#include "frontend/parallel/ps/ps_context.h"
+#include "utils/load_onnx/anf_converter.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+#include "frontend/parallel/context.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+// Bump it when the format of the entries changes.
+constexpr auto kCompileCacheVersion = "2";
+constexpr auto kKeySuffix = ".key";
+constexpr auto kGraphSuffix = ".mindir";
+constexpr auto kParamSuffix = ".params";
+// the env switches read while compiling a graph
+const char *const kKeyEnvs[] = {opt::kEnvSubstitutionSweep, parallel::ps::kEnvRole};
+
+uint64_t Fnv1aHash(const std::string &text) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (auto c : text) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Identifies the library doing the compilation, so that the entries of another build are not used.
+std::string LibraryIdentity() {
+  Dl_info info;
+  if (dladdr(reinterpret_cast<void *>(&Fnv1aHash), &info) == 0 || info.dli_fname == nullptr) {
+    return "unknown";
+  }
+  struct stat lib_stat;
+  if (stat(info.dli_fname, &lib_stat) != 0) {
+    return info.dli_fname;
+  }
+  std::ostringstream oss;
+  oss << info.dli_fname << ":" << lib_stat.st_size << ":" << lib_stat.st_mtime;
+  return oss.str();
+}
+
+std::string ContextText() {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  std::ostringstream oss;
+  oss << context->get_param<std::string>(MS_CTX_DEVICE_TARGET) << " "
+      << context->get_param<int>(MS_CTX_EXECUTION_MODE) << " "
+      << context->get_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL) << " "
+      << context->get_param<bool>(MS_CTX_ENABLE_REDUCE_PRECISION) << " " << parallel_context->parallel_mode() << " "
+      << parallel_context->device_num() << " " << parallel_context->global_rank();
+  for (auto env : kKeyEnvs) {
+    oss << " " << env << "=" << common::GetEnv(env);
+  }
+  return oss.str();
+}
+
+bool ValueText(const ValuePtr &value, std::ostringstream *oss);
+
+bool ValuesText(const ValuePtrList &values, std::ostringstream *oss) {
+  *oss << "(";
+  for (auto &value : values) {
+    if (!ValueText(value, oss)) {
+      return false;
+    }
+    *oss << ",";
+  }
+  *oss << ")";
+  return true;
+}
+
+// The python functions of a MultitypeFuncGraph are only parsed by the static analysis, so their code is keyed.
+bool MultitypeFuncGraphText(const prim::MultitypeFuncGraphPtr &multitype_fg, std::ostringstream *oss) {
+  std::vector<std::string> functions;
+  for (auto &item : multitype_fg->GetPyFunctions()) {
+    py::function fn = item.second;
+    if (!py::hasattr(fn, "__code__")) {
+      return false;
+    }
+    py::object code = fn.attr("__code__");
+    std::ostringstream text;
+    for (auto &type : item.first) {
+      text << type->ToString() << ",";
+    }
+    text << " " << py::str(fn.attr("__module__")).cast<std::string>() << "."
+         << py::str(fn.attr("__qualname__")).cast<std::string>() << " "
+         << Fnv1aHash(py::bytes(code.attr("co_code")).cast<std::string>()) << " "
+         << py::repr(code.attr("co_consts")).cast<std::string>() << " "
+         << py::repr(code.attr("co_names")).cast<std::string>();
+    functions.push_back(text.str());
+  }
+  // the functions are kept in a hash map
+  std::sort(functions.begin(), functions.end());
+  *oss << multitype_fg->name() << "{";
+  for (auto &function : functions) {
+    *oss << function << ";";
+  }
+  *oss << "}";
+  return true;
+}
+
+bool MetaFuncGraphText(const MetaFuncGraphPtr &meta_fg, std::ostringstream *oss) {
+  if (meta_fg->isa<prim::MultitypeFuncGraph>()) {
+    return MultitypeFuncGraphText(meta_fg->cast<prim::MultitypeFuncGraphPtr>(), oss);
+  }
+  *oss << meta_fg->type_name() << " " << meta_fg->name();
+  if (meta_fg->isa<prim::HyperMap>() || meta_fg->isa<prim::Map>()) {
+    auto fn_leaf = meta_fg->isa<prim::HyperMap>() ? meta_fg->cast<prim::HyperMapPtr>()->GetFnLeaf()
+                                                  : meta_fg->cast<prim::MapPtr>()->GetFnLeaf();
+    return fn_leaf == nullptr || MetaFuncGraphText(fn_leaf, oss);
+  }
+  if (meta_fg->isa<prim::GradOperation>()) {
+    auto grad = meta_fg->cast<prim::GradOperationPtr>();
+    *oss << " " << grad->get_all_ << grad->get_by_list_ << grad->sens_param_;
+    return true;
+  }
+  if (meta_fg->isa<prim::DoSignatureMetaFuncGraph>()) {
+    *oss << " ";
+    return ValueText(meta_fg->cast<prim::RWSignaturePtr>()->function(), oss);
+  }
+  // the other meta graphs are only defined by their names
+  return meta_fg->isa<prim::Tail>() || meta_fg->isa<prim::MakeTupleGradient>() ||
+         meta_fg->isa<prim::MakeListGradient>() || meta_fg->isa<prim::TupleAdd>() || meta_fg->isa<prim::TupleSlice>() ||
+         meta_fg->isa<prim::TupleGetItemTensor>() || meta_fg->isa<prim::UnpackCall>() ||
+         meta_fg->isa<prim::ListAppend>() || meta_fg->isa<prim::ZipOperation>();
+}
+
+// Writes the whole state of a value, returns false for a value whose state is unknown, the graph holding it can not
+// be cached.
+bool ValueText(const ValuePtr &value, std::ostringstream *oss) {
+  MS_EXCEPTION_IF_NULL(oss);
+  if (value == nullptr) {
+    return false;
+  }
+  if (value->isa<Primitive>()) {
+    auto prim = value->cast<PrimitivePtr>();
+    // the attributes are kept in a hash map
+    std::map<std::string, ValuePtr> attrs(prim->attrs().begin(), prim->attrs().end());
+    *oss << prim->name() << "[";
+    for (auto &attr : attrs) {
+      *oss << attr.first << "=";
+      if (!ValueText(attr.second, oss)) {
+        return false;
+      }
+      *oss << ",";
+    }
+    *oss << "]";
+    return true;
+  }
+  if (value->isa<tensor::Tensor>()) {
+    auto tensor = value->cast<tensor::TensorPtr>();
+    std::string data(static_cast<const char *>(tensor->data_c()), tensor->data().nbytes());
+    *oss << tensor->GetShapeAndDataTypeInfo() << Fnv1aHash(data);
+    return true;
+  }
+  if (value->isa<MetaFuncGraph>()) {
+    return MetaFuncGraphText(value->cast<MetaFuncGraphPtr>(), oss);
+  }
+  if (value->isa<ValueSequeue>()) {
+    *oss << value->type_name();
+    return ValuesText(value->cast<ValueSequeuePtr>()->value(), oss);
+  }
+  if (value->isa<ValueDictionary>()) {
+    *oss << "dict{";
+    for (auto &item : value->cast<ValueDictionaryPtr>()->value()) {
+      *oss << item.first << ":";
+      if (!ValueText(item.second, oss)) {
+        return false;
+      }
+      *oss << ",";
+    }
+    *oss << "}";
+    return true;
+  }
+  if (value->isa<ValueSlice>()) {
+    auto slice = value->cast<ValueSlicePtr>();
+    *oss << "slice";
+    return ValuesText({slice->start(), slice->stop(), slice->step()}, oss);
+  }
+  if (value->isa<FP32Imm>() || value->isa<FP64Imm>()) {
+    // ToString rounds the floats
+    auto float_value = value->isa<FP32Imm>() ? GetValue<float>(value) : GetValue<double>(value);
+    *oss << value->type_name() << std::setprecision(std::numeric_limits<double>::max_digits10) << float_value;
+    return true;
+  }
+  // the text of these values holds their whole state
+  if (value->isa<Scalar>() || value->isa<StringImm>() || value->isa<Type>() || value->isa<Named>()) {
+    *oss << value->type_name() << " " << value->ToString();
+    return true;
+  }
+  return false;
+}
+
+// Writes the structure of the graphs reachable from func_graph, with the graphs and nodes numbered in the order
+// they are reached so that the text only depends on the structure.
+class GraphTextWriter {
+ public:
+  // Returns an empty text if a graph holds a value whose state can not be written.
+  std::string Write(const FuncGraphPtr &func_graph) {
+    (void)GraphId(func_graph);
+    for (size_t i = 0; i < graphs_.size(); ++i) {
+      auto graph = graphs_[i];
+      oss_ << "graph " << i << " params";
+      for (auto &param : graph->parameters()) {
+        oss_ << " " << NodeId(param);
+      }
+      oss_ << "\n";
+      for (auto &node : TopoSort(graph->get_return())) {
+        if (node->isa<CNode>() && node->func_graph() == graph) {
+          (void)NodeId(node);
+        }
+      }
+    }
+    return unknown_value_ ? "" : oss_.str();
+  }
+
+ private:
+  size_t GraphId(const FuncGraphPtr &graph) {
+    auto iter = graph_ids_.find(graph);
+    if (iter != graph_ids_.end()) {
+      return iter->second;
+    }
+    auto id = graphs_.size();
+    graph_ids_[graph] = id;
+    graphs_.push_back(graph);
+    return id;
+  }
+
+  size_t NodeId(const AnfNodePtr &node) {
+    auto iter = node_ids_.find(node);
+    if (iter != node_ids_.end()) {
+      return iter->second;
+    }
+    std::ostringstream text;
+    if (node->isa<CNode>()) {
+      text << "cnode(";
+      for (auto &input : node->cast<CNodePtr>()->inputs()) {
+        text << NodeId(input) << ",";
+      }
+      text << ")";
+    } else if (node->isa<Parameter>()) {
+      auto param = node->cast<ParameterPtr>();
+      text << "param " << param->name();
+      // the values of the weights may change between runs, their shapes and types may not
+      auto value = param->has_default() ? param->default_param() : nullptr;
+      auto tensor = value != nullptr ? value->cast<tensor::TensorPtr>() : nullptr;
+      if (tensor != nullptr) {
+        text << " " << tensor->GetShapeAndDataTypeInfo();
+      }
+    } else if (IsValueNode<FuncGraph>(node)) {
+      text << "graph " << GraphId(GetValueNode<FuncGraphPtr>(node));
+    } else if (node->isa<ValueNode>()) {
+      text << "value ";
+      if (!ValueText(GetValueNode(node), &text)) {
+        MS_LOG(INFO) << "The state of value " << node->DebugString() << " is unknown, the graph is not cached.";
+        unknown_value_ = true;
+      }
+    }
+    auto id = node_ids_.size();
+    node_ids_[node] = id;
+    oss_ << id << " = " << text.str() << "\n";
+    return id;
+  }
+
+  std::ostringstream oss_;
+  std::vector<FuncGraphPtr> graphs_;
+  std::unordered_map<FuncGraphPtr, size_t> graph_ids_;
+  std::unordered_map<AnfNodePtr, size_t> node_ids_;
+  bool unknown_value_{false};
+};
+
+bool ReadFile(const std::string &file_name, std::string *content) {
+  std::ifstream ifs(file_name, std::ios::binary);
+  if (!ifs.is_open()) {
+    return false;
+  }
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  *content = oss.str();
+  return ifs.good() || ifs.eof();
+}
+
+// Writes to a temporary file renamed at the end, so a reader never sees a partial entry.
+bool WriteFile(const std::string &file_name, const std::string &content) {
+  std::string tmp_name = file_name + ".tmp" + std::to_string(getpid());
+  std::ofstream ofs(tmp_name, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    return false;
+  }
+  ofs << content;
+  ofs.close();
+  if (!ofs.good() || rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+    (void)remove(tmp_name.c_str());
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+CompileCache &CompileCache::GetInstance() {
+  static CompileCache instance(common::GetEnv(kEnvCompileCachePath));
+  return instance;
+}
+
+CompileCache::CompileCache(const std::string &path) {
+  if (path.empty()) {
+    return;
+  }
+  if (mkdir(path.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+    MS_LOG(WARNING) << "Env " << kEnvCompileCachePath << " is invalid: " << path
+                    << ", the directory can not be created, the compile cache is disabled.";
+    return;
+  }
+  path_ = path;
+  MS_LOG(INFO) << "Compile cache path: " << path_;
+}
+
+CompileCache::~CompileCache() {
+  if (enabled()) {
+    MS_LOG(INFO) << Report();
+  }
+}
+
+std::vector<ActionItem> CompileCache::WrapActions(const std::vector<ActionItem> &actions) {
+  // the parallel strategies and layouts are not kept in the cached graph
+  auto parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode != parallel::STAND_ALONE && parallel_mode != parallel::DATA_PARALLEL) {
+    MS_LOG(INFO) << "The compile cache is not used in " << parallel_mode << " mode.";
+    return actions;
+  }
+  // only the graphs compiled by the vm backend are cached
+  auto is_task_emit = [](const ActionItem &action) { return action.first == "task_emit"; };
+  if (std::none_of(actions.begin(), actions.end(), is_task_emit)) {
+    return actions;
+  }
+  auto hit = std::make_shared<bool>(false);
+  auto key = std::make_shared<std::string>();
+  std::vector<ActionItem> wrapped_actions;
+  bool skippable = false;
+  for (auto &action : actions) {
+    if (skippable && action.first == "validate") {
+      wrapped_actions.emplace_back("store_compile_cache", [this, hit, key](const ResourcePtr &res) {
+        if (!*hit) {
+          Store(*key, res->func_graph());
+        }
+        return true;
+      });
+      skippable = false;
+    }
+    if (!skippable) {
+      wrapped_actions.push_back(action);
+    } else {
+      auto action_func = action.second;
+      wrapped_actions.emplace_back(action.first,
+                                   [hit, action_func](const ResourcePtr &res) { return *hit || action_func(res); });
+    }
+    if (action.first == "symbol_resolve") {
+      wrapped_actions.emplace_back("load_compile_cache", [this, hit, key](const ResourcePtr &res) {
+        *key = GetKey(res->func_graph(), res->args_spec());
+        auto graph = Load(*key, res->func_graph());
+        *hit = graph != nullptr;
+        if (*hit) {
+          auto manager = res->manager();
+          MS_EXCEPTION_IF_NULL(manager);
+          manager->AddFuncGraph(graph, true);
+          manager->KeepRoots({graph});
+          res->set_func_graph(graph);
+        }
+        return true;
+      });
+      skippable = true;
+    }
+  }
+  if (skippable) {
+    MS_LOG(DEBUG) << "No validate action, the compile cache is not used.";
+    return actions;
+  }
+  return wrapped_actions;
+}
+
+std::string CompileCache::GetKey(const FuncGraphPtr &resolved_graph,
+                                 const abstract::AbstractBasePtrList &args_spec) const {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  std::ostringstream oss;
+  oss << kCompileCacheVersion << "\n" << LibraryIdentity() << "\n" << ContextText() << "\n";
+  for (auto &arg : args_spec) {
+    MS_EXCEPTION_IF_NULL(arg);
+    oss << arg->ToString() << "\n";
+  }
+  auto graph_text = GraphTextWriter().Write(resolved_graph);
+  if (graph_text.empty()) {
+    return "";
+  }
+  oss << graph_text;
+  return oss.str();
+}
+
+std::string CompileCache::EntryName(const std::string &key) const {
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << Fnv1aHash(key);
+  return name.str();
+}
+
+std::string CompileCache::EntryPath(const std::string &key, const std::string &suffix) const {
+  return path_ + "/" + EntryName(key) + suffix;
+}
+
+void CompileCache::RemoveEntry(const std::string &key) const {
+  (void)remove(EntryPath(key, kKeySuffix).c_str());
+  (void)remove(EntryPath(key, kGraphSuffix).c_str());
+  (void)remove(EntryPath(key, kParamSuffix).c_str());
+}
+
+FuncGraphPtr CompileCache::Load(const std::string &key, const FuncGraphPtr &resolved_graph) {
+  MS_EXCEPTION_IF_NULL(resolved_graph);
+  if (key.empty()) {
+    return nullptr;
+  }
+  auto name = EntryName(key);
+  std::string key_buf;
+  std::string graph_buf;
+  std::string param_buf;
+  // an entry of another key with the same hash is replaced by the next store
+  if (!ReadFile(EntryPath(key, kKeySuffix), &key_buf) || key_buf != key ||
+      !ReadFile(EntryPath(key, kGraphSuffix), &graph_buf) || !ReadFile(EntryPath(key, kParamSuffix), &param_buf)) {
+    miss_++;
+    MS_LOG(INFO) << "Compile cache miss: " << name;
+    return nullptr;
+  }
+  // the weights of the cached graph, by the position of their parameters
+  std::vector<std::string> param_names;
+  std::istringstream param_stream(param_buf);
+  std::string line;
+  while (std::getline(param_stream, line)) {
+    param_names.push_back(line);
+  }
+  std::unordered_map<std::string, ParameterPtr> weights;
+  for (auto &node : resolved_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    if (param != nullptr && param->has_default()) {
+      weights[param->name()] = param;
+    }
+  }
+  FuncGraphPtr graph = nullptr;
+  try {
+    graph = lite::AnfConverter::RunAnfConverter(graph_buf.data(), graph_buf.size());
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Load compile cache " << name << " failed: " << e.what();
+  }
+  bool valid = graph != nullptr && graph->parameters().size() == param_names.size();
+  for (size_t i = 0; valid && i < param_names.size(); ++i) {
+    if (param_names[i].empty()) {
+      continue;
+    }
+    auto weight = weights.find(param_names[i]);
+    auto param = graph->parameters()[i]->cast<ParameterPtr>();
+    if (weight == weights.end() || param == nullptr) {
+      valid = false;
+      break;
+    }
+    param->set_name(param_names[i]);
+    param->set_default_param(weight->second->default_param());
+  }
+  if (!valid) {
+    failure_++;
+    miss_++;
+    MS_LOG(WARNING) << "Compile cache " << name << " is invalid, remove it.";
+    RemoveEntry(key);
+    return nullptr;
+  }
+  hit_++;
+  MS_LOG(INFO) << "Compile cache hit: " << name;
+  return graph;
+}
+
+void CompileCache::Store(const std::string &key, const FuncGraphPtr &optimized_graph) {
+  MS_EXCEPTION_IF_NULL(optimized_graph);
+  if (key.empty()) {
+    return;
+  }
+  // the graph is stored in the mindir format, which holds a single graph
+  if (!optimized_graph->func_graphs_used_total().empty()) {
+    MS_LOG(INFO) << "Graph " << optimized_graph->ToString() << " calls other graphs, it is not cached.";
+    return;
+  }
+  std::string graph_buf;
+  try {
+    graph_buf = GetBinaryProtoString(optimized_graph);
+    // make sure the entry can be loaded
+    auto graph = lite::AnfConverter::RunAnfConverter(graph_buf.data(), graph_buf.size());
+    if (graph == nullptr || graph->parameters().size() != optimized_graph->parameters().size()) {
+      graph_buf.clear();
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Graph " << optimized_graph->ToString() << " can not be cached: " << e.what();
+    graph_buf.clear();
+  }
+  if (graph_buf.empty()) {
+    failure_++;
+    return;
+  }
+  std::ostringstream param_buf;
+  for (auto &node : optimized_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    param_buf << ((param != nullptr && param->has_default()) ? param->name() : "") << "\n";
+  }
+  auto name = EntryName(key);
+  // the key is written last, an entry is only loaded once it is complete
+  (void)remove(EntryPath(key, kKeySuffix).c_str());
+  if (!WriteFile(EntryPath(key, kParamSuffix), param_buf.str()) ||
+      !WriteFile(EntryPath(key, kGraphSuffix), graph_buf) || !WriteFile(EntryPath(key, kKeySuffix), key)) {
+    MS_LOG(WARNING) << "Write compile cache " << name << " to " << path_ << " failed.";
+    RemoveEntry(key);
+    failure_++;
+    return;
+  }
+  store_++;
+  MS_LOG(INFO) << "Compile cache stored: " << name;
+}
+
+std::string CompileCache::Report() const {
+  std::ostringstream oss;
+  oss << "Compile cache " << path_ << ": hit " << hit_ << ", miss " << miss_ << ", stored " << store_ << ", failed "
+      << failure_;
+  return oss.str();
+}
+}  // namespace pipeline
+}  // namespace mindspore
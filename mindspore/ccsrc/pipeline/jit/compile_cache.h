@@ -0,0 +1,67 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <string>
+#include <vector>
+#include "ir/func_graph.h"
+#include "pipeline/jit/action.h"
+
+namespace mindspore {
+namespace pipeline {
+// Directory of the compile cache, the cache is disabled if it is not set.
+constexpr char kEnvCompileCachePath[] = "MS_COMPILE_CACHE_PATH";
+
+// An on-disk cache of the optimized graphs of the vm pipeline. A graph is keyed by the text of the graph after
+// symbol_resolve, the abstracts of the arguments, the context flags and env switches affecting compilation and the
+// mindspore library compiling it, so an entry is never used for a different network, input or build. The entries are
+// named by the hash of the key and keep the key, which is compared on a load. On a hit, the actions from
+// symbol_resolve to validate are skipped and the cached graph is used with the current values of the weights.
+class CompileCache {
+ public:
+  static CompileCache &GetInstance();
+  // A cache in the directory path, disabled if path is empty.
+  explicit CompileCache(const std::string &path);
+  ~CompileCache();
+
+  bool enabled() const { return !path_.empty(); }
+  // Adds the actions loading and storing the graph around the optimizing actions, which are skipped on a hit.
+  std::vector<ActionItem> WrapActions(const std::vector<ActionItem> &actions);
+  // Returns an empty key if the graph holds a value whose state is unknown, such a graph is not cached.
+  std::string GetKey(const FuncGraphPtr &resolved_graph, const abstract::AbstractBasePtrList &args_spec) const;
+  // Returns the cached graph bound to the weights of the resolved graph, nullptr on a miss.
+  FuncGraphPtr Load(const std::string &key, const FuncGraphPtr &resolved_graph);
+  void Store(const std::string &key, const FuncGraphPtr &optimized_graph);
+  std::string Report() const;
+
+ private:
+  std::string EntryName(const std::string &key) const;
+  std::string EntryPath(const std::string &key, const std::string &suffix) const;
+  void RemoveEntry(const std::string &key) const;
+
+  std::string path_;
+  size_t hit_{0};
+  size_t miss_{0};
+  size_t store_{0};
+  // graphs which could not be stored or loaded back
+  size_t failure_{0};
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
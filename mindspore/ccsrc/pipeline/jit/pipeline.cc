@@ -26,6 +26,7 @@
 
 #include "ir/param_info.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
@@ -456,7 +457,12 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   ResourcePtr resource = std::make_shared<Resource>(obj);
 
   auto p_actions = GetPipline(resource, phase_s, use_vm);
-  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, FilterActions(p_actions, phase_s));
+  auto actions = FilterActions(p_actions, phase_s);
+  auto &compile_cache = CompileCache::GetInstance();
+  if (compile_cache.enabled()) {
+    actions = compile_cache.WrapActions(actions);
+  }
+  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, actions);
 
   // get the parameters items and add the value to args_spec
   abstract::AbstractBasePtrList args_spec;
@@ -476,6 +482,9 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   executor_info->resource = resource;
   info_[phase_s] = executor_info;
   pip->Run();
+  if (compile_cache.enabled()) {
+    MS_LOG(INFO) << compile_cache.Report();
+  }
 
   // save the run graph func to MsPipeLine
   SaveCompiledGraph(phase_s);
@@ -0,0 +1,167 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiler/device/cpu/cpu_profiling.h"
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include "profiler/device/cpu/data_saver.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+#include "pybind_api/api_register.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+namespace {
+// The op last launched by a thread, it is running between OpDataProducerBegin and OpDataProducerEnd.
+struct RunningOp {
+  OpInfo *op_info = nullptr;
+  // The generation of the op info map op_info points into.
+  uint64_t generation = 0;
+  uint64_t start_timestamp = 0l;
+  bool running = false;
+};
+thread_local RunningOp running_op;
+
+uint64_t GetHostTimeStamp() {
+  auto cur_sys_clock = std::chrono::system_clock::now();
+  uint64_t cur_time_stamp =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(cur_sys_clock.time_since_epoch()).count();
+  return cur_time_stamp;
+}
+
+uint32_t GetThreadID() {
+  thread_local static uint32_t tid = static_cast<uint32_t>(syscall(__NR_gettid));
+  return tid;
+}
+}  // namespace
+
+// Called by the kernel threads at each launch, the instance is created once whichever thread comes first.
+std::shared_ptr<CPUProfiler> CPUProfiler::GetInstance() {
+  static std::shared_ptr<CPUProfiler> profiler_inst(new (std::nothrow) CPUProfiler());
+  return profiler_inst;
+}
+
+void CPUProfiler::Init(const std::string &profileDataPath = "") {
+  MS_LOG(INFO) << "Initialize CPU Profiling";
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  device_id_ = context->get_param<uint32_t>(MS_CTX_DEVICE_ID);
+  profile_data_path_ = profileDataPath;
+  MS_LOG(INFO) << "profile data path: " << profile_data_path_;
+}
+
+void CPUProfiler::StepProfilingEnable(const bool enable_flag) {
+  MS_LOG(INFO) << "CPU Profiler enable flag:" << enable_flag;
+  enable_flag_ = enable_flag;
+}
+
+void CPUProfiler::OpDataProducerBegin(const std::string &op_name) {
+  {
+    std::lock_guard<std::mutex> lock(op_info_mutex_);
+    auto iter = op_info_map_.find(op_name);
+    if (iter == op_info_map_.end()) {
+      iter = op_info_map_.emplace(op_name, OpInfo()).first;
+      iter->second.op_name = op_name;
+    }
+    iter->second.op_count += 1;
+    running_op.op_info = &iter->second;
+    running_op.generation = op_info_generation_;
+  }
+  running_op.running = true;
+  running_op.start_timestamp = GetHostTimeStamp();
+}
+
+void CPUProfiler::OpDataProducerEnd() {
+  uint64_t stop_timestamp = GetHostTimeStamp();
+  if (!running_op.running) {
+    MS_LOG(WARNING) << "No op begins in thread " << GetThreadID() << ", ignore the end of it.";
+    return;
+  }
+  running_op.running = false;
+  float op_time_elapsed = (stop_timestamp - running_op.start_timestamp) / kTimeUnit;
+  {
+    std::lock_guard<std::mutex> lock(op_info_mutex_);
+    if (!RunningOpValid()) {
+      MS_LOG(INFO) << "The profiling data was cleared while an op was running in thread " << GetThreadID()
+                   << ", ignore the end of it.";
+      return;
+    }
+    running_op.op_info->op_host_cost_time += op_time_elapsed;
+    running_op.op_info->start_duration.emplace_back(
+      StartDuration({running_op.start_timestamp, op_time_elapsed, GetThreadID()}));
+  }
+}
+
+// Called with op_info_mutex_ locked.
+bool CPUProfiler::RunningOpValid() const {
+  return running_op.op_info != nullptr && running_op.generation == op_info_generation_;
+}
+
+bool CPUProfiler::NeedOpInputInfo() const {
+  std::lock_guard<std::mutex> lock(op_info_mutex_);
+  return RunningOpValid() && !running_op.op_info->input_info_set;
+}
+
+void CPUProfiler::SetOpInputInfo(const std::string &input_shape, size_t touched_bytes) {
+  std::lock_guard<std::mutex> lock(op_info_mutex_);
+  if (!RunningOpValid()) {
+    return;
+  }
+  running_op.op_info->input_shape = input_shape;
+  running_op.op_info->touched_bytes = touched_bytes;
+  running_op.op_info->input_info_set = true;
+}
+
+void CPUProfiler::Stop() {
+  MS_LOG(INFO) << "Stop CPU Profiling";
+  enable_flag_ = false;
+  SaveProfileData();
+  ClearInst();
+}
+
+void CPUProfiler::SaveProfileData() {
+  if (profile_data_path_.empty()) {
+    MS_LOG(WARNING) << "Profile data path is empty, skip save profile data.";
+  } else {
+    std::lock_guard<std::mutex> lock(op_info_mutex_);
+    DataSaver dataSaver;
+    dataSaver.ParseOpInfo(op_info_map_);
+    dataSaver.WriteFile(profile_data_path_, device_id_);
+  }
+}
+
+void CPUProfiler::ClearInst() {
+  std::lock_guard<std::mutex> lock(op_info_mutex_);
+  op_info_map_.clear();
+  // The launches running in other threads still point into the map, they are dropped at their end.
+  op_info_generation_++;
+  running_op = RunningOp();
+  enable_flag_ = false;
+}
+
+REGISTER_PYBIND_DEFINE(CPUProfiler_, ([](const py::module *m) {
+                         (void)py::class_<CPUProfiler, std::shared_ptr<CPUProfiler>>(*m, "CPUProfiler")
+                           .def_static("get_instance", &CPUProfiler::GetInstance, "CPUProfiler get_instance.")
+                           .def("init", &CPUProfiler::Init, py::arg("profile_data_path"), "init")
+                           .def("stop", &CPUProfiler::Stop, "stop")
+                           .def("step_profiling_enable", &CPUProfiler::StepProfilingEnable, py::arg("enable_flag"),
+                                "enable or disable step profiling");
+                       }));
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CPU_PROFILING_H
+#define MINDSPORE_CPU_PROFILING_H
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <memory>
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+struct StartDuration {
+  uint64_t start_timestamp = 0l;
+  float duration = 0l;
+  uint32_t thread_id = 0;
+};
+
+struct OpInfo {
+  std::string op_name;
+  // The input shapes and the bytes of inputs and outputs of one launch, they do not change between launches.
+  std::string input_shape;
+  size_t touched_bytes = 0;
+  bool input_info_set = false;
+  float op_host_cost_time = 0;
+  int op_count = 0;
+  std::vector<StartDuration> start_duration;
+};
+
+const float kTimeUnit = 1000;
+
+class CPUProfiler {
+ public:
+  static std::shared_ptr<CPUProfiler> GetInstance();
+  ~CPUProfiler() = default;
+  CPUProfiler(const CPUProfiler &) = delete;
+  CPUProfiler &operator=(const CPUProfiler &) = delete;
+
+  void Init(const std::string &profileDataPath);
+  void Stop();
+  void StepProfilingEnable(const bool enable_flag);
+  bool GetEnableFlag() const { return enable_flag_; }
+  // Begin and end the launch of an op in the calling thread, launches of different threads may interleave.
+  void OpDataProducerBegin(const std::string &op_name);
+  void OpDataProducerEnd();
+  // Whether the op last launched by the calling thread still misses its input shapes and touched bytes, they are set
+  // after OpDataProducerEnd to keep them out of the op time.
+  bool NeedOpInputInfo() const;
+  void SetOpInputInfo(const std::string &input_shape, size_t touched_bytes);
+
+ private:
+  CPUProfiler() = default;
+  void ClearInst();
+  void SaveProfileData();
+
+  // Whether the launch running in the calling thread began after the last ClearInst, its OpInfo is still in the map.
+  bool RunningOpValid() const;
+
+  std::atomic<bool> enable_flag_{false};
+  // The OpInfo are never moved by the rehash of the map, the running launches keep pointers to them.
+  std::unordered_map<std::string, OpInfo> op_info_map_;
+  // Counts the clears of op_info_map_, the pointers of the launches begun before a clear are dangling.
+  uint64_t op_info_generation_ = 0;
+  mutable std::mutex op_info_mutex_;
+  uint32_t device_id_ = 0;
+  std::string profile_data_path_;
+};
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CPU_PROFILING_H
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profiler/device/cpu/data_saver.h"
+#include <fstream>
+#include <map>
+#include <vector>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+
+namespace {
+const char kOpDetailHeader[] =
+  "op_side,op_type,op_name,op_full_name,op_occurrences,op_total_time(us),op_avg_time(us),total_proportion,"
+  "input_shape,touched_bytes";
+}  // namespace
+
+void DataSaver::WriteFile(std::string out_path_dir, uint32_t device_id) {
+  if (out_path_dir.empty()) {
+    MS_LOG(WARNING) << "Output directory. Ignore the writing data.";
+    return;
+  }
+  if (op_detail_infos_.empty() || op_type_infos_.empty()) {
+    MS_LOG(WARNING) << "No operation detail infos to write.";
+    return;
+  }
+  device_id_ = std::to_string(device_id);
+  WriteOpDetail(out_path_dir + "/cpu_op_detail_info_" + device_id_ + ".csv", kOpDetailHeader);
+  WriteOpType(out_path_dir + "/cpu_op_type_info_" + device_id_ + ".csv");
+  WriteOpTimestamp(out_path_dir);
+}
+
+void DataSaver::WriteOpTimestamp(const std::string &saver_base_dir) {
+  std::string file_path = saver_base_dir + "/cpu_op_execute_timestamp_" + device_id_ + ".txt";
+  std::ofstream ofs(file_path);
+  // check if the file is writable
+  if (!ofs.is_open()) {
+    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+    return;
+  }
+  // write op timestamp info into file, one line for the launches of an op in a thread, the thread id takes the place
+  // of the stream id of gpu ops in the timeline.
+  for (const auto &op_detail : op_detail_infos_) {
+    std::map<uint32_t, std::vector<StartDuration>> thread_timestamps;
+    for (const auto &start_duration : op_detail.op_info_->start_duration) {
+      thread_timestamps[start_duration.thread_id].emplace_back(start_duration);
+    }
+    for (const auto &thread_timestamp : thread_timestamps) {
+      ofs << op_detail.op_full_name_ << ";" << thread_timestamp.first << ";";
+      for (auto start_end : thread_timestamp.second) {
+        ofs << start_end.start_timestamp << "," << start_end.duration << " ";
+      }
+      ofs << std::endl;
+    }
+  }
+  ofs.close();
+  MS_LOG(INFO) << "Write " << op_detail_infos_.size() << " op timestamp infos into file: " << file_path;
+}
+
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
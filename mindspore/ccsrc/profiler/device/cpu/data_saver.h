@@ -0,0 +1,54 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CPU_DATA_SAVER_H
+#define MINDSPORE_CPU_DATA_SAVER_H
+#include <iostream>
+#include <string>
+#include "profiler/device/cpu/cpu_profiling.h"
+#include "profiler/device/data_saver.h"
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+using OpDetailInfo = profiler::OpDetailInfo<OpInfo>;
+
+inline std::ostream &operator<<(std::ostream &os, const OpDetailInfo &event) {
+  os << "Host," << event.op_type_ << ',' << event.op_name_ << ',' << event.op_full_name_ << ','
+     << event.op_info_->op_count << ',' << event.op_info_->op_host_cost_time << ',' << event.op_avg_time_ << ','
+     << event.proportion_ << ",\"" << event.op_info_->input_shape << "\"," << event.op_info_->touched_bytes;
+  return os;
+}
+
+class DataSaver : public BaseDataSaver<OpInfo> {
+ public:
+  DataSaver() = default;
+
+  ~DataSaver() override = default;
+
+  DataSaver(const DataSaver &) = delete;
+
+  DataSaver &operator=(const DataSaver &) = delete;
+
+  void WriteFile(std::string out_path, uint32_t device_id);
+
+ private:
+  void WriteOpTimestamp(const std::string &saver_base_dir);
+};
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CPU_DATA_SAVER_H
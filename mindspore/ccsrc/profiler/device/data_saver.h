@@ -0,0 +1,174 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_PROFILER_DATA_SAVER_H
+#define MINDSPORE_PROFILER_DATA_SAVER_H
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/log_adapter.h"
+namespace mindspore {
+namespace profiler {
+// The statistics of an op, OpInfo is the op info collected by the profiler of a device. The device prints it in its
+// op detail file.
+template <typename OpInfo>
+struct OpDetailInfo {
+  std::string op_type_;
+  std::string op_name_;
+  std::string op_full_name_;
+  std::shared_ptr<OpInfo> op_info_{nullptr};
+  float op_avg_time_{0};
+  float proportion_{0};
+
+  OpDetailInfo() = default;
+
+  OpDetailInfo(std::shared_ptr<OpInfo> op_info, float proportion) : op_info_(op_info), proportion_(proportion) {
+    // op_full_name is like 'xxx/xxx/{op_type}-op{node_id}'
+    op_full_name_ = op_info->op_name;
+    auto op_type_begin_iter = op_full_name_.rfind('/') + 1;
+    auto op_type_end_iter = op_full_name_.rfind('-');
+    op_type_ = op_full_name_.substr(op_type_begin_iter, op_type_end_iter - op_type_begin_iter);
+    op_name_ = op_full_name_.substr(op_type_begin_iter);
+    op_avg_time_ = op_info->op_host_cost_time / op_info->op_count;
+  }
+};
+
+struct OpType {
+  std::string op_type_;
+  int count_{0};
+  float total_time_{0};
+  float avg_time_{0};
+  float proportion_{0};
+
+  std::string GetHeader() const { return "op_type,type_occurrences,total_time(us),total_proportion,avg_time(us)"; }
+
+  friend std::ostream &operator<<(std::ostream &os, const OpType &event) {
+    os << event.op_type_ << ',' << event.count_ << ',' << event.total_time_ << ',' << event.proportion_ << ','
+       << event.avg_time_;
+    return os;
+  }
+
+  OpType &operator+=(const OpType &other) {
+    this->count_ += other.count_;
+    this->total_time_ += other.total_time_;
+    this->proportion_ += other.proportion_;
+    return *this;
+  }
+};
+
+// Parses the op infos of a device profiler into the op details and the op type statistics, and writes them.
+template <typename OpInfo>
+class BaseDataSaver {
+ public:
+  using OpInfoMap = std::unordered_map<std::string, OpInfo>;
+  using OpTypeInfos = std::unordered_map<std::string, OpType>;  // <op_full_name, Optype>
+  using OpDetailInfos = std::vector<OpDetailInfo<OpInfo>>;
+
+  BaseDataSaver() = default;
+
+  virtual ~BaseDataSaver() = default;
+
+  BaseDataSaver(const BaseDataSaver &) = delete;
+
+  BaseDataSaver &operator=(const BaseDataSaver &) = delete;
+
+  void ParseOpInfo(const OpInfoMap &op_info_maps) {
+    op_detail_infos_.reserve(op_info_maps.size());
+    float total_time_sum = GetTotalOpTime(op_info_maps);
+    for (auto &item : op_info_maps) {
+      float proportion = item.second.op_host_cost_time / total_time_sum;
+      auto op_info = std::make_shared<OpInfo>(item.second);
+      OpDetailInfo<OpInfo> op_detail_info = OpDetailInfo<OpInfo>(op_info, proportion);
+      op_detail_infos_.emplace_back(op_detail_info);
+      AddOpDetailInfoForType(op_detail_info);
+    }
+    // update average time of op type
+    for (auto &op_type : op_type_infos_) {
+      // device_infos: <type_name, op_type_info>
+      op_type.second.avg_time_ = op_type.second.total_time_ / op_type.second.count_;
+    }
+    MS_LOG(DEBUG) << "Get " << op_detail_infos_.size() << " operation items.";
+    MS_LOG(DEBUG) << "Get " << op_type_infos_.size() << " operation type items.";
+  }
+
+ protected:
+  void WriteOpType(const std::string &file_path) {
+    std::ofstream ofs(file_path);
+    // check if the file is writable
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+      return;
+    }
+    // write op type info into file
+    ofs << OpType().GetHeader() << std::endl;
+    for (auto op_type_info : op_type_infos_) {
+      ofs << op_type_info.second << std::endl;
+    }
+    ofs.close();
+    MS_LOG(INFO) << "Write " << op_type_infos_.size() << " op type infos into file: " << file_path;
+  }
+
+  // The op details are written by the operator<< of the device.
+  void WriteOpDetail(const std::string &file_path, const std::string &header) {
+    std::ofstream ofs(file_path);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
+      return;
+    }
+    // write op detail info into file
+    ofs << header << std::endl;
+    for (auto op_detail : op_detail_infos_) {
+      ofs << op_detail << std::endl;
+    }
+    ofs.close();
+    MS_LOG(INFO) << "Write " << op_detail_infos_.size() << " op detail infos into file: " << file_path;
+  }
+
+  std::string device_id_;
+  OpTypeInfos op_type_infos_;
+  OpDetailInfos op_detail_infos_;
+
+ private:
+  void AddOpDetailInfoForType(const OpDetailInfo<OpInfo> &op_detail_info) {
+    // Construct OpType object according to op detail info
+    OpType op_type = OpType{op_detail_info.op_type_, op_detail_info.op_info_->op_count,
+                            op_detail_info.op_info_->op_host_cost_time, 0, op_detail_info.proportion_};
+    // Set the OpType into op_type_infos_ map
+    std::string type_name = op_detail_info.op_type_;
+    auto iter = op_type_infos_.find(type_name);
+    if (iter == op_type_infos_.end()) {
+      op_type_infos_.emplace(type_name, op_type);
+    } else {
+      iter->second += op_type;
+    }
+  }
+
+  float GetTotalOpTime(const OpInfoMap &op_info_maps) {
+    float sum = 0;
+    sum = std::accumulate(op_info_maps.begin(), op_info_maps.end(), sum,
+                          [](float i, const auto &iter) { return i + iter.second.op_host_cost_time; });
+    MS_LOG(DEBUG) << "The total op time is " << sum;
+    return sum;
+  }
+};
+}  // namespace profiler
+}  // namespace mindspore
+
+#endif  // MINDSPORE_PROFILER_DATA_SAVER_H
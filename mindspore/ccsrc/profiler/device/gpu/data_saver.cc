@@ -16,23 +16,17 @@
 
 #include "profiler/device/gpu/data_saver.h"
 #include <fstream>
-#include <numeric>
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace profiler {
 namespace gpu {
 
-OpDetailInfo::OpDetailInfo(std::shared_ptr<OpInfo> op_info, float proportion)
-    : op_info_(op_info), proportion_(proportion) {
-  // op_full_name is like 'xxx/xxx/{op_type}-op{node_id}'
-  op_full_name_ = op_info->op_name;
-  auto op_type_begin_iter = op_full_name_.rfind('/') + 1;
-  auto op_type_end_iter = op_full_name_.rfind('-');
-  op_type_ = op_full_name_.substr(op_type_begin_iter, op_type_end_iter - op_type_begin_iter);
-  op_name_ = op_full_name_.substr(op_type_begin_iter);
-  op_avg_time_ = op_info->op_host_cost_time / op_info->op_count;
-}
+namespace {
+const char kOpDetailHeader[] =
+  "op_side,op_type,op_name,op_full_name,op_occurrences,op_total_time(us),op_avg_time(us),total_proportion,"
+  "cuda_activity_cost_time(us),cuda_activity_call_count";
+}  // namespace
 
 ActivityData::ActivityData(std::shared_ptr<Event> data) : basic_info_(data) {
   grid_dim_ = basic_info_->activity_type == ActivityType::kKernel
@@ -65,48 +59,6 @@ ActivityData &ActivityData::operator+=(const ActivityData &other) {
   return *this;
 }
 
-void DataSaver::ParseOpInfo(const OpInfoMap &op_info_maps) {
-  op_detail_infos_.reserve(op_info_maps.size());
-  float total_time_sum = GetTotalOpTime(op_info_maps);
-  for (auto item : op_info_maps) {
-    op_timestamps_map_[item.first] = item.second.start_duration;
-    float proportion = item.second.op_host_cost_time / total_time_sum;
-    auto op_info = std::make_shared<OpInfo>(item.second);
-    OpDetailInfo op_detail_info = OpDetailInfo(op_info, proportion);
-    op_detail_infos_.emplace_back(op_detail_info);
-    AddOpDetailInfoForType(op_detail_info);
-  }
-  // update average time of op type
-  for (auto &op_type : op_type_infos_) {
-    // device_infos: <type_name, op_type_info>
-    op_type.second.avg_time_ = op_type.second.total_time_ / op_type.second.count_;
-  }
-  MS_LOG(DEBUG) << "Get " << op_detail_infos_.size() << " operation items.";
-  MS_LOG(DEBUG) << "Get " << op_type_infos_.size() << " operation type items.";
-}
-
-void DataSaver::AddOpDetailInfoForType(const OpDetailInfo &op_detail_info) {
-  // Construct OpType object according to op detail info
-  OpType op_type = OpType{op_detail_info.op_type_, op_detail_info.op_info_->op_count,
-                          op_detail_info.op_info_->op_host_cost_time, 0, op_detail_info.proportion_};
-  // Set the OpType into op_type_infos_ map
-  std::string type_name = op_detail_info.op_type_;
-  auto iter = op_type_infos_.find(type_name);
-  if (iter == op_type_infos_.end()) {
-    op_type_infos_.emplace(type_name, op_type);
-  } else {
-    iter->second += op_type;
-  }
-}
-
-float DataSaver::GetTotalOpTime(const OpInfoMap &op_info_maps) {
-  float sum = 0;
-  sum = std::accumulate(op_info_maps.begin(), op_info_maps.end(), sum,
-                        [](float i, auto iter) { return i + iter.second.op_host_cost_time; });
-  MS_LOG(DEBUG) << "The total op time is " << sum;
-  return sum;
-}
-
 void DataSaver::ParseEvent(const std::vector<Event> &events) {
   // Put Kernel activity events into activity_infos_
   for (const auto &event : events) {
@@ -164,45 +116,12 @@ void DataSaver::WriteFile(std::string out_path_dir) {
   }
   // not support multi-device for operator info per process yet
   device_id_ = std::to_string(activity_infos_.begin()->first);
-  WriteOpDetail(out_path_dir);
-  WriteOpType(out_path_dir);
+  WriteOpDetail(out_path_dir + "/gpu_op_detail_info_" + device_id_ + ".csv", kOpDetailHeader);
+  WriteOpType(out_path_dir + "/gpu_op_type_info_" + device_id_ + ".csv");
   WriteActivity(out_path_dir);
   WriteOpTimestamp(out_path_dir);
 }
 
-void DataSaver::WriteOpType(const std::string &saver_base_dir) {
-  std::string file_path = saver_base_dir + "/gpu_op_type_info_" + device_id_ + ".csv";
-  std::ofstream ofs(file_path);
-  // check if the file is writable
-  if (!ofs.is_open()) {
-    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
-    return;
-  }
-  // write op type info into file
-  ofs << OpType().GetHeader() << std::endl;
-  for (auto op_type_info : op_type_infos_) {
-    ofs << op_type_info.second << std::endl;
-  }
-  ofs.close();
-  MS_LOG(INFO) << "Write " << op_type_infos_.size() << " op type infos into file: " << file_path;
-}
-
-void DataSaver::WriteOpDetail(const std::string &saver_base_dir) {
-  std::string file_path = saver_base_dir + "/gpu_op_detail_info_" + device_id_ + ".csv";
-  std::ofstream ofs(file_path);
-  if (!ofs.is_open()) {
-    MS_LOG(WARNING) << "Open file '" << file_path << "' failed!";
-    return;
-  }
-  // write op detail info into file
-  ofs << OpDetailInfo().GetHeader() << std::endl;
-  for (auto op_detail : op_detail_infos_) {
-    ofs << op_detail << std::endl;
-  }
-  ofs.close();
-  MS_LOG(INFO) << "Write " << op_detail_infos_.size() << " op detail infos into file: " << file_path;
-}
-
 void DataSaver::WriteActivity(const std::string &saver_base_dir) {
   std::string file_path_base = saver_base_dir + "/gpu_activity_data_";
   std::string timestamp_file_path_base = saver_base_dir + "/activity_execute_timestamp_";
@@ -247,9 +166,9 @@ void DataSaver::WriteOpTimestamp(const std::string &saver_base_dir) {
     return;
   }
   // write op timestamp info into file
-  for (const auto &op_timestamp_info : op_timestamps_map_) {
-    ofs << op_timestamp_info.first << ";Ops;";
-    for (auto start_end : op_timestamp_info.second) {
+  for (const auto &op_detail : op_detail_infos_) {
+    ofs << op_detail.op_full_name_ << ";Ops;";
+    for (auto start_end : op_detail.op_info_->start_duration) {
       ofs << start_end.start_timestamp << "," << start_end.duration << " ";
     }
     ofs << std::endl;
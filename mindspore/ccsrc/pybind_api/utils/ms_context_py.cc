@@ -78,6 +78,7 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("check_bprop", MsCtxParam::MS_CTX_CHECK_BPROP_FLAG)
                            .value("enable_dump", MsCtxParam::MS_CTX_ENABLE_DUMP)
                            .value("enable_graph_kernel", MsCtxParam::MS_CTX_ENABLE_GRAPH_KERNEL)
+                           .value("enable_mem_reuse", MsCtxParam::MS_CTX_ENABLE_MEM_REUSE)
                            .value("enable_reduce_precision", MsCtxParam::MS_CTX_ENABLE_REDUCE_PRECISION)
                            .value("enable_sparse", MsCtxParam::MS_CTX_ENABLE_SPARSE)
                            .value("precompile_only", MsCtxParam::MS_CTX_PRECOMPILE_ONLY)
@@ -28,6 +28,7 @@
 #include "frontend/operator/ops.h"
 #include "utils/shape_utils.h"
 #include "utils/profile.h"
+#include "profiler/device/cpu/cpu_profiling.h"
 
 namespace mindspore {
 namespace device {
@@ -265,6 +266,47 @@ void CPUKernelRuntime::BindInputOutput(session::KernelGraph *kernel_graph, const
   }
 }
 
+// A cached single op graph is bound to new tensors at every run: the outputs not computed in the memory of their
+// tensors are synced, and the memory malloced for the run is freed.
+void CPUKernelRuntime::ReleaseRunOpMemory(const session::KernelGraph *kernel_graph, const VectorRef &outputs) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  for (auto &item : kernel_graph->inputs()) {
+    MS_EXCEPTION_IF_NULL(item);
+    if (!item->isa<Parameter>()) {
+      continue;
+    }
+    auto address = AnfAlgo::GetMutableOutputAddr(item, 0);
+    MS_EXCEPTION_IF_NULL(address);
+    resource_manager_.MemFree(address->ptr_);
+    address->ptr_ = nullptr;
+  }
+  ReleaseOutputMemory(outputs);
+  input_param_tensor_map_.clear();
+  bound_addresses_.clear();
+}
+
+void CPUKernelRuntime::ReleaseOutputMemory(const VectorRef &outputs) {
+  for (auto &item : outputs) {
+    if (utils::isa<VectorRefPtr>(item)) {
+      ReleaseOutputMemory(utils::cast<VectorRef>(item));
+    } else if (utils::isa<tensor::TensorPtr>(item)) {
+      auto tensor = utils::cast<tensor::TensorPtr>(item);
+      MS_EXCEPTION_IF_NULL(tensor);
+      if (!tensor->NeedSyncDeviceToHostImmediately()) {
+        continue;
+      }
+      auto address = std::dynamic_pointer_cast<DeviceAddress>(tensor->device_address());
+      tensor->data_sync();
+      tensor->set_device_address(nullptr);
+      tensor->set_sync_status(kNoNeedSync);
+      if (address != nullptr) {
+        resource_manager_.MemFree(address->ptr_);
+        address->ptr_ = nullptr;
+      }
+    }
+  }
+}
+
 void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list) {
   MS_EXCEPTION_IF_NULL(address);
   MS_EXCEPTION_IF_NULL(input_list);
@@ -287,9 +329,37 @@ void CPUKernelRuntime::DecreaseSummaryRefCount(const session::NamedSummaryOutput
   resource_manager_.DecreaseSummaryRefCount(summary_outputs);
 }
 
+namespace {
+// Records the input shapes like '1,3,224,224;64' and the bytes of inputs and outputs of one launch of the kernel.
+void SetProfilerOpInputInfo(const CNodePtr &node, const std::vector<kernel::AddressPtr> &kernel_inputs,
+                            const std::vector<kernel::AddressPtr> &kernel_outputs) {
+  std::string input_shape;
+  size_t input_num = AnfAlgo::GetInputTensorNum(node);
+  for (size_t i = 0; i < input_num; ++i) {
+    if (i != 0) {
+      input_shape += ";";
+    }
+    auto shape = AnfAlgo::GetPrevNodeOutputInferShape(node, i);
+    for (size_t j = 0; j < shape.size(); ++j) {
+      input_shape += (j == 0 ? "" : ",") + std::to_string(shape[j]);
+    }
+  }
+  size_t touched_bytes = 0;
+  for (const auto &address : kernel_inputs) {
+    touched_bytes += address->size;
+  }
+  for (const auto &address : kernel_outputs) {
+    touched_bytes += address->size;
+  }
+  profiler::cpu::CPUProfiler::GetInstance()->SetOpInputInfo(input_shape, touched_bytes);
+}
+}  // namespace
+
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink, Debugger *debugger) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.IncreaseAddressRefCount(kernel_graph);
+  auto profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
+  MS_EXCEPTION_IF_NULL(profiler_inst);
 
   auto kernels = kernel_graph->execution_order();
   for (const auto &kernel : kernels) {
@@ -318,7 +388,17 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph, bool is_task_sink
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_workspaces);
     }
+    bool profiling = profiler_inst->GetEnableFlag();
+    if (profiling) {
+      profiler_inst->OpDataProducerBegin(kernel->fullname_with_scope());
+    }
     auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+    if (profiling) {
+      profiler_inst->OpDataProducerEnd();
+      if (profiler_inst->NeedOpInputInfo()) {
+        SetProfilerOpInputInfo(kernel, kernel_inputs, kernel_outputs);
+      }
+    }
     resource_manager_.DecreaseAddressRefCount(kernel);
     if (!ret) {
       MS_LOG(EXCEPTION) << "Launch kernel failed.";
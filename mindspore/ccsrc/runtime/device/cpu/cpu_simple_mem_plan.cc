@@ -14,12 +14,52 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <memory>
 #include "backend/session/anf_runtime_algorithm.h"
+#include "backend/optimizer/mem_reuse/mem_reuse_allocator.h"
+#include "utils/ms_context.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  GraphMemPlan plan;
+  plan.naive_size = NaiveMemPlan(graph);
+  plan.planned_size = plan.naive_size;
+  mem_reuse_util_ = nullptr;
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (context_ptr->get_param<bool>(MS_CTX_ENABLE_MEM_REUSE) && !graph->execution_order().empty()) {
+    auto mem_reuse_util_ptr = std::make_shared<memreuse::MemReuseUtil>();
+    mem_reuse_util_ptr->SetAllInfo(graph);
+    // Graph outputs are read after the last kernel, so they keep their memory to the end.
+    mem_reuse_util_ptr->SetGraphOutputRefCount();
+    auto bestfit_mem_reuse = std::make_shared<memreuse::BestFitMemReuse>();
+    bestfit_mem_reuse->Reuse(mem_reuse_util_ptr.get());
+    size_t reuse_size = bestfit_mem_reuse->GetAllocatedSize();
+    // Every reused tensor is 512 aligned, which may cost more than it saves for graphs of small tensors.
+    if (reuse_size < plan.naive_size) {
+      mem_reuse_util_ = mem_reuse_util_ptr;
+      plan.planned_size = reuse_size;
+      plan.reused = true;
+    }
+  }
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " memory plan: naive size " << plan.naive_size
+               << ", planned size " << plan.planned_size << (plan.reused ? ", tensors reuse memory." : ".");
+  graph_mem_plans_[graph->graph_id()] = plan;
+  return plan.planned_size;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  if (mem_reuse_util_ != nullptr) {
+    ReuseMemAssign(graph, base_ptr);
+  } else {
+    NaiveMemAssign(graph, base_ptr);
+  }
+}
+
+size_t CPUSimpleMemPlan::NaiveMemPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
   size_t total_mem_size = 32;
   auto kernels = graph->execution_order();
@@ -62,7 +102,7 @@ size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
   return total_mem_size;
 }
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+void CPUSimpleMemPlan::NaiveMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(base_ptr);
   uint8_t *mem_ptr = base_ptr;
@@ -106,6 +146,36 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
     }
   }
 }
+
+void CPUSimpleMemPlan::ReuseMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  MS_EXCEPTION_IF_NULL(mem_reuse_util_);
+  mem_reuse_util_->set_mem_base(base_ptr);
+  auto kernels = graph->execution_order();
+  for (const auto &kernel : kernels) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ == nullptr) {
+        address->ptr_ = mem_reuse_util_->GetNodeOutputPtr(kernel, i);
+      }
+    }
+
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+      MS_EXCEPTION_IF_NULL(address);
+      if (address->ptr_ == nullptr) {
+        address->ptr_ = mem_reuse_util_->GetNodeWorkSpacePtr(kernel, i);
+      }
+    }
+  }
+  mem_reuse_util_ = nullptr;
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
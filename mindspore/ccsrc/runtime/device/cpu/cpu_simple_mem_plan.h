@@ -16,13 +16,22 @@
 #ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
+#include <map>
 #include <vector>
 #include "backend/session/kernel_graph.h"
+#include "backend/optimizer/mem_reuse/mem_reuse.h"
 #include "runtime/device/device_address.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// Memory size of a graph laid out end to end and with the reused offsets planned by BestFitMemReuse
+struct GraphMemPlan {
+  size_t naive_size{0};
+  size_t planned_size{0};
+  bool reused{false};
+};
+
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
@@ -30,6 +39,16 @@ class CPUSimpleMemPlan {
 
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  const std::map<uint32_t, GraphMemPlan> &graph_mem_plans() const { return graph_mem_plans_; }
+
+ private:
+  size_t NaiveMemPlan(const session::KernelGraph *graph);
+  void NaiveMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  void ReuseMemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+
+  // reuse info of the last planned graph, null if its tensors are laid out end to end
+  memreuse::MemReuseUtilPtr mem_reuse_util_{nullptr};
+  std::map<uint32_t, GraphMemPlan> graph_mem_plans_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -226,6 +226,9 @@ constexpr auto kAttrIsAICPUKernel = "is_AICPU_kernel";
 constexpr auto kIsBackendCast = "is_backed_cast";
 constexpr auto kAttrOutputNames = "output_names";
 constexpr auto kAttrVisited = "visited";
+constexpr auto kAttrMkldnnBlockedInput = "mkldnn_blocked_input";
+constexpr auto kAttrMkldnnBlockedOutput = "mkldnn_blocked_output";
+constexpr auto kAttrMkldnnReadOnlyWeight = "mkldnn_read_only_weight";
 constexpr auto kAttrShape = "shape";
 constexpr auto kAttrMomentum = "momentum";
 constexpr auto kAttrEps = "eps";
@@ -437,6 +437,7 @@ def _check_target_specific_cfgs(device, arg_key):
         'enable_auto_mixed_precision': ['Ascend'],
         'enable_dump': ['Ascend'],
         'enable_profiling': ['Ascend'],
+        'enable_mem_reuse': ['Ascend', 'CPU'],
         'variable_memory_max_size': ['Ascend'],
         'max_device_memory': ['GPU']
     }
@@ -456,7 +457,7 @@ def _check_target_specific_cfgs(device, arg_key):
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
-                 enable_sparse=bool, max_call_depth=int)
+                 enable_sparse=bool, max_call_depth=int, enable_mem_reuse=bool)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -485,6 +486,7 @@ def set_context(**kwargs):
     device_id                    enable_dump
     device_target                enable_profiling
     enable_graph_kernel          variable_memory_max_size
+    enable_mem_reuse
     enable_reduce_precision
     enable_sparse
     mode
@@ -536,6 +538,8 @@ def set_context(**kwargs):
             suffix to the file.
         enable_sparse (bool): Whether to enable sparsity feature. Default: False.
         max_call_depth(int): Specify the function call depth limit. Default: 1000.
+        enable_mem_reuse (bool): Whether to let the intermediate tensors of a graph share memory when their
+            lifetimes do not overlap, currently only supported on Ascend and CPU. Default: True.
 
     Raises:
         ValueError: If input key is not an attribute in context.
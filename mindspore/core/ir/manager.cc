@@ -306,6 +306,7 @@ void FuncGraphManager::MaybeDropFuncGraphs(const FuncGraphSet &func_graphs, bool
     MS_EXCEPTION_IF_NULL(fg);
     all_nodes_.difference_update(fg->parameters());
     (void)func_graphs_.erase(fg);
+    DropFuncGraphAnalysis(fg);
     if (fg->manager().get() == this) {
       fg->set_manager(nullptr);
     }
@@ -483,16 +484,18 @@ void FuncGraphManager::AddEdge(AnfNodePtr node, int index, AnfNodePtr input) {
     if (IsValueNode<FuncGraph>(input)) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
-      if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
-      }
+      bool changed = fg->AddFuncGraphUsed(used);
       if (IsPrimitiveCNode(node, prim::kPrimJ)) {
         fg->AddJFuncGraph(used);
+        changed = true;
+      }
+      if (changed) {
+        InvalidateFuncGraph(fg);
       }
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateFuncGraph(fg);
     }
   }
 }
@@ -504,16 +507,18 @@ void FuncGraphManager::DropEdge(AnfNodePtr node, int index, AnfNodePtr input) {
     if (IsValueNode<FuncGraph>(input)) {
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
-      if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
-      }
+      bool changed = fg->DropFuncGraphUsed(used);
       if (IsPrimitiveCNode(node, prim::kPrimJ)) {
         fg->DropJFuncGraph(used);
+        changed = true;
+      }
+      if (changed) {
+        InvalidateFuncGraph(fg);
       }
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      InvalidateFuncGraph(fg);
     }
   }
 }
@@ -529,6 +534,85 @@ void FuncGraphManager::MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target) {
   source->ClearAllManagerInfo();
 }
 
+namespace {
+// fg and all the func graphs using it directly or indirectly, i.e. the func graphs whose analyses may change when the
+// func graphs used or the free variables of fg change.
+FuncGraphSet FuncGraphUsersTotal(const FuncGraphPtr &fg) {
+  FuncGraphSet users;
+  users.add(fg);
+  std::vector<FuncGraphPtr> todo = {fg};
+  while (!todo.empty()) {
+    auto gt = todo.back();
+    todo.pop_back();
+    for (auto &item : gt->func_graph_cnodes_index()) {
+      auto user = item.first->first->func_graph();
+      if (user != nullptr && !users.contains(user)) {
+        users.add(user);
+        todo.push_back(user);
+      }
+    }
+  }
+  return users;
+}
+
+bool Intersect(const FuncGraphSet &lhs, const FuncGraphSet &rhs) {
+  return std::any_of(lhs.begin(), lhs.end(), [&rhs](const FuncGraphPtr &fg) { return rhs.contains(fg); });
+}
+}  // namespace
+
+// Drop only the analyses which depend on the func graphs used or the free variables of fg, so that a pass doing many
+// replacements does not recompute the analyses of the whole manager after each of them.
+void FuncGraphManager::InvalidateFuncGraph(const FuncGraphPtr &fg) {
+  MS_EXCEPTION_IF_NULL(fg);
+  auto users = FuncGraphUsersTotal(fg);
+  // The parents total of the other func graphs are unchanged, the parent of a func graph with several parents is
+  // chosen by the parents total of them.
+  FuncGraphSet parent_changed;
+  auto &parents_total = func_graph_parents_total_->func_graph_parents_total_analysis();
+  for (auto &item : func_graph_parent_->func_graphs_validate_) {
+    auto iter = parents_total.find(item.first);
+    if (users.contains(item.first) || iter == parents_total.end() ||
+        (iter->second.size() > 1 && Intersect(iter->second, users))) {
+      parent_changed.add(item.first);
+    }
+  }
+  // The children of a func graph are the func graphs used total whose parent is it.
+  FuncGraphSet children_changed;
+  auto &used_total = func_graphs_used_total_->func_graph_used_total_analysis();
+  for (auto &item : children_->func_graphs_validate_) {
+    auto iter = used_total.find(item.first);
+    if (users.contains(item.first) || iter == used_total.end() || Intersect(iter->second, parent_changed)) {
+      children_changed.add(item.first);
+    }
+  }
+  for (auto &user : users) {
+    func_graph_parents_total_->Invalidate(user);
+    func_graphs_used_total_->Invalidate(user);
+    recursive_->Invalidate(user);
+    j_total_->Invalidate(user);
+  }
+  for (auto &child : parent_changed) {
+    func_graph_parent_->Invalidate(child);
+  }
+  for (auto &parent : children_changed) {
+    children_->Invalidate(parent);
+    scopes_->Invalidate(parent);
+  }
+  // The free variables total are computed for all the func graphs at once.
+  free_variables_total_->Reset();
+}
+
+// Release the analyses of a func graph dropped from the manager.
+void FuncGraphManager::DropFuncGraphAnalysis(const FuncGraphPtr &fg) {
+  func_graph_parents_total_->Invalidate(fg);
+  func_graph_parent_->Invalidate(fg);
+  children_->Invalidate(fg);
+  scopes_->Invalidate(fg);
+  func_graphs_used_total_->Invalidate(fg);
+  recursive_->Invalidate(fg);
+  j_total_->Invalidate(fg);
+}
+
 FuncGraphTransaction FuncGraphManager::Transact() {
   auto tr = FuncGraphTransaction(this);
   return tr;
@@ -113,6 +113,12 @@ class DepComputer {
 
   void OnInvalidateComputer() { Reset(); }
 
+  // drop the analysis of fg only, the analyses of the other func graphs are kept
+  void Invalidate(const FuncGraphPtr &fg) {
+    ExtraInvalidate(fg);
+    (void)func_graphs_validate_.erase(fg);
+  }
+
   void Recompute();
 
   void Recompute(const FuncGraphPtr &fg);
@@ -124,6 +130,8 @@ class DepComputer {
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
+  // subclass can drop their own member of a func graph;
+  virtual void ExtraInvalidate(const FuncGraphPtr &) {}
   // subclass do the real compute
   virtual void RealRecompute() {}
   virtual void RealRecompute(FuncGraphPtr) {}
@@ -150,6 +158,7 @@ class FuncGraphParentsTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_parents_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_parents_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -173,6 +182,7 @@ class ParentComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { parent_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)parent_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -191,6 +201,7 @@ class ChildrenComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { children_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)children_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -209,6 +220,7 @@ class ScopeComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { scope_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)scope_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -245,6 +257,7 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)func_graph_used_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -272,6 +285,10 @@ class RecursiveComputer final : public DepComputer {
     recursive_analysis_.clear();
     recursive_map_.clear();
   }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override {
+    (void)recursive_analysis_.erase(fg);
+    (void)recursive_map_.erase(fg);
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -289,6 +306,7 @@ class FuncGraphJTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { j_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphPtr &fg) override { (void)j_total_analysis_.erase(fg); }
 
   void RealRecompute(FuncGraphPtr fg) override;
   bool SeekJ(const FuncGraphPtr &fg, size_t seen_num);
@@ -368,6 +386,8 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
   void AddEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void DropEdge(AnfNodePtr node, int index, AnfNodePtr input);
   void MoveAllNodes(FuncGraphPtr source, FuncGraphPtr target);
+  void InvalidateFuncGraph(const FuncGraphPtr &fg);
+  void DropFuncGraphAnalysis(const FuncGraphPtr &fg);
 
   FuncGraphSet roots_;        // managed roots
   FuncGraphSet func_graphs_;  // managed func graphs
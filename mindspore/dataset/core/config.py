@@ -20,9 +20,12 @@ import numpy
 import mindspore._c_dataengine as cde
 
 __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'set_num_parallel_workers',
-           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval', 'load']
+           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval', 'load',
+           'set_coalesce_max_rows', 'get_coalesce_max_rows', 'set_mindrecord_prefetch_window',
+           'get_mindrecord_prefetch_window']
 
 INT32_MAX = 2147483647
+MINDRECORD_MAX_PREFETCH_WINDOW = 4096
 UINT32_MAX = 4294967295
 
 _config = cde.GlobalContext.config_manager()
@@ -189,6 +192,71 @@ def get_callback_timeout():
     return _config.get_callback_timeout()
 
 
+def set_coalesce_max_rows(max_rows):
+    """
+    Set the max number of rows of a buffer coalesced by the output connectors of the operations.
+    Small buffers already waiting in a connector are merged into one, the size of the merged buffer
+    follows the observed throughput of the connector. 0 disables coalescing.
+
+    Args:
+        max_rows (int): max number of rows of a coalesced buffer.
+
+    Raises:
+        ValueError: If max_rows is invalid (< 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> # merge up to 64 rows into one buffer.
+        >>> ds.config.set_coalesce_max_rows(64)
+    """
+    if max_rows < 0 or max_rows > INT32_MAX:
+        raise ValueError("max_rows given is not within the required range.")
+    _config.set_coalesce_max_rows(max_rows)
+
+
+def get_coalesce_max_rows():
+    """
+    Get the max number of rows of a buffer coalesced by the output connectors.
+
+    Returns:
+        Int, max number of rows, 0 if coalescing is disabled.
+    """
+    return _config.get_coalesce_max_rows()
+
+
+def set_mindrecord_prefetch_window(window):
+    """
+    Set the max number of rows MindDataset reads ahead of its workers.
+    The blobs of the rows are read into the page cache in the order the sampler visits them,
+    through io_uring where the kernel supports it or by a pool of threads otherwise. 0 disables the read-ahead.
+    The window never exceeds the number of rows of the dataset.
+
+    Args:
+        window (int): max number of rows read ahead, at most 4096.
+
+    Raises:
+        ValueError: If window is invalid (< 0 or > 4096).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> # read up to 256 rows ahead.
+        >>> ds.config.set_mindrecord_prefetch_window(256)
+    """
+    if window < 0 or window > MINDRECORD_MAX_PREFETCH_WINDOW:
+        raise ValueError("window given is not within the required range.")
+    _config.set_mindrecord_prefetch_window(window)
+
+
+def get_mindrecord_prefetch_window():
+    """
+    Get the max number of rows MindDataset reads ahead of its workers.
+
+    Returns:
+        Int, max number of rows, 0 if the read-ahead is disabled.
+    """
+    return _config.get_mindrecord_prefetch_window()
+
+
 def __str__():
     """
     String representation of the configurations.
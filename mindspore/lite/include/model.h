@@ -36,6 +36,8 @@ struct Model {
   Uint32Vector output_indices_;
   NodePtrVector nodes_;
   char *buf;
+  size_t buf_size_ = 0;
+  bool buf_mapped_ = false;
 
   /// \brief Static method to create a Model pointer.
   ///
@@ -45,6 +47,16 @@ struct Model {
   /// \return Pointer of MindSpore Lite Model.
   static Model *Import(const char *model_buf, size_t size);
 
+  /// \brief Static method to create a Model pointer by memory-mapping a model file.
+  ///
+  /// \note Weight tensors of the compiled session point into the mapping instead of being copied, so the model
+  /// must be kept alive until the sessions compiled from it are destroyed.
+  ///
+  /// \param[in] model_path Define the path of the model file.
+  ///
+  /// \return Pointer of MindSpore Lite Model.
+  static Model *ImportFromFile(const char *model_path);
+
   /// \brief Free meta graph temporary buffer
   void Free();
 
@@ -20,10 +20,20 @@
 #ifdef ENABLE_ARM64
 #include <arm_neon.h>
 #endif
+#ifdef ENABLE_SSE
+#include "nnacl/nnacl_utils.h"
+#include "nnacl/x86_64/conv_depthwise_avx.h"
+#endif
 
 #ifndef ENABLE_ARM
 void ConvDwFp32Row(float *output_ptr, const float *input_ptr, const float *weight_ptr, int num_pixels,
                    int output_channel, int input_step) {
+#ifdef ENABLE_SSE
+  if (GetX86SimdLevel() != X86Simd_Sse) {
+    ConvDwFp32RowAvx2(output_ptr, input_ptr, weight_ptr, num_pixels, output_channel, input_step);
+    return;
+  }
+#endif
   for (int i = 0; i < num_pixels; i++) {
     for (int c = 0; c < output_channel; c++) {
       *output_ptr++ += weight_ptr[c] * input_ptr[c];
@@ -220,6 +230,13 @@ void DepthwiseBorder(float *dst, const float *src, const float *weight, const fl
 void DepthwiseCenter(float *dst, const float *src, const float *weight, const float *bias, int height, int width,
                      int kernel_h, int kernel_w, int out_h_step, int block_channel, int in_sh_step, int in_sw_step,
                      int in_kh_step, int in_kw_step, bool is_relu, bool is_relu6) {
+#ifdef ENABLE_SSE
+  if (GetX86SimdLevel() != X86Simd_Sse) {
+    ConvDwFp32CenterAvx2(dst, src, weight, bias, height, width, kernel_h, kernel_w, out_h_step, block_channel,
+                         in_sh_step, in_sw_step, in_kh_step, in_kw_step, is_relu, is_relu6);
+    return;
+  }
+#endif
   float *dst_h = dst;
   const float *src_h = src;
   for (int oh = 0; oh < height; oh++) {
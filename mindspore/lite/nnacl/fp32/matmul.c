@@ -15,6 +15,10 @@
  */
 
 #include "nnacl/fp32/matmul.h"
+#ifdef ENABLE_SSE
+#include "nnacl/nnacl_utils.h"
+#include "nnacl/x86_64/matmul_avx.h"
+#endif
 
 void RowMajor2Row4Major(float *src_ptr, float *dst_ptr, int row, int col) {
   for (int r = 0; r < row; r++) {
@@ -557,6 +561,15 @@ void MatMulOpt(const float *a, const float *b, float *c, const float *bias, ActT
 #elif ENABLE_ARM32
   MatmulFloatNeon32Opt(a, b, c, bias, (int)act_type, deep, row, col, stride, (int)(out_type == OutType_Nhwc),
                          (int)(out_type == OutType_TileC8));
+#elif ENABLE_SSE
+  X86SimdLevel simd_level = GetX86SimdLevel();
+  if (simd_level == X86Simd_Avx512) {
+    MatmulFloatAvx512(a, b, c, bias, (int)act_type, deep, row, col, stride, out_type);
+  } else if (simd_level == X86Simd_Avx2Fma) {
+    MatmulFloatAvx2(a, b, c, bias, (int)act_type, deep, row, col, stride, out_type);
+  } else {
+    MatMul12x8(a, b, c, bias, act_type, deep, row, col, stride, out_type);
+  }
 #else
   MatMul12x8(a, b, c, bias, act_type, deep, row, col, stride, out_type);
 #endif
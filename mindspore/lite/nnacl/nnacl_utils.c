@@ -18,6 +18,9 @@
 #ifdef __ANDROID__
 #include <sys/auxv.h>
 #endif
+#ifdef ENABLE_SSE
+#include <pthread.h>
+#endif
 
 #if defined(__ANDROID__)
 uint32_t getHwCap(int hwcap_type) {
@@ -25,3 +28,24 @@ uint32_t getHwCap(int hwcap_type) {
   return ret;
 }
 #endif
+
+#ifdef ENABLE_SSE
+static X86SimdLevel x86_simd_level = X86Simd_Sse;
+static pthread_once_t x86_simd_level_once = PTHREAD_ONCE_INIT;
+
+static void ProbeX86SimdLevel(void) {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    x86_simd_level = X86Simd_Avx512;
+  } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    x86_simd_level = X86Simd_Avx2Fma;
+  } else {
+    x86_simd_level = X86Simd_Sse;
+  }
+}
+
+X86SimdLevel GetX86SimdLevel(void) {
+  (void)pthread_once(&x86_simd_level_once, ProbeX86SimdLevel);
+  return x86_simd_level;
+}
+#endif
@@ -24,6 +24,12 @@ extern "C" {
 #if defined(__arm__) || defined(__aarch64__)
 uint32_t getHwCap(int hwcap_type);
 #endif
+#ifdef ENABLE_SSE
+typedef enum X86SimdLevel { X86Simd_Sse = 0, X86Simd_Avx2Fma = 1, X86Simd_Avx512 = 2 } X86SimdLevel;
+
+// highest simd level of the running cpu, probed once through cpuid
+X86SimdLevel GetX86SimdLevel(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -137,7 +137,7 @@ void GeneralOutputTransformUnit(const float *src_data, float *dst_data, const fl
 InputTransFunc GetInputTransFunc(int input_unit) { return InputTransFuncList[input_unit]; }
 
 void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[16];
   float32x4_t m[16];
@@ -189,7 +189,7 @@ void InputTransform4x4Unit(const float *src_data, float *dst_data, int src_step,
 }
 
 void InputTransform6x6Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[36];
   float32x4_t m[36];
@@ -261,7 +261,7 @@ void InputTransform6x6Unit(const float *src_data, float *dst_data, int src_step,
 }
 
 void InputTransform8x8Unit(const float *src_data, float *dst_data, int src_step, int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[64];
   float32x4_t m[64];
@@ -374,7 +374,7 @@ OutputTransFunc GetOutputTransFunc(int input_unit, int output_unit) {
 
 void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[8];
   float32x4_t m[4];
@@ -424,7 +424,7 @@ void OutputTransform4x2Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[16];
   float32x4_t t[12];
   float32x4_t m[9];
@@ -480,7 +480,7 @@ void OutputTransform4x3Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform6x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[12];
   float32x4_t m[4];
@@ -537,7 +537,7 @@ void OutputTransform6x2Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform6x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[18];
   float32x4_t m[9];
@@ -597,7 +597,7 @@ void OutputTransform6x3Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform6x4Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[24];
   float32x4_t m[16];
@@ -662,7 +662,7 @@ void OutputTransform6x4Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform6x5Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[36];
   float32x4_t t[30];
   float32x4_t m[25];
@@ -732,7 +732,7 @@ void OutputTransform6x5Unit(const float *src_data, float *dst_data, const float
 
 void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[16];
   float32x4_t m[4];
@@ -801,7 +801,7 @@ void OutputTransform8x2Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[24];
   float32x4_t m[9];
@@ -872,7 +872,7 @@ void OutputTransform8x3Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[32];
   float32x4_t m[16];
@@ -949,7 +949,7 @@ void OutputTransform8x4Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[40];
   float32x4_t m[25];
@@ -1032,7 +1032,7 @@ void OutputTransform8x5Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[48];
   float32x4_t m[36];
@@ -1130,7 +1130,7 @@ void OutputTransform8x6Unit(const float *src_data, float *dst_data, const float
 }
 void OutputTransform8x7Unit(const float *src_data, float *dst_data, const float *bias_data, int src_step,
                             int dst_step) {
-#ifdef ENABLE_ARM
+#if defined(ENABLE_ARM) || defined(ENABLE_SSE)
   float32x4_t src[64];
   float32x4_t t[56];
   float32x4_t m[49];
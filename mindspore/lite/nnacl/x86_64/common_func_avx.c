@@ -0,0 +1,100 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/common_func_avx.h"
+#ifdef ENABLE_SSE
+#include <immintrin.h>
+#include <string.h>
+#include "nnacl/common_func.h"
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+
+#define AVX2_FMA_TILE(acc, index) acc = _mm256_fmadd_ps(_mm256_broadcast_ss(src + (index)*C4NUM), w, acc)
+
+#define AVX2_POST_TILE(acc, index)                                               \
+  acc = _mm256_add_ps(acc, bias_v);                                              \
+  if (relu || relu6) {                                                           \
+    acc = _mm256_max_ps(acc, zero);                                              \
+  }                                                                              \
+  if (relu6) {                                                                   \
+    acc = _mm256_min_ps(acc, six);                                               \
+  }                                                                              \
+  if (valid_oc == C8NUM) {                                                       \
+    _mm256_storeu_ps(dst + (index)*output_channel, acc);                         \
+  } else {                                                                       \
+    _mm256_storeu_ps(tile, acc);                                                 \
+    memcpy(dst + (index)*output_channel, tile, valid_oc * sizeof(float));        \
+  }
+
+/* 8 tiles x 8 output channels register block: eight ymm accumulators, one broadcast and one weight register */
+AVX2_TARGET static void IndirectGemmFp32Avx2(float *output, const float *input, const float *weight,
+                                             const float *bias, size_t step, size_t ic4, size_t output_channel,
+                                             size_t relu, size_t relu6) {
+  size_t deep = step * ic4;
+  __m256 zero = _mm256_setzero_ps();
+  __m256 six = _mm256_set1_ps(6.0f);
+  float tile[C8NUM];
+  for (size_t oc8 = 0; oc8 < UP_DIV(output_channel, C8NUM); ++oc8) {
+    size_t valid_oc = MSMIN(C8NUM, output_channel - oc8 * C8NUM);
+    const float *weight_oc = weight + oc8 * deep * C4NUM * C8NUM;
+    __m256 dst0 = _mm256_setzero_ps();
+    __m256 dst1 = _mm256_setzero_ps();
+    __m256 dst2 = _mm256_setzero_ps();
+    __m256 dst3 = _mm256_setzero_ps();
+    __m256 dst4 = _mm256_setzero_ps();
+    __m256 dst5 = _mm256_setzero_ps();
+    __m256 dst6 = _mm256_setzero_ps();
+    __m256 dst7 = _mm256_setzero_ps();
+    /* the kernel plane and the ic4 blocks are laid out one after another in both the input and the weight */
+    for (size_t d = 0; d < deep; ++d) {
+      for (int m = 0; m < C4NUM; ++m) {
+        const float *src = input + d * TILE_NUM * C4NUM + m;
+        __m256 w = _mm256_loadu_ps(weight_oc + d * C4NUM * C8NUM + m * C8NUM);
+        AVX2_FMA_TILE(dst0, 0);
+        AVX2_FMA_TILE(dst1, 1);
+        AVX2_FMA_TILE(dst2, 2);
+        AVX2_FMA_TILE(dst3, 3);
+        AVX2_FMA_TILE(dst4, 4);
+        AVX2_FMA_TILE(dst5, 5);
+        AVX2_FMA_TILE(dst6, 6);
+        AVX2_FMA_TILE(dst7, 7);
+      }
+    }
+    memset(tile, 0, sizeof(tile));
+    memcpy(tile, bias + oc8 * C8NUM, valid_oc * sizeof(float));
+    __m256 bias_v = _mm256_loadu_ps(tile);
+    float *dst = output + oc8 * C8NUM;
+    AVX2_POST_TILE(dst0, 0);
+    AVX2_POST_TILE(dst1, 1);
+    AVX2_POST_TILE(dst2, 2);
+    AVX2_POST_TILE(dst3, 3);
+    AVX2_POST_TILE(dst4, 4);
+    AVX2_POST_TILE(dst5, 5);
+    AVX2_POST_TILE(dst6, 6);
+    AVX2_POST_TILE(dst7, 7);
+  }
+}
+
+void IndirectGemmFp32_8x8Avx2(float *output, const float *input, const float *weight, const float *bias, size_t step,
+                              size_t ic4, size_t output_channel, size_t offset, size_t mode, size_t writeC4,
+                              size_t relu, size_t relu6) {
+  if (mode) {
+    IndirectGemmFp32_8x8(output, input, weight, bias, step, ic4, output_channel, offset, mode, writeC4, relu, relu6);
+    return;
+  }
+  IndirectGemmFp32Avx2(output, input, weight, bias, step, ic4, output_channel, relu, relu6);
+}
+#endif
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/conv_depthwise_avx.h"
+#ifdef ENABLE_SSE
+#include <immintrin.h>
+#include "nnacl/op_base.h"
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+
+AVX2_TARGET void ConvDwFp32RowAvx2(float *output_ptr, const float *input_ptr, const float *weight_ptr,
+                                   int num_pixels, int output_channel, int input_step) {
+  for (int i = 0; i < num_pixels; i++) {
+    int c = 0;
+    for (; c <= output_channel - C8NUM; c += C8NUM) {
+      __m256 out = _mm256_loadu_ps(output_ptr + c);
+      out = _mm256_fmadd_ps(_mm256_loadu_ps(weight_ptr + c), _mm256_loadu_ps(input_ptr + c), out);
+      _mm256_storeu_ps(output_ptr + c, out);
+    }
+    for (; c < output_channel; c++) {
+      output_ptr[c] += weight_ptr[c] * input_ptr[c];
+    }
+    output_ptr += output_channel;
+    input_ptr += input_step;
+  }
+}
+
+AVX2_TARGET static inline __m256 LoadPixelPair(const float *first, const float *second) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(first)), _mm_loadu_ps(second), 1);
+}
+
+/* two horizontally adjacent C4 output pixels share one ymm register, the kernel weights are broadcast to both halves */
+AVX2_TARGET void ConvDwFp32CenterAvx2(float *dst, const float *src, const float *weight, const float *bias,
+                                      int height, int width, int kernel_h, int kernel_w, int out_h_step,
+                                      int block_channel, int in_sh_step, int in_sw_step, int in_kh_step,
+                                      int in_kw_step, bool is_relu, bool is_relu6) {
+  __m256 bias_v = _mm256_broadcast_ps((const __m128 *)bias);
+  __m256 zero = _mm256_setzero_ps();
+  __m256 six = _mm256_set1_ps(6.0f);
+  float *dst_h = dst;
+  const float *src_h = src;
+  for (int oh = 0; oh < height; oh++) {
+    float *dst_w = dst_h;
+    const float *src_w = src_h;
+    int ow = 0;
+    for (; ow <= width - C2NUM; ow += C2NUM) {
+      __m256 acc = bias_v;
+      const float *src_kh = src_w;
+      const float *weight_kh = weight;
+      for (int kh = 0; kh < kernel_h; kh++) {
+        const float *src_kw = src_kh;
+        const float *weight_kw = weight_kh;
+        for (int kw = 0; kw < kernel_w; kw++) {
+          __m256 in = LoadPixelPair(src_kw, src_kw + in_sw_step);
+          acc = _mm256_fmadd_ps(in, _mm256_broadcast_ps((const __m128 *)weight_kw), acc);
+          src_kw += in_kw_step;
+          weight_kw += C4NUM;
+        }  // kernel_w loop
+        src_kh += in_kh_step;
+        weight_kh += kernel_w * C4NUM;
+      }  // kernel_h loop
+      if (is_relu || is_relu6) {
+        acc = _mm256_max_ps(acc, zero);
+      }
+      if (is_relu6) {
+        acc = _mm256_min_ps(acc, six);
+      }
+      _mm_storeu_ps(dst_w, _mm256_castps256_ps128(acc));
+      _mm_storeu_ps(dst_w + block_channel, _mm256_extractf128_ps(acc, 1));
+      dst_w += C2NUM * block_channel;
+      src_w += C2NUM * in_sw_step;
+    }  // dst_width loop
+    for (; ow < width; ow++) {
+      __m128 acc = _mm256_castps256_ps128(bias_v);
+      const float *src_kh = src_w;
+      const float *weight_kh = weight;
+      for (int kh = 0; kh < kernel_h; kh++) {
+        const float *src_kw = src_kh;
+        const float *weight_kw = weight_kh;
+        for (int kw = 0; kw < kernel_w; kw++) {
+          acc = _mm_fmadd_ps(_mm_loadu_ps(src_kw), _mm_loadu_ps(weight_kw), acc);
+          src_kw += in_kw_step;
+          weight_kw += C4NUM;
+        }
+        src_kh += in_kh_step;
+        weight_kh += kernel_w * C4NUM;
+      }
+      if (is_relu || is_relu6) {
+        acc = _mm_max_ps(acc, _mm_setzero_ps());
+      }
+      if (is_relu6) {
+        acc = _mm_min_ps(acc, _mm_set1_ps(6.0f));
+      }
+      _mm_storeu_ps(dst_w, acc);
+      dst_w += block_channel;
+      src_w += in_sw_step;
+    }
+    dst_h += out_h_step;
+    src_h += in_sh_step;
+  }  // dst_height loop
+}
+#endif
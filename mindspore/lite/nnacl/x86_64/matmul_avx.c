@@ -0,0 +1,225 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/matmul_avx.h"
+#ifdef ENABLE_SSE
+#include <immintrin.h>
+#include <string.h>
+#include "nnacl/matmul_parameter.h"
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#define AVX512_TARGET __attribute__((target("avx512f,avx2,fma")))
+
+static void LoadBiasTile(const float *bias, float *bias_tile, int col_start, int width, int bias_len) {
+  memset(bias_tile, 0, width * sizeof(float));
+  if (bias == NULL) {
+    return;
+  }
+  int valid = MSMIN(width, bias_len - col_start);
+  if (valid > 0) {
+    memcpy(bias_tile, bias + col_start, valid * sizeof(float));
+  }
+}
+
+/* scatter a row-major 12 x (block_num * 8) tile to the destination layout selected by out_type */
+static void WriteResultTile(const float *tile, int tile_stride, int block_num, float *dst, int row_start,
+                            int c8_start, int row, int col, size_t stride, int out_type) {
+  int row_12 = UP_ROUND(row, C12NUM);
+  int valid_row = out_type == OutType_C8 ? C12NUM : MSMIN(C12NUM, row - row_start);
+  for (int r = 0; r < valid_row; ++r) {
+    const float *src = tile + r * tile_stride;
+    size_t dst_r = row_start + r;
+    for (int j = 0; j < block_num; ++j) {
+      size_t c8 = c8_start + j;
+      int valid_col = out_type == OutType_C8 ? C8NUM : MSMIN(C8NUM, col - (int)c8 * C8NUM);
+      if (valid_col <= 0) {
+        break;
+      }
+      float *dst_ptr = NULL;
+      if (out_type == OutType_Nhwc) {
+        dst_ptr = dst + dst_r * stride + c8 * C8NUM;
+      } else if (out_type == OutType_C8) {
+        dst_ptr = dst + c8 * C8NUM * row_12 + dst_r * C8NUM;
+      } else {
+        dst_ptr = dst + dst_r * col * stride + c8 * C8NUM * stride;
+      }
+      memcpy(dst_ptr, src + j * C8NUM, valid_col * sizeof(float));
+    }
+  }
+}
+
+#define AVX2_FMA_ROW(acc, index) acc = _mm256_fmadd_ps(_mm256_broadcast_ss(a + (index)), weight, acc)
+
+#define AVX2_POST_ROW(acc, index)                  \
+  acc = _mm256_add_ps(acc, bias_v);                \
+  if (act_type == ActType_Relu6) {                 \
+    acc = _mm256_min_ps(acc, six);                 \
+  }                                                \
+  if (act_type != ActType_No) {                    \
+    acc = _mm256_max_ps(acc, zero);                \
+  }                                                \
+  _mm256_storeu_ps(tile + (index)*C8NUM, acc);
+
+/* 12x8 register tile: twelve ymm accumulators, one broadcast and one weight register */
+AVX2_TARGET static void MatmulFloatAvx2Tile12x8(const float *a, const float *b, const float *bias, float *tile,
+                                                int act_type, int deep) {
+  __m256 dst0 = _mm256_setzero_ps();
+  __m256 dst1 = _mm256_setzero_ps();
+  __m256 dst2 = _mm256_setzero_ps();
+  __m256 dst3 = _mm256_setzero_ps();
+  __m256 dst4 = _mm256_setzero_ps();
+  __m256 dst5 = _mm256_setzero_ps();
+  __m256 dst6 = _mm256_setzero_ps();
+  __m256 dst7 = _mm256_setzero_ps();
+  __m256 dst8 = _mm256_setzero_ps();
+  __m256 dst9 = _mm256_setzero_ps();
+  __m256 dst10 = _mm256_setzero_ps();
+  __m256 dst11 = _mm256_setzero_ps();
+  for (int d = 0; d < deep; ++d) {
+    __m256 weight = _mm256_loadu_ps(b);
+    AVX2_FMA_ROW(dst0, 0);
+    AVX2_FMA_ROW(dst1, 1);
+    AVX2_FMA_ROW(dst2, 2);
+    AVX2_FMA_ROW(dst3, 3);
+    AVX2_FMA_ROW(dst4, 4);
+    AVX2_FMA_ROW(dst5, 5);
+    AVX2_FMA_ROW(dst6, 6);
+    AVX2_FMA_ROW(dst7, 7);
+    AVX2_FMA_ROW(dst8, 8);
+    AVX2_FMA_ROW(dst9, 9);
+    AVX2_FMA_ROW(dst10, 10);
+    AVX2_FMA_ROW(dst11, 11);
+    a += C12NUM;
+    b += C8NUM;
+  }
+  __m256 bias_v = _mm256_loadu_ps(bias);
+  __m256 zero = _mm256_setzero_ps();
+  __m256 six = _mm256_set1_ps(6.0f);
+  AVX2_POST_ROW(dst0, 0);
+  AVX2_POST_ROW(dst1, 1);
+  AVX2_POST_ROW(dst2, 2);
+  AVX2_POST_ROW(dst3, 3);
+  AVX2_POST_ROW(dst4, 4);
+  AVX2_POST_ROW(dst5, 5);
+  AVX2_POST_ROW(dst6, 6);
+  AVX2_POST_ROW(dst7, 7);
+  AVX2_POST_ROW(dst8, 8);
+  AVX2_POST_ROW(dst9, 9);
+  AVX2_POST_ROW(dst10, 10);
+  AVX2_POST_ROW(dst11, 11);
+}
+
+#define AVX512_FMA_ROW(acc, index) acc = _mm512_fmadd_ps(_mm512_set1_ps(a[index]), weight, acc)
+
+#define AVX512_POST_ROW(acc, index)                \
+  acc = _mm512_add_ps(acc, bias_v);                \
+  if (act_type == ActType_Relu6) {                 \
+    acc = _mm512_min_ps(acc, six);                 \
+  }                                                \
+  if (act_type != ActType_No) {                    \
+    acc = _mm512_max_ps(acc, zero);                \
+  }                                                \
+  _mm512_storeu_ps(tile + (index)*C16NUM, acc);
+
+/* 12x16 register tile covering two adjacent col8 blocks of b, which live deep * 8 floats apart */
+AVX512_TARGET static void MatmulFloatAvx512Tile12x16(const float *a, const float *b, const float *bias, float *tile,
+                                                     int act_type, int deep) {
+  const float *b_next = b + deep * C8NUM;
+  __m512 dst0 = _mm512_setzero_ps();
+  __m512 dst1 = _mm512_setzero_ps();
+  __m512 dst2 = _mm512_setzero_ps();
+  __m512 dst3 = _mm512_setzero_ps();
+  __m512 dst4 = _mm512_setzero_ps();
+  __m512 dst5 = _mm512_setzero_ps();
+  __m512 dst6 = _mm512_setzero_ps();
+  __m512 dst7 = _mm512_setzero_ps();
+  __m512 dst8 = _mm512_setzero_ps();
+  __m512 dst9 = _mm512_setzero_ps();
+  __m512 dst10 = _mm512_setzero_ps();
+  __m512 dst11 = _mm512_setzero_ps();
+  for (int d = 0; d < deep; ++d) {
+    __m256d low = _mm256_castps_pd(_mm256_loadu_ps(b));
+    __m256d high = _mm256_castps_pd(_mm256_loadu_ps(b_next));
+    __m512 weight = _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castpd256_pd512(low), high, 1));
+    AVX512_FMA_ROW(dst0, 0);
+    AVX512_FMA_ROW(dst1, 1);
+    AVX512_FMA_ROW(dst2, 2);
+    AVX512_FMA_ROW(dst3, 3);
+    AVX512_FMA_ROW(dst4, 4);
+    AVX512_FMA_ROW(dst5, 5);
+    AVX512_FMA_ROW(dst6, 6);
+    AVX512_FMA_ROW(dst7, 7);
+    AVX512_FMA_ROW(dst8, 8);
+    AVX512_FMA_ROW(dst9, 9);
+    AVX512_FMA_ROW(dst10, 10);
+    AVX512_FMA_ROW(dst11, 11);
+    a += C12NUM;
+    b += C8NUM;
+    b_next += C8NUM;
+  }
+  __m512 bias_v = _mm512_loadu_ps(bias);
+  __m512 zero = _mm512_setzero_ps();
+  __m512 six = _mm512_set1_ps(6.0f);
+  AVX512_POST_ROW(dst0, 0);
+  AVX512_POST_ROW(dst1, 1);
+  AVX512_POST_ROW(dst2, 2);
+  AVX512_POST_ROW(dst3, 3);
+  AVX512_POST_ROW(dst4, 4);
+  AVX512_POST_ROW(dst5, 5);
+  AVX512_POST_ROW(dst6, 6);
+  AVX512_POST_ROW(dst7, 7);
+  AVX512_POST_ROW(dst8, 8);
+  AVX512_POST_ROW(dst9, 9);
+  AVX512_POST_ROW(dst10, 10);
+  AVX512_POST_ROW(dst11, 11);
+}
+
+void MatmulFloatAvx2(const float *a, const float *b, float *c, const float *bias, int act_type, int deep, int row,
+                     int col, size_t stride, int out_type) {
+  int col_end = out_type == OutType_C8 ? UP_ROUND(col, C8NUM) : col;
+  float bias_tile[C8NUM];
+  float tile[C12NUM * C8NUM];
+  for (int r = 0; r < row; r += C12NUM) {
+    const float *a_ptr = a + r * deep;
+    for (int ci = 0; ci < col_end; ci += C8NUM) {
+      LoadBiasTile(bias, bias_tile, ci, C8NUM, col_end);
+      MatmulFloatAvx2Tile12x8(a_ptr, b + ci * deep, bias_tile, tile, act_type, deep);
+      WriteResultTile(tile, C8NUM, 1, c, r, ci / C8NUM, row, col, stride, out_type);
+    }
+  }
+}
+
+void MatmulFloatAvx512(const float *a, const float *b, float *c, const float *bias, int act_type, int deep, int row,
+                       int col, size_t stride, int out_type) {
+  int col_end = out_type == OutType_C8 ? UP_ROUND(col, C8NUM) : col;
+  float bias_tile[C16NUM];
+  float tile[C12NUM * C16NUM];
+  for (int r = 0; r < row; r += C12NUM) {
+    const float *a_ptr = a + r * deep;
+    int ci = 0;
+    for (; ci + C8NUM < col_end; ci += C16NUM) {
+      LoadBiasTile(bias, bias_tile, ci, C16NUM, col_end);
+      MatmulFloatAvx512Tile12x16(a_ptr, b + ci * deep, bias_tile, tile, act_type, deep);
+      WriteResultTile(tile, C16NUM, 2, c, r, ci / C8NUM, row, col, stride, out_type);
+    }
+    if (ci < col_end) {
+      LoadBiasTile(bias, bias_tile, ci, C8NUM, col_end);
+      MatmulFloatAvx2Tile12x8(a_ptr, b + ci * deep, bias_tile, tile, act_type, deep);
+      WriteResultTile(tile, C8NUM, 1, c, r, ci / C8NUM, row, col, stride, out_type);
+    }
+  }
+}
+#endif
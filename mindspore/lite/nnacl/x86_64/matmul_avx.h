@@ -0,0 +1,38 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_NNACL_X86_64_MATMUL_AVX_H_
+#define MINDSPORE_LITE_NNACL_X86_64_MATMUL_AVX_H_
+
+#include <stddef.h>
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef ENABLE_SSE
+/* same contract as MatMulOpt: a is col12-major, b is col8-major, results are written according to out_type */
+void MatmulFloatAvx2(const float *a, const float *b, float *c, const float *bias, int act_type, int deep, int row,
+                     int col, size_t stride, int out_type);
+
+void MatmulFloatAvx512(const float *a, const float *b, float *c, const float *bias, int act_type, int deep, int row,
+                       int col, size_t stride, int out_type);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_LITE_NNACL_X86_64_MATMUL_AVX_H_
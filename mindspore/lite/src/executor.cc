@@ -37,9 +37,11 @@ int Executor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_
       return RET_ERROR;
     }
   }
-  kernel::LiteKernelUtil::InitTensorRefCount(kernels);
-  for (auto out_tensor : out_tensors) {  // increase RefCount of output tensors, such that Run will not free them
-    out_tensor->SetRefCount(out_tensor->RefCount() + 1);
+  if (!memory_planned_) {
+    kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+    for (auto out_tensor : out_tensors) {  // increase RefCount of output tensors, such that Run will not free them
+      out_tensor->SetRefCount(out_tensor->RefCount() + 1);
+    }
   }
 
   for (auto *kernel : kernels) {
@@ -64,6 +66,9 @@ int Executor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_
         MS_LOG(ERROR) << "run kernel after_callback failed, name: " << kernel->name();
       }
     }
+    if (memory_planned_) {
+      continue;
+    }
     for (auto input_kernel : kernel->in_kernels()) {
       MS_ASSERT(input_kernel != nullptr);
       if (input_kernel->is_model_output()) {
@@ -34,12 +34,20 @@ class Executor {
                   std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
                   const session::KernelCallBack &before = nullptr, const session::KernelCallBack &after = nullptr);
 
+  // kernels run one by one in the order given, so a static memory plan built on that order is valid
+  virtual bool SupportMemoryPlan() const { return true; }
+
+  // tensors of a planned graph own their memory for the whole session, skip ref-counting and freeing them
+  void set_memory_planned(bool memory_planned) { memory_planned_ = memory_planned; }
+
  protected:
   int TransformTensorLayoutFp32(Tensor *tensor, schema::Format dst_format, Allocator *allocator = nullptr);
 
   int TransformTensorLayoutUint8(Tensor *tensor, schema::Format dst_format, Allocator *allocator = nullptr);
 
   int TransformTensorLayout(Tensor *tensor, schema::Format dst_format, Allocator *allocator = nullptr);
+
+  bool memory_planned_ = false;
 };
 
 }  // namespace mindspore::lite
@@ -43,6 +43,10 @@ static bool WeightTensorNeedCopy(const lite::Model *model, const uint32_t tensor
 #endif
 
   MS_ASSERT(model != nullptr);
+  // a mapped model stays alive with the session, kernels read the weights directly from the mapping
+  if (model->buf_mapped_) {
+    return false;
+  }
   auto post_node_idxes = GetLinkedPostNodeIdx(model, tensor_idx);
   return std::none_of(post_node_idxes.begin(), post_node_idxes.end(), [&](const size_t &post_node_idx) {
     auto node = model->nodes_[post_node_idx];
@@ -271,11 +275,47 @@ int LiteSession::CompileGraph(Model *model) {
 
   executor->Prepare(this->kernels_);
 #ifndef SUPPORT_TRAIN
-  model->Free();
+  PlanMemory();
+  if (!model->buf_mapped_) {
+    model->Free();
+  }
 #endif
   return RET_OK;
 }
 
+void LiteSession::PlanMemory() {
+  memory_planner_.Release();
+  executor->set_memory_planned(false);
+  if (!executor->SupportMemoryPlan()) {
+    return;
+  }
+  for (auto *kernel : kernels_) {
+    MS_ASSERT(kernel != nullptr);
+    if (kernel->desc().arch != kernel::KERNEL_ARCH::kCPU) {
+      MS_LOG(INFO) << "Kernel " << kernel->name() << " is not a cpu kernel, skip memory plan";
+      return;
+    }
+    auto primitive = kernel->GetPrimitive();
+    if (primitive != nullptr && !primitive->GetInferFlag()) {
+      MS_LOG(INFO) << "Shape of kernel " << kernel->name() << " is inferred at runtime, skip memory plan";
+      return;
+    }
+  }
+  auto ret = memory_planner_.Plan(kernels_, outputs_);
+  if (ret != RET_OK) {
+    MS_LOG(WARNING) << "Plan memory failed, tensors are allocated at runtime instead: " << ret;
+    return;
+  }
+  if (!memory_planner_.planned()) {
+    return;
+  }
+  executor->set_memory_planned(true);
+  MS_LOG(INFO) << "Memory plan of " << memory_planner_.tensor_num()
+               << " tensors, arena size: " << memory_planner_.arena_size()
+               << ", live peak size: " << memory_planner_.live_peak_size()
+               << ", ref-count allocator size: " << memory_planner_.allocator_size();
+}
+
 std::vector<mindspore::tensor::MSTensor *> LiteSession::GetInputs() const { return this->input_vec_; }
 
 int LiteSession::RunGraph(const session::KernelCallBack &before, const session::KernelCallBack &after) {
@@ -332,6 +372,7 @@ void LiteSession::BindThread(bool if_bind) {
 }
 
 LiteSession::~LiteSession() {
+  memory_planner_.Release();
   for (size_t i = 0; i < tensors_.size(); i++) {
     auto *tensor = tensors_.at(i);
     MS_ASSERT(tensor != nullptr);
@@ -436,6 +477,9 @@ int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs
     return ret;
   }
 
+  // the plan depends on tensor sizes, drop it before the shapes change
+  memory_planner_.Release();
+  executor->set_memory_planned(false);
   Scheduler scheduler(context_);
   ret = scheduler.ReSizeKernels(kernels_);
   if (ret != RET_OK) {
@@ -443,9 +487,16 @@ int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs
     auto resize_ret = scheduler.ReSizeKernels(kernels_);
     if (resize_ret != RET_OK) {
       MS_LOG(ERROR) << "restore kernel size fail!ret: " << resize_ret;
+      return ret;
     }
+#ifndef SUPPORT_TRAIN
+    PlanMemory();
+#endif
     return ret;
   }
+#ifndef SUPPORT_TRAIN
+  PlanMemory();
+#endif
   return RET_OK;
 }
 }  // namespace lite
@@ -13,6 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifdef _WIN32
+#include <fstream>
+#include <memory>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include "src/ops/primitive_c.h"
 #include "include/model.h"
 #include "utils/log_adapter.h"
@@ -65,6 +74,38 @@ bool ConvertTensors(const schema::MetaGraph *meta_graph, Model *model) {
   }
   return true;
 }
+
+bool InitModel(Model *model) {
+  auto meta_graph = schema::GetMetaGraph(model->buf);
+  if (meta_graph == nullptr) {
+    MS_LOG(ERROR) << "meta_graph is nullptr!";
+    return false;
+  }
+
+  if (meta_graph->name() != nullptr) {
+    model->name_ = meta_graph->name()->c_str();
+  }
+  if (meta_graph->version() != nullptr) {
+    model->version_ = meta_graph->version()->c_str();
+  }
+  auto in_count = meta_graph->inputIndex()->size();
+  for (uint32_t i = 0; i < in_count; ++i) {
+    model->input_indices_.push_back(size_t(meta_graph->inputIndex()->GetAs<uint32_t>(i)));
+  }
+
+  auto out_count = meta_graph->outputIndex()->size();
+  for (uint32_t i = 0; i < out_count; ++i) {
+    model->output_indices_.push_back(size_t(meta_graph->outputIndex()->GetAs<uint32_t>(i)));
+  }
+  if (!ConvertNodes(meta_graph, model)) {
+    return false;
+  }
+
+  if (!ConvertTensors(meta_graph, model)) {
+    return false;
+  }
+  return true;
+}
 }  // namespace
 
 Model *Model::Import(const char *model_buf, size_t size) {
@@ -85,47 +126,103 @@ Model *Model::Import(const char *model_buf, size_t size) {
   model->buf = reinterpret_cast<char *>(malloc(size));
   if (model->buf == nullptr) {
     MS_LOG(ERROR) << "new inner model buf fail!";
+    delete model;
     return nullptr;
   }
   memcpy(model->buf, model_buf, size);
-  auto meta_graph = schema::GetMetaGraph(model->buf);
-  if (meta_graph == nullptr) {
-    MS_LOG(ERROR) << "meta_graph is nullptr!";
+  model->buf_size_ = size;
+  if (!InitModel(model)) {
+    delete model;
     return nullptr;
   }
+  return model;
+}
 
-  if (meta_graph->name() != nullptr) {
-    model->name_ = meta_graph->name()->c_str();
+#ifdef _WIN32
+Model *Model::ImportFromFile(const char *model_path) {
+  if (model_path == nullptr) {
+    MS_LOG(ERROR) << "The model path is nullptr";
+    return nullptr;
   }
-  if (meta_graph->version() != nullptr) {
-    model->version_ = meta_graph->version()->c_str();
+  std::ifstream ifs(model_path, std::ios::binary);
+  if (!ifs.good()) {
+    MS_LOG(ERROR) << "open model file " << model_path << " failed";
+    return nullptr;
   }
-  auto in_count = meta_graph->inputIndex()->size();
-  for (uint32_t i = 0; i < in_count; ++i) {
-    model->input_indices_.push_back(size_t(meta_graph->inputIndex()->GetAs<uint32_t>(i)));
+  ifs.seekg(0, std::ios::end);
+  size_t size = ifs.tellg();
+  std::unique_ptr<char[]> model_buf(new (std::nothrow) char[size]);
+  if (model_buf == nullptr) {
+    MS_LOG(ERROR) << "malloc model buf failed, file: " << model_path;
+    return nullptr;
   }
-
-  auto out_count = meta_graph->outputIndex()->size();
-  for (uint32_t i = 0; i < out_count; ++i) {
-    model->output_indices_.push_back(size_t(meta_graph->outputIndex()->GetAs<uint32_t>(i)));
+  ifs.seekg(0, std::ios::beg);
+  ifs.read(model_buf.get(), size);
+  return Import(model_buf.get(), size);
+}
+#else
+Model *Model::ImportFromFile(const char *model_path) {
+  if (model_path == nullptr) {
+    MS_LOG(ERROR) << "The model path is nullptr";
+    return nullptr;
   }
-  if (!ConvertNodes(meta_graph, model)) {
-    delete model;
+  int fd = open(model_path, O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "open model file " << model_path << " failed";
     return nullptr;
   }
-
-  if (!ConvertTensors(meta_graph, model)) {
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "stat model file " << model_path << " failed";
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(file_stat.st_size);
+  // a private mapping keeps the weights shared with the page cache; a kernel writing a weight in place only
+  // copies the touched pages
+  void *model_buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (model_buf == MAP_FAILED) {
+    MS_LOG(ERROR) << "mmap model file " << model_path << " failed";
+    return nullptr;
+  }
+  flatbuffers::Verifier verify(reinterpret_cast<const uint8_t *>(model_buf), size);
+  if (!schema::VerifyMetaGraphBuffer(verify)) {
+    MS_LOG(ERROR) << "The model file " << model_path << " is invalid and fail to create graph.";
+    munmap(model_buf, size);
+    return nullptr;
+  }
+  Model *model = new (std::nothrow) Model();
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "new model fail!";
+    munmap(model_buf, size);
+    return nullptr;
+  }
+  model->buf = reinterpret_cast<char *>(model_buf);
+  model->buf_size_ = size;
+  model->buf_mapped_ = true;
+  if (!InitModel(model)) {
     delete model;
     return nullptr;
   }
   return model;
 }
+#endif
 
 void Model::Free() {
-  if (this->buf != nullptr) {
-    free(this->buf);
+  if (this->buf == nullptr) {
+    return;
+  }
+#ifndef _WIN32
+  if (this->buf_mapped_) {
+    munmap(this->buf, this->buf_size_);
     this->buf = nullptr;
+    this->buf_mapped_ = false;
+    return;
   }
+#endif
+  free(this->buf);
+  this->buf = nullptr;
 }
 
 void Model::Destroy() {
@@ -21,6 +21,10 @@
 #include "src/runtime/kernel/arm/fp32/convolution_winograd.h"
 #include "nnacl/fp32/conv.h"
 #include "nnacl/common_func.h"
+#ifdef ENABLE_SSE
+#include "nnacl/nnacl_utils.h"
+#include "nnacl/x86_64/common_func_avx.h"
+#endif
 #include "schema/model_generated.h"
 #include "src/kernel_registry.h"
 #include "include/errorcode.h"
@@ -120,6 +124,8 @@ void ConvolutionCPUKernel::ConfigInputOutput() {
 
 #ifdef ENABLE_ARM32
   gemm_func_ = IndirectGemmFp32_8x4;
+#elif defined(ENABLE_SSE)
+  gemm_func_ = GetX86SimdLevel() == X86Simd_Sse ? IndirectGemmFp32_8x8 : IndirectGemmFp32_8x8Avx2;
 #else
   gemm_func_ = IndirectGemmFp32_8x8;
 #endif
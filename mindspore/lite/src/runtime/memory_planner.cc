@@ -0,0 +1,215 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/memory_planner.h"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include "include/errorcode.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr size_t kMemAlign = 64;
+// keep in line with the shiftFactor of DefaultAllocator
+constexpr size_t kAllocatorShiftFactor = 6;
+
+size_t AlignSize(size_t size) { return (size + kMemAlign - 1) / kMemAlign * kMemAlign; }
+}  // namespace
+
+MemoryPlanner::~MemoryPlanner() {
+  // tensors may be gone already, Release() is expected to be called before them
+  if (arena_ != nullptr) {
+    free(arena_);
+    arena_ = nullptr;
+  }
+}
+
+int MemoryPlanner::Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &graph_outputs) {
+  Release();
+  std::unordered_map<Tensor *, size_t> lifetime_index;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    auto kernel = kernels[i];
+    MS_ASSERT(kernel != nullptr);
+    for (auto tensor : kernel->in_tensors()) {
+      auto iter = lifetime_index.find(tensor);
+      if (iter != lifetime_index.end()) {
+        lifetimes_[iter->second].end = i;
+      }
+    }
+    for (auto tensor : kernel->out_tensors()) {
+      // tensors which already own data are left to the allocator
+      if (tensor == nullptr || tensor->category() != Tensor::Category::VAR || tensor->data_c() != nullptr ||
+          lifetime_index.find(tensor) != lifetime_index.end()) {
+        continue;
+      }
+      auto size = tensor->Size();
+      if (size == 0) {
+        continue;
+      }
+      lifetime_index[tensor] = lifetimes_.size();
+      lifetimes_.push_back({tensor, size, i, i, 0});
+    }
+  }
+  for (auto tensor : graph_outputs) {
+    auto iter = lifetime_index.find(tensor);
+    if (iter != lifetime_index.end()) {
+      lifetimes_[iter->second].end = kernels.size();
+    }
+  }
+  if (lifetimes_.empty()) {
+    return RET_OK;
+  }
+
+  AssignOffsets();
+  ComputeLivePeak(kernels.size());
+  SimulateAllocator(kernels, graph_outputs);
+
+  arena_ = malloc(arena_size_);
+  if (arena_ == nullptr) {
+    MS_LOG(ERROR) << "Malloc memory plan arena failed, size: " << arena_size_;
+    lifetimes_.clear();
+    arena_size_ = 0;
+    return RET_MEMORY_FAILED;
+  }
+  for (auto &lifetime : lifetimes_) {
+    lifetime.tensor->SetData(static_cast<char *>(arena_) + lifetime.offset);
+  }
+  return RET_OK;
+}
+
+void MemoryPlanner::Release() {
+  for (auto &lifetime : lifetimes_) {
+    lifetime.tensor->SetData(nullptr);
+  }
+  lifetimes_.clear();
+  if (arena_ != nullptr) {
+    free(arena_);
+    arena_ = nullptr;
+  }
+  arena_size_ = 0;
+  live_peak_size_ = 0;
+  allocator_size_ = 0;
+}
+
+void MemoryPlanner::AssignOffsets() {
+  std::vector<size_t> order(lifetimes_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+    if (lifetimes_[lhs].size != lifetimes_[rhs].size) {
+      return lifetimes_[lhs].size > lifetimes_[rhs].size;
+    }
+    return lifetimes_[lhs].begin < lifetimes_[rhs].begin;
+  });
+
+  std::vector<size_t> placed;
+  std::vector<std::pair<size_t, size_t>> conflicts;
+  arena_size_ = 0;
+  for (auto index : order) {
+    auto &current = lifetimes_[index];
+    auto size = AlignSize(current.size);
+    conflicts.clear();
+    for (auto other_index : placed) {
+      auto &other = lifetimes_[other_index];
+      if (other.begin <= current.end && current.begin <= other.end) {
+        conflicts.emplace_back(other.offset, other.offset + AlignSize(other.size));
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end());
+    size_t offset = 0;
+    for (auto &conflict : conflicts) {
+      if (conflict.first >= offset + size) {
+        break;
+      }
+      offset = std::max(offset, conflict.second);
+    }
+    current.offset = offset;
+    placed.emplace_back(index);
+    arena_size_ = std::max(arena_size_, offset + size);
+  }
+}
+
+void MemoryPlanner::ComputeLivePeak(size_t kernel_num) {
+  std::vector<size_t> alloc_bytes(kernel_num + 1, 0);
+  std::vector<size_t> free_bytes(kernel_num + 1, 0);
+  for (auto &lifetime : lifetimes_) {
+    alloc_bytes[lifetime.begin] += lifetime.size;
+    free_bytes[lifetime.end] += lifetime.size;
+  }
+  size_t live = 0;
+  live_peak_size_ = 0;
+  for (size_t i = 0; i <= kernel_num; ++i) {
+    live += alloc_bytes[i];
+    live_peak_size_ = std::max(live_peak_size_, live);
+    live -= free_bytes[i];
+  }
+}
+
+// Replay one Executor::Run with ref-counting on the policy of DefaultAllocator, without allocating anything.
+void MemoryPlanner::SimulateAllocator(const std::vector<kernel::LiteKernel *> &kernels,
+                                      const std::vector<Tensor *> &graph_outputs) {
+  std::unordered_map<Tensor *, size_t> tensor_size;
+  for (auto &lifetime : lifetimes_) {
+    tensor_size[lifetime.tensor] = lifetime.size;
+  }
+  std::unordered_map<Tensor *, size_t> ref_count;
+  for (auto kernel : kernels) {
+    for (auto tensor : kernel->out_tensors()) {
+      ref_count[tensor] = kernel->out_kernels().size();
+    }
+  }
+  for (auto tensor : graph_outputs) {
+    ref_count[tensor]++;
+  }
+
+  std::multiset<size_t> free_list;
+  std::unordered_map<Tensor *, size_t> buf_size;
+  allocator_size_ = 0;
+  for (auto kernel : kernels) {
+    for (auto tensor : kernel->out_tensors()) {
+      auto size_iter = tensor_size.find(tensor);
+      if (size_iter == tensor_size.end() || buf_size.find(tensor) != buf_size.end()) {
+        continue;
+      }
+      auto size = size_iter->second;
+      auto iter = free_list.lower_bound(size);
+      if (iter != free_list.end() && *iter < (size << kAllocatorShiftFactor)) {
+        buf_size[tensor] = *iter;
+        free_list.erase(iter);
+      } else {
+        buf_size[tensor] = size;
+        allocator_size_ += size;
+      }
+    }
+    for (auto input_kernel : kernel->in_kernels()) {
+      if (input_kernel->is_model_output()) {
+        continue;
+      }
+      for (auto tensor : input_kernel->out_tensors()) {
+        auto &count = ref_count[tensor];
+        count = count > 0 ? count - 1 : 0;
+        auto buf_iter = buf_size.find(tensor);
+        if (count == 0 && buf_iter != buf_size.end()) {
+          free_list.insert(buf_iter->second);
+          buf_size.erase(buf_iter);
+        }
+      }
+    }
+  }
+}
+}  // namespace mindspore::lite
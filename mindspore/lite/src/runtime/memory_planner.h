@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
+
+#include <vector>
+#include "src/lite_kernel.h"
+#include "src/tensor.h"
+
+namespace mindspore::lite {
+// Static memory plan for the activation tensors of a kernel list which is executed in order.
+// The lifetime of a tensor spans from the kernel producing it to the last kernel consuming it. Tensors whose lifetimes
+// do not overlap share memory, and all of them are packed into one arena (largest tensor first, lowest fitting offset).
+// Once planned, the tensors keep pointing into the arena, so running the kernels allocates no tensor memory at all.
+class MemoryPlanner {
+ public:
+  MemoryPlanner() = default;
+
+  ~MemoryPlanner();
+
+  // Plan and bind the out tensors of kernels. Graph output tensors stay alive until the end of the kernel list.
+  int Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &graph_outputs);
+
+  // Detach the planned tensors from the arena and free the arena.
+  void Release();
+
+  bool planned() const { return arena_ != nullptr; }
+
+  size_t tensor_num() const { return lifetimes_.size(); }
+
+  // bytes of the arena holding all planned tensors
+  size_t arena_size() const { return arena_size_; }
+
+  // max bytes of planned tensors alive at the same time, the lower bound of any plan
+  size_t live_peak_size() const { return live_peak_size_; }
+
+  // bytes the DefaultAllocator would hold for the same tensors when freeing them by ref-count
+  size_t allocator_size() const { return allocator_size_; }
+
+ private:
+  struct TensorLifetime {
+    Tensor *tensor;
+    size_t size;
+    size_t begin;
+    size_t end;
+    size_t offset;
+  };
+
+  void AssignOffsets();
+
+  void ComputeLivePeak(size_t kernel_num);
+
+  void SimulateAllocator(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<Tensor *> &graph_outputs);
+
+  std::vector<TensorLifetime> lifetimes_;
+  void *arena_ = nullptr;
+  size_t arena_size_ = 0;
+  size_t live_peak_size_ = 0;
+  size_t allocator_size_ = 0;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
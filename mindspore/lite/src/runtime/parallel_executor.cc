@@ -14,43 +14,251 @@
  * limitations under the License.
  */
 
+#include <new>
+#include <thread>
 #include <utility>
 #include "src/runtime/parallel_executor.h"
 #include "src/runtime/runtime_api.h"
 
-#define MAX_THREAD_NUM 8
 namespace mindspore::lite {
+namespace {
+// index of the queue owned by the current thread, -1 outside of ParallelExecutor::WorkerRun
+thread_local int tls_worker_id = -1;
+// the default shift factor of DefaultAllocator
+constexpr int kAllocatorShiftFactor = 6;
+// times an idle worker looks for work before it blocks
+constexpr int kIdleSpinCount = 64;
+
+int WorkerEntry(void *data, int task_id) {
+  auto executor = reinterpret_cast<ParallelExecutor *>(data);
+  return executor->WorkerRun(task_id);
+}
+
+int NestedLaunch(void *handler, int (*func)(void *, int), void *content, int task_num) {
+  auto executor = reinterpret_cast<ParallelExecutor *>(handler);
+  return executor->LaunchNested(func, content, task_num);
+}
+}  // namespace
+
 ParallelExecutor::~ParallelExecutor() {}
+
 int ParallelExecutor::Prepare(std::vector<mindspore::kernel::LiteKernel *> &kernels) {
-  int status = ConfigThreadPool(THREAD_POOL_DEFAULT, MAX_THREAD_NUM, NO_BIND);
-  if (status != 0) {
-    MS_LOG(ERROR) << "Memory error: fail to new ThreadPool";
+  // share the thread pool configured by the session, the same one kernels split their work on
+  thread_num_ = GetCurrentThreadNum(THREAD_POOL_DEFAULT);
+  if (thread_num_ < 1) {
+    thread_num_ = 1;
+  }
+  kernel_num_ = static_cast<int>(kernels.size());
+  kernel_index_.clear();
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    kernel_index_[kernels[i]] = i;
+  }
+  in_degree_.assign(kernels.size(), 0);
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    for (auto in_kernel : kernels[i]->in_kernels()) {
+      if (kernel_index_.find(in_kernel) != kernel_index_.end()) {
+        in_degree_[i]++;
+      }
+    }
+  }
+  pending_.reset(new (std::nothrow) std::atomic_int[kernels.size()]);
+  if (pending_ == nullptr) {
+    MS_LOG(ERROR) << "new pending count failed";
     return RET_ERROR;
   }
+  queues_.clear();
+  for (int i = 0; i < thread_num_; ++i) {
+    queues_.emplace_back(std::make_unique<WorkQueue>());
+  }
   return RET_OK;
 }
 
-static int RunKernel(void *data, int index) {
-  ParallelExecutor *executor = reinterpret_cast<ParallelExecutor *>(data);
-  auto kernel = executor->GetReadyKernel(index);
+bool ParallelExecutor::TakeWork(WorkQueue *queue, bool from_back, WorkItem *item) {
+  std::lock_guard<std::mutex> lock(queue->lock);
+  auto &items = queue->items;
+  while (!items.empty()) {
+    auto work = from_back ? items.back() : items.front();
+    // a nested task stays queued until all its jobs are taken, users keeps it alive while a job runs
+    bool keep = work.kernel == nullptr && work.task->next < work.task->task_num;
+    if (!keep) {
+      if (from_back) {
+        items.pop_back();
+      } else {
+        items.pop_front();
+      }
+      if (work.kernel == nullptr) {
+        continue;
+      }
+    } else {
+      work.task->users++;
+    }
+    *item = work;
+    return true;
+  }
+  return false;
+}
+
+bool ParallelExecutor::PopWork(int worker_id, WorkItem *item) {
+  if (TakeWork(queues_[worker_id].get(), true, item)) {
+    return true;
+  }
+  for (int i = 1; i < thread_num_; ++i) {
+    if (TakeWork(queues_[(worker_id + i) % thread_num_].get(), false, item)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParallelExecutor::RunNestedTask(NestedTask *task) {
+  auto index = task->next.fetch_add(1);
+  if (index < task->task_num) {
+    auto ret = task->func(task->content, index);
+    if (ret != 0) {
+      task->ret = ret;
+    }
+    task->done++;
+  }
+  task->users--;
+}
+
+int ParallelExecutor::LaunchNested(int (*func)(void *, int), void *content, int task_num) {
+  auto worker_id = tls_worker_id;
+  if (worker_id < 0 || thread_num_ <= 1 || task_num <= 1) {
+    int result = RET_OK;
+    for (int i = 0; i < task_num; ++i) {
+      auto ret = func(content, i);
+      result = ret != 0 ? ret : result;
+    }
+    return result;
+  }
+  NestedTask task;
+  task.func = func;
+  task.content = content;
+  task.task_num = task_num;
+  auto queue = queues_[worker_id].get();
+  {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    queue->items.push_back({nullptr, &task});
+  }
+  NotifyWork();
+  int index;
+  while ((index = task.next.fetch_add(1)) < task_num) {
+    auto ret = func(content, index);
+    if (ret != 0) {
+      task.ret = ret;
+    }
+    task.done++;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    for (auto iter = queue->items.begin(); iter != queue->items.end(); ++iter) {
+      if (iter->task == &task) {
+        queue->items.erase(iter);
+        break;
+      }
+    }
+  }
+  while (task.done < task_num || task.users > 0) {
+    std::this_thread::yield();
+  }
+  return task.ret;
+}
+
+void ParallelExecutor::RunKernel(kernel::LiteKernel *kernel, int worker_id) {
+  if (before_ != nullptr && *before_ != nullptr) {
+    std::lock_guard<std::mutex> lock(callback_lock_);
+    if (!(*before_)(TensorVectorCast(kernel->in_tensors()), TensorVectorCast(kernel->out_tensors()),
+                    {kernel->name(), kernel->type_str()})) {
+      MS_LOG(ERROR) << "run kernel before_callback failed, name: " << kernel->name();
+    }
+  }
   auto ret = kernel->Run();
-  executor->SetResult(index, ret);
   if (0 != ret) {
     MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
-    return 0;
+    failed_ = true;
+    NotifyWork();
+    return;
+  }
+  if (after_ != nullptr && *after_ != nullptr) {
+    std::lock_guard<std::mutex> lock(callback_lock_);
+    if (!(*after_)(TensorVectorCast(kernel->in_tensors()), TensorVectorCast(kernel->out_tensors()),
+                   {kernel->name(), kernel->type_str()})) {
+      MS_LOG(ERROR) << "run kernel after_callback failed, name: " << kernel->name();
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(ref_count_lock_);
+    for (auto input_kernel : kernel->in_kernels()) {
+      MS_ASSERT(input_kernel != nullptr);
+      if (input_kernel->is_model_output()) {
+        continue;
+      }
+      ret = input_kernel->DecOutTensorRefCount();
+      if (0 != ret) {
+        MS_LOG(WARNING) << "DecOutTensorRefCount for kernel" << kernel->name() << " failed";
+      }
+    }
   }
+  // the thread finishing the last producer of a kernel runs it next unless it is stolen
+  bool pushed = false;
+  for (auto out_kernel : kernel->out_kernels()) {
+    auto iter = kernel_index_.find(out_kernel);
+    if (iter == kernel_index_.end()) {
+      continue;
+    }
+    if (pending_[iter->second].fetch_sub(1) == 1) {
+      auto queue = queues_[worker_id].get();
+      std::lock_guard<std::mutex> lock(queue->lock);
+      queue->items.push_back({out_kernel, nullptr});
+      pushed = true;
+    }
+  }
+  if (++finished_ == kernel_num_ || pushed) {
+    NotifyWork();
+  }
+}
+
+void ParallelExecutor::NotifyWork() {
+  work_version_++;
+  if (idle_num_ > 0) {
+    // the lock orders the notification after the check of a worker about to wait
+    { std::lock_guard<std::mutex> lock(idle_lock_); }
+    idle_cond_.notify_all();
+  }
+}
+
+void ParallelExecutor::WaitWork(uint64_t version) {
+  std::unique_lock<std::mutex> lock(idle_lock_);
+  idle_num_++;
+  idle_cond_.wait(lock, [this, version] { return work_version_ != version || finished_ >= kernel_num_ || failed_; });
+  idle_num_--;
+}
 
-  for (auto input_kernel : kernel->in_kernels()) {
-    MS_ASSERT(input_kernel != nullptr);
-    if (input_kernel->is_model_output()) {
+int ParallelExecutor::WorkerRun(int worker_id) {
+  tls_worker_id = worker_id;
+  WorkItem item;
+  int spin_count = 0;
+  while (finished_ < kernel_num_ && !failed_) {
+    uint64_t version = work_version_;
+    if (!PopWork(worker_id, &item)) {
+      if (++spin_count < kIdleSpinCount) {
+        std::this_thread::yield();
+      } else {
+        WaitWork(version);
+        spin_count = 0;
+      }
       continue;
     }
-    ret = input_kernel->DecOutTensorRefCount();
-    if (0 != ret) {
-      MS_LOG(WARNING) << "DecOutTensorRefCount for kernel" << kernel->name() << " failed";
+    spin_count = 0;
+    if (item.kernel != nullptr) {
+      RunKernel(item.kernel, worker_id);
+    } else {
+      RunNestedTask(item.task);
     }
   }
-  return 0;
+  tls_worker_id = -1;
+  return RET_OK;
 }
 
 int ParallelExecutor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
@@ -67,54 +275,55 @@ int ParallelExecutor::Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor
       return RET_ERROR;
     }
   }
+  if (static_cast<int>(kernels.size()) != kernel_num_ || pending_ == nullptr) {
+    auto ret = Prepare(kernels);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Prepare parallel executor failed";
+      return ret;
+    }
+  }
+  if (kernels.empty()) {
+    return RET_OK;
+  }
+  if (allocator != nullptr) {
+    // kernels malloc and free tensors concurrently
+    allocator->SetContext({kAllocatorShiftFactor, true});
+  }
   kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+  for (auto out_tensor : out_tensors) {  // increase RefCount of output tensors, such that Run will not free them
+    out_tensor->SetRefCount(out_tensor->RefCount() + 1);
+  }
 
-  for (auto kernel : kernels) {
-    if (kernel->in_kernels().size() == 0) {
-      readyKernels.emplace_back(kernel);
-      continue;
+  size_t ready_num = 0;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    pending_[i] = in_degree_[i];
+    if (in_degree_[i] == 0) {
+      queues_[ready_num % thread_num_]->items.push_back({kernels[i], nullptr});
+      ready_num++;
     }
-    refCount[kernel] = kernel->in_kernels().size();
   }
-  std::vector<kernel::LiteKernel *> newReadyKernels;
-  while (readyKernels.size() > 0) {
-    results.resize(readyKernels.size(), RET_OK);
-    ParallelLaunch(THREAD_POOL_DEFAULT, RunKernel, this, readyKernels.size());
+  if (ready_num == 0) {
+    MS_LOG(ERROR) << "No kernel is ready to run, the graph has a cycle";
+    return RET_ERROR;
+  }
+  finished_ = 0;
+  failed_ = false;
+  before_ = &before;
+  after_ = &after;
 
-    if (std::find_if(results.begin(), results.end(), [](const int &ret) { return (ret != 0); }) != results.end()) {
-      return RET_ERROR;
-    }
-    newReadyKernels.clear();
-    for (auto completed : readyKernels) {
-      for (auto out : completed->out_kernels()) {
-        auto iter = refCount.find(out);
-        if (iter == refCount.end()) {
-          continue;
-        }
-        (iter->second)--;
-        if (iter->second <= 0) {
-          newReadyKernels.emplace_back(iter->first);
-          refCount.erase(iter);
-        }
-      }
+  SetNestedLaunchHandler(THREAD_POOL_DEFAULT, NestedLaunch, this);
+  auto ret = ParallelLaunch(THREAD_POOL_DEFAULT, WorkerEntry, this, thread_num_);
+  SetNestedLaunchHandler(THREAD_POOL_DEFAULT, nullptr, nullptr);
 
-      for (auto input_kernel : completed->in_kernels()) {
-        MS_ASSERT(input_kernel != nullptr);
-        if (input_kernel->is_model_output()) {
-          continue;
-        }
-        auto ret = input_kernel->DecOutTensorRefCount();
-        if (0 != ret) {
-          MS_LOG(WARNING) << "DecOutTensorRefCount for kernel" << completed->name() << " failed";
-          return -1;
-        }
-      }
-    }
-    readyKernels.clear();
-    readyKernels = std::move(newReadyKernels);
+  before_ = nullptr;
+  after_ = nullptr;
+  for (auto &queue : queues_) {
+    queue->items.clear();
+  }
+  if (ret != 0 || failed_) {
+    MS_LOG(ERROR) << "Run graph failed";
+    return RET_ERROR;
   }
-
   return RET_OK;
 }
-
 }  // namespace mindspore::lite
@@ -17,6 +17,11 @@
 #ifndef MINDSPORE_LITE_PARALLEL_EXECUTOR_H_
 #define MINDSPORE_LITE_PARALLEL_EXECUTOR_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include "src/runtime/allocator.h"
@@ -25,6 +30,10 @@
 #include "src/executor.h"
 
 namespace mindspore::lite {
+// Runs independent kernels of a graph concurrently on the default thread pool.
+// Every thread of the pool owns a queue of ready kernels. A kernel is pushed to the queue of the thread finishing its
+// last producer, and idle threads steal from the other queues. ParallelLaunch issued by a running kernel is turned into
+// tasks of the same queues, so intra-op parallelism uses the threads left idle by the graph.
 class ParallelExecutor : public Executor {
  public:
   ParallelExecutor() = default;
@@ -35,13 +44,66 @@ class ParallelExecutor : public Executor {
   int Run(std::vector<Tensor *> &in_tensors, std::vector<Tensor *> &out_tensors,
           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
           const session::KernelCallBack &before = nullptr, const session::KernelCallBack &after = nullptr) override;
-  inline kernel::LiteKernel *GetReadyKernel(const int index) { return readyKernels.at(index); }
-  inline void SetResult(const int index, const int result) { results.at(index) = result; }
+
+  // kernels run concurrently, which a sequential memory plan does not account for
+  bool SupportMemoryPlan() const override { return false; }
+
+  int WorkerRun(int worker_id);
+
+  int LaunchNested(int (*func)(void *, int), void *content, int task_num);
 
  private:
-  std::unordered_map<kernel::LiteKernel *, size_t> refCount;
-  std::vector<kernel::LiteKernel *> readyKernels;
-  std::vector<int> results;
+  // jobs of one ParallelLaunch issued by a running kernel
+  struct NestedTask {
+    int (*func)(void *, int);
+    void *content;
+    int task_num;
+    std::atomic_int next{0};
+    std::atomic_int done{0};
+    std::atomic_int users{0};
+    std::atomic_int ret{0};
+  };
+
+  struct WorkItem {
+    kernel::LiteKernel *kernel;
+    NestedTask *task;
+  };
+
+  struct WorkQueue {
+    std::mutex lock;
+    std::deque<WorkItem> items;
+  };
+
+  bool TakeWork(WorkQueue *queue, bool from_back, WorkItem *item);
+
+  bool PopWork(int worker_id, WorkItem *item);
+
+  void RunNestedTask(NestedTask *task);
+
+  void RunKernel(kernel::LiteKernel *kernel, int worker_id);
+
+  // wakes up the idle workers after work is queued or the graph is done
+  void NotifyWork();
+
+  // blocks an idle worker until work is queued after version or the graph is done
+  void WaitWork(uint64_t version);
+
+  int thread_num_ = 1;
+  std::unordered_map<kernel::LiteKernel *, size_t> kernel_index_;
+  std::vector<int> in_degree_;
+  std::unique_ptr<std::atomic_int[]> pending_;
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::atomic_int finished_{0};
+  std::atomic_bool failed_{false};
+  std::atomic_uint64_t work_version_{0};
+  std::atomic_int idle_num_{0};
+  std::mutex idle_lock_;
+  std::condition_variable idle_cond_;
+  int kernel_num_ = 0;
+  std::mutex ref_count_lock_;
+  std::mutex callback_lock_;
+  const session::KernelCallBack *before_ = nullptr;
+  const session::KernelCallBack *after_ = nullptr;
 };
 
 }  // namespace mindspore::lite
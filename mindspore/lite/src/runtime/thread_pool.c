@@ -79,11 +79,15 @@ typedef struct ThreadPool {
   int thread_num;
   BindMode mode;
   atomic_bool is_alive;
+  NestedLaunchFunc nested_launch;
+  void *nested_handler;
 } ThreadPool;
 
 static ThreadPool thread_pool_list[MAX_THREAD_POOL_NUM];
 static atomic_int thread_pool_refcount[MAX_THREAD_POOL_NUM] = {ATOMIC_VAR_INIT(0)};
 static atomic_bool thread_pool_is_created[MAX_THREAD_POOL_NUM] = {ATOMIC_VAR_INIT(false)};
+// > 0 while the current thread is running a task of a thread pool
+static __thread int task_depth = 0;
 
 ThreadPool *GetInstance(int thread_pool_id) {
   if (thread_pool_id < 0 || thread_pool_id >= MAX_THREAD_POOL_NUM) {
@@ -502,7 +506,9 @@ int DistributeTask(int thread_pool_id, Task *task, int task_num) {
     LOG_ERROR("task->func is nullptr");
     return RET_TP_ERROR;
   }
+  task_depth++;
   task->func(task->content, size - 1);
+  task_depth--;
   // wait
   WaitAllThread(thread_pool_id);
   return RET_TP_OK;
@@ -514,6 +520,16 @@ int AddTask(int thread_pool_id, int func(void *, int), void *content, int task_n
     LOG_ERROR("get thread pool instane failed");
     return RET_TP_ERROR;
   }
+  // launched from a task of the pool, the other threads may be busy running tasks themselves, never wait for them
+  if (task_depth > 0) {
+    if (thread_pool->nested_launch != NULL) {
+      return thread_pool->nested_launch(thread_pool->nested_handler, func, content, task_num);
+    }
+    for (int i = 0; i < task_num; ++i) {
+      func(content, i);
+    }
+    return RET_TP_OK;
+  }
   // if single thread, run master thread
   if (thread_pool->thread_num <= 1 || task_num <= 1) {
     for (int i = 0; i < task_num; ++i) {
@@ -531,6 +547,16 @@ int ParallelLaunch(int thread_pool_id, int (*func)(void *, int), void *content,
   return AddTask(thread_pool_id, func, content, task_num);
 }
 
+void SetNestedLaunchHandler(int thread_pool_id, NestedLaunchFunc func, void *handler) {
+  ThreadPool *thread_pool = GetInstance(thread_pool_id);
+  if (thread_pool == NULL) {
+    LOG_ERROR("get thread pool instane failed");
+    return;
+  }
+  thread_pool->nested_handler = handler;
+  thread_pool->nested_launch = func;
+}
+
 void ThreadRun(Thread *thread) {
   ThreadPool *thread_pool = GetInstance(thread->thread_pool_id);
   if (thread_pool == NULL) {
@@ -548,7 +574,9 @@ void ThreadRun(Thread *thread) {
           LOG_ERROR("task->func is nullptr");
           return;
         }
+        task_depth++;
         task->func(task->content, thread_id);
+        task_depth--;
         atomic_fetch_sub_explicit(&thread->task_size, 1, memory_order_relaxed);
         spin_count = 0;
         sem_trywait(&thread->sem);
@@ -34,6 +34,9 @@ typedef enum {
   THREAD_POOL_FOURTH = 3   /**< the fourth thread pool id */
 } ThreadPoolId;
 
+/// \brief NestedLaunchFunc defined for running a ParallelLaunch issued from inside a task of the thread pool.
+typedef int (*NestedLaunchFunc)(void *handler, int (*job)(void *, int), void *content, int task_num);
+
 /**
  * create thread pool and init
  * @param thread_num
@@ -50,6 +53,15 @@ int ConfigThreadPool(int thread_pool_id, int thread_num, int mode);
  */
 int ParallelLaunch(int thread_pool_id, int (*job)(void *, int), void *content, int task_num);
 
+/**
+ * set the handler of ParallelLaunch issued from inside a task of the thread pool, such as a kernel run by a
+ * graph-level executor. Without a handler, such launches run their jobs in the calling thread.
+ * @param thread_pool_id
+ * @param func, NULL to reset
+ * @param handler
+ */
+void SetNestedLaunchHandler(int thread_pool_id, NestedLaunchFunc func, void *handler);
+
 /**
  * bind each thread to specified cpu core
  * @param is_bind
@@ -15,7 +15,11 @@
  */
 
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 #include "mindspore/lite/schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
@@ -24,6 +28,7 @@
 #include "include/errorcode.h"
 #include "mindspore/core/utils/log_adapter.h"
 #include "src/lite_session.h"
+#include "src/common/utils.h"
 #include "src/runtime/parallel_executor.h"
 
 namespace mindspore {
@@ -244,6 +249,95 @@ TEST_F(InferTest, TestAddNode) {
   MS_LOG(INFO) << "Passed";
 }
 
+TEST_F(InferTest, TestImportFromFile) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  auto primitive = new schema::AddT;
+  node->primitive->value.value = primitive;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input0 = std::make_unique<schema::TensorT>();
+  input0->nodeType = schema::NodeType::NodeType_Parameter;
+  input0->format = schema::Format_NHWC;
+  input0->dataType = TypeId::kNumberTypeFloat32;
+  input0->dims = {1, 4, 4, 3};
+  input0->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input0));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = schema::NodeType::NodeType_ValueNode;
+  weight->format = schema::Format_NHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {1, 4, 4, 3};
+  weight->data.resize(4 * 4 * 3 * sizeof(float));
+  auto weight_data = reinterpret_cast<float *>(weight->data.data());
+  for (int i = 0; i < 4 * 4 * 3; i++) {
+    weight_data[i] = static_cast<float>(i);
+  }
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  std::string model_path = "./test_import_from_file.ms";
+  std::ofstream ofs(model_path, std::ios::binary);
+  ASSERT_TRUE(ofs.good());
+  ofs.write(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  ofs.close();
+
+  auto model = lite::Model::ImportFromFile(model_path.c_str());
+  ASSERT_NE(nullptr, model);
+#ifndef _WIN32
+  ASSERT_TRUE(model->buf_mapped_);
+#endif
+  ASSERT_EQ(builder.GetSize(), model->buf_size_);
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_type_ = lite::DT_CPU;
+  context->thread_num_ = 1;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  auto in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  ASSERT_NE(nullptr, in_data);
+  for (int i = 0; i < 4 * 4 * 3; i++) {
+    in_data[i] = 1.0f;
+  }
+  ret = session->RunGraph();
+  ASSERT_EQ(lite::RET_OK, ret);
+  auto outputs = session->GetOutputs();
+  ASSERT_EQ(outputs.size(), 1);
+  auto out_data = reinterpret_cast<float *>(outputs.begin()->second->MutableData());
+  ASSERT_NE(nullptr, out_data);
+  for (int i = 0; i < 4 * 4 * 3; i++) {
+    ASSERT_EQ(static_cast<float>(i) + 1.0f, out_data[i]);
+  }
+  delete session;
+  delete context;
+  delete model;
+  remove(model_path.c_str());
+}
+
 class SessionWithParallelExecutor : public lite::LiteSession {
  public:
   int Init(lite::Context *context) {
@@ -334,6 +428,115 @@ TEST_F(InferTest, TestParallelExecutor) {
   MS_LOG(INFO) << "Passed";
 }
 
+// a model of branch_num independent chains of Add, like the heads of a detection model
+static lite::Model *BuildBranchModel(int branch_num, int branch_depth, const std::vector<int> &dims) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  int element_num = 1;
+  for (auto dim : dims) {
+    element_num *= dim;
+  }
+  auto add_tensor = [&](schema::NodeType node_type, bool with_data) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = node_type;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    tensor->dims = dims;
+    tensor->offset = -1;
+    if (with_data) {
+      tensor->data.resize(element_num * sizeof(float));
+      auto data = reinterpret_cast<float *>(tensor->data.data());
+      for (int i = 0; i < element_num; i++) {
+        data[i] = static_cast<float>(meta_graph->allTensors.size() % 7) * 0.1f;
+      }
+    }
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+    return static_cast<uint32_t>(meta_graph->allTensors.size() - 1);
+  };
+  auto input = add_tensor(schema::NodeType::NodeType_Parameter, false);
+  meta_graph->inputIndex = {input};
+  for (int branch = 0; branch < branch_num; branch++) {
+    auto prev = input;
+    for (int depth = 0; depth < branch_depth; depth++) {
+      auto weight = add_tensor(schema::NodeType::NodeType_ValueNode, true);
+      auto output = add_tensor(schema::NodeType::NodeType_Parameter, false);
+      auto node = std::make_unique<schema::CNodeT>();
+      node->inputIndex = {prev, weight};
+      node->outputIndex = {output};
+      node->primitive = std::make_unique<schema::PrimitiveT>();
+      node->primitive->value.type = schema::PrimitiveType_Add;
+      node->primitive->value.value = new schema::AddT;
+      node->name = "Add_" + std::to_string(branch) + "_" + std::to_string(depth);
+      meta_graph->nodes.emplace_back(std::move(node));
+      prev = output;
+    }
+    meta_graph->outputIndex.emplace_back(prev);
+  }
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  return lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+static float RunBranchModel(lite::LiteSession *session, int loop_count, std::vector<float> *result) {
+  auto inputs = session->GetInputs();
+  auto in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  for (int i = 0; i < inputs.front()->ElementsNum(); i++) {
+    in_data[i] = static_cast<float>(i % 11);
+  }
+  auto time_start = lite::GetTimeUs();
+  for (int i = 0; i < loop_count; i++) {
+    if (session->RunGraph() != lite::RET_OK) {
+      return -1.0f;
+    }
+  }
+  auto time_end = lite::GetTimeUs();
+  result->clear();
+  for (auto &name : session->GetOutputTensorNames()) {
+    auto tensor = session->GetOutputByTensorName(name);
+    auto data = reinterpret_cast<float *>(tensor->MutableData());
+    result->insert(result->end(), data, data + tensor->ElementsNum());
+  }
+  return (time_end - time_start) / loop_count / 1000.0f;
+}
+
+TEST_F(InferTest, TestParallelExecutorBenchmark) {
+  const int branch_num = 6, branch_depth = 8, loop_count = 10;
+  // model buffer is freed by CompileGraph, each session needs its own model
+  auto model = BuildBranchModel(branch_num, branch_depth, {1, 64, 64, 32});
+  ASSERT_NE(nullptr, model);
+  auto parallel_model = BuildBranchModel(branch_num, branch_depth, {1, 64, 64, 32});
+  ASSERT_NE(nullptr, parallel_model);
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_type_ = lite::DT_CPU;
+  context->thread_num_ = 4;
+
+  auto session = new lite::LiteSession();
+  ASSERT_EQ(lite::RET_OK, session->Init(context));
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model));
+  auto parallel_session = new SessionWithParallelExecutor();
+  ASSERT_EQ(lite::RET_OK, parallel_session->Init(context));
+  ASSERT_EQ(lite::RET_OK, parallel_session->CompileGraph(parallel_model));
+
+  std::vector<float> expect;
+  std::vector<float> output;
+  auto sequential_time = RunBranchModel(session, loop_count, &expect);
+  ASSERT_GE(sequential_time, 0.0f);
+  auto parallel_time = RunBranchModel(parallel_session, loop_count, &output);
+  ASSERT_GE(parallel_time, 0.0f);
+  ASSERT_EQ(expect.size(), output.size());
+  CompareOutputData(output.data(), expect.data(), output.size(), 0.0001);
+  printf("%d branches of %d Add, Executor average time: %f ms, ParallelExecutor average time: %f ms\n", branch_num,
+         branch_depth, sequential_time, parallel_time);
+
+  delete session;
+  delete parallel_session;
+  delete context;
+  delete model;
+  delete parallel_model;
+}
+
 TEST_F(InferTest, TestModel) {
   auto buf = new char *[1];
   size_t model_size;
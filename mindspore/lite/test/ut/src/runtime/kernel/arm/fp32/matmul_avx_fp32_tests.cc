@@ -0,0 +1,196 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_SSE
+#include <iostream>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "src/common/utils.h"
+#include "mindspore/lite/nnacl/nnacl_utils.h"
+#include "mindspore/lite/nnacl/matmul_parameter.h"
+#include "mindspore/lite/nnacl/fp32/matmul.h"
+#include "mindspore/lite/nnacl/common_func.h"
+#include "mindspore/lite/nnacl/x86_64/common_func_avx.h"
+#include "mindspore/lite/nnacl/x86_64/matmul_avx.h"
+#include "mindspore/lite/nnacl/x86_64/conv_depthwise_avx.h"
+
+namespace mindspore {
+class TestMatMulAvxFp32 : public mindspore::CommonTest {
+ public:
+  TestMatMulAvxFp32() {}
+};
+
+typedef void (*MatmulFunc)(const float *a, const float *b, float *c, const float *bias, int act_type, int deep,
+                           int row, int col, size_t stride, int out_type);
+
+static void RandomFill(std::vector<float> *data, std::mt19937 *gen) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  for (auto &value : *data) {
+    value = dist(*gen);
+  }
+}
+
+static void CompareWithReference(MatmulFunc func, int row, int col, int deep, int out_type, int act_type) {
+  std::mt19937 gen(row * 131 + col * 17 + deep);
+  int row_12 = UP_ROUND(row, C12NUM);
+  int col_8 = UP_ROUND(col, C8NUM);
+  std::vector<float> a(row_12 * deep, 0.0f);
+  std::vector<float> b(col_8 * deep, 0.0f);
+  std::vector<float> bias(col_8, 0.0f);
+  RandomFill(&a, &gen);
+  RandomFill(&b, &gen);
+  RandomFill(&bias, &gen);
+  size_t stride = out_type == OutType_TileC8 ? 3 : col + 1;
+  size_t out_size = static_cast<size_t>(row_12) * col_8 * 4;
+  std::vector<float> expect(out_size, 0.0f);
+  std::vector<float> output(out_size, 0.0f);
+  MatMul12x8(a.data(), b.data(), expect.data(), bias.data(), static_cast<ActType>(act_type), deep, row, col, stride,
+             out_type);
+  func(a.data(), b.data(), output.data(), bias.data(), act_type, deep, row, col, stride, out_type);
+  CommonTest::CompareOutputData(output.data(), expect.data(), out_size, 0.0001);
+}
+
+static void CompareAllShapes(MatmulFunc func) {
+  int shapes[][3] = {{1, 1, 1}, {12, 8, 16}, {13, 9, 7}, {7, 23, 33}, {36, 40, 64}, {37, 17, 5}};
+  for (auto &shape : shapes) {
+    for (int act_type = ActType_No; act_type <= ActType_Relu6; ++act_type) {
+      CompareWithReference(func, shape[0], shape[1], shape[2], OutType_Nhwc, act_type);
+      CompareWithReference(func, shape[0], shape[1], shape[2], OutType_C8, act_type);
+      // the tile-c8 output is only produced for a single 12-row block (winograd gemm)
+      if (shape[0] <= C12NUM) {
+        CompareWithReference(func, shape[0], shape[1], shape[2], OutType_TileC8, act_type);
+      }
+    }
+  }
+}
+
+TEST_F(TestMatMulAvxFp32, MatmulAvx2) {
+  if (GetX86SimdLevel() < X86Simd_Avx2Fma) {
+    std::cout << "cpu does not support avx2/fma, skip" << std::endl;
+    return;
+  }
+  CompareAllShapes(MatmulFloatAvx2);
+}
+
+TEST_F(TestMatMulAvxFp32, MatmulAvx512) {
+  if (GetX86SimdLevel() < X86Simd_Avx512) {
+    std::cout << "cpu does not support avx512, skip" << std::endl;
+    return;
+  }
+  CompareAllShapes(MatmulFloatAvx512);
+}
+
+TEST_F(TestMatMulAvxFp32, ConvDwCenterAvx2) {
+  if (GetX86SimdLevel() < X86Simd_Avx2Fma) {
+    std::cout << "cpu does not support avx2/fma, skip" << std::endl;
+    return;
+  }
+  const int height = 5, width = 7, kernel_h = 3, kernel_w = 3, block_channel = 12, in_w = 20;
+  const int out_h_step = width * block_channel, in_sw_step = 2 * block_channel, in_kw_step = block_channel;
+  const int in_kh_step = in_w * block_channel, in_sh_step = 2 * in_kh_step;
+  std::mt19937 gen(7);
+  std::vector<float> src(in_w * in_w * block_channel);
+  std::vector<float> weight(kernel_h * kernel_w * C4NUM);
+  std::vector<float> bias(C4NUM);
+  RandomFill(&src, &gen);
+  RandomFill(&weight, &gen);
+  RandomFill(&bias, &gen);
+  for (int act = 0; act < 3; ++act) {
+    bool relu = act == 1;
+    bool relu6 = act == 2;
+    std::vector<float> expect(height * out_h_step, 0.0f);
+    std::vector<float> output(height * out_h_step, 0.0f);
+    for (int oh = 0; oh < height; ++oh) {
+      for (int ow = 0; ow < width; ++ow) {
+        for (int c = 0; c < C4NUM; ++c) {
+          float value = 0;
+          for (int kh = 0; kh < kernel_h; ++kh) {
+            for (int kw = 0; kw < kernel_w; ++kw) {
+              value += src[oh * in_sh_step + ow * in_sw_step + kh * in_kh_step + kw * in_kw_step + c] *
+                       weight[(kh * kernel_w + kw) * C4NUM + c];
+            }
+          }
+          value += bias[c];
+          value = (relu || relu6) ? MSMAX(0.0f, value) : value;
+          value = relu6 ? MSMIN(6.0f, value) : value;
+          expect[oh * out_h_step + ow * block_channel + c] = value;
+        }
+      }
+    }
+    ConvDwFp32CenterAvx2(output.data(), src.data(), weight.data(), bias.data(), height, width, kernel_h, kernel_w,
+                         out_h_step, block_channel, in_sh_step, in_sw_step, in_kh_step, in_kw_step, relu, relu6);
+    CompareOutputData(output.data(), expect.data(), height * out_h_step, 0.0001);
+  }
+}
+
+// The gemm of ConvFp32: a tile of 8 output pixels, of step kernel points and ic4 blocks of 4 input channels each.
+TEST_F(TestMatMulAvxFp32, IndirectGemmAvx2) {
+  if (GetX86SimdLevel() < X86Simd_Avx2Fma) {
+    std::cout << "cpu does not support avx2/fma, skip" << std::endl;
+    return;
+  }
+  int shapes[][3] = {{1, 1, 1}, {9, 1, 8}, {9, 3, 13}, {1, 16, 64}, {4, 2, 30}};
+  for (auto &shape : shapes) {
+    size_t step = shape[0], ic4 = shape[1], oc = shape[2];
+    std::mt19937 gen(step * 131 + ic4 * 17 + oc);
+    std::vector<float> input(step * ic4 * C4NUM * TILE_NUM);
+    std::vector<float> weight(UP_ROUND(oc, C8NUM) * step * ic4 * C4NUM);
+    std::vector<float> bias(UP_ROUND(oc, C8NUM));
+    RandomFill(&input, &gen);
+    RandomFill(&weight, &gen);
+    RandomFill(&bias, &gen);
+    for (int act = 0; act < 3; ++act) {
+      size_t relu = act == 1;
+      size_t relu6 = act == 2;
+      std::vector<float> expect(TILE_NUM * oc, 0.0f);
+      std::vector<float> output(TILE_NUM * oc, 0.0f);
+      IndirectGemmFp32_8x8(expect.data(), input.data(), weight.data(), bias.data(), step, ic4, oc, oc * sizeof(float),
+                           0, 0, relu, relu6);
+      IndirectGemmFp32_8x8Avx2(output.data(), input.data(), weight.data(), bias.data(), step, ic4, oc,
+                               oc * sizeof(float), 0, 0, relu, relu6);
+      CompareOutputData(output.data(), expect.data(), TILE_NUM * oc, 0.0001);
+    }
+  }
+}
+
+TEST_F(TestMatMulAvxFp32, MatmulBenchmark) {
+  const int row = 12 * 32, col = 256, deep = 256, loop_count = 10;
+  std::mt19937 gen(1);
+  std::vector<float> a(row * deep);
+  std::vector<float> b(col * deep);
+  std::vector<float> bias(col);
+  std::vector<float> output(row * col);
+  RandomFill(&a, &gen);
+  RandomFill(&b, &gen);
+  RandomFill(&bias, &gen);
+
+  auto time_start = mindspore::lite::GetTimeUs();
+  for (int i = 0; i < loop_count; i++) {
+    MatMul12x8(a.data(), b.data(), output.data(), bias.data(), ActType_No, deep, row, col, col, OutType_Nhwc);
+  }
+  auto time_end = mindspore::lite::GetTimeUs();
+  printf("MatMul12x8 c reference average time : %f ms\n", (time_end - time_start) / loop_count / 1000.0f);
+
+  time_start = mindspore::lite::GetTimeUs();
+  for (int i = 0; i < loop_count; i++) {
+    MatMulOpt(a.data(), b.data(), output.data(), bias.data(), ActType_No, deep, row, col, col, OutType_Nhwc);
+  }
+  time_end = mindspore::lite::GetTimeUs();
+  printf("MatMulOpt simd level %d average time : %f ms\n", static_cast<int>(GetX86SimdLevel()),
+         (time_end - time_start) / loop_count / 1000.0f);
+}
+}  // namespace mindspore
+#endif
@@ -0,0 +1,130 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "mindspore/lite/src/lite_kernel.h"
+#include "mindspore/lite/src/runtime/memory_planner.h"
+
+namespace mindspore {
+class MemoryPlannerTest : public mindspore::CommonTest {
+ public:
+  MemoryPlannerTest() {}
+};
+
+static bool Overlap(lite::Tensor *lhs, lite::Tensor *rhs) {
+  auto lhs_begin = reinterpret_cast<char *>(lhs->data_c());
+  auto rhs_begin = reinterpret_cast<char *>(rhs->data_c());
+  return lhs_begin < rhs_begin + rhs->Size() && rhs_begin < lhs_begin + lhs->Size();
+}
+
+static void Connect(kernel::LiteKernel *from, kernel::LiteKernel *to) {
+  from->AddOutKernel(to);
+  to->AddInKernel(from);
+}
+
+TEST_F(MemoryPlannerTest, TestPlan) {
+  // kernel0 -> tensor0 -> kernel1 -> tensor1 -> kernel3 -> tensor3
+  //                    -> kernel2 -> tensor2 ->
+  //                                             kernel4 -> tensor4 -> kernel5 -> tensor5
+  auto input = std::make_shared<lite::Tensor>(kNumberTypeFloat32, std::vector<int>{1, 8, 8, 16});
+  std::vector<std::shared_ptr<lite::Tensor>> tensors;
+  std::vector<int> channels = {16, 32, 32, 8, 64, 8};
+  for (auto channel : channels) {
+    tensors.emplace_back(std::make_shared<lite::Tensor>(kNumberTypeFloat32, std::vector<int>{1, 8, 8, channel}));
+  }
+  std::vector<std::shared_ptr<kernel::LiteKernel>> kernels_holder;
+  std::vector<kernel::LiteKernel *> kernels;
+  for (size_t i = 0; i < channels.size(); ++i) {
+    kernels_holder.emplace_back(std::make_shared<kernel::LiteKernel>());
+    kernels.emplace_back(kernels_holder.back().get());
+    kernels.back()->set_out_tensors({tensors[i].get()});
+  }
+  kernels[0]->set_in_tensors({input.get()});
+  kernels[1]->set_in_tensors({tensors[0].get()});
+  kernels[2]->set_in_tensors({tensors[0].get()});
+  kernels[3]->set_in_tensors({tensors[1].get(), tensors[2].get()});
+  kernels[4]->set_in_tensors({tensors[3].get()});
+  kernels[5]->set_in_tensors({tensors[4].get()});
+  Connect(kernels[0], kernels[1]);
+  Connect(kernels[0], kernels[2]);
+  Connect(kernels[1], kernels[3]);
+  Connect(kernels[2], kernels[3]);
+  Connect(kernels[3], kernels[4]);
+  Connect(kernels[4], kernels[5]);
+  kernels[5]->set_is_model_output(true);
+
+  lite::MemoryPlanner planner;
+  auto ret = planner.Plan(kernels, {tensors[5].get()});
+  ASSERT_EQ(lite::RET_OK, ret);
+  ASSERT_TRUE(planner.planned());
+  ASSERT_EQ(channels.size(), planner.tensor_num());
+  for (auto &tensor : tensors) {
+    ASSERT_NE(nullptr, tensor->data_c());
+  }
+  ASSERT_EQ(nullptr, input->data_c());
+
+  // tensors alive at the same time must not share memory
+  ASSERT_FALSE(Overlap(tensors[0].get(), tensors[1].get()));
+  ASSERT_FALSE(Overlap(tensors[0].get(), tensors[2].get()));
+  ASSERT_FALSE(Overlap(tensors[1].get(), tensors[2].get()));
+  ASSERT_FALSE(Overlap(tensors[1].get(), tensors[3].get()));
+  ASSERT_FALSE(Overlap(tensors[2].get(), tensors[3].get()));
+  ASSERT_FALSE(Overlap(tensors[3].get(), tensors[4].get()));
+  ASSERT_FALSE(Overlap(tensors[4].get(), tensors[5].get()));
+
+  size_t total_size = 0;
+  for (auto &tensor : tensors) {
+    total_size += tensor->Size();
+  }
+  ASSERT_LE(planner.live_peak_size(), planner.arena_size());
+  ASSERT_LT(planner.arena_size(), total_size);
+  MS_LOG(INFO) << "arena size: " << planner.arena_size() << ", live peak size: " << planner.live_peak_size()
+               << ", ref-count allocator size: " << planner.allocator_size() << ", total size: " << total_size;
+
+  planner.Release();
+  ASSERT_FALSE(planner.planned());
+  for (auto &tensor : tensors) {
+    ASSERT_EQ(nullptr, tensor->data_c());
+  }
+}
+
+TEST_F(MemoryPlannerTest, TestSkipAllocatedTensor) {
+  auto tensor0 = std::make_shared<lite::Tensor>(kNumberTypeFloat32, std::vector<int>{1, 4, 4, 4});
+  auto tensor1 = std::make_shared<lite::Tensor>(kNumberTypeFloat32, std::vector<int>{1, 4, 4, 4});
+  ASSERT_EQ(0, tensor0->MallocData());
+  auto data0 = tensor0->data_c();
+  auto kernel0 = std::make_shared<kernel::LiteKernel>();
+  auto kernel1 = std::make_shared<kernel::LiteKernel>();
+  kernel0->set_out_tensors({tensor0.get()});
+  kernel1->set_in_tensors({tensor0.get()});
+  kernel1->set_out_tensors({tensor1.get()});
+  Connect(kernel0.get(), kernel1.get());
+
+  lite::MemoryPlanner planner;
+  std::vector<kernel::LiteKernel *> kernels = {kernel0.get(), kernel1.get()};
+  auto ret = planner.Plan(kernels, {tensor1.get()});
+  ASSERT_EQ(lite::RET_OK, ret);
+  ASSERT_EQ(1, planner.tensor_num());
+  ASSERT_EQ(data0, tensor0->data_c());
+  ASSERT_NE(nullptr, tensor1->data_c());
+  planner.Release();
+  ASSERT_EQ(data0, tensor0->data_c());
+  ASSERT_EQ(nullptr, tensor1->data_c());
+}
+}  // namespace mindspore
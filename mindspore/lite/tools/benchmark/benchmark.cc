@@ -344,25 +344,29 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
 
   MS_LOG(INFO) << "start reading model file";
   std::cout << "start reading model file" << std::endl;
-  size_t size = 0;
-  char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
-  if (graphBuf == nullptr) {
-    MS_LOG(ERROR) << "Read model file failed while running " << modelName.c_str();
-    std::cerr << "Read model file failed while running " << modelName.c_str() << std::endl;
-    return RET_ERROR;
-  }
-  auto model = lite::Model::Import(graphBuf, size);
-  auto model_version = model->version_;
-  if (model_version != Version()) {
-    MS_LOG(WARNING) << "model version is " << model_version << ", inference version is " << Version() << " not equal";
+  lite::Model *model = nullptr;
+  if (_flags->enableMmap) {
+    model = lite::Model::ImportFromFile(_flags->modelPath.c_str());
+  } else {
+    size_t size = 0;
+    char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
+    if (graphBuf == nullptr) {
+      MS_LOG(ERROR) << "Read model file failed while running " << modelName.c_str();
+      std::cerr << "Read model file failed while running " << modelName.c_str() << std::endl;
+      return RET_ERROR;
+    }
+    model = lite::Model::Import(graphBuf, size);
+    delete[](graphBuf);
   }
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model file failed while running " << modelName.c_str();
     std::cerr << "Import model file failed while running " << modelName.c_str() << std::endl;
-    delete[](graphBuf);
     return RET_ERROR;
   }
-  delete[](graphBuf);
+  auto model_version = model->version_;
+  if (model_version != Version()) {
+    MS_LOG(WARNING) << "model version is " << model_version << ", inference version is " << Version() << " not equal";
+  }
   auto context = new (std::nothrow) lite::Context;
   if (context == nullptr) {
     MS_LOG(ERROR) << "New context failed while running " << modelName.c_str();
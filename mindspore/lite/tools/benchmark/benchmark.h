@@ -64,6 +64,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::numThreads, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::fp16Priority, "fp16Priority", "Priority float16", false);
     AddFlag(&BenchmarkFlags::warmUpLoopCount, "warmUpLoopCount", "Run warm up loop", 3);
+    AddFlag(&BenchmarkFlags::enableMmap, "enableMmap", "Memory-map the model file instead of copying it", false);
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::calibDataPath, "calibDataPath", "Calibration data file path", "");
     AddFlag(&BenchmarkFlags::calibDataType, "calibDataType", "Calibration data type. FLOAT | INT32 | INT8", "FLOAT");
@@ -89,6 +90,7 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int numThreads;
   bool fp16Priority;
   int warmUpLoopCount;
+  bool enableMmap;
   // MarkAccuracy
   std::string calibDataPath;
   std::string calibDataType;
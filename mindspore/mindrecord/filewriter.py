@@ -68,6 +68,7 @@ class FileWriter:
                            for x in range(self._shard_num)]
 
         self._append = False
+        self._compact_index = False
         self._header = ShardHeader()
         self._writer = ShardWriter()
         self._generator = None
@@ -103,6 +104,8 @@ class FileWriter:
     def init_append(self, file_name, header):
         self._append = True
         self._file_name = file_name
+        # keep the compact index if the dataset was written with it
+        self._compact_index = os.path.exists(file_name + ".idx")
         self._header = header
         self._writer.open_for_append(file_name)
 
@@ -273,6 +276,22 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_compact_index(self, compact_index):
+        """
+        Set whether to generate a compact binary index file (.idx) for every mindrecord file \
+        besides the db file. The reader loads the compact index without opening the db files, \
+        which shortens the start of reading datasets with many files.
+
+        Args:
+           compact_index (bool): Whether to generate the compact index.
+
+        Raises:
+            ParamTypeError: If compact_index is not a bool.
+        """
+        if not isinstance(compact_index, bool):
+            raise ParamTypeError('compact_index', 'bool')
+        self._compact_index = compact_index
+
     def commit(self):
         """
         Flush data to disk and generate the corresponding db files.
@@ -295,9 +314,10 @@ class FileWriter:
         ret = self._writer.commit()
         if self._index_generator is True:
             if self._append:
-                self._generator = ShardIndexGenerator(self._file_name, self._append)
+                self._generator = ShardIndexGenerator(self._file_name, self._append, self._compact_index)
             elif len(self._paths) >= 1:
-                self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append)
+                self._generator = ShardIndexGenerator(os.path.realpath(self._paths[0]), self._append,
+                                                      self._compact_index)
             self._generator.build()
             self._generator.write_to_db()
 
@@ -308,10 +328,10 @@ class FileWriter:
             if os.path.exists(item):
                 os.chmod(item, stat.S_IRUSR | stat.S_IWUSR)
                 mindrecord_files.append(item)
-            index_file = item + ".db"
-            if os.path.exists(index_file):
-                os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
-                index_files.append(index_file)
+            for index_file in (item + ".db", item + ".idx"):
+                if os.path.exists(index_file):
+                    os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
+                    index_files.append(index_file)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
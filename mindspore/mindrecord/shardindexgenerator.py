@@ -30,12 +30,14 @@ class ShardIndexGenerator:
     Args:
         path (str): Absolute path of MindRecord File.
         append (bool): If True, open existed MindRecord Files for appending, or create new MindRecord Files.
+        compact_index (bool): If True, also write a compact binary index file (.idx) for every shard,
+            which is loaded by the reader instead of the db file (default=False).
 
     Raises:
         MRMIndexGeneratorError: If failed to create index generator.
     """
-    def __init__(self, path, append=False):
-        self._generator = ms.ShardIndexGenerator(path, append)
+    def __init__(self, path, append=False, compact_index=False):
+        self._generator = ms.ShardIndexGenerator(path, append, compact_index)
         if not self._generator:
             logger.error("Failed to create index generator.")
             raise MRMIndexGeneratorError
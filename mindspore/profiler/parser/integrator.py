@@ -768,6 +768,24 @@ class GpuTimelineGenerator(BaseTimelineGenerator):
         # Update timeline summary info
         self._timeline_summary['num_of_streams'] += len(stream_count_dict.keys())
 
+
+class CpuTimelineGenerator(GpuTimelineGenerator):
+    """Generate cpu Timeline data from file, the tid of an operator is the thread launching it."""
+    _display_filename = 'cpu_timeline_display_{}.json'
+    _timeline_summary_filename = 'cpu_timeline_summary_{}.json'
+    _output_op_execute_time_file_path = "cpu_op_execute_timestamp_{}.txt"
+
+    def _load_timeline_data(self):
+        """Load timeline data from file, cpu operators have no activity data."""
+        op_file_path = self._get_and_validate_path(
+            self._output_op_execute_time_file_path)
+
+        timeline_list = self._load_op_data(op_file_path)
+        timeline_list.sort(key=lambda x: float(x[2]))
+
+        return timeline_list
+
+
 class AscendTimelineGenerator(BaseTimelineGenerator):
     """Generate ascend Timeline data from file."""
 
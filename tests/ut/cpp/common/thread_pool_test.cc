@@ -0,0 +1,163 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "common/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace common {
+namespace {
+constexpr size_t kLens = 4096;
+constexpr size_t kSpawnThreadNum = 24;
+constexpr int kRepeat = 200;
+}  // namespace
+
+class ThreadPoolTest : public UT::Common {
+ public:
+  ThreadPoolTest() = default;
+  void SetUp() override { ThreadPool::GetInstance().Reset(4, {}); }
+  void TearDown() override { ThreadPool::GetInstance().Reset(0, {}); }
+};
+
+TEST_F(ThreadPoolTest, ParallelForCoverRange) {
+  auto &pool = ThreadPool::GetInstance();
+  EXPECT_EQ(pool.GetThreadNum(), 4);
+  std::vector<std::atomic<int>> visits(1001);
+  std::atomic<int> blocks{0};
+  pool.ParallelFor(visits.size(), [&visits, &blocks](size_t start, size_t end) {
+    blocks++;
+    for (size_t i = start; i < end; ++i) {
+      visits[i]++;
+    }
+  });
+  EXPECT_EQ(blocks, 4);
+  for (auto &visit : visits) {
+    EXPECT_EQ(visit, 1);
+  }
+}
+
+TEST_F(ThreadPoolTest, ParallelForGrainSize) {
+  auto &pool = ThreadPool::GetInstance();
+  auto caller = std::this_thread::get_id();
+  std::vector<std::pair<size_t, size_t>> blocks;
+  pool.ParallelFor(100, [&caller, &blocks](size_t start, size_t end) {
+    EXPECT_EQ(std::this_thread::get_id(), caller);
+    blocks.emplace_back(start, end);
+  }, 1000);
+  ASSERT_EQ(blocks.size(), 1);
+  EXPECT_EQ(blocks[0].first, 0);
+  EXPECT_EQ(blocks[0].second, 100);
+
+  std::atomic<int> block_num{0};
+  pool.ParallelFor(100, [&block_num](size_t start, size_t end) {
+    EXPECT_GE(end - start, 40);
+    block_num++;
+  }, 40);
+  EXPECT_EQ(block_num, 2);
+}
+
+TEST_F(ThreadPoolTest, ParallelForNestedAndConcurrent) {
+  auto &pool = ThreadPool::GetInstance();
+  std::atomic<size_t> sum{0};
+  auto outer = [&pool, &sum](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      pool.ParallelFor(100, [&sum](size_t inner_start, size_t inner_end) { sum += inner_end - inner_start; });
+    }
+  };
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 3; ++i) {
+    callers.emplace_back([&pool, &outer]() { pool.ParallelFor(16, outer); });
+  }
+  for (auto &caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(sum, 3 * 16 * 100);
+}
+
+TEST_F(ThreadPoolTest, ParallelForException) {
+  auto &pool = ThreadPool::GetInstance();
+  std::atomic<size_t> done{0};
+  auto task = [&done](size_t start, size_t end) {
+    if (start > 0) {
+      throw std::runtime_error("block failed");
+    }
+    done += end - start;
+  };
+  EXPECT_THROW(pool.ParallelFor(1000, task), std::runtime_error);
+  EXPECT_EQ(done, 250);
+  // the pool is still usable after an exception
+  done = 0;
+  pool.ParallelFor(1000, [&done](size_t start, size_t end) { done += end - start; });
+  EXPECT_EQ(done, 1000);
+}
+
+TEST_F(ThreadPoolTest, BindCore) {
+  auto &pool = ThreadPool::GetInstance();
+  pool.Reset(2, {0});
+  std::atomic<size_t> done{0};
+  pool.ParallelFor(2, [&done](size_t start, size_t end) { done += end - start; });
+  EXPECT_EQ(done, 2);
+}
+
+// Latency of a small elementwise op, the pool against a fresh std::thread per block as the kernels did before.
+TEST_F(ThreadPoolTest, SmallOpLatency) {
+  std::vector<float> input1(kLens, 1.0f);
+  std::vector<float> input2(kLens, 2.0f);
+  std::vector<float> output(kLens, 0.0f);
+  auto add = [&input1, &input2, &output](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      output[i] = input1[i] + input2[i];
+    }
+  };
+  auto elapsed_us = [](const std::function<void()> &launch) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRepeat; ++i) {
+      launch();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / kRepeat;
+  };
+
+  double spawn_us = elapsed_us([&add]() {
+    std::vector<std::thread> threads;
+    size_t once_compute_size = (kLens + kSpawnThreadNum - 1) / kSpawnThreadNum;
+    for (size_t start = 0; start < kLens; start += once_compute_size) {
+      threads.emplace_back(add, start, std::min(start + once_compute_size, kLens));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  });
+  EXPECT_EQ(output[kLens - 1], 3.0f);
+  auto &pool = ThreadPool::GetInstance();
+  pool.Reset(0, {});
+  std::fill(output.begin(), output.end(), 0.0f);
+  double pool_us = elapsed_us([&pool, &add]() { pool.ParallelFor(kLens, add); });
+  EXPECT_EQ(output[kLens - 1], 3.0f);
+  double inline_us = elapsed_us([&pool, &add]() { pool.ParallelFor(kLens, add, 16384); });
+  MS_LOG(INFO) << "Add of " << kLens << " floats, spawn threads: " << spawn_us << "us, thread pool: " << pool_us
+               << "us, thread pool under grain size: " << inline_us << "us";
+}
+}  // namespace common
+}  // namespace mindspore
@@ -24,6 +24,7 @@
 
 #include "common/common.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "utils/log_adapter.h"
 
@@ -48,12 +49,19 @@ public:
   // A random sleep/delay can be introduced for each thread. See run().
   Status Run_test_1();
 
+  // Microbenchmark: num_workers producers push num_rows rows in round robin to a single consumer.
+  // The consumer checks the order and the rows per second are returned in rows_per_sec.
+  Status Run_benchmark(int num_workers, uint32_t num_rows, double *rows_per_sec);
+
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
+  void SetLockFree(bool lock_free) { lock_free_ = lock_free; }
+
 private:
   std::unique_ptr<TaskGroup> tg_;
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
+  bool lock_free_ = false;
   std::vector<uint32_t> input_;
   WaitPost wp;
 
@@ -82,6 +90,11 @@ private:
 
   Status ValidateOutput(const std::vector<uint32_t> &output);
 
+  // Worker loops of Run_benchmark.
+  Status BenchWorkerPush(int tid, Connector<uint32_t> *my_conn, int num_workers, uint32_t num_rows);
+
+  Status BenchWorkerPull(Connector<uint32_t> *my_conn, uint32_t num_rows, bool *in_order);
+
   uint32_t GenRand(int max);
 
   // Put the current thread to sleep mode for MaxDue milliseconds.
@@ -122,7 +135,99 @@ TEST_F(MindDataTestConnector, Test2) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+// Test3: single producer, single consumer with a lock free connector
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3: lock free, single producer, single consumer.";
+  this->SetLockFree(true);
+  Status rc = this->Run_test_0();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+// Test4: multiple producers, multiple consumers with lock free connectors
+TEST_F(MindDataTestConnector, Test4) {
+  MS_LOG(INFO) << "MindDataTestConnector Test4: lock free.";
+  this->SetLockFree(true);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
 
+// Test5: lock free connectors with random delay after push/pop, so that workers have to sleep on the queues.
+TEST_F(MindDataTestConnector, Test5) {
+  MS_LOG(INFO) << "MindDataTestConnector Test5: lock free with random delay.";
+  this->SetLockFree(true);
+  this->SetSleepMilliSec(30);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+// Benchmark: rows per second through a connector against the number of producers, with and without locks.
+// Disabled by default, run it with --gtest_also_run_disabled_tests.
+TEST_F(MindDataTestConnector, DISABLED_TestBenchmark) {
+  MS_LOG(INFO) << "MindDataTestConnector TestBenchmark.";
+  const uint32_t num_rows = 200000;
+  for (int num_workers : {1, 2, 4, 8, 16}) {
+    double locked = 0;
+    double lock_free = 0;
+    this->SetLockFree(false);
+    Status rc = this->Run_benchmark(num_workers, num_rows, &locked);
+    ASSERT_TRUE(rc.IsOk());
+    this->SetLockFree(true);
+    rc = this->Run_benchmark(num_workers, num_rows, &lock_free);
+    ASSERT_TRUE(rc.IsOk());
+    MS_LOG(INFO) << "workers: " << num_workers << ", locked: " << static_cast<int64_t>(locked)
+                 << " rows/s, lock free: " << static_cast<int64_t>(lock_free) << " rows/s";
+  }
+  Status rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+// TestCoalesce: data buffers waiting in a DbConnector are merged in order, control buffers are never merged.
+TEST_F(MindDataTestConnector, TestCoalesce) {
+  MS_LOG(INFO) << "MindDataTestConnector TestCoalesce.";
+  auto make_buffer = [](int32_t id, DataBuffer::BufferFlags flag) {
+    auto buffer = std::make_unique<DataBuffer>(id, flag);
+    if (flag == DataBuffer::kDeBFlagNone) {
+      auto table = std::make_unique<TensorQTable>();
+      TensorRow row;
+      row.setId(id);
+      table->push_back(std::move(row));
+      buffer->set_tensor_table(std::move(table));
+    }
+    return buffer;
+  };
+  // Buffers in round robin order over 2 producers: D0 D1 D2 D3 D4 EOE D5 EOF
+  std::vector<DataBuffer::BufferFlags> flags = {DataBuffer::kDeBFlagNone, DataBuffer::kDeBFlagNone,
+                                                DataBuffer::kDeBFlagNone, DataBuffer::kDeBFlagNone,
+                                                DataBuffer::kDeBFlagNone, DataBuffer::kDeBFlagEOE,
+                                                DataBuffer::kDeBFlagNone, DataBuffer::kDeBFlagEOF};
+  for (bool lock_free : {false, true}) {
+    DbConnector conn(2, 1, 8, lock_free);
+    conn.SetCoalesceRows(4);
+    int32_t id = 0;
+    for (size_t i = 0; i < flags.size(); i++) {
+      ASSERT_TRUE(conn.Add(i % 2, make_buffer(flags[i] == DataBuffer::kDeBFlagNone ? id++ : -1, flags[i])).IsOk());
+    }
+    std::vector<std::vector<int64_t>> expect_rows = {{0, 1, 2, 3}, {4}, {}, {5}, {}};
+    std::unique_ptr<DataBuffer> buffer;
+    for (auto &expect : expect_rows) {
+      ASSERT_TRUE(conn.PopWithRetry(0, &buffer).IsOk());
+      ASSERT_EQ(buffer->NumRows(), static_cast<int32_t>(expect.size()));
+      for (auto row_id : expect) {
+        TensorRow row;
+        ASSERT_TRUE(buffer->PopRow(&row).IsOk());
+        ASSERT_EQ(row.getId(), row_id);
+      }
+    }
+    ASSERT_TRUE(buffer->eof());
+    ASSERT_EQ(conn.out_rows_count(), 6);
+  }
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
@@ -139,7 +244,8 @@ Status MindDataTestConnector::Run_test_0() {
   wp.Clear();
   auto my_conn = std::make_shared<Connector<uint32_t>>(1,  // num of producers
                                                       1,  // num of consumers
-                                                      10);  // capacity of each queue
+                                                      10,  // capacity of each queue
+                                                      lock_free_);
   MS_ASSERT(my_conn != nullptr);
 
   rc = my_conn->Register(tg_.get());
@@ -188,11 +294,13 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     lock_free_);
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     lock_free_);
 
   rc = conn1->Register(tg_.get());
   RETURN_IF_NOT_OK(rc);
@@ -241,6 +349,53 @@ Status MindDataTestConnector::Run_test_1() {
   return ValidateOutput(output);
 }
 
+Status MindDataTestConnector::Run_benchmark(int num_workers, uint32_t num_rows, double *rows_per_sec) {
+  // tg_ can not be used again once interrupted, so each run gets its own task group and all workers simply finish.
+  TaskGroup vg;
+  bool in_order = true;
+  auto my_conn = std::make_unique<Connector<uint32_t>>(num_workers, 1, 16, lock_free_);
+  RETURN_IF_NOT_OK(my_conn->Register(&vg));
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_workers; i++) {
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask("Bench Push", std::bind(&MindDataTestConnector::BenchWorkerPush, this, i,
+                                                                my_conn.get(), num_workers, num_rows)));
+  }
+  RETURN_IF_NOT_OK(vg.CreateAsyncTask(
+    "Bench Pull", std::bind(&MindDataTestConnector::BenchWorkerPull, this, my_conn.get(), num_rows, &in_order)));
+  RETURN_IF_NOT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  auto end = std::chrono::steady_clock::now();
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  *rows_per_sec = seconds > 0 ? num_rows / seconds : 0;
+  if (!in_order) {
+    return Status(StatusCode::kUnexpectedError, "Output rows are not in-order.");
+  }
+  return Status::OK();
+}
+
+Status MindDataTestConnector::BenchWorkerPush(int tid, Connector<uint32_t> *my_conn, int num_workers,
+                                              uint32_t num_rows) {
+  TaskManager::FindMe()->Post();
+  for (uint32_t row = tid; row < num_rows; row += num_workers) {
+    RETURN_IF_NOT_OK(my_conn->Push(tid, row));
+  }
+  return Status::OK();
+}
+
+Status MindDataTestConnector::BenchWorkerPull(Connector<uint32_t> *my_conn, uint32_t num_rows, bool *in_order) {
+  TaskManager::FindMe()->Post();
+  for (uint32_t expect = 0; expect < num_rows; expect++) {
+    uint32_t row;
+    RETURN_IF_NOT_OK(my_conn->Pop(0, &row));
+    if (row != expect) {
+      *in_order = false;
+    }
+  }
+  return Status::OK();
+}
+
 Status MindDataTestConnector::SerialWorkerPull(
                                                int tid,
                                                std::shared_ptr<Connector<uint32_t>> my_conn,
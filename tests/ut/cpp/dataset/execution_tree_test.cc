@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <string>
+#include <vector>
 #include "minddata/dataset/util/circular_pool.h"
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/execution_tree.h"
@@ -138,6 +139,45 @@ TEST_F(MindDataTestExecutionTree, TestExecutionTree2) {
   }
 }
 
+// Run a TFReader pipeline with tiny buffers, with and without buffer coalescing
+TEST_F(MindDataTestExecutionTree, TestExecutionTreeCoalescing) {
+  MS_LOG(INFO) << "Doing MindDataTestExecutionTreeCoalescing.";
+  std::string dataset_path = datasets_root_path_ + "/testDataset1/testDataset1.data";
+  std::vector<int32_t> num_rows;
+  for (int32_t coalesce_max_rows : {0, 16}) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<TFReaderOp> my_tfreader_op;
+    TFReaderOp::Builder()
+        .SetDatasetFilesList({dataset_path})
+        .SetRowsPerBuffer(1)
+        .SetWorkerConnectorSize(2)
+        .SetNumWorkers(2)
+        .Build(&my_tfreader_op);
+    my_tree->AssociateNode(my_tfreader_op);
+    my_tree->AssignRoot(my_tfreader_op);
+    my_tree->Prepare();
+    Status rc = my_tree->SetCoalesceMaxRows(coalesce_max_rows);
+    EXPECT_TRUE(rc.IsOk());
+    my_tree->Launch();
+
+    DatasetIterator di(my_tree);
+    TensorRow row;
+    rc = di.FetchNextTensorRow(&row);
+    EXPECT_TRUE(rc.IsOk());
+    int32_t row_count = 0;
+    while (!row.empty()) {
+      row_count++;
+      rc = di.FetchNextTensorRow(&row);
+      EXPECT_TRUE(rc.IsOk());
+    }
+    num_rows.push_back(row_count);
+    // Coalescing can not be changed once launched
+    EXPECT_TRUE(my_tree->SetCoalesceMaxRows(0).IsError());
+  }
+  EXPECT_GT(num_rows[0], 0);
+  EXPECT_EQ(num_rows[0], num_rows[1]);
+}
+
 // Construct some tree nodes and play with them
 TEST_F(MindDataTestExecutionTree, TestExecutionTree3) {
   MS_LOG(INFO) << "Doing MindDataTestExecutionTree3.";
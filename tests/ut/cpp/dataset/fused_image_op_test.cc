@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/fused_image_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
+#include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestFusedImageOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedImageOp() : CVOpCommon() {}
+
+  // run the ops one after the other, as MapOp does without the fusion
+  void RunSequential(const std::vector<std::shared_ptr<TensorOp>> &ops, std::shared_ptr<Tensor> *output) {
+    std::shared_ptr<Tensor> tensor = raw_input_tensor_;
+    for (auto &op : ops) {
+      std::shared_ptr<Tensor> out;
+      EXPECT_TRUE(op->Compute(tensor, &out).IsOk());
+      tensor = out;
+    }
+    *output = tensor;
+  }
+
+  void ExpectSameFloats(const std::shared_ptr<Tensor> &lhs, const std::shared_ptr<Tensor> &rhs) {
+    ASSERT_EQ(lhs->shape(), rhs->shape());
+    ASSERT_EQ(lhs->type(), DataType(DataType::DE_FLOAT32));
+    ASSERT_EQ(rhs->type(), DataType(DataType::DE_FLOAT32));
+    auto lhs_it = lhs->begin<float>();
+    auto rhs_it = rhs->begin<float>();
+    for (; lhs_it != lhs->end<float>(); ++lhs_it, ++rhs_it) {
+      ASSERT_NEAR(*lhs_it, *rhs_it, 1e-4);
+    }
+  }
+};
+
+TEST_F(MindDataTestFusedImageOp, TestResizeFlipNormalizeChw) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp::TestResizeFlipNormalizeChw.";
+  auto decode = std::make_shared<DecodeOp>(true);
+  auto resize = std::make_shared<ResizeOp>(64, 48);
+  auto flip = std::make_shared<RandomHorizontalFlipOp>(1.0);
+  auto normalize = std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0);
+  auto hwc_to_chw = std::make_shared<HwcToChwOp>();
+  std::shared_ptr<Tensor> expected;
+  RunSequential({decode, resize, flip, normalize, hwc_to_chw}, &expected);
+
+  FusedImageOp op(decode, resize, 1.0, {121.0, 115.0, 100.0}, {70.0, 68.0, 71.0}, true);
+  std::shared_ptr<Tensor> output;
+  Status s = op.Compute(raw_input_tensor_, &output);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output->shape(), TensorShape({3, 64, 48}));
+  ExpectSameFloats(output, expected);
+}
+
+TEST_F(MindDataTestFusedImageOp, TestNormalizeHwc) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp::TestNormalizeHwc.";
+  auto decode = std::make_shared<DecodeOp>(true);
+  auto normalize = std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0);
+  std::shared_ptr<Tensor> expected;
+  RunSequential({decode, normalize}, &expected);
+
+  FusedImageOp op(decode, nullptr, 0.0, {121.0, 115.0, 100.0}, {70.0, 68.0, 71.0}, false);
+  std::shared_ptr<Tensor> output;
+  Status s = op.Compute(raw_input_tensor_, &output);
+  EXPECT_TRUE(s.IsOk());
+  ExpectSameFloats(output, expected);
+}
+
+TEST_F(MindDataTestFusedImageOp, TestRandomCropDecodeResize) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp::TestRandomCropDecodeResize.";
+  RandomCropAndResizeOp crop_resize(32, 40);
+  auto decode = std::make_shared<RandomCropDecodeResizeOp>(crop_resize);
+  FusedImageOp op(decode, nullptr, 0.5, {121.0, 115.0, 100.0}, {70.0, 68.0, 71.0}, true);
+  for (int i = 0; i < 4; ++i) {
+    std::shared_ptr<Tensor> output;
+    Status s = op.Compute(raw_input_tensor_, &output);
+    EXPECT_TRUE(s.IsOk());
+    EXPECT_EQ(output->shape(), TensorShape({3, 32, 40}));
+  }
+}
+
+TEST_F(MindDataTestFusedImageOp, TestInvalidInput) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedImageOp::TestInvalidInput.";
+  std::shared_ptr<Tensor> output;
+  Status s = FlipNormalizeTranspose(input_tensor_, &output, {121.0, 115.0}, {70.0, 68.0}, false, true);
+  EXPECT_TRUE(s.IsError());
+}
@@ -20,10 +20,13 @@
 #include "common/common.h"
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_with_bbox_op.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "minddata/mindrecord/include/shard_shuffle.h"
+#include "minddata/mindrecord/include/shard_writer.h"
 #include "utils/log_adapter.h"
 
 namespace common = mindspore::common;
@@ -521,3 +524,134 @@ TEST_F(MindDataTestMindRecordOp, TestMindRecordInvalidColumnList) {
   ASSERT_TRUE(rc.IsError());
   ASSERT_TRUE(rc.ToString().find_first_of("illegal column list") != std::string::npos);
 }
+
+TEST_F(MindDataTestMindRecordOp, TestMindRecordInPlaceOpKeepsFile) {
+  // An op writing its input in place must not change the rows read from the shard file in the next epoch
+  //
+  //    RepeatOp
+  //       |
+  //     MapOp (RandomHorizontalFlipWithBBox)
+  //       |
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordInPlaceOpKeepsFile";
+
+  const int kNumRows = 10;
+  const int kHeight = 4;
+  const int kWidth = 8;
+  const float kBoxX = 1.0;
+  const float kBoxWidth = 2.0;
+  std::string file_name = "./in_place_op.mindrecord";
+  remove(common::SafeCStr(file_name));
+  remove(common::SafeCStr(file_name + ".db"));
+
+  // write image and bbox as blob columns, the boxes of every row are flipped from x=1 to x=8-1-2=5
+  mindspore::mindrecord::ShardHeader header;
+  auto schema_json = R"({"label": {"type": "int32"}, "image": {"type": "uint8", "shape": [4, 8, 3]},
+                         "bbox": {"type": "float32", "shape": [-1, 4]}})"_json;
+  auto schema = mindspore::mindrecord::Schema::Build("in_place_op", schema_json);
+  ASSERT_NE(schema, nullptr);
+  int schema_id = header.AddSchema(schema);
+  ASSERT_EQ(header.AddIndexFields(std::vector<std::string>{"label"}), mindspore::mindrecord::SUCCESS);
+
+  mindspore::mindrecord::ShardWriter writer;
+  ASSERT_EQ(writer.Open({file_name}), mindspore::mindrecord::SUCCESS);
+  ASSERT_EQ(writer.SetShardHeader(std::make_shared<mindspore::mindrecord::ShardHeader>(header)),
+            mindspore::mindrecord::SUCCESS);
+  std::vector<mindspore::mindrecord::json> raw_rows;
+  std::vector<std::vector<uint8_t>> blobs;
+  for (int i = 0; i < kNumRows; i++) {
+    raw_rows.push_back(mindspore::mindrecord::json{{"label", i}});
+    std::vector<float> bbox = {kBoxX, static_cast<float>(i % kHeight), kBoxWidth, 1.0, kBoxX, 0.0, kBoxWidth, 2.0};
+    std::map<std::string, std::unique_ptr<std::vector<uint8_t>>> row_bin;
+    row_bin["image"] = std::make_unique<std::vector<uint8_t>>(kHeight * kWidth * 3, static_cast<uint8_t>(i));
+    row_bin["bbox"] = std::make_unique<std::vector<uint8_t>>(reinterpret_cast<uint8_t *>(bbox.data()),
+                                                             reinterpret_cast<uint8_t *>(bbox.data() + bbox.size()));
+    std::shared_ptr<std::vector<uint8_t>> blob;
+    ASSERT_EQ(writer.MergeBlobData(schema->GetBlobFields(), row_bin, &blob), mindspore::mindrecord::SUCCESS);
+    blobs.push_back(*blob);
+  }
+  std::map<uint64_t, std::vector<mindspore::mindrecord::json>> raw_data = {{schema_id, raw_rows}};
+  ASSERT_EQ(writer.WriteRawData(raw_data, blobs), mindspore::mindrecord::SUCCESS);
+  ASSERT_EQ(writer.Commit(), mindspore::mindrecord::SUCCESS);
+  mindspore::mindrecord::ShardIndexGenerator index_generator(file_name);
+  ASSERT_EQ(index_generator.Build(), mindspore::mindrecord::SUCCESS);
+  ASSERT_EQ(index_generator.WriteToDatabase(), mindspore::mindrecord::SUCCESS);
+
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<MindRecordOp> my_mindrecord_op;
+  MindRecordOp::Builder builder;
+  builder.SetDatasetFile({file_name})
+    .SetLoadDataset(false)
+    .SetRowsPerBuffer(3)
+    .SetNumMindRecordWorkers(4)
+    .SetColumnsToLoad({"image", "bbox", "label"});
+  Status rc = builder.Build(&my_mindrecord_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_mindrecord_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  std::vector<std::shared_ptr<TensorOp>> my_func_list;
+  my_func_list.push_back(std::make_shared<RandomHorizontalFlipWithBBoxOp>(1.0));
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder map_builder;
+  map_builder.SetInColNames({"image", "bbox"})
+    .SetOutColNames({"image", "bbox"})
+    .SetTensorFuncs(std::move(my_func_list))
+    .SetNumWorkers(2);
+  rc = map_builder.Build(&my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  uint32_t num_epochs = 2;
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  rc = RepeatOp::Builder(num_epochs).Build(&my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  rc = my_map_op->AddChild(my_mindrecord_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_repeat_op->AddChild(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  ASSERT_TRUE(rc.IsOk());
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    ASSERT_EQ(tensor_list.size(), 3);
+    int32_t label = 0;
+    ASSERT_TRUE(tensor_list[2]->GetItemAt(&label, {0}).IsOk());
+    ASSERT_EQ(tensor_list[1]->shape(), TensorShape({2, 4}));
+    for (dsize_t box = 0; box < 2; box++) {
+      float x = 0;
+      float y = 0;
+      ASSERT_TRUE(tensor_list[1]->GetItemAt(&x, {box, 0}).IsOk());
+      ASSERT_TRUE(tensor_list[1]->GetItemAt(&y, {box, 1}).IsOk());
+      // every epoch flips the boxes read from the file, never the boxes flipped in the previous epoch
+      EXPECT_EQ(x, kWidth - kBoxX - kBoxWidth) << "row " << row_count << ", box " << box;
+      EXPECT_EQ(y, box == 0 ? static_cast<float>(label % kHeight) : 0.0);
+    }
+    uint8_t pixel = 0;
+    ASSERT_TRUE(tensor_list[0]->GetItemAt(&pixel, {0, 0, 0}).IsOk());
+    EXPECT_EQ(pixel, static_cast<uint8_t>(label));
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, kNumRows * num_epochs);
+
+  my_tree.reset();
+  remove(common::SafeCStr(file_name));
+  remove(common::SafeCStr(file_name + ".db"));
+}
@@ -0,0 +1,165 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "profiler/device/cpu/cpu_profiling.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace profiler {
+namespace cpu {
+namespace {
+constexpr size_t kLaunchNum = 100000;
+
+std::vector<std::string> ReadLines(const std::string &file_path) {
+  std::vector<std::string> lines;
+  std::ifstream ifs(file_path);
+  std::string line;
+  while (std::getline(ifs, line)) {
+    lines.emplace_back(line);
+  }
+  return lines;
+}
+
+void LaunchOp(const std::shared_ptr<CPUProfiler> &profiler, const std::string &op_name) {
+  profiler->OpDataProducerBegin(op_name);
+  profiler->OpDataProducerEnd();
+  if (profiler->NeedOpInputInfo()) {
+    profiler->SetOpInputInfo("32,64;64", 8448);
+  }
+}
+}  // namespace
+
+class TestCPUProfiling : public UT::Common {
+ public:
+  TestCPUProfiling() = default;
+
+  void SetUp() override {
+    char dir[] = "/tmp/cpu_profiling_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    path_ = dir;
+  }
+
+  void TearDown() override {
+    for (auto &file : {"cpu_op_detail_info_0.csv", "cpu_op_type_info_0.csv", "cpu_op_execute_timestamp_0.txt"}) {
+      (void)remove((path_ + "/" + file).c_str());
+    }
+    (void)rmdir(path_.c_str());
+  }
+
+  std::string path_;
+};
+
+// The kernel threads get the instance at each launch, they all get the same one.
+TEST_F(TestCPUProfiling, test_get_instance_from_threads) {
+  std::vector<std::shared_ptr<CPUProfiler>> instances(8);
+  std::vector<std::thread> threads;
+  for (auto &instance : instances) {
+    threads.emplace_back([&instance]() { instance = CPUProfiler::GetInstance(); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &instance : instances) {
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance, CPUProfiler::GetInstance());
+  }
+}
+
+// The op statistics and the timeline of the launches in two threads are written in the format of the gpu profiler.
+TEST_F(TestCPUProfiling, test_save_profile_data) {
+  auto profiler = CPUProfiler::GetInstance();
+  profiler->Init(path_);
+  profiler->StepProfilingEnable(true);
+  LaunchOp(profiler, "Default/MatMul-op1");
+  LaunchOp(profiler, "Default/BiasAdd-op2");
+  std::thread thread([&profiler]() { LaunchOp(profiler, "Default/MatMul-op1"); });
+  thread.join();
+  profiler->Stop();
+  EXPECT_FALSE(profiler->GetEnableFlag());
+
+  auto op_details = ReadLines(path_ + "/cpu_op_detail_info_0.csv");
+  ASSERT_EQ(op_details.size(), 3);
+  EXPECT_EQ(op_details[0].find("op_side,op_type,op_name,op_full_name,op_occurrences"), 0);
+  for (size_t i = 1; i < op_details.size(); ++i) {
+    if (op_details[i].find("MatMul") != std::string::npos) {
+      EXPECT_EQ(op_details[i].find("Host,MatMul,MatMul-op1,Default/MatMul-op1,2,"), 0);
+    }
+    EXPECT_NE(op_details[i].find(",\"32,64;64\",8448"), std::string::npos);
+  }
+  auto op_types = ReadLines(path_ + "/cpu_op_type_info_0.csv");
+  EXPECT_EQ(op_types.size(), 3);
+  // One line for the launches of an op in a thread.
+  auto op_timestamps = ReadLines(path_ + "/cpu_op_execute_timestamp_0.txt");
+  EXPECT_EQ(op_timestamps.size(), 3);
+}
+
+// A launch running in another thread while the profiling stops is dropped, the data of the next profiling does not
+// have it.
+TEST_F(TestCPUProfiling, test_stop_while_running) {
+  auto profiler = CPUProfiler::GetInstance();
+  profiler->Init(path_);
+  profiler->StepProfilingEnable(true);
+  std::promise<void> began;
+  std::promise<void> stopped;
+  std::thread thread([&profiler, &began, &stopped]() {
+    profiler->OpDataProducerBegin("Default/MatMul-op1");
+    began.set_value();
+    stopped.get_future().wait();
+    profiler->OpDataProducerEnd();
+    EXPECT_FALSE(profiler->NeedOpInputInfo());
+    profiler->SetOpInputInfo("32,64;64", 8448);
+  });
+  began.get_future().wait();
+  profiler->Stop();
+  stopped.set_value();
+  thread.join();
+
+  profiler->StepProfilingEnable(true);
+  LaunchOp(profiler, "Default/BiasAdd-op2");
+  profiler->Stop();
+  auto op_details = ReadLines(path_ + "/cpu_op_detail_info_0.csv");
+  ASSERT_EQ(op_details.size(), 2);
+  EXPECT_EQ(op_details[1].find("Host,BiasAdd,BiasAdd-op2,Default/BiasAdd-op2,1,"), 0);
+}
+
+// The cost of profiling a launch, it should be far less than the 2% of a kernel of 50 us. Only logged.
+TEST_F(TestCPUProfiling, test_profiling_overhead) {
+  auto profiler = CPUProfiler::GetInstance();
+  profiler->Init("");
+  profiler->StepProfilingEnable(true);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kLaunchNum; ++i) {
+    LaunchOp(profiler, "Default/ReLU-op" + std::to_string(i % 100));
+  }
+  std::chrono::duration<double, std::micro> cost = std::chrono::steady_clock::now() - start;
+  profiler->Stop();
+  double launch_cost = cost.count() / kLaunchNum;
+  MS_LOG(INFO) << "Profiling a launch costs " << launch_cost << " us.";
+}
+}  // namespace cpu
+}  // namespace profiler
+}  // namespace mindspore
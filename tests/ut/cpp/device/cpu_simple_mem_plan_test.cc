@@ -0,0 +1,141 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "backend/session/ascend_session.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/kernel_info.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kTensorSize = 1 << 20;
+
+class TestKernelMod : public kernel::KernelMod {
+ public:
+  TestKernelMod() : input_size_list_({kTensorSize, kTensorSize}), output_size_list_({kTensorSize}) {}
+  ~TestKernelMod() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &, const std::vector<kernel::AddressPtr> &,
+              const std::vector<kernel::AddressPtr> &, void *) override {
+    return true;
+  }
+
+ private:
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+
+// add_0 = x + y, add_i = add_{i-1} + y, returns add_3
+KernelGraphPtr CreateChainGraph() {
+  auto anf_graph = std::make_shared<FuncGraph>();
+  std::vector<int> shape = {256, 1024};
+  auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+  auto x = anf_graph->add_parameter();
+  x->set_abstract(abstract);
+  auto y = anf_graph->add_parameter();
+  y->set_abstract(abstract);
+  std::vector<AnfNodePtr> lst;
+  AnfNodePtr prev = x;
+  for (size_t i = 0; i < 4; ++i) {
+    auto add = anf_graph->NewCNode({NewValueNode(prim::kPrimTensorAdd), prev, y});
+    add->set_abstract(abstract);
+    lst.push_back(add);
+    prev = add;
+  }
+  session::SessionPtr sess = std::make_shared<session::AscendSession>();
+  sess->Init(0);
+  auto kernel_graph = sess->ConstructKernelGraph(lst, {prev});
+  kernel_graph->SetExecOrderByDefault();
+  for (auto &kernel : kernel_graph->execution_order()) {
+    auto kernel_info = std::make_shared<device::KernelInfo>();
+    kernel_info->set_kernel_mod(std::make_shared<TestKernelMod>());
+    kernel->set_kernel_info(kernel_info);
+    AnfAlgo::SetOutputAddr(std::make_shared<CPUDeviceAddress>(nullptr, kTensorSize), 0, kernel.get());
+  }
+  return kernel_graph;
+}
+}  // namespace
+
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() {}
+  void TearDown() override { MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_MEM_REUSE, true); }
+};
+
+TEST_F(TestCPUSimpleMemPlan, test_reuse_mem_plan) {
+  MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_MEM_REUSE, true);
+  auto graph = CreateChainGraph();
+  auto kernels = graph->execution_order();
+  ASSERT_EQ(kernels.size(), 4);
+
+  CPUSimpleMemPlan mem_plan;
+  size_t mem_size = mem_plan.MemPlan(graph.get());
+  auto plan = mem_plan.graph_mem_plans().at(graph->graph_id());
+  ASSERT_TRUE(plan.reused);
+  ASSERT_EQ(plan.planned_size, mem_size);
+  ASSERT_LT(plan.planned_size, plan.naive_size);
+  // two tensors are alive at a time
+  ASSERT_LT(plan.planned_size, 3 * kTensorSize);
+
+  std::vector<uint8_t> mem(mem_size);
+  mem_plan.MemAssign(graph.get(), mem.data());
+  std::vector<const void *> ptrs;
+  for (auto &kernel : kernels) {
+    auto address = AnfAlgo::GetOutputAddr(kernel, 0);
+    ASSERT_NE(address->GetPtr(), nullptr);
+    ASSERT_GE(static_cast<const uint8_t *>(address->GetPtr()), mem.data());
+    ASSERT_LE(static_cast<const uint8_t *>(address->GetPtr()) + kTensorSize, mem.data() + mem_size);
+    ptrs.push_back(address->GetPtr());
+  }
+  // each kernel reads the output of the previous one, which must not be overwritten
+  for (size_t i = 1; i < ptrs.size(); ++i) {
+    ASSERT_NE(ptrs[i], ptrs[i - 1]);
+  }
+  ASSERT_EQ(ptrs[2], ptrs[0]);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_naive_mem_plan) {
+  MsContext::GetInstance()->set_param<bool>(MS_CTX_ENABLE_MEM_REUSE, false);
+  auto graph = CreateChainGraph();
+  CPUSimpleMemPlan mem_plan;
+  size_t mem_size = mem_plan.MemPlan(graph.get());
+  auto plan = mem_plan.graph_mem_plans().at(graph->graph_id());
+  ASSERT_FALSE(plan.reused);
+  ASSERT_EQ(plan.planned_size, plan.naive_size);
+
+  std::vector<uint8_t> mem(mem_size);
+  mem_plan.MemAssign(graph.get(), mem.data());
+  std::vector<const void *> ptrs;
+  for (auto &kernel : graph->execution_order()) {
+    ptrs.push_back(AnfAlgo::GetOutputAddr(kernel, 0)->GetPtr());
+  }
+  for (size_t i = 1; i < ptrs.size(); ++i) {
+    ASSERT_EQ(static_cast<const uint8_t *>(ptrs[i]), static_cast<const uint8_t *>(ptrs[i - 1]) + kTensorSize);
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
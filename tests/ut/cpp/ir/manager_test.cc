@@ -13,6 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "common/common_test.h"
 #include "common/py_func_graph_fetcher.h"
 #include "ir/dtype.h"
@@ -44,6 +49,135 @@ std::vector<std::string> SplitString(std::string str, std::string pattern) {
 
   return result;
 }
+
+constexpr size_t kBlockNum = 100;
+
+FuncGraphPtr MakeLeafGraph() {
+  FuncGraphPtr leaf = std::make_shared<FuncGraph>();
+  ParameterPtr y = leaf->add_parameter();
+  leaf->set_output(leaf->NewCNode({NewValueNode(prim::kPrimScalarAdd), y, y}));
+  return leaf;
+}
+
+// The nodes of a block of the network which the tests replace.
+struct BlockNodes {
+  FuncGraphPtr block;
+  FuncGraphPtr inner;
+  AnfNodePtr leaf_node;
+  CNodePtr inner_out;
+  CNodePtr block_out;
+};
+
+// A network of block_num blocks nested in root:
+//   def root(x, p):
+//       def block_i(y):
+//           def inner_i(z):
+//               return z + y
+//           def helper_i(w):
+//               return inner_i(w)
+//           return helper_i(leaf_i(y)) + p
+//       return block_0(x) + block_1(x) + ...
+FuncGraphPtr MakeBlockNetwork(size_t block_num, std::vector<BlockNodes> *blocks) {
+  FuncGraphPtr root = std::make_shared<FuncGraph>();
+  ParameterPtr x = root->add_parameter();
+  ParameterPtr p = root->add_parameter();
+  AnfNodePtr out = nullptr;
+  for (size_t i = 0; i < block_num; ++i) {
+    BlockNodes nodes;
+    nodes.block = std::make_shared<FuncGraph>();
+    ParameterPtr y = nodes.block->add_parameter();
+    nodes.inner = std::make_shared<FuncGraph>();
+    ParameterPtr z = nodes.inner->add_parameter();
+    nodes.inner_out = nodes.inner->NewCNode({NewValueNode(prim::kPrimScalarAdd), z, y});
+    nodes.inner->set_output(nodes.inner_out);
+    FuncGraphPtr helper = std::make_shared<FuncGraph>();
+    ParameterPtr w = helper->add_parameter();
+    helper->set_output(helper->NewCNode({NewValueNode(nodes.inner), w}));
+    nodes.leaf_node = NewValueNode(MakeLeafGraph());
+    auto call_helper = nodes.block->NewCNode({NewValueNode(helper), nodes.block->NewCNode({nodes.leaf_node, y})});
+    nodes.block_out = nodes.block->NewCNode({NewValueNode(prim::kPrimScalarAdd), call_helper, p});
+    nodes.block->set_output(nodes.block_out);
+    auto call_block = root->NewCNode({NewValueNode(nodes.block), x});
+    out = out == nullptr ? call_block : root->NewCNode({NewValueNode(prim::kPrimScalarAdd), out, call_block});
+    blocks->push_back(nodes);
+  }
+  root->set_output(out);
+  return root;
+}
+
+// The dynamic analyses an optimizer pass reads between its replacements.
+void QueryAnalyses(const FuncGraphManagerPtr &mng) {
+  for (auto &fg : mng->func_graphs()) {
+    (void)mng->parent(fg);
+    (void)mng->scopes(fg);
+    (void)mng->func_graphs_used_total(fg);
+    (void)mng->recursive(fg);
+  }
+}
+
+// The names of a set sorted, the order of a set depends on the order its analysis is computed in.
+std::string SortedNames(const FuncGraphSet &func_graphs) {
+  std::vector<std::string> names;
+  for (auto &fg : func_graphs) {
+    names.push_back(fg->ToString());
+  }
+  std::sort(names.begin(), names.end());
+  std::string result;
+  for (auto &name : names) {
+    result += " " + name;
+  }
+  return result;
+}
+
+std::string DumpAnalyses(const FuncGraphManagerPtr &mng) {
+  std::ostringstream oss;
+  for (auto &fg : mng->func_graphs()) {
+    oss << fg->ToString() << " parent: " << (mng->parent(fg) == nullptr ? "null" : mng->parent(fg)->ToString());
+    oss << " parents total:" << SortedNames(mng->func_graph_parents_total(fg));
+    oss << " children:" << SortedNames(mng->children(fg));
+    oss << " scopes:" << SortedNames(mng->scopes(fg));
+    oss << " used total:" << SortedNames(mng->func_graphs_used_total(fg));
+    oss << " recursive: " << mng->recursive(fg) << " j total: " << mng->func_graph_j_total(fg) << "\n";
+  }
+  std::vector<std::string> free_variables;
+  for (auto &item : mng->free_variables_total()) {
+    std::ostringstream fvs;
+    fvs << item.first->ToString() << ":";
+    for (auto &fv : item.second) {
+      fvs << " " << fv.first.ToString();
+    }
+    free_variables.push_back(fvs.str());
+  }
+  std::sort(free_variables.begin(), free_variables.end());
+  oss << "free variables total:";
+  for (auto &fvs : free_variables) {
+    oss << "\n" << fvs;
+  }
+  return oss.str();
+}
+
+// Replaces the leaf of each block and reads the analyses after each replacement, returns the time it takes in
+// milliseconds.
+double ReplaceLeaves(const FuncGraphManagerPtr &mng, const std::vector<BlockNodes> &blocks, bool reset) {
+  auto start = std::chrono::steady_clock::now();
+  for (auto &nodes : blocks) {
+    (void)mng->Replace(nodes.leaf_node, NewValueNode(MakeLeafGraph()));
+    if (reset) {
+      mng->signals()->InvalidateComputer();
+    }
+    QueryAnalyses(mng);
+  }
+  std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+  return cost.count();
+}
+
+// The analyses kept by the manager after an edit are the ones computed from scratch.
+void CheckAnalyses(const FuncGraphManagerPtr &mng) {
+  QueryAnalyses(mng);
+  auto incremental = DumpAnalyses(mng);
+  mng->signals()->InvalidateComputer();
+  ASSERT_EQ(incremental, DumpAnalyses(mng));
+}
 }  // namespace
 using std::dynamic_pointer_cast;
 
@@ -602,6 +736,61 @@ TEST_F(TestManager, test_keep_roots) {
   ASSERT_TRUE(mng->func_graphs().contains(fg2));
 }
 
+// The analyses updated after each replacement are the same as the ones computed from scratch. The costs of the
+// replacements with the analyses recomputed and invalidated incrementally are only logged.
+TEST_F(TestManager, test_incremental_invalidation) {
+  std::vector<BlockNodes> reset_blocks;
+  auto reset_mng = Manage(MakeBlockNetwork(kBlockNum, &reset_blocks));
+  QueryAnalyses(reset_mng);
+  double reset_cost = ReplaceLeaves(reset_mng, reset_blocks, true);
+
+  std::vector<BlockNodes> blocks;
+  auto mng = Manage(MakeBlockNetwork(kBlockNum, &blocks));
+  QueryAnalyses(mng);
+  double cost = ReplaceLeaves(mng, blocks, false);
+  ASSERT_EQ(mng->func_graphs().size(), 1 + kBlockNum * 4);
+
+  auto incremental = DumpAnalyses(mng);
+  mng->signals()->InvalidateComputer();
+  ASSERT_EQ(incremental, DumpAnalyses(mng));
+  MS_LOG(INFO) << kBlockNum << " replacements take " << reset_cost << " ms with the analyses recomputed, "
+               << cost << " ms with the analyses invalidated incrementally.";
+}
+
+// The analyses stay right when the replacements change the free variables of a func graph, and so its parent:
+// inner_i captures p instead of y, then both y and p, then nothing, and block_i stops capturing p. With both y and p,
+// inner_i has two parents and the leaf replaced in block_i changes the parent of none of inner_i and helper_i, which
+// do not use the leaf.
+TEST_F(TestManager, test_incremental_invalidation_free_variables) {
+  constexpr size_t kFVBlockNum = 4;
+  std::vector<BlockNodes> blocks;
+  auto root = MakeBlockNetwork(kFVBlockNum, &blocks);
+  auto mng = Manage(root);
+  auto p = root->parameters()[1];
+  CheckAnalyses(mng);
+  for (auto &nodes : blocks) {
+    auto y = nodes.block->parameters()[0];
+    auto z = nodes.inner->parameters()[0];
+    mng->SetEdge(nodes.inner_out, 2, p);
+    CheckAnalyses(mng);
+    EXPECT_EQ(mng->parent(nodes.inner), root);
+    mng->SetEdge(nodes.inner_out, 2, nodes.inner->NewCNode({NewValueNode(prim::kPrimScalarAdd), y, p}));
+    CheckAnalyses(mng);
+    EXPECT_EQ(mng->parent(nodes.inner), nodes.block);
+    (void)mng->Replace(nodes.leaf_node, NewValueNode(MakeLeafGraph()));
+    CheckAnalyses(mng);
+    mng->SetEdge(nodes.inner_out, 2, z);
+    CheckAnalyses(mng);
+    EXPECT_EQ(mng->parent(nodes.inner), nullptr);
+    mng->SetEdge(nodes.block_out, 2, y);
+    CheckAnalyses(mng);
+    EXPECT_EQ(mng->parent(nodes.block), nullptr);
+  }
+  for (auto &item : mng->free_variables_total()) {
+    EXPECT_TRUE(item.second.empty());
+  }
+}
+
 TEST_F(TestManager, test_keep_roots_recursion) {
   return;
 
@@ -0,0 +1,191 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/elementwise_engine.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+size_t ShapeSize(const std::vector<size_t> &shape) {
+  size_t size = 1;
+  for (auto dim : shape) {
+    size *= dim;
+  }
+  return size;
+}
+
+// Reference broadcast computing the input indices of each output element.
+template <typename T, typename Op>
+std::vector<float> NaiveBinary(const std::vector<size_t> &shape0, const std::vector<T> &input0,
+                               const std::vector<size_t> &shape1, const std::vector<T> &input1,
+                               const std::vector<size_t> &out_shape, const Op &op) {
+  std::vector<float> output(ShapeSize(out_shape));
+  size_t rank = out_shape.size();
+  for (size_t pos = 0; pos < output.size(); ++pos) {
+    size_t rest = pos;
+    size_t offset0 = 0;
+    size_t offset1 = 0;
+    size_t stride0 = 1;
+    size_t stride1 = 1;
+    for (size_t dim = rank; dim > 0; --dim) {
+      size_t index = rest % out_shape[dim - 1];
+      rest /= out_shape[dim - 1];
+      if (dim + shape0.size() > rank) {
+        size_t dim0 = shape0[dim + shape0.size() - rank - 1];
+        offset0 += (dim0 == 1 ? 0 : index) * stride0;
+        stride0 *= dim0;
+      }
+      if (dim + shape1.size() > rank) {
+        size_t dim1 = shape1[dim + shape1.size() - rank - 1];
+        offset1 += (dim1 == 1 ? 0 : index) * stride1;
+        stride1 *= dim1;
+      }
+    }
+    output[pos] = static_cast<float>(op(input0[offset0], input1[offset1]));
+  }
+  return output;
+}
+
+template <typename T, typename Op>
+void CheckBinary(const std::vector<size_t> &shape0, const std::vector<size_t> &shape1,
+                 const std::vector<size_t> &out_shape, const Op &op) {
+  std::vector<T> input0(ShapeSize(shape0));
+  std::vector<T> input1(ShapeSize(shape1));
+  for (size_t i = 0; i < input0.size(); ++i) {
+    input0[i] = T(static_cast<float>(i % 13) - 6);
+  }
+  for (size_t i = 0; i < input1.size(); ++i) {
+    input1[i] = T(static_cast<float>(i % 7) + 1);
+  }
+  BroadcastPlan plan;
+  ASSERT_TRUE(ElementwiseEngine::InitBroadcastPlan(shape0, shape1, &plan));
+  ASSERT_EQ(plan.output_size, ShapeSize(out_shape));
+  std::vector<T> output(plan.output_size);
+  ElementwiseEngine::Binary(plan, input0.data(), input1.data(), output.data(), op);
+  auto expect = NaiveBinary(shape0, input0, shape1, input1, out_shape, op);
+  for (size_t i = 0; i < output.size(); ++i) {
+    ASSERT_NEAR(static_cast<float>(output[i]), expect[i], 1e-2 * (1 + std::fabs(expect[i])));
+  }
+}
+
+// A fused expression of several ops, computed in one pass.
+struct MulAddSquareFunc {
+  template <typename V>
+  V operator()(const V &x, const V &y) const {
+    V sum = x * y + x;
+    return sum * sum;
+  }
+};
+}  // namespace
+
+class ElementwiseEngineTest : public UT::Common {
+ public:
+  ElementwiseEngineTest() = default;
+};
+
+TEST_F(ElementwiseEngineTest, BroadcastPlan) {
+  BroadcastPlan plan;
+  ASSERT_TRUE(ElementwiseEngine::InitBroadcastPlan({2, 3, 4}, {2, 3, 4}, &plan));
+  EXPECT_EQ(plan.outer_count, 1);
+  EXPECT_EQ(plan.inner_size, 24);
+
+  ASSERT_TRUE(ElementwiseEngine::InitBroadcastPlan({2, 3, 4}, {}, &plan));
+  EXPECT_EQ(plan.inner_size, 24);
+  EXPECT_EQ(plan.inner_step1, 0);
+
+  ASSERT_TRUE(ElementwiseEngine::InitBroadcastPlan({5, 2, 3}, {5, 1, 1}, &plan));
+  EXPECT_EQ(plan.outer_count, 5);
+  EXPECT_EQ(plan.inner_size, 6);
+  EXPECT_EQ(plan.inner_step0, 1);
+  EXPECT_EQ(plan.inner_step1, 0);
+  EXPECT_EQ(plan.outer_strides1[0], 1);
+
+  EXPECT_FALSE(ElementwiseEngine::InitBroadcastPlan({2, 3}, {3, 2}, &plan));
+}
+
+TEST_F(ElementwiseEngineTest, BinaryFloat32) {
+  CheckBinary<float>({1000}, {1000}, {1000}, AddFunc());
+  CheckBinary<float>({1000}, {}, {1000}, SubFunc());
+  CheckBinary<float>({40000}, {1}, {40000}, SubFunc());
+  CheckBinary<float>({}, {37}, {37}, DivFunc());
+  CheckBinary<float>({4, 1, 37}, {3, 1}, {4, 3, 37}, MulFunc());
+  CheckBinary<float>({7, 1, 5, 1}, {1, 9, 1, 11}, {7, 9, 5, 11}, SquaredDifferenceFunc());
+  CheckBinary<float>({300, 200}, {200}, {300, 200}, MulAddSquareFunc());
+}
+
+TEST_F(ElementwiseEngineTest, BinaryInt32) {
+  CheckBinary<int>({3, 65}, {3, 65}, {3, 65}, MulFunc());
+  CheckBinary<int>({3, 65}, {3, 1}, {3, 65}, DivFunc());
+  CheckBinary<int>({1, 17}, {9, 1}, {9, 17}, SquaredDifferenceFunc());
+}
+
+TEST_F(ElementwiseEngineTest, DivideByZero) {
+  BroadcastPlan plan;
+  ASSERT_TRUE(ElementwiseEngine::InitBroadcastPlan({3, 65}, {3, 65}, &plan));
+  std::vector<int> int_input0(plan.output_size, 6);
+  std::vector<int> int_input1(plan.output_size, 3);
+  std::vector<int> int_output(plan.output_size);
+  std::atomic<bool> divided_by_zero{false};
+  ElementwiseEngine::Binary(plan, int_input0.data(), int_input1.data(), int_output.data(),
+                            CheckedIntDivFunc{&divided_by_zero});
+  EXPECT_FALSE(divided_by_zero.load());
+  EXPECT_EQ(int_output[100], 2);
+  int_input1[100] = 0;
+  ElementwiseEngine::Binary(plan, int_input0.data(), int_input1.data(), int_output.data(),
+                            CheckedIntDivFunc{&divided_by_zero});
+  EXPECT_TRUE(divided_by_zero.load());
+  EXPECT_EQ(int_output[100], 0);
+  EXPECT_EQ(int_output[101], 2);
+
+  // float division by zero is not an error
+  std::vector<float> float_input0(plan.output_size, 1);
+  std::vector<float> float_input1(plan.output_size, 0);
+  std::vector<float> float_output(plan.output_size);
+  ElementwiseEngine::Binary(plan, float_input0.data(), float_input1.data(), float_output.data(), DivFunc());
+  EXPECT_EQ(float_output[0], std::numeric_limits<float>::infinity());
+}
+
+TEST_F(ElementwiseEngineTest, BinaryFloat16) {
+  CheckBinary<float16>({600}, {600}, {600}, AddFunc());
+  CheckBinary<float16>({2, 300}, {1}, {2, 300}, SquaredDifferenceFunc());
+  CheckBinary<float16>({5, 1}, {1, 70}, {5, 70}, DivFunc());
+}
+
+TEST_F(ElementwiseEngineTest, Unary) {
+  std::vector<float> input(1003);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i) / 7;
+  }
+  std::vector<float> output(input.size());
+  ElementwiseEngine::Unary(input.data(), output.data(), input.size(), SqrtFunc());
+  for (size_t i = 0; i < input.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], std::sqrt(input[i]));
+  }
+  std::vector<float16> half_input(input.begin(), input.end());
+  std::vector<float16> half_output(input.size());
+  ElementwiseEngine::Unary(half_input.data(), half_output.data(), half_input.size(), SquareFunc());
+  for (size_t i = 0; i < input.size(); ++i) {
+    float value = static_cast<float>(half_input[i]);
+    EXPECT_NEAR(static_cast<float>(half_output[i]), value * value, 1e-2 * (1 + value * value));
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
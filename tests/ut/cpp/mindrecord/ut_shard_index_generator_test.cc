@@ -17,11 +17,15 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
@@ -29,9 +33,12 @@
 
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
 #include "minddata/mindrecord/include/shard_error.h"
+#include "minddata/mindrecord/include/shard_index_file.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_index.h"
+#include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_statistics.h"
 #include "securec.h"
 #include "ut_common.h"
@@ -81,5 +88,221 @@ TEST_F(TestShardIndexGenerator, TakeFieldType) {
   auto type5 = ShardIndexGenerator::TakeFieldType("label", schema2);
   ASSERT_EQ("array", type5);
 }
+
+static std::vector<std::string> ReadAllLabels(const std::string &file_name, const std::vector<std::string> &columns) {
+  std::vector<std::string> labels;
+  ShardReader dataset;
+  if (dataset.Open({file_name}, true, 4, columns) != SUCCESS) {
+    return labels;
+  }
+  dataset.Launch();
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      labels.emplace_back(std::get<1>(j).dump());
+    }
+  }
+  dataset.Close();
+  return labels;
+}
+
+TEST_F(TestShardIndexGenerator, CompactIndexFile) {
+  MS_LOG(INFO) << FormatInfo("Test ShardIndexFile: write and load");
+  std::string file_name = "./compact_index_test.idx";
+  std::vector<std::pair<std::string, std::string>> fields = {
+    {"label_0", "INTEGER"}, {"score_0", "NUMERIC"}, {"file_name_0", "TEXT"}};
+  std::vector<ShardIndexFile::Row> rows(3);
+  for (int i = 0; i < 3; ++i) {
+    rows[i].row_id = 2 - i;
+    for (int c = 0; c < ShardIndexFile::kNumIndexColumn; ++c) {
+      rows[i].index[c] = (2 - i) * 100 + c;
+    }
+    rows[i].fields = {std::to_string(2 - i), std::to_string(0.5 * (2 - i)), "image_" + std::to_string(2 - i)};
+  }
+  ShardIndexFile::ShardDigest digest;
+  digest.shard_size = 1 << 20;
+  digest.header_checksum = 12345;
+  ASSERT_EQ(SUCCESS, ShardIndexFile::Write(file_name, "compact_index_test", digest, fields, &rows));
+
+  ShardIndexFile index_file;
+  ASSERT_EQ(SUCCESS, index_file.Load(file_name));
+  ASSERT_EQ("compact_index_test", index_file.GetShardName());
+  ASSERT_EQ(3u, index_file.GetNumRows());
+  ASSERT_TRUE(index_file.MatchShard(digest));
+  digest.header_checksum++;
+  ASSERT_FALSE(index_file.MatchShard(digest));
+  int label_id = index_file.GetFieldId("label_0");
+  int score_id = index_file.GetFieldId("score_0");
+  int name_id = index_file.GetFieldId("file_name_0");
+  ASSERT_EQ(-1, index_file.GetFieldId("label_1"));
+  ASSERT_EQ(ShardIndexFile::kFieldText, index_file.GetFieldType(name_id));
+  // rows are sorted by row id
+  for (uint64_t i = 0; i < 3; ++i) {
+    for (int c = 0; c < ShardIndexFile::kNumIndexColumn; ++c) {
+      auto column = index_file.GetIndexColumn(static_cast<ShardIndexFile::IndexColumn>(c));
+      ASSERT_EQ(static_cast<int64_t>(i * 100 + c), column[i]);
+    }
+    ASSERT_EQ(static_cast<int64_t>(i), index_file.GetInteger(label_id, i));
+    ASSERT_DOUBLE_EQ(0.5 * i, index_file.GetFloat(score_id, i));
+    ASSERT_EQ("image_" + std::to_string(i), index_file.GetText(name_id, i));
+  }
+
+  // text offsets out of order are rejected, GetText would read outside of the text
+  {
+    std::fstream file(file_name, std::ios::in | std::ios::out | std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    uint64_t offsets[] = {0, 7, 14, 21};
+    auto pos = content.find(std::string(reinterpret_cast<char *>(offsets), sizeof(offsets)));
+    ASSERT_NE(std::string::npos, pos);
+    uint64_t corrupt_offset = 100;
+    file.seekp(pos + sizeof(uint64_t));
+    file.write(reinterpret_cast<char *>(&corrupt_offset), sizeof(corrupt_offset));
+  }
+  ShardIndexFile corrupted;
+  ASSERT_EQ(FAILED, corrupted.Load(file_name));
+
+  // a truncated file is rejected
+  ASSERT_EQ(0, truncate(common::SafeCStr(file_name), 64));
+  ShardIndexFile truncated;
+  ASSERT_EQ(FAILED, truncated.Load(file_name));
+  remove(common::SafeCStr(file_name));
+}
+
+TEST_F(TestShardIndexGenerator, CompactIndexReader) {
+  MS_LOG(INFO) << FormatInfo("Test ShardReader: read with compact index");
+  ShardWriterImageNet();
+  std::string file_name = "./imagenet.shard01";
+  ShardIndexGenerator sg{file_name, true, true};
+  ASSERT_EQ(SUCCESS, sg.Build());
+  ASSERT_EQ(SUCCESS, sg.WriteToDatabase());
+  ShardIndexFile shard_index_file;
+  ASSERT_EQ(SUCCESS, shard_index_file.Load(file_name + ".idx"));
+
+  auto columns = std::vector<std::string>{"file_name", "label"};
+  auto time_start = std::chrono::steady_clock::now();
+  auto labels_index_file = ReadAllLabels(file_name, columns);
+  auto time_index_file = std::chrono::steady_clock::now() - time_start;
+  for (int i = 1; i <= 4; i++) {
+    remove(common::SafeCStr(std::string("./imagenet.shard0") + std::to_string(i) + ".idx"));
+  }
+  time_start = std::chrono::steady_clock::now();
+  auto labels_db = ReadAllLabels(file_name, columns);
+  auto time_db = std::chrono::steady_clock::now() - time_start;
+  MS_LOG(INFO) << "Read " << labels_db.size() << " rows, with compact index: "
+               << std::chrono::duration_cast<std::chrono::microseconds>(time_index_file).count()
+               << " us, with sqlite index: " << std::chrono::duration_cast<std::chrono::microseconds>(time_db).count()
+               << " us.";
+  ASSERT_EQ(labels_db, labels_index_file);
+
+  // an index file not matching the rows or the header of its shard is not used, the rows are read with sqlite
+  std::vector<std::pair<std::string, std::string>> fields = {{"file_name_0", "TEXT"}, {"label_0", "INTEGER"}};
+  ShardIndexFile::ShardDigest digest;
+  ASSERT_EQ(SUCCESS, ShardIndexFile::GetShardDigest(file_name, &digest));
+  std::vector<ShardIndexFile::Row> rows;
+  ASSERT_EQ(SUCCESS, ShardIndexFile::Write(file_name + ".idx", "imagenet.shard01", digest, fields, &rows));
+  ASSERT_EQ(labels_db, ReadAllLabels(file_name, columns));
+  rows.resize(shard_index_file.GetNumRows());
+  for (auto &row : rows) {
+    row.fields = {"", ""};
+  }
+  digest.header_checksum++;
+  ASSERT_EQ(SUCCESS, ShardIndexFile::Write(file_name + ".idx", "imagenet.shard01", digest, fields, &rows));
+  ASSERT_EQ(labels_db, ReadAllLabels(file_name, columns));
+  remove(common::SafeCStr(file_name + ".idx"));
+
+  for (int i = 1; i <= 4; i++) {
+    string filename = std::string("./imagenet.shard0") + std::to_string(i);
+    remove(common::SafeCStr(filename));
+    remove(common::SafeCStr(filename + ".db"));
+  }
+}
+
+// Opens the dataset and creates its read tasks, returns the fastest of repeat runs in microseconds.
+static int64_t TimeReaderStartup(const std::string &file_name, int repeat, int *num_rows) {
+  int64_t best = -1;
+  for (int i = 0; i < repeat; ++i) {
+    ShardReader dataset;
+    auto time_start = std::chrono::steady_clock::now();
+    if (dataset.Open({file_name}, true, 4, {"file_name", "label"}) != SUCCESS || dataset.Launch(true) != SUCCESS) {
+      return -1;
+    }
+    auto time_cost = std::chrono::steady_clock::now() - time_start;
+    *num_rows = dataset.GetNumRows();
+    dataset.Close();
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(time_cost).count();
+    best = best < 0 ? cost : std::min(best, static_cast<int64_t>(cost));
+  }
+  return best;
+}
+
+// A benchmark, run it with --gtest_also_run_disabled_tests. It writes 320000 rows unless the number of rows is set by
+// MS_BENCHMARK_MINDRECORD_ROWS, e.g. 10000000.
+TEST_F(TestShardIndexGenerator, DISABLED_CompactIndexStartupBenchmark) {
+  MS_LOG(INFO) << FormatInfo("Test ShardReader: startup with compact index and sqlite index");
+  const int shard_count = 16;
+  const char *row_count_env = std::getenv("MS_BENCHMARK_MINDRECORD_ROWS");
+  const int row_count = row_count_env == nullptr ? 320000 : std::atoi(row_count_env);
+  const int batch_size = 100000;
+  const int repeat = 5;
+  ASSERT_GT(row_count, 0);
+
+  ShardHeader header_data;
+  json anno_schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}})"_json;
+  auto anno_schema = Schema::Build("annotation", anno_schema_json);
+  ASSERT_NE(anno_schema, nullptr);
+  uint64_t anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(SUCCESS, header_data.AddIndexFields({{anno_schema_id, "file_name"}, {anno_schema_id, "label"}}));
+
+  std::vector<std::string> file_names;
+  for (int i = 0; i < shard_count; ++i) {
+    file_names.emplace_back("./compact_index_bench.shard" + std::to_string(i));
+  }
+  {
+    ShardWriter fw_init;
+    ASSERT_EQ(SUCCESS, fw_init.Open(file_names));
+    ASSERT_EQ(SUCCESS, fw_init.SetShardHeader(std::make_shared<ShardHeader>(header_data)));
+    ASSERT_EQ(SUCCESS, fw_init.Commit());
+  }
+  {
+    // written in batches to bound the memory of the rows
+    ShardWriter fw;
+    ASSERT_EQ(SUCCESS, fw.OpenForAppend(file_names[0]));
+    for (int start = 0; start < row_count; start += batch_size) {
+      std::vector<json> annotations;
+      std::vector<std::vector<uint8_t>> bin_data;
+      for (int i = start; i < std::min(start + batch_size, row_count); ++i) {
+        annotations.push_back(json{{"file_name", "image_" + std::to_string(i) + ".jpg"}, {"label", i % 1000}});
+        bin_data.emplace_back(64, static_cast<uint8_t>(i));
+      }
+      std::map<uint64_t, std::vector<json>> raw_data = {{anno_schema_id, annotations}};
+      ASSERT_EQ(SUCCESS, fw.WriteRawData(raw_data, bin_data));
+    }
+    ASSERT_EQ(SUCCESS, fw.Commit());
+  }
+  ShardIndexGenerator sg{file_names[0], false, true};
+  ASSERT_EQ(SUCCESS, sg.Build());
+  ASSERT_EQ(SUCCESS, sg.WriteToDatabase());
+
+  int rows_index_file = 0;
+  auto time_index_file = TimeReaderStartup(file_names[0], repeat, &rows_index_file);
+  for (const auto &file_name : file_names) {
+    remove(common::SafeCStr(file_name + ".idx"));
+  }
+  int rows_db = 0;
+  auto time_db = TimeReaderStartup(file_names[0], repeat, &rows_db);
+  MS_LOG(INFO) << "Start a reader of " << rows_db << " rows in " << shard_count
+               << " shards, with compact index: " << time_index_file << " us, with sqlite index: " << time_db
+               << " us.";
+  ASSERT_GE(time_index_file, 0);
+  ASSERT_GE(time_db, 0);
+  ASSERT_EQ(row_count, rows_index_file);
+  ASSERT_EQ(row_count, rows_db);
+
+  for (const auto &file_name : file_names) {
+    remove(common::SafeCStr(file_name));
+    remove(common::SafeCStr(file_name + ".db"));
+  }
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -14,11 +14,14 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "utils/ms_utils.h"
@@ -194,5 +197,46 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Close();
 }
+
+TEST_F(TestShardReader, TestShardReaderPrefetch) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with read-ahead");
+  std::string file_name = "./imagenet.shard01";
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({file_name}, true, 4), SUCCESS);
+  dataset.SetPrefetchWindow(16);
+  ASSERT_EQ(dataset.Launch(true), SUCCESS);
+  ShardReader expected_dataset;
+  ASSERT_EQ(expected_dataset.Open({file_name}, true, 4), SUCCESS);
+  ASSERT_EQ(expected_dataset.Launch(true), SUCCESS);
+  ASSERT_EQ(expected_dataset.GetPrefetchStats().backend, "");
+
+  // the window is filled before any row is read
+  int64_t num_rows = dataset.GetNumRows();
+  for (int i = 0; i < 1000 && dataset.GetPrefetchStats().prefetched_rows < std::min<int64_t>(16, num_rows); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  auto stats = dataset.GetPrefetchStats();
+  ASSERT_NE(stats.backend, "");
+  ASSERT_EQ(stats.window, std::min<int64_t>(16, num_rows));
+  ASSERT_EQ(stats.prefetched_rows, std::min<int64_t>(16, num_rows));
+  ASSERT_GT(stats.read_requests, 0);
+  ASSERT_GT(stats.read_bytes, 0);
+
+  for (int64_t i = 0; i < num_rows; ++i) {
+    auto slice = dataset.GetNextSliceById(i, 0);
+    auto row = expected_dataset.GetNextById(i, 0);
+    ASSERT_EQ(slice.second.size(), 1);
+    ASSERT_EQ(row.second.size(), 1);
+    auto &blob = std::get<0>(slice.second[0]);
+    auto &expected = std::get<0>(row.second[0]);
+    ASSERT_EQ(blob.size, expected.size());
+    ASSERT_EQ(memcmp(blob.data, expected.data(), blob.size), 0);
+  }
+  stats = dataset.GetPrefetchStats();
+  ASSERT_EQ(stats.hit_rows + stats.miss_rows, num_rows);
+  ASSERT_GT(stats.hit_rows, 0);
+  dataset.Close();
+  expected_dataset.Close();
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 
@@ -82,6 +83,9 @@ class TestOptOpt : public UT::Common {
     elim_R = MakeSubstitution(std::make_shared<irpass::PrimEliminater>(R), "elim_R", R);
     idempotent_P = MakeSubstitution(std::make_shared<IdempotentEliminater>(), "idempotent_P", P);
     Qct_to_P = MakeSubstitution(std::make_shared<QctToP>(), "Qct_to_P", Q);
+    // not indexed by primitive, the sweep matches it against every node
+    elim_R_any = MakeSubstitution(std::make_shared<irpass::PrimEliminater>(R), "elim_R_any",
+                                  [](const AnfNodePtr &node) { return IsPrimitiveCNode(node, R); });
   }
 
   bool CheckTransform(FuncGraphPtr gbefore, FuncGraphPtr gafter, const SubstitutionList &transform) {
@@ -100,6 +104,22 @@ class TestOptOpt : public UT::Common {
     return CheckTransform(before, after, eq);
   }
 
+  // Applies the list in one sweep and with a traversal per substitution, both must give the after graph.
+  bool CheckTraversals(FuncGraphPtr before, FuncGraphPtr after, const std::vector<SubstitutionPtr> &opts,
+                       bool is_once = false) {
+    SubstitutionList traversal(opts, is_once);
+    (void)setenv(kEnvSubstitutionSweep, "1", 1);
+    SubstitutionList sweep(opts, is_once);
+    (void)unsetenv(kEnvSubstitutionSweep);
+    bool sweep_ok = CheckTransform(before, after, sweep);
+    bool traversal_ok = CheckTransform(before, after, traversal);
+    sweep_visited = sweep.visited_nodes();
+    traversal_visited = traversal.visited_nodes();
+    MS_LOG(INFO) << "Visited nodes in one sweep: " << sweep_visited
+                 << ", with a traversal per substitution: " << traversal_visited;
+    return sweep_ok && traversal_ok;
+  }
+
  public:
   UT::PyFuncGraphFetcher getPyFun;
 
@@ -114,6 +134,10 @@ class TestOptOpt : public UT::Common {
   SubstitutionPtr elim_R;
   SubstitutionPtr idempotent_P;
   SubstitutionPtr Qct_to_P;
+  SubstitutionPtr elim_R_any;
+
+  size_t sweep_visited{0};
+  size_t traversal_visited{0};
 };
 
 const PrimitivePtr TestOptOpt::P = std::make_shared<Primitive>("P");
@@ -177,6 +201,58 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, TraversalsSameResult) {
+  FuncGraphPtr after_zero = getPyFun.CallAndParseRet("test_add_zero", "after");
+  ASSERT_TRUE(CheckTraversals(getPyFun.CallAndParseRet("test_add_zero", "before_1"), after_zero, {elim_Z}));
+  ASSERT_TRUE(CheckTraversals(getPyFun.CallAndParseRet("test_add_zero", "before_2"), after_zero, {elim_Z}));
+  ASSERT_TRUE(CheckTraversals(getPyFun.CallAndParseRet("test_elimR", "before_1"),
+                              getPyFun.CallAndParseRet("test_elimR", "after"), {elim_R}));
+  FuncGraphPtr after_idempotent = getPyFun.CallAndParseRet("test_idempotent", "after");
+  ASSERT_TRUE(CheckTraversals(getPyFun.CallAndParseRet("test_idempotent", "before_1"), after_idempotent,
+                              {idempotent_P}));
+  ASSERT_TRUE(CheckTraversals(getPyFun.CallAndParseRet("test_idempotent", "before_2"), after_idempotent,
+                              {idempotent_P}));
+  ASSERT_TRUE(CheckTraversals(getPyFun.CallAndParseRet("test_constant_variable", "before_1"),
+                              getPyFun.CallAndParseRet("test_constant_variable", "after"), {Qct_to_P}));
+}
+
+// The replaced nodes and their users are matched again, so one substitution may enable another in a single sweep.
+TEST_F(TestOptOpt, SubstitutionSweep) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_substitution_sweep", "before");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_substitution_sweep", "after");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  ASSERT_TRUE(CheckTraversals(before, after, {idempotent_P, elim_R}));
+  ASSERT_TRUE(CheckTraversals(before, after, {elim_R, idempotent_P}));
+  // the substitutions matching any node keep their place in the list
+  ASSERT_TRUE(CheckTraversals(before, after, {elim_R_any, idempotent_P}));
+  ASSERT_TRUE(CheckTraversals(before, after, {idempotent_P, elim_R_any}));
+}
+
+// A list applied once is not swept, idempotent_P sees no P(P(x)) before elim_R removes the R nodes.
+TEST_F(TestOptOpt, SubstitutionOnce) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_substitution_sweep", "before");
+  FuncGraphPtr after_once = getPyFun.CallAndParseRet("test_substitution_sweep", "after_once");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after_once);
+  ASSERT_TRUE(CheckTraversals(before, after_once, {idempotent_P, elim_R}, true));
+  ASSERT_EQ(sweep_visited, traversal_visited);
+}
+
+TEST_F(TestOptOpt, SubstitutionSweepMix) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_substitution_mix", "before");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_substitution_mix", "after");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  ASSERT_TRUE(CheckTraversals(before, after, {elim_Z, elim_R, idempotent_P, Qct_to_P}));
+  ASSERT_LT(sweep_visited, traversal_visited);
+  ASSERT_TRUE(CheckTraversals(before, after, {Qct_to_P, idempotent_P, elim_R_any, elim_Z}));
+  ASSERT_LT(sweep_visited, traversal_visited);
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/embedding_cache.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+namespace {
+constexpr uint64_t kTable = 7;
+constexpr size_t kRowNum = 1000;
+constexpr size_t kRowSize = 8;
+
+// An embedding table served locally, counting the rows workers fetch from it.
+class LocalServer {
+ public:
+  LocalServer() : table_(kRowNum * kRowSize) {
+    for (size_t i = 0; i < table_.size(); ++i) {
+      table_[i] = static_cast<float>(i);
+    }
+  }
+
+  EmbeddingCache<float>::FetchFunc fetch() {
+    return [this](const std::vector<int> &ids, float *rows) {
+      for (size_t i = 0; i < ids.size(); ++i) {
+        for (size_t j = 0; j < kRowSize; ++j) {
+          rows[i * kRowSize + j] = table_[ids[i] * kRowSize + j];
+        }
+      }
+      fetched_rows_ += ids.size();
+    };
+  }
+
+  void Update(int id, float delta) {
+    for (size_t j = 0; j < kRowSize; ++j) {
+      table_[id * kRowSize + j] += delta;
+    }
+  }
+
+  float value(int id) const { return table_[id * kRowSize]; }
+  size_t fetched_rows() const { return fetched_rows_; }
+
+ private:
+  std::vector<float> table_;
+  size_t fetched_rows_{0};
+};
+
+EmbeddingCacheConfig Config(size_t capacity, EmbeddingCachePolicy policy, size_t max_staleness) {
+  EmbeddingCacheConfig config;
+  config.capacity = capacity;
+  config.policy = policy;
+  config.max_staleness = max_staleness;
+  return config;
+}
+
+// The first column of the row of id looked up through the cache.
+float LookupOne(EmbeddingCache<float> *cache, LocalServer *server, int id) {
+  std::vector<float> output(kRowSize);
+  cache->Lookup(kTable, &id, 1, kRowSize, output.data(), server->fetch());
+  return output[0];
+}
+}  // namespace
+
+class EmbeddingCacheTest : public UT::Common {
+ public:
+  EmbeddingCacheTest() = default;
+};
+
+// Ids of a zipf like distribution as recommendation workloads have, with the hit rate and latency counters.
+TEST_F(EmbeddingCacheTest, SkewedLookups) {
+  LocalServer server;
+  EmbeddingCache<float> cache(Config(200, EmbeddingCachePolicy::kLFU, 0));
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  const size_t batch = 256;
+  const size_t steps = 100;
+  std::vector<int> ids(batch);
+  std::vector<float> output(batch * kRowSize);
+  for (size_t step = 0; step < steps; ++step) {
+    for (auto &id : ids) {
+      id = static_cast<int>(std::pow(kRowNum, uniform(engine))) - 1;
+    }
+    cache.Lookup(kTable, ids.data(), ids.size(), kRowSize, output.data(), server.fetch());
+    for (size_t i = 0; i < batch; ++i) {
+      for (size_t j = 0; j < kRowSize; ++j) {
+        ASSERT_EQ(output[i * kRowSize + j], ids[i] * kRowSize + j);
+      }
+    }
+  }
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.lookups, steps);
+  EXPECT_EQ(stats.hits + stats.misses, batch * steps);
+  EXPECT_GT(stats.hit_rate(), 0.6);
+  EXPECT_LT(server.fetched_rows(), stats.misses + 1);
+  EXPECT_GT(stats.lookup_us, 0);
+  MS_LOG(INFO) << "Hit rate: " << stats.hit_rate() << ", rows fetched: " << server.fetched_rows() << " of "
+               << batch * steps << ", average lookup latency: " << stats.lookup_us / stats.lookups << "us";
+}
+
+TEST_F(EmbeddingCacheTest, DuplicateIdsFetchedOnce) {
+  LocalServer server;
+  EmbeddingCache<float> cache(Config(10, EmbeddingCachePolicy::kLRU, 0));
+  std::vector<int> ids = {3, 5, 3, 3, 5};
+  std::vector<float> output(ids.size() * kRowSize);
+  cache.Lookup(kTable, ids.data(), ids.size(), kRowSize, output.data(), server.fetch());
+  EXPECT_EQ(server.fetched_rows(), 2);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    EXPECT_EQ(output[i * kRowSize], ids[i] * kRowSize);
+  }
+}
+
+TEST_F(EmbeddingCacheTest, InvalidatedOnPush) {
+  LocalServer server;
+  EmbeddingCache<float> cache(Config(10, EmbeddingCachePolicy::kLRU, 1));
+  EXPECT_EQ(LookupOne(&cache, &server, 3), server.value(3));
+  EXPECT_EQ(LookupOne(&cache, &server, 4), server.value(4));
+  EXPECT_EQ(server.fetched_rows(), 2);
+
+  // the worker pushes row 3, row 4 may still be served
+  server.Update(3, 1);
+  server.Update(4, 1);
+  int pushed = 3;
+  cache.OnPush(kTable, &pushed, 1);
+  EXPECT_EQ(LookupOne(&cache, &server, 3), server.value(3));
+  EXPECT_EQ(LookupOne(&cache, &server, 4), server.value(4) - 1);
+  EXPECT_EQ(server.fetched_rows(), 3);
+
+  // a push of the whole table
+  cache.OnPush(kTable, nullptr, 0);
+  EXPECT_EQ(LookupOne(&cache, &server, 4), server.value(4));
+  EXPECT_EQ(server.fetched_rows(), 4);
+}
+
+// Rows updated by the other workers are served for at most max_staleness pushes.
+TEST_F(EmbeddingCacheTest, StalenessBound) {
+  LocalServer server;
+  EmbeddingCache<float> cache(Config(10, EmbeddingCachePolicy::kLRU, 2));
+  float original = LookupOne(&cache, &server, 5);
+  server.Update(5, 1);
+  int other = 6;
+  for (int push = 1; push <= 2; ++push) {
+    cache.OnPush(kTable, &other, 1);
+    EXPECT_EQ(LookupOne(&cache, &server, 5), original);
+  }
+  cache.OnPush(kTable, &other, 1);
+  EXPECT_EQ(LookupOne(&cache, &server, 5), server.value(5));
+
+  EmbeddingCache<float> fresh_cache(Config(10, EmbeddingCachePolicy::kLRU, 0));
+  EXPECT_EQ(LookupOne(&fresh_cache, &server, 5), server.value(5));
+  server.Update(5, 1);
+  fresh_cache.OnPush(kTable, &other, 1);
+  EXPECT_EQ(LookupOne(&fresh_cache, &server, 5), server.value(5));
+}
+
+TEST_F(EmbeddingCacheTest, Eviction) {
+  for (auto policy : {EmbeddingCachePolicy::kLRU, EmbeddingCachePolicy::kLFU}) {
+    LocalServer server;
+    EmbeddingCache<float> cache(Config(2, policy, 0));
+    (void)LookupOne(&cache, &server, 1);
+    (void)LookupOne(&cache, &server, 1);
+    (void)LookupOne(&cache, &server, 2);
+    // lru evicts 1, used least recently, lfu evicts 2, used least often
+    (void)LookupOne(&cache, &server, 3);
+    EXPECT_EQ(server.fetched_rows(), 3);
+    (void)LookupOne(&cache, &server, policy == EmbeddingCachePolicy::kLRU ? 2 : 1);
+    EXPECT_EQ(server.fetched_rows(), 3);
+    (void)LookupOne(&cache, &server, policy == EmbeddingCachePolicy::kLRU ? 1 : 2);
+    EXPECT_EQ(server.fetched_rows(), 4);
+  }
+}
+
+TEST_F(EmbeddingCacheTest, ConfigFromEnv) {
+  EmbeddingCacheConfig config;
+  EXPECT_FALSE(EmbeddingCache<float>::GetConfigFromEnv(&config));
+  (void)setenv(kEnvEmbeddingCacheSize, "4096", 1);
+  (void)setenv(kEnvEmbeddingCachePolicy, "lfu", 1);
+  (void)setenv(kEnvEmbeddingCacheStaleness, "3", 1);
+  EXPECT_TRUE(EmbeddingCache<float>::GetConfigFromEnv(&config));
+  EXPECT_EQ(config.capacity, 4096);
+  EXPECT_EQ(config.policy, EmbeddingCachePolicy::kLFU);
+  EXPECT_EQ(config.max_staleness, 3);
+  (void)unsetenv(kEnvEmbeddingCacheSize);
+  (void)unsetenv(kEnvEmbeddingCachePolicy);
+  (void)unsetenv(kEnvEmbeddingCacheStaleness);
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/gradient_compression.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+namespace {
+constexpr uint64_t kKey = 3;
+constexpr size_t kGradSize = 1000;
+
+std::vector<float> RandomGrad(std::mt19937 *engine) {
+  std::normal_distribution<float> normal(0, 1);
+  std::vector<float> grad(kGradSize);
+  for (auto &value : grad) {
+    value = normal(*engine);
+  }
+  return grad;
+}
+}  // namespace
+
+class GradientCompressionTest : public UT::Common {
+ public:
+  GradientCompressionTest() = default;
+};
+
+TEST_F(GradientCompressionTest, RoundTrip) {
+  std::mt19937 engine(0);
+  auto grad = RandomGrad(&engine);
+  // the bound of the error of a single encoding, and the size of an encoded gradient
+  std::vector<std::tuple<CompressionType, float, size_t>> cases = {
+    {kCompressionNone, 0, 2 + kGradSize},
+    {kCompressionFp16, 2e-3, 2 + kGradSize / 2},
+    {kCompressionInt8, 3e-2, 3 + kGradSize / 4},
+  };
+  for (auto [type, tolerance, encoded_size] : cases) {
+    GradientCompressor compressor(type, 0.01);
+    std::vector<float> encoded;
+    compressor.Encode(kKey, grad.data(), grad.size(), &encoded);
+    EXPECT_EQ(encoded.size(), encoded_size);
+    std::vector<float> decoded;
+    ASSERT_TRUE(GradientCompressor::Decode(encoded.data(), encoded.size(), &decoded));
+    ASSERT_EQ(decoded.size(), grad.size());
+    for (size_t i = 0; i < grad.size(); ++i) {
+      EXPECT_NEAR(decoded[i], grad[i], tolerance);
+    }
+  }
+}
+
+TEST_F(GradientCompressionTest, TopKKeepsLargest) {
+  std::vector<float> grad(kGradSize, 0.1);
+  grad[17] = -5;
+  grad[400] = 3;
+  GradientCompressor compressor(kCompressionTopK, 0.002);
+  std::vector<float> encoded;
+  compressor.Encode(kKey, grad.data(), grad.size(), &encoded);
+  EXPECT_EQ(encoded.size(), 2 + 1 + 2 * 2);
+  std::vector<float> decoded;
+  ASSERT_TRUE(GradientCompressor::Decode(encoded.data(), encoded.size(), &decoded));
+  for (size_t i = 0; i < kGradSize; ++i) {
+    EXPECT_EQ(decoded[i], i == 17 || i == 400 ? grad[i] : 0);
+  }
+
+  // without error feedback the same elements are sent again
+  std::vector<float> encoded_again;
+  compressor.Encode(grad.data(), grad.size(), &encoded);
+  compressor.Encode(grad.data(), grad.size(), &encoded_again);
+  EXPECT_EQ(encoded, encoded_again);
+  ASSERT_TRUE(GradientCompressor::Decode(encoded.data(), encoded.size(), &decoded));
+  EXPECT_EQ(decoded[17], grad[17]);
+  EXPECT_EQ(decoded[400], grad[400]);
+}
+
+TEST_F(GradientCompressionTest, EmptyGradient) {
+  for (auto type : {kCompressionNone, kCompressionTopK, kCompressionFp16, kCompressionInt8}) {
+    GradientCompressor compressor(type, 0.01);
+    std::vector<float> grad(1);
+    std::vector<float> encoded;
+    compressor.Encode(kKey, grad.data(), 0, &encoded);
+    std::vector<float> decoded(1);
+    ASSERT_TRUE(GradientCompressor::Decode(encoded.data(), encoded.size(), &decoded));
+    EXPECT_TRUE(decoded.empty());
+  }
+}
+
+// The error of each encoding is sent with the later gradients: what the servers receive in total only differs from
+// the sum of the gradients by the residual of the last step.
+TEST_F(GradientCompressionTest, ErrorFeedback) {
+  const size_t steps = 200;
+  for (auto type : {kCompressionTopK, kCompressionInt8}) {
+    std::mt19937 engine(1);
+    GradientCompressor compressor(type, 0.1);
+    std::vector<float> grad_sum(kGradSize, 0);
+    std::vector<float> received_sum(kGradSize, 0);
+    size_t encoded_words = 0;
+    for (size_t step = 0; step < steps; ++step) {
+      auto grad = RandomGrad(&engine);
+      std::vector<float> encoded;
+      compressor.Encode(kKey, grad.data(), grad.size(), &encoded);
+      encoded_words += encoded.size();
+      std::vector<float> decoded;
+      ASSERT_TRUE(GradientCompressor::Decode(encoded.data(), encoded.size(), &decoded));
+      for (size_t i = 0; i < kGradSize; ++i) {
+        grad_sum[i] += grad[i];
+        received_sum[i] += decoded[i];
+      }
+    }
+    double error = 0;
+    double norm = 0;
+    for (size_t i = 0; i < kGradSize; ++i) {
+      error += (grad_sum[i] - received_sum[i]) * (grad_sum[i] - received_sum[i]);
+      norm += grad_sum[i] * grad_sum[i];
+    }
+    double relative_error = std::sqrt(error / norm);
+    EXPECT_LT(relative_error, 0.1);
+    EXPECT_LT(encoded_words, steps * kGradSize / 3);
+    MS_LOG(INFO) << "Compression " << type << ": " << encoded_words * sizeof(float) << " bytes pushed instead of "
+                 << steps * kGradSize * sizeof(float) << ", relative error of the accumulated gradient "
+                 << relative_error;
+  }
+}
+
+TEST_F(GradientCompressionTest, MalformedInput) {
+  std::vector<float> grad(kGradSize, 1);
+  std::vector<float> decoded;
+  EXPECT_FALSE(GradientCompressor::Decode(grad.data(), 1, &decoded));
+  for (auto type : {kCompressionTopK, kCompressionFp16, kCompressionInt8}) {
+    GradientCompressor compressor(type, 0.01);
+    std::vector<float> encoded;
+    compressor.Encode(kKey, grad.data(), grad.size(), &encoded);
+    EXPECT_FALSE(GradientCompressor::Decode(encoded.data(), encoded.size() - 1, &decoded));
+    encoded[0] = 1e-44;
+    EXPECT_FALSE(GradientCompressor::Decode(encoded.data(), encoded.size(), &decoded));
+  }
+}
+
+TEST_F(GradientCompressionTest, TypeFromEnv) {
+  float ratio = 0;
+  EXPECT_EQ(GradientCompressor::GetTypeFromEnv(&ratio), kCompressionNone);
+  (void)setenv(kEnvGradientCompression, "topk", 1);
+  (void)setenv(kEnvGradientTopKRatio, "0.05", 1);
+  EXPECT_EQ(GradientCompressor::GetTypeFromEnv(&ratio), kCompressionTopK);
+  EXPECT_FLOAT_EQ(ratio, 0.05);
+  (void)unsetenv(kEnvGradientCompression);
+  (void)unsetenv(kEnvGradientTopKRatio);
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,256 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/push_pull_controller.h"
+#include "frontend/parallel/ps/request_dispatcher.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+namespace {
+constexpr size_t kKeyNum = 32;
+constexpr size_t kWeightSize = 16384;
+constexpr size_t kWorkerNum = 4;
+constexpr size_t kRounds = 20;
+
+// The request handling of a server without the network: the requests of a key run on its dispatcher thread, the
+// gradients are accumulated and the weights updated through a PushPullController as ParameterServer does.
+class FakeServer {
+ public:
+  FakeServer(size_t thread_num, size_t key_num, size_t weight_size, UpdateMode mode)
+      : dispatcher_(thread_num),
+        controller_(kWorkerNum, mode, 0),
+        weights_(key_num, std::vector<float>(weight_size, 0)),
+        grads_(key_num, std::vector<float>(weight_size, 0)) {
+    std::unique_lock<std::shared_mutex> lock(controller_.keys_mutex());
+    for (size_t key = 0; key < key_num; ++key) {
+      controller_.AddWeight(key, false);
+      controller_.AddGrad(key);
+    }
+  }
+
+  void StartUpdates() {
+    update_thread_ = std::thread([this]() { controller_.UpdateLoop([this](uint64_t key) { Update(key); }); });
+  }
+
+  void Stop() {
+    dispatcher_.Stop();
+    controller_.Stop();
+    if (update_thread_.joinable()) {
+      update_thread_.join();
+    }
+  }
+
+  // Each request runs on the dispatcher thread of key, the worker waits for the response.
+  bool ReadyForPush(size_t key, size_t worker) {
+    return Call(key, [this, key, worker]() { return controller_.ReadyForPush(key, worker); });
+  }
+
+  bool ReadyForPull(size_t key) {
+    return Call(key, [this, key]() { return controller_.ReadyForPull(key); });
+  }
+
+  void Push(size_t key, size_t worker, const std::vector<float> &grad) {
+    (void)Call(key, [this, key, worker, &grad]() {
+      controller_.Push(
+        key, worker,
+        [this, key, &grad]() {
+          auto &accum = grads_[key];
+          for (size_t i = 0; i < accum.size(); ++i) {
+            accum[i] += grad[i];
+          }
+        },
+        [this, key]() { Update(key); });
+      return true;
+    });
+  }
+
+  std::vector<float> Pull(size_t key) {
+    std::vector<float> weight;
+    (void)Call(key, [this, key, &weight]() {
+      controller_.Pull(key, [this, key, &weight]() { weight = weights_[key]; });
+      return true;
+    });
+    return weight;
+  }
+
+  PushPullController *controller() { return &controller_; }
+
+ private:
+  bool Call(size_t key, const std::function<bool()> &request) {
+    std::promise<bool> response;
+    dispatcher_.Dispatch(key, [&request, &response]() { response.set_value(request()); });
+    return response.get_future().get();
+  }
+
+  // Adds the gradients accumulated to the weight. It is not atomic, an update outside of the key lock loses gradients.
+  void Update(size_t key) {
+    auto &weight = weights_[key];
+    auto &accum = grads_[key];
+    for (size_t i = 0; i < weight.size(); ++i) {
+      weight[i] += accum[i];
+      accum[i] = 0;
+    }
+  }
+
+  RequestDispatcher dispatcher_;
+  PushPullController controller_;
+  std::vector<std::vector<float>> weights_;
+  std::vector<std::vector<float>> grads_;
+  std::thread update_thread_;
+};
+
+// Pushes per second of kWorkerNum workers, each pushing all keys for kRounds.
+double PushesPerSecond(FakeServer *server) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t worker = 0; worker < kWorkerNum; ++worker) {
+    workers.emplace_back([server, worker]() {
+      std::vector<float> grad(kWeightSize, 1.0f);
+      for (size_t round = 0; round < kRounds; ++round) {
+        for (size_t i = 0; i < kKeyNum; ++i) {
+          server->Push((i + worker * kKeyNum / kWorkerNum) % kKeyNum, worker, grad);
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (size_t key = 0; key < kKeyNum; ++key) {
+    EXPECT_EQ(server->Pull(key)[kWeightSize - 1], kWorkerNum * kRounds);
+  }
+  server->Stop();
+  return kWorkerNum * kRounds * kKeyNum / std::chrono::duration<double>(end - start).count();
+}
+}  // namespace
+
+class RequestDispatcherTest : public UT::Common {
+ public:
+  RequestDispatcherTest() = default;
+};
+
+TEST_F(RequestDispatcherTest, KeyOrder) {
+  RequestDispatcher dispatcher(4);
+  EXPECT_EQ(dispatcher.thread_num(), 4);
+  std::vector<std::vector<size_t>> sequences(kKeyNum);
+  std::vector<std::thread::id> threads(kKeyNum);
+  std::atomic<bool> same_thread{true};
+  for (size_t seq = 0; seq < 100; ++seq) {
+    for (size_t key = 0; key < kKeyNum; ++key) {
+      dispatcher.Dispatch(key, [&sequences, &threads, &same_thread, key, seq]() {
+        if (seq == 0) {
+          threads[key] = std::this_thread::get_id();
+        } else if (threads[key] != std::this_thread::get_id()) {
+          same_thread = false;
+        }
+        sequences[key].push_back(seq);
+      });
+    }
+  }
+  dispatcher.Stop();
+  EXPECT_TRUE(same_thread);
+  for (auto &sequence : sequences) {
+    ASSERT_EQ(sequence.size(), 100);
+    for (size_t seq = 0; seq < sequence.size(); ++seq) {
+      EXPECT_EQ(sequence[seq], seq);
+    }
+  }
+}
+
+TEST_F(RequestDispatcherTest, StopRunsPendingRequests) {
+  RequestDispatcher dispatcher(2);
+  std::atomic<size_t> done{0};
+  for (size_t key = 0; key < 1000; ++key) {
+    dispatcher.Dispatch(key, [&done]() { done++; });
+  }
+  dispatcher.Stop();
+  EXPECT_EQ(done, 1000);
+  dispatcher.Dispatch(0, [&done]() { done++; });
+  EXPECT_EQ(done, 1000);
+}
+
+// Workers and server as threads of one process, the weights are updated at each push. A single handler thread is how
+// the server handled requests before, against a handler thread per worker with the striped key mutexes.
+TEST_F(RequestDispatcherTest, PushThroughput) {
+  FakeServer serial_server(1, kKeyNum, kWeightSize, UpdateMode::kAsync);
+  double serial_pushes = PushesPerSecond(&serial_server);
+  FakeServer parallel_server(kWorkerNum, kKeyNum, kWeightSize, UpdateMode::kAsync);
+  double parallel_pushes = PushesPerSecond(&parallel_server);
+  MS_LOG(INFO) << kWorkerNum << " workers pushing " << kKeyNum << " keys of " << kWeightSize
+               << " floats, single handler thread: " << serial_pushes << " pushes/sec, " << kWorkerNum
+               << " handler threads: " << parallel_pushes << " pushes/sec";
+}
+
+// Workers pushing and pulling all keys each round in sync mode, the requests run on the dispatcher threads through the
+// key mutexes and the weights are updated on the update thread. Each pull returns the sum of the gradients pushed up
+// to its round.
+TEST_F(RequestDispatcherTest, SyncPushPull) {
+  constexpr size_t kServerKeyNum = 8;
+  constexpr size_t kServerWeightSize = 1024;
+  FakeServer server(kWorkerNum, kServerKeyNum, kServerWeightSize, UpdateMode::kSync);
+  server.StartUpdates();
+  std::atomic<size_t> wrong_pulls{0};
+  std::vector<std::thread> workers;
+  for (size_t worker = 0; worker < kWorkerNum; ++worker) {
+    workers.emplace_back([&server, &wrong_pulls, worker]() {
+      std::vector<float> grad(kServerWeightSize, worker + 1);
+      for (size_t round = 0; round < kRounds; ++round) {
+        for (size_t key = 0; key < kServerKeyNum; ++key) {
+          while (!server.ReadyForPush(key, worker)) {
+            std::this_thread::yield();
+          }
+          server.Push(key, worker, grad);
+        }
+        float expect = (round + 1) * kWorkerNum * (kWorkerNum + 1) / 2;
+        for (size_t key = 0; key < kServerKeyNum; ++key) {
+          while (!server.ReadyForPull(key)) {
+            std::this_thread::yield();
+          }
+          auto weight = server.Pull(key);
+          if (!std::all_of(weight.begin(), weight.end(), [expect](float value) { return value == expect; })) {
+            wrong_pulls++;
+          }
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  EXPECT_EQ(wrong_pulls, 0);
+  for (size_t key = 0; key < kServerKeyNum; ++key) {
+    EXPECT_EQ(server.controller()->grads_accum_counter(key), 0);
+    EXPECT_EQ(server.controller()->tokens(key), 0);
+  }
+  server.Stop();
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,254 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/ps/push_pull_controller.h"
+#include "frontend/parallel/ps/staleness_controller.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace ps {
+namespace {
+constexpr uint64_t kKey = 5;
+constexpr size_t kWorkerNum = 4;
+constexpr size_t kSlowSteps = 20;
+constexpr double kTarget = 1.0;
+constexpr double kLearningRate = 0.1;
+
+// A server holding one weight, minimizing (w - kTarget)^2 / 2 with the gradients of kWorkerNum workers. The pushes go
+// through the accumulation path of the server, each gradient is applied by the update callback as it arrives. Worker 0
+// is slowed down, the steps each worker finishes before worker 0 has done kSlowSteps are counted.
+class Training {
+ public:
+  Training(UpdateMode mode, size_t staleness) : controller_(kWorkerNum, mode, staleness) {
+    std::unique_lock<std::shared_mutex> lock(controller_.keys_mutex());
+    controller_.AddWeight(kKey, false);
+    controller_.AddGrad(kKey);
+  }
+
+  void Run() {
+    std::vector<std::thread> threads;
+    for (size_t worker = 0; worker < kWorkerNum; ++worker) {
+      threads.emplace_back([this, worker]() { Work(worker); });
+    }
+    threads[0].join();
+    // give the other workers the time to reach the staleness bound
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stop_ = true;
+    for (size_t worker = 1; worker < kWorkerNum; ++worker) {
+      threads[worker].join();
+    }
+  }
+
+  size_t steps(size_t worker) { return controller_.clock(kKey, worker); }
+  double weight() {
+    double weight = 0;
+    controller_.Pull(kKey, [this, &weight]() { weight = weight_; });
+    return weight;
+  }
+
+ private:
+  void Work(size_t worker) {
+    bool slow = worker == 0;
+    while (slow ? steps(worker) < kSlowSteps : !stop_) {
+      // pull, compute the gradient, wait until the push is allowed, push
+      double grad = weight() - kTarget;
+      std::this_thread::sleep_for(slow ? std::chrono::microseconds(5000) : std::chrono::microseconds(100));
+      while (!controller_.ReadyForPush(kKey, worker)) {
+        if (!slow && stop_) {
+          return;
+        }
+        std::this_thread::yield();
+      }
+      controller_.Push(
+        kKey, worker, [this, grad]() { grad_ += grad; },
+        [this]() {
+          weight_ -= kLearningRate * grad_;
+          grad_ = 0;
+        });
+    }
+  }
+
+  PushPullController controller_;
+  double weight_{0};
+  double grad_{0};
+  std::atomic<bool> stop_{false};
+};
+
+// A key of kServerWeightSize zeros, each push adds its gradient to the weight in the update callback. The additions
+// are not atomic, an update outside of the key mutex loses gradients.
+class SumServer {
+ public:
+  explicit SumServer(size_t staleness)
+      : controller_(kWorkerNum, UpdateMode::kSSP, staleness),
+        weight_(kServerWeightSize, 0),
+        grad_(kServerWeightSize, 0) {
+    std::unique_lock<std::shared_mutex> lock(controller_.keys_mutex());
+    controller_.AddWeight(kKey, false);
+    controller_.AddGrad(kKey);
+  }
+
+  void Push(size_t worker, float value) {
+    controller_.Push(
+      kKey, worker,
+      [this, value]() {
+        for (auto &grad : grad_) {
+          grad += value;
+        }
+      },
+      [this]() {
+        for (size_t i = 0; i < weight_.size(); ++i) {
+          weight_[i] += grad_[i];
+          grad_[i] = 0;
+        }
+      });
+  }
+
+  std::vector<float> Pull() {
+    std::vector<float> weight;
+    controller_.Pull(kKey, [this, &weight]() { weight = weight_; });
+    return weight;
+  }
+
+  PushPullController *controller() { return &controller_; }
+
+  static constexpr size_t kServerWeightSize = 1024;
+
+ private:
+  PushPullController controller_;
+  std::vector<float> weight_;
+  std::vector<float> grad_;
+};
+}  // namespace
+
+class StalenessControllerTest : public UT::Common {
+ public:
+  StalenessControllerTest() = default;
+};
+
+// With a staleness bound of 0 every worker goes at the pace of the slowest one.
+TEST_F(StalenessControllerTest, LockStep) {
+  Training training(UpdateMode::kSSP, 0);
+  training.Run();
+  EXPECT_EQ(training.steps(0), kSlowSteps);
+  for (size_t worker = 1; worker < kWorkerNum; ++worker) {
+    EXPECT_EQ(training.steps(worker), kSlowSteps + 1);
+  }
+  EXPECT_NEAR(training.weight(), kTarget, 1e-3);
+}
+
+// The other workers run up to staleness steps ahead of the slowed one.
+TEST_F(StalenessControllerTest, StalenessBound) {
+  const size_t staleness = 3;
+  Training training(UpdateMode::kSSP, staleness);
+  training.Run();
+  for (size_t worker = 1; worker < kWorkerNum; ++worker) {
+    EXPECT_EQ(training.steps(worker), kSlowSteps + staleness + 1);
+  }
+  EXPECT_NEAR(training.weight(), kTarget, 1e-3);
+}
+
+// Without any bound the other workers keep making progress while the slowed one lags behind.
+TEST_F(StalenessControllerTest, Async) {
+  Training training(UpdateMode::kAsync, 0);
+  training.Run();
+  for (size_t worker = 1; worker < kWorkerNum; ++worker) {
+    EXPECT_GT(training.steps(worker), 5 * kSlowSteps);
+    MS_LOG(INFO) << "Worker " << worker << " finished " << training.steps(worker) << " steps while the slowed worker "
+                 << "finished " << kSlowSteps;
+  }
+  EXPECT_NEAR(training.weight(), kTarget, 1e-3);
+}
+
+// In ssp mode a push updates the weight at once, and is counted in the clock of its worker only.
+TEST_F(StalenessControllerTest, ServerPush) {
+  SumServer server(1);
+  auto controller = server.controller();
+  float sum = 0;
+  for (size_t worker = 0; worker < kWorkerNum; ++worker) {
+    EXPECT_TRUE(controller->ReadyForPush(kKey, worker));
+    server.Push(worker, worker + 1);
+    sum += worker + 1;
+    auto weight = server.Pull();
+    EXPECT_EQ(weight[0], sum);
+    EXPECT_EQ(weight[SumServer::kServerWeightSize - 1], sum);
+    EXPECT_TRUE(controller->ReadyForPull(kKey));
+    for (size_t other = 0; other < kWorkerNum; ++other) {
+      EXPECT_EQ(controller->clock(kKey, other), other <= worker ? 1 : 0);
+    }
+  }
+  // A worker more than one push ahead of the slowest one waits with a staleness of 1.
+  server.Push(0, 0);
+  EXPECT_TRUE(controller->ReadyForPush(kKey, 0));
+  server.Push(0, 0);
+  EXPECT_FALSE(controller->ReadyForPush(kKey, 0));
+  EXPECT_TRUE(controller->ReadyForPush(kKey, 1));
+  // The sync mode counters are left as they are.
+  EXPECT_EQ(controller->grads_accum_counter(kKey), 0);
+  EXPECT_EQ(controller->tokens(kKey), 0);
+}
+
+// Workers pushing the same key at the same time in ssp mode, the weight is updated under the key mutex so no gradient
+// is lost.
+TEST_F(StalenessControllerTest, ServerConcurrentPush) {
+  constexpr size_t kSteps = 50;
+  SumServer server(2);
+  auto controller = server.controller();
+  std::vector<std::thread> workers;
+  for (size_t worker = 0; worker < kWorkerNum; ++worker) {
+    workers.emplace_back([&server, controller, worker]() {
+      for (size_t step = 0; step < kSteps; ++step) {
+        while (!controller->ReadyForPush(kKey, worker)) {
+          std::this_thread::yield();
+        }
+        server.Push(worker, worker + 1);
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (size_t worker = 0; worker < kWorkerNum; ++worker) {
+    EXPECT_EQ(controller->clock(kKey, worker), kSteps);
+  }
+  EXPECT_EQ(server.Pull()[SumServer::kServerWeightSize - 1], kSteps * kWorkerNum * (kWorkerNum + 1) / 2);
+}
+
+TEST_F(StalenessControllerTest, ModeFromEnv) {
+  size_t staleness = 1;
+  EXPECT_EQ(StalenessController::GetModeFromEnv(&staleness), UpdateMode::kSync);
+  EXPECT_EQ(staleness, 0);
+  (void)setenv(kEnvPSUpdateMode, "ssp", 1);
+  (void)setenv(kEnvPSStaleness, "4", 1);
+  EXPECT_EQ(StalenessController::GetModeFromEnv(&staleness), UpdateMode::kSSP);
+  EXPECT_EQ(staleness, 4);
+  (void)setenv(kEnvPSUpdateMode, "async", 1);
+  EXPECT_EQ(StalenessController::GetModeFromEnv(&staleness), UpdateMode::kAsync);
+  (void)unsetenv(kEnvPSUpdateMode);
+  (void)unsetenv(kEnvPSStaleness);
+}
+}  // namespace ps
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,225 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <dirent.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ir/func_graph_cloner.h"
+#include "ir/manager.h"
+#include "ir/tensor.h"
+#include "frontend/optimizer/opt.h"
+#include "frontend/operator/ops.h"
+#include "pipeline/jit/compile_cache.h"
+#include "pipeline/jit/resource.h"
+
+namespace mindspore {
+namespace pipeline {
+class TestCompileCache : public UT::Common {
+ public:
+  TestCompileCache() {}
+
+  void SetUp() override {
+    char dir[] = "/tmp/compile_cache_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    path_ = dir;
+  }
+
+  void TearDown() override {
+    for (auto &file : ListDir()) {
+      (void)remove((path_ + "/" + file).c_str());
+    }
+    (void)rmdir(path_.c_str());
+  }
+
+  std::vector<std::string> ListDir() {
+    std::vector<std::string> files;
+    DIR *dir = opendir(path_.c_str());
+    if (dir == nullptr) {
+      return files;
+    }
+    for (auto entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      if (name != "." && name != "..") {
+        files.push_back(name);
+      }
+    }
+    (void)closedir(dir);
+    return files;
+  }
+
+  FuncGraphPtr MakeGraph(const PrimitivePtr &prim) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    auto y = func_graph->add_parameter();
+    func_graph->set_output(func_graph->NewCNode({NewValueNode(prim), x, y}));
+    return func_graph;
+  }
+
+  abstract::AbstractBasePtrList MakeArgs(int x) {
+    return {std::make_shared<abstract::AbstractScalar>(x), std::make_shared<abstract::AbstractScalar>(1)};
+  }
+
+  // x + w, with the abstracts the optimized graph has
+  FuncGraphPtr MakeWeightGraph(const tensor::TensorPtr &weight, const std::string &weight_name = "w") {
+    ShapeVector shape = {2, 3};
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    auto w = func_graph->add_parameter();
+    w->set_name(weight_name);
+    w->set_default_param(weight);
+    w->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    auto add = func_graph->NewCNode({NewValueNode(prim::kPrimTensorAdd), x, w});
+    add->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    func_graph->set_output(add);
+    // the cache looks for the graphs it calls
+    managers_.push_back(Manage(func_graph, true));
+    return func_graph;
+  }
+
+  tensor::TensorPtr MakeWeight(float value) {
+    auto weight = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+    auto data = static_cast<float *>(weight->data_c());
+    std::fill(data, data + weight->DataSize(), value);
+    return weight;
+  }
+
+  std::string path_;
+  std::vector<FuncGraphManagerPtr> managers_;
+};
+
+// The key only depends on the structure of the graph, the arguments and the context.
+TEST_F(TestCompileCache, Key) {
+  auto &cache = CompileCache::GetInstance();
+  auto graph = MakeGraph(prim::kPrimScalarAdd);
+  auto key = cache.GetKey(graph, MakeArgs(1));
+  ASSERT_FALSE(key.empty());
+  ASSERT_EQ(key, cache.GetKey(BasicClone(graph), MakeArgs(1)));
+  ASSERT_NE(key, cache.GetKey(MakeGraph(prim::kPrimScalarMul), MakeArgs(1)));
+  ASSERT_NE(key, cache.GetKey(graph, {std::make_shared<abstract::AbstractScalar>(1.0f)}));
+
+  // the values of the weights are not in the key, the values of the constants are
+  ASSERT_EQ(cache.GetKey(MakeWeightGraph(MakeWeight(1)), {}), cache.GetKey(MakeWeightGraph(MakeWeight(2)), {}));
+  auto prim = std::make_shared<Primitive>("P");
+  prim->set_attr("alpha", MakeValue(0.1f));
+  auto prim_other = std::make_shared<Primitive>("P");
+  prim_other->set_attr("alpha", MakeValue(0.1000001f));
+  ASSERT_NE(cache.GetKey(MakeGraph(prim), {}), cache.GetKey(MakeGraph(prim_other), {}));
+
+  (void)setenv(opt::kEnvSubstitutionSweep, "1", 1);
+  auto key_env = cache.GetKey(graph, MakeArgs(1));
+  (void)unsetenv(opt::kEnvSubstitutionSweep);
+  ASSERT_NE(key, key_env);
+}
+
+// A graph holding a value whose state can not be written has no key and is never cached.
+TEST_F(TestCompileCache, UnknownValue) {
+  CompileCache cache(path_);
+  auto graph = MakeWeightGraph(MakeWeight(1));
+  auto func_graph = std::make_shared<FuncGraph>();
+  auto keyword_arg = std::make_shared<KeywordArg>("k", MakeValue(1));
+  func_graph->set_output(func_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), NewValueNode(keyword_arg)}));
+  auto key = cache.GetKey(func_graph, {});
+  ASSERT_TRUE(key.empty());
+  cache.Store(key, graph);
+  ASSERT_TRUE(ListDir().empty());
+  ASSERT_EQ(cache.Load(key, graph), nullptr);
+}
+
+// The cached graph is bound to the weights of the graph being compiled.
+TEST_F(TestCompileCache, StoreLoad) {
+  CompileCache cache(path_);
+  auto graph = MakeWeightGraph(MakeWeight(1));
+  auto key = cache.GetKey(graph, {});
+  ASSERT_EQ(cache.Load(key, graph), nullptr);
+  cache.Store(key, graph);
+  ASSERT_EQ(ListDir().size(), 3);
+
+  auto weight = MakeWeight(2);
+  auto resolved_graph = MakeWeightGraph(weight);
+  ASSERT_EQ(cache.GetKey(resolved_graph, {}), key);
+  auto cached_graph = cache.Load(key, resolved_graph);
+  ASSERT_NE(cached_graph, nullptr);
+  ASSERT_EQ(cached_graph->parameters().size(), 2);
+  auto param = cached_graph->parameters()[1]->cast<ParameterPtr>();
+  ASSERT_NE(param, nullptr);
+  ASSERT_EQ(param->name(), "w");
+  ASSERT_EQ(param->default_param(), weight);
+  ASSERT_FALSE(cached_graph->parameters()[0]->cast<ParameterPtr>()->has_default());
+  ASSERT_EQ(cache.Report(), "Compile cache " + path_ + ": hit 1, miss 1, stored 1, failed 0");
+}
+
+// An entry is only loaded for the key it was stored with.
+TEST_F(TestCompileCache, KeyMismatch) {
+  CompileCache cache(path_);
+  auto graph = MakeWeightGraph(MakeWeight(1));
+  auto key = cache.GetKey(graph, {});
+  cache.Store(key, graph);
+  for (auto &file : ListDir()) {
+    if (file.size() > 4 && file.substr(file.size() - 4) == ".key") {
+      std::ofstream ofs(path_ + "/" + file, std::ios::trunc);
+      ofs << "another key with the same hash";
+    }
+  }
+  ASSERT_EQ(cache.Load(key, graph), nullptr);
+  ASSERT_EQ(ListDir().size(), 3);
+  cache.Store(key, graph);
+  ASSERT_NE(cache.Load(key, graph), nullptr);
+}
+
+// An entry whose weights can not be rebound is removed.
+TEST_F(TestCompileCache, InvalidEntry) {
+  CompileCache cache(path_);
+  auto graph = MakeWeightGraph(MakeWeight(1));
+  auto key = cache.GetKey(graph, {});
+  cache.Store(key, graph);
+  ASSERT_EQ(ListDir().size(), 3);
+
+  ASSERT_EQ(cache.Load(key, MakeWeightGraph(MakeWeight(1), "v")), nullptr);
+  ASSERT_TRUE(ListDir().empty());
+  ASSERT_EQ(cache.Load(key, graph), nullptr);
+  ASSERT_EQ(cache.Report(), "Compile cache " + path_ + ": hit 0, miss 2, stored 1, failed 1");
+}
+
+// The actions between symbol_resolve and validate are skipped on a hit.
+TEST_F(TestCompileCache, WrapActions) {
+  std::vector<std::string> names = {"parse", "symbol_resolve", "optimize", "validate", "task_emit"};
+  std::vector<ActionItem> actions;
+  for (auto &name : names) {
+    actions.emplace_back(name, [](const ResourcePtr &) { return true; });
+  }
+  auto wrapped_actions = CompileCache::GetInstance().WrapActions(actions);
+  std::vector<std::string> wrapped_names;
+  for (auto &action : wrapped_actions) {
+    wrapped_names.push_back(action.first);
+  }
+  std::vector<std::string> expect_names = {"parse",    "symbol_resolve",      "load_compile_cache",
+                                           "optimize", "store_compile_cache", "validate",
+                                           "task_emit"};
+  ASSERT_EQ(wrapped_names, expect_names);
+
+  actions.pop_back();
+  ASSERT_EQ(CompileCache::GetInstance().WrapActions(actions).size(), actions.size());
+}
+}  // namespace pipeline
+}  // namespace mindspore
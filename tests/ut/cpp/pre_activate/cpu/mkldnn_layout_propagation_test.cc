@@ -0,0 +1,174 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/common/pass_manager.h"
+#include "backend/optimizer/cpu/mkldnn_layout_propagation.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "ir/tensor.h"
+#include "runtime/device/kernel_info.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class TestHWMkldnnLayoutPropagation : public BackendCommon {
+ public:
+  TestHWMkldnnLayoutPropagation() : get_py_fun_("gtest_input.pre_activate.mkldnn_layout_propagation_test", true) {}
+  ~TestHWMkldnnLayoutPropagation() override = default;
+
+  // Builds the kernel graph and selects float32 default format kernels for it, as CPUSession::SetKernelInfo does.
+  KernelGraphPtr GetKernelGraphWithKernelInfo(const std::string &sub_func_name, const std::vector<int> &shp,
+                                              const std::vector<int> &weight_shp = {}) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_mkldnn_layout_propagation", sub_func_name);
+    auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+    AbstractBasePtrList args_spec_list{x_abstract};
+    if (!weight_shp.empty()) {
+      args_spec_list.push_back(std::make_shared<abstract::AbstractTensor>(kFloat32, weight_shp));
+    }
+    auto kg = GetKernelGraph(g, args_spec_list);
+    for (auto &cnode : kg->execution_order()) {
+      size_t input_num = AnfAlgo::GetInputTensorNum(cnode);
+      size_t output_num = AnfAlgo::GetOutputTensorNum(cnode);
+      KernelBuildInfoBuilder builder;
+      builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+      builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+      builder.SetInputsReshapeType(std::vector<std::vector<Axis>>(input_num));
+      builder.SetOutputsFormat(std::vector<std::string>(output_num, kOpFormat_DEFAULT));
+      builder.SetOutputsDeviceType(std::vector<TypeId>(output_num, kNumberTypeFloat32));
+      builder.SetOutputsReshapeType(std::vector<std::vector<Axis>>(output_num));
+      cnode->set_kernel_info(std::make_shared<device::KernelInfo>());
+      AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), cnode.get());
+    }
+    return kg;
+  }
+
+  bool RunPass(const KernelGraphPtr &kg) {
+    auto optimizer = std::make_shared<opt::GraphOptimizer>();
+    auto pm = std::make_shared<opt::PassManager>();
+    pm->AddPass(std::make_shared<opt::MkldnnLayoutPropagation>());
+    optimizer->AddPassManager(pm);
+    (void)optimizer->Optimize(kg);
+    return std::any_of(kg->execution_order().begin(), kg->execution_order().end(), [](const CNodePtr &cnode) {
+      return AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedOutput, cnode) ||
+             AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedInput, cnode);
+    });
+  }
+
+  static CNodePtr FindKernel(const KernelGraphPtr &kg, const PrimitivePtr &prim, size_t index = 0) {
+    for (auto &cnode : kg->execution_order()) {
+      if (IsPrimitiveCNode(cnode, prim) && index-- == 0) {
+        return cnode;
+      }
+    }
+    return nullptr;
+  }
+
+  // Gives the last input of the graph a default value, as a weight has.
+  static void SetWeight(const KernelGraphPtr &kg) {
+    ASSERT_FALSE(kg->inputs().empty());
+    auto weight = kg->inputs().back()->cast<ParameterPtr>();
+    ASSERT_NE(weight, nullptr);
+    weight->set_default_param(std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{32, 32, 3, 3}));
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+  const std::vector<int> shp_{2, 32, 8, 8};
+  const std::vector<int> weight_shp_{32, 32, 3, 3};
+};
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_single_user) {
+  auto kg = GetKernelGraphWithKernelInfo("single_user", shp_);
+  EXPECT_TRUE(RunPass(kg));
+  auto relu = FindKernel(kg, prim::kPrimRelu);
+  auto max_pool = FindKernel(kg, prim::kPrimMaxPool);
+  ASSERT_NE(relu, nullptr);
+  ASSERT_NE(max_pool, nullptr);
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedOutput, relu));
+  EXPECT_FALSE(AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedInput, relu));
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedInput, max_pool));
+  // The graph output stays in the default layout.
+  EXPECT_FALSE(AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedOutput, max_pool));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_multi_user) {
+  auto kg = GetKernelGraphWithKernelInfo("multi_user", shp_);
+  EXPECT_FALSE(RunPass(kg));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_graph_output) {
+  auto kg = GetKernelGraphWithKernelInfo("graph_output", shp_);
+  EXPECT_FALSE(RunPass(kg));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_not_4d) {
+  auto kg = GetKernelGraphWithKernelInfo("relu_relu", {2, 32});
+  EXPECT_FALSE(RunPass(kg));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_4d_relu_relu) {
+  auto kg = GetKernelGraphWithKernelInfo("relu_relu", shp_);
+  EXPECT_TRUE(RunPass(kg));
+  auto first = FindKernel(kg, prim::kPrimRelu, 0);
+  auto second = FindKernel(kg, prim::kPrimRelu, 1);
+  ASSERT_NE(first, nullptr);
+  ASSERT_NE(second, nullptr);
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedOutput, first));
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedInput, second));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_read_only_weight) {
+  auto kg = GetKernelGraphWithKernelInfo("conv_relu", shp_, weight_shp_);
+  SetWeight(kg);
+  EXPECT_TRUE(RunPass(kg));
+  auto conv = FindKernel(kg, prim::kPrimConv2D);
+  ASSERT_NE(conv, nullptr);
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr(kAttrMkldnnReadOnlyWeight, conv));
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr(kAttrMkldnnBlockedOutput, conv));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_weight_read_by_others) {
+  auto kg = GetKernelGraphWithKernelInfo("conv_weight_output", shp_, weight_shp_);
+  SetWeight(kg);
+  (void)RunPass(kg);
+  auto conv = FindKernel(kg, prim::kPrimConv2D);
+  ASSERT_NE(conv, nullptr);
+  EXPECT_FALSE(AnfAlgo::HasNodeAttr(kAttrMkldnnReadOnlyWeight, conv));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_input_not_weight) {
+  auto kg = GetKernelGraphWithKernelInfo("conv_relu", shp_, weight_shp_);
+  (void)RunPass(kg);
+  auto conv = FindKernel(kg, prim::kPrimConv2D);
+  ASSERT_NE(conv, nullptr);
+  EXPECT_FALSE(AnfAlgo::HasNodeAttr(kAttrMkldnnReadOnlyWeight, conv));
+}
+
+TEST_F(TestHWMkldnnLayoutPropagation, test_internal_output) {
+  auto kg = GetKernelGraphWithKernelInfo("single_user", shp_);
+  auto relu = FindKernel(kg, prim::kPrimRelu);
+  ASSERT_NE(relu, nullptr);
+  // The relu output is also read by a following graph.
+  kg->AddInternalOutput(relu, relu, 0);
+  EXPECT_FALSE(RunPass(kg));
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -106,6 +106,48 @@ def test_idempotent(tag):
     return fns[tag]
 
 
+def test_substitution_sweep(tag):
+    """ test_substitution_sweep """
+    P = Primitive('P')
+    R = Primitive('R')
+
+    fns = FnDict()
+
+    @fns
+    def before(x):
+        return P(R(P(R(P(x)))))
+
+    @fns
+    def after(x):
+        return P(x)
+
+    @fns
+    def after_once(x):
+        return P(P(P(x)))
+
+    return fns[tag]
+
+
+def test_substitution_mix(tag):
+    """ test_substitution_mix """
+    P = Primitive('P')
+    Q = Primitive('Q')
+    R = Primitive('R')
+
+    fns = FnDict()
+
+    @fns
+    def before(x):
+        y = scalar_add(P(R(P(Q(2)))), 0)
+        return scalar_add(R(P(P(x))), y)
+
+    @fns
+    def after(x):
+        return scalar_add(P(x), P(2))
+
+    return fns[tag]
+
+
 def test_constant_variable(tag):
     """ test_constant_variable """
     P = Primitive('P')
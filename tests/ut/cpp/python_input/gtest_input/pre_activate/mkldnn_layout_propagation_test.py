@@ -0,0 +1,75 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import Primitive
+from mindspore.ops import operations as P
+
+relu = P.ReLU()
+max_pool = P.MaxPool(ksize=2, strides=2)
+conv = P.Conv2D(out_channel=32, kernel_size=3, pad_mode='same')
+make_tuple = Primitive('make_tuple')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_mkldnn_layout_propagation(tag):
+    fns = FnDict()
+
+    @fns
+    def single_user(x):
+        res = relu(x)
+        res = max_pool(res)
+        return res
+
+    @fns
+    def multi_user(x):
+        res = relu(x)
+        pool = max_pool(res)
+        res = relu(res)
+        return make_tuple(pool, res)
+
+    @fns
+    def graph_output(x):
+        res = relu(x)
+        pool = max_pool(res)
+        return make_tuple(res, pool)
+
+    @fns
+    def relu_relu(x):
+        res = relu(x)
+        res = relu(res)
+        return res
+
+    @fns
+    def conv_relu(x, w):
+        res = conv(x, w)
+        res = relu(res)
+        return res
+
+    @fns
+    def conv_weight_output(x, w):
+        res = conv(x, w)
+        res = relu(res)
+        return make_tuple(res, w)
+
+    return fns[tag]
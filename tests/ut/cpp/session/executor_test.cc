@@ -0,0 +1,224 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/executor.h"
+#include "backend/session/executor_manager.h"
+#include "backend/session/session_basic.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace session {
+namespace {
+constexpr size_t kSessionNum = 4;
+constexpr size_t kGraphNum = 8;
+constexpr auto kRunTime = std::chrono::milliseconds(5);
+constexpr auto kRendezvousTimeout = std::chrono::seconds(30);
+
+// Graphs running in any session, and the most of them ever running at once.
+std::atomic<int> running_graph_num{0};
+std::atomic<int> peak_graph_num{0};
+// The first graph of a session waits until this many graphs ran at once, so the overlap does not depend on timing.
+std::atomic<int> rendezvous_graph_num{0};
+
+// A session whose graphs sleep for kRunTime and produce one tensor.
+class SleepSession : public SessionBasic {
+ public:
+  GraphId CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) override {
+    compiled_alone_ = running_graph_num == 0;
+    return 0;
+  }
+
+  void CreateOutputTensors(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &input_tensors,
+                           VectorRef *outputs,
+                           std::map<tensor::TensorPtr, session::KernelWithIndex> *tensor_to_node) override {
+    auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{1});
+    tensor->SetNeedWait(true);
+    outputs->push_back(tensor);
+  }
+
+  void RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) override {
+    run_count_++;
+    if (gate_.valid()) {
+      gate_.wait();
+    }
+    int running = ++running_graph_num;
+    int peak = peak_graph_num;
+    while (running > peak && !peak_graph_num.compare_exchange_weak(peak, running)) {
+    }
+    if (++running_ > 1) {
+      overlapped_ = true;
+    }
+    auto deadline = std::chrono::steady_clock::now() + kRendezvousTimeout;
+    while (graph_id == 0 && peak_graph_num < rendezvous_graph_num && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(kRunTime);
+    running_--;
+    running_graph_num--;
+    if (fail_) {
+      MS_LOG(EXCEPTION) << "Run graph " << graph_id << " failed.";
+    }
+  }
+
+  std::atomic<int> running_{0};
+  std::atomic<bool> overlapped_{false};
+  std::atomic<bool> compiled_alone_{false};
+  std::atomic<int> run_count_{0};
+  bool fail_{false};
+  // RunGraph blocks until the gate opens if it is set
+  std::shared_future<void> gate_;
+};
+
+std::vector<std::shared_ptr<SleepSession>> CreateSessions() {
+  std::vector<std::shared_ptr<SleepSession>> sessions;
+  for (size_t i = 0; i < kSessionNum; ++i) {
+    sessions.emplace_back(std::make_shared<SleepSession>());
+  }
+  return sessions;
+}
+
+void WaitOutput(const VectorRef &outputs) {
+  ASSERT_EQ(outputs.size(), 1);
+  auto tensor = utils::cast<tensor::TensorPtr>(outputs[0]);
+  tensor->Wait();
+}
+
+// Runs kGraphNum graphs in each session, returns the time it takes in milliseconds.
+double RunGraphs(size_t thread_num, const std::vector<std::shared_ptr<SleepSession>> &sessions) {
+  (void)setenv(kEnvExecutorThreadNum, std::to_string(thread_num).c_str(), 1);
+  Executor executor(kCPUDevice, 0);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<VectorRef> outputs(kGraphNum * sessions.size());
+  for (size_t graph = 0; graph < kGraphNum; ++graph) {
+    for (size_t i = 0; i < sessions.size(); ++i) {
+      (void)executor.RunGraphAsync(sessions[i], graph, {}, &outputs[graph * sessions.size() + i]);
+    }
+  }
+  for (auto &output : outputs) {
+    WaitOutput(output);
+  }
+  std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - start;
+  executor.WorkerJoin();
+  (void)unsetenv(kEnvExecutorThreadNum);
+  return cost.count();
+}
+}  // namespace
+
+class ExecutorTest : public UT::Common {
+ public:
+  ExecutorTest() = default;
+};
+
+// The graphs of different sessions overlap, the graphs of a session run one after another. The costs are only logged,
+// the overlap is checked by the graphs running at once.
+TEST_F(ExecutorTest, Throughput) {
+  auto serial_sessions = CreateSessions();
+  peak_graph_num = 0;
+  double serial_cost = RunGraphs(1, serial_sessions);
+  EXPECT_EQ(peak_graph_num, 1);
+  auto parallel_sessions = CreateSessions();
+  peak_graph_num = 0;
+  rendezvous_graph_num = kSessionNum;
+  double parallel_cost = RunGraphs(kSessionNum, parallel_sessions);
+  rendezvous_graph_num = 0;
+  EXPECT_EQ(peak_graph_num, kSessionNum);
+  for (auto &session : parallel_sessions) {
+    EXPECT_FALSE(session->overlapped_);
+  }
+  MS_LOG(INFO) << kSessionNum * kGraphNum << " graphs run in " << serial_cost << " ms with 1 worker thread, in "
+               << parallel_cost << " ms with " << kSessionNum << " worker threads.";
+}
+
+// A compile task waits for the running graphs and runs alone.
+TEST_F(ExecutorTest, CompileRunsAlone) {
+  (void)setenv(kEnvExecutorThreadNum, std::to_string(kSessionNum).c_str(), 1);
+  Executor executor(kCPUDevice, 0);
+  auto sessions = CreateSessions();
+  std::vector<VectorRef> outputs(sessions.size());
+  for (size_t i = 0; i < sessions.size(); ++i) {
+    (void)executor.RunGraphAsync(sessions[i], 0, {}, &outputs[i]);
+  }
+  (void)executor.CompileGraphAsync(sessions[0], {}, {});
+  EXPECT_TRUE(sessions[0]->compiled_alone_);
+  for (auto &output : outputs) {
+    WaitOutput(output);
+  }
+  executor.WorkerJoin();
+  (void)unsetenv(kEnvExecutorThreadNum);
+}
+
+// The outputs of a failed graph do not block their readers, the failure is reported by the future of the graph and
+// by the next call to the executor from the same session.
+TEST_F(ExecutorTest, RunGraphFailed) {
+  (void)setenv(kEnvExecutorThreadNum, "2", 1);
+  Executor executor(kCPUDevice, 0);
+  auto session = std::make_shared<SleepSession>();
+  session->fail_ = true;
+  VectorRef outputs;
+  auto future = executor.RunGraphAsync(session, 0, {}, &outputs);
+  WaitOutput(outputs);
+  EXPECT_ANY_THROW(future.get());
+  auto other_session = std::make_shared<SleepSession>();
+  VectorRef other_outputs;
+  EXPECT_NO_THROW(executor.RunGraphAsync(other_session, 0, {}, &other_outputs));
+  WaitOutput(other_outputs);
+  session->fail_ = false;
+  VectorRef next_outputs;
+  EXPECT_ANY_THROW(executor.RunGraphAsync(session, 0, {}, &next_outputs));
+  (void)executor.RunGraphAsync(session, 0, {}, &next_outputs);
+  WaitOutput(next_outputs);
+  executor.WorkerJoin();
+  (void)unsetenv(kEnvExecutorThreadNum);
+}
+
+// A graph waiting for the outputs of a failed graph fails without running, its outputs do not block their readers.
+TEST_F(ExecutorTest, DependentGraphFailed) {
+  (void)setenv(kEnvExecutorThreadNum, "2", 1);
+  auto executor = ExecutorManager::Instance().GetExecutor(kCPUDevice, 0);
+  auto failed_session = std::make_shared<SleepSession>();
+  failed_session->fail_ = true;
+  std::promise<void> gate;
+  failed_session->gate_ = gate.get_future().share();
+  VectorRef failed_outputs;
+  auto failed_future = executor->RunGraphAsync(failed_session, 0, {}, &failed_outputs);
+
+  // the input is not ready, the graph is pending until the failed graph finishes
+  auto dependent_session = std::make_shared<SleepSession>();
+  auto input = utils::cast<tensor::TensorPtr>(failed_outputs[0]);
+  VectorRef dependent_outputs;
+  auto dependent_future = executor->RunGraphAsync(dependent_session, 0, {input}, &dependent_outputs);
+  gate.set_value();
+
+  WaitOutput(failed_outputs);
+  WaitOutput(dependent_outputs);
+  EXPECT_ANY_THROW(failed_future.get());
+  EXPECT_ANY_THROW(dependent_future.get());
+  EXPECT_EQ(dependent_session->run_count_, 0);
+  ExecutorManager::Instance().Clear();
+  (void)unsetenv(kEnvExecutorThreadNum);
+}
+}  // namespace session
+}  // namespace mindspore
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include "common/common_test.h"
+#include "backend/session/single_op_graph_cache.h"
+
+namespace mindspore {
+namespace session {
+class SingleOpGraphCacheTest : public UT::Common {
+ public:
+  SingleOpGraphCacheTest() = default;
+};
+
+TEST_F(SingleOpGraphCacheTest, EvictLeastRecentlyUsed) {
+  SingleOpGraphCache cache(2);
+  auto add_graph = std::make_shared<KernelGraph>();
+  auto mul_graph = std::make_shared<KernelGraph>();
+  auto sub_graph = std::make_shared<KernelGraph>();
+  EXPECT_EQ(cache.Get("2_3_43_Add"), nullptr);
+  cache.Put("2_3_43_Add", add_graph);
+  EXPECT_EQ(cache.Get("2_3_43_Mul"), nullptr);
+  cache.Put("2_3_43_Mul", mul_graph);
+  // Add becomes the most recently used graph, Mul is evicted for Sub
+  EXPECT_EQ(cache.Get("2_3_43_Add"), add_graph);
+  EXPECT_EQ(cache.Get("2_3_43_Sub"), nullptr);
+  cache.Put("2_3_43_Sub", sub_graph);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.Find("2_3_43_Mul"), nullptr);
+  EXPECT_EQ(cache.Find("2_3_43_Add"), add_graph);
+  EXPECT_EQ(cache.Find("2_3_43_Sub"), sub_graph);
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(cache.misses(), 3);
+  EXPECT_EQ(cache.evictions(), 1);
+}
+
+TEST_F(SingleOpGraphCacheTest, CapacityFromEnv) {
+  EXPECT_EQ(SingleOpGraphCache::GetCapacityFromEnv(), kDefaultSingleOpGraphCacheSize);
+  (void)setenv(kEnvSingleOpGraphCacheSize, "16", 1);
+  EXPECT_EQ(SingleOpGraphCache::GetCapacityFromEnv(), 16);
+  (void)setenv(kEnvSingleOpGraphCacheSize, "0", 1);
+  EXPECT_EQ(SingleOpGraphCache::GetCapacityFromEnv(), kDefaultSingleOpGraphCacheSize);
+  (void)unsetenv(kEnvSingleOpGraphCacheSize);
+}
+}  // namespace session
+}  // namespace mindspore
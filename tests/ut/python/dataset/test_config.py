@@ -357,6 +357,25 @@ def test_deterministic_python_seed_multi_thread():
     ds.config.set_seed(seed_original)
 
 
+def test_mindrecord_prefetch_window():
+    """
+    Test the bounds of the mindrecord prefetch window
+    """
+    window_original = ds.config.get_mindrecord_prefetch_window()
+
+    ds.config.set_mindrecord_prefetch_window(4096)
+    assert ds.config.get_mindrecord_prefetch_window() == 4096
+    for window in [-1, 4097, 2147483647]:
+        try:
+            ds.config.set_mindrecord_prefetch_window(window)
+            assert False
+        except ValueError as e:
+            assert "not within the required range" in str(e)
+    assert ds.config.get_mindrecord_prefetch_window() == 4096
+
+    ds.config.set_mindrecord_prefetch_window(window_original)
+
+
 if __name__ == '__main__':
     test_basic()
     test_get_seed()
@@ -367,3 +386,4 @@ if __name__ == '__main__':
     test_deterministic_run_distribution()
     test_deterministic_python_seed()
     test_deterministic_python_seed_multi_thread()
+    test_mindrecord_prefetch_window()